@@ -811,6 +811,19 @@ macro(process_options)
     endif()
   endif()
 
+  set(ENABLE_ZLIB False)
+  if(${NS3_ZLIB})
+    find_package(ZLIB QUIET)
+
+    if(${ZLIB_FOUND})
+      set(ENABLE_ZLIB True)
+      add_definitions(-DHAVE_ZLIB)
+      include_directories(${ZLIB_INCLUDE_DIRS})
+    else()
+      message(${HIGHLIGHTED_STATUS} "zlib was not found")
+    endif()
+  endif()
+
   # GTK3 Don't search for it if you don't have it installed, as it take an
   # insane amount of time
   if(${NS3_GTK3})
@@ -0,0 +1,239 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/buildings-module.h"
+#include "ns3/core-module.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup buildings
+ *
+ * Benchmark of the building lookups used by MobilityBuildingInfo and
+ * BuildingsChannelConditionModel.
+ *
+ * For each number of buildings, the program places the buildings at random
+ * in a square city whose area grows with the number of buildings, and
+ * measures the rate of line of sight queries between random outdoor
+ * positions and of indoor/outdoor classifications of random positions, with
+ * the spatial index of the BuildingList and with a test of every building,
+ * e.g.:
+ *
+ * \code
+ *   ./ns3 run "buildings-los-benchmark --buildings=100,1000,10000,20000"
+ * \endcode
+ *
+ * The time to build the index, which is done on the first query after the
+ * buildings change, is reported separately.
+ */
+
+NS_LOG_COMPONENT_DEFINE("BuildingsLosBenchmark");
+
+/**
+ * Parse a comma separated list of unsigned integers.
+ *
+ * \param list the list
+ * \return the values of the list
+ */
+static std::vector<uint32_t>
+ParseList(std::string list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Test every building for an intersection with a line segment, as done
+ * without the spatial index.
+ *
+ * \param l1 one end of the line segment
+ * \param l2 the other end of the line segment
+ * \return true if a building intersects the segment
+ */
+static bool
+IsBlockedLinear(const Vector& l1, const Vector& l2)
+{
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsIntersect(l1, l2))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Test every building for a position, as done without the spatial index.
+ *
+ * \param position the position
+ * \return true if a building contains the position
+ */
+static bool
+IsIndoorLinear(const Vector& position)
+{
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsInside(position))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Run the benchmark for a number of buildings and print its results.
+ *
+ * \param nBuildings the number of buildings
+ * \param nQueries the number of queries of each type
+ * \param blockSize the side of the area per building [m]
+ */
+static void
+RunConfiguration(uint32_t nBuildings, uint32_t nQueries, double blockSize)
+{
+    using Clock = std::chrono::steady_clock;
+
+    double citySize = std::sqrt(nBuildings) * blockSize;
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    for (uint32_t i = 0; i < nBuildings; ++i)
+    {
+        Ptr<Building> building = CreateObject<Building>();
+        double x = rand->GetValue(0, citySize);
+        double y = rand->GetValue(0, citySize);
+        building->SetBoundaries(Box(x,
+                                    x + rand->GetValue(10, 40),
+                                    y,
+                                    y + rand->GetValue(10, 40),
+                                    0,
+                                    rand->GetValue(10, 60)));
+    }
+
+    // segments between UEs at 1.5 m and base stations at 25 m, at most 500 m apart
+    std::vector<std::pair<Vector, Vector>> segments(nQueries);
+    std::vector<Vector> positions(nQueries);
+    for (uint32_t i = 0; i < nQueries; ++i)
+    {
+        Vector ue(rand->GetValue(0, citySize), rand->GetValue(0, citySize), 1.5);
+        Vector bs(ue.x + rand->GetValue(-500, 500), ue.y + rand->GetValue(-500, 500), 25);
+        segments[i] = std::make_pair(ue, bs);
+        positions[i] = ue;
+    }
+
+    auto start = Clock::now();
+    BuildingList::GetBuildingsAt(Vector(0, 0, 0));
+    double buildS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32_t blocked = 0;
+    start = Clock::now();
+    for (const auto& segment : segments)
+    {
+        blocked += BuildingList::IsAnyBuildingIntersecting(segment.first, segment.second);
+    }
+    double losIndexS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32_t blockedLinear = 0;
+    start = Clock::now();
+    for (const auto& segment : segments)
+    {
+        blockedLinear += IsBlockedLinear(segment.first, segment.second);
+    }
+    double losLinearS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32_t indoor = 0;
+    start = Clock::now();
+    for (const auto& position : positions)
+    {
+        indoor += !BuildingList::GetBuildingsAt(position).empty();
+    }
+    double indoorIndexS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    uint32_t indoorLinear = 0;
+    start = Clock::now();
+    for (const auto& position : positions)
+    {
+        indoorLinear += IsIndoorLinear(position);
+    }
+    double indoorLinearS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    NS_ABORT_MSG_IF(blocked != blockedLinear || indoor != indoorLinear,
+                    "The spatial index and the linear search disagree");
+
+    std::cout << nBuildings << "\t" << std::fixed << std::setprecision(4) << buildS << "\t"
+              << std::setprecision(0) << nQueries / losIndexS << "\t" << nQueries / losLinearS
+              << "\t" << std::setprecision(1) << losLinearS / losIndexS << "\t"
+              << std::setprecision(0) << nQueries / indoorIndexS << "\t"
+              << nQueries / indoorLinearS << "\t" << std::setprecision(1)
+              << indoorLinearS / indoorIndexS << "\t" << 100.0 * blocked / nQueries << std::endl;
+
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string buildings = "100,1000,5000,20000";
+    uint32_t queries = 20000;
+    double blockSize = 60;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("buildings", "Comma separated numbers of buildings", buildings);
+    cmd.AddValue("queries", "Number of queries of each type", queries);
+    cmd.AddValue("blockSize", "Side of the area per building [m]", blockSize);
+    cmd.Parse(argc, argv);
+
+    std::cout << "buildings\tbuild(s)\tlos/s\tlinearLos/s\tspeedup\tindoor/s\t"
+              << "linearIndoor/s\tspeedup\tblocked(%)" << std::endl;
+    for (uint32_t nBuildings : ParseList(buildings))
+    {
+        RunConfiguration(nBuildings, queries, blockSize);
+    }
+    return 0;
+}
@@ -187,20 +187,14 @@ OutdoorPositionAllocator::GetNext() const
 
         NS_LOG_INFO("Position " << position);
 
-        bool inside = false;
-        for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+        std::vector<Ptr<Building>> buildings = BuildingList::GetBuildingsAt(position);
+        bool inside = !buildings.empty();
+        if (inside)
         {
-            if ((*bit)->IsInside(position))
-            {
-                NS_LOG_INFO("Position "
-                            << position << " is inside the building with boundaries "
-                            << (*bit)->GetBoundaries().xMin << " " << (*bit)->GetBoundaries().xMax
-                            << " " << (*bit)->GetBoundaries().yMin << " "
-                            << (*bit)->GetBoundaries().yMax << " " << (*bit)->GetBoundaries().zMin
-                            << " " << (*bit)->GetBoundaries().zMax);
-                inside = true;
-                break;
-            }
+            Box box = buildings.front()->GetBoundaries();
+            NS_LOG_INFO("Position " << position << " is inside the building with boundaries "
+                                    << box.xMin << " " << box.xMax << " " << box.yMin << " "
+                                    << box.yMax << " " << box.zMin << " " << box.zMax);
         }
 
         if (inside)
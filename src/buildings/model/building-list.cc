@@ -28,6 +28,10 @@
 #include "ns3/object-vector.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -77,6 +81,30 @@ class BuildingListPriv : public Object
      * \returns the container size
      */
     uint32_t GetNBuildings();
+    /**
+     * Gets the buildings containing a position
+     * \param position the position
+     * \returns the buildings, in the order of the container
+     */
+    std::vector<Ptr<Building>> GetBuildingsAt(const Vector& position);
+    /**
+     * Checks if a line segment intersects a building
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \returns true if at least one building intersects the line segment
+     */
+    bool IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2);
+    /**
+     * Gets the buildings intersecting a line segment
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \returns the buildings, in the order of the container
+     */
+    std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /**
+     * Rebuild the spatial index before the next query
+     */
+    void InvalidateIndex();
 
     /**
      * Get the Singleton instance of BuildingListPriv (or create one)
@@ -98,9 +126,47 @@ class BuildingListPriv : public Object
      *
      */
     static void Delete();
+    /**
+     * Build the grid over the footprints of the buildings
+     */
+    void BuildIndex();
+    /**
+     * \param x an X coordinate
+     * \returns the column of the grid containing the coordinate, clamped to the grid
+     */
+    uint32_t GetCellX(double x) const;
+    /**
+     * \param y an Y coordinate
+     * \returns the row of the grid containing the coordinate, clamped to the grid
+     */
+    uint32_t GetCellY(double y) const;
+    /**
+     * Call a function for each building intersecting a line segment,
+     * until the function returns true
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \param visit the function, called with the index of the building
+     */
+    template <typename F>
+    void VisitIntersectingBuildings(const Vector& l1, const Vector& l2, F visit);
+
     std::vector<Ptr<Building>> m_buildings; //!< Container of Building
+    /// Indices of the buildings whose footprint overlaps each cell of the grid, row by row
+    std::vector<std::vector<uint32_t>> m_cells;
+    double m_gridXMin;     //!< X coordinate of the first column of the grid
+    double m_gridYMin;     //!< Y coordinate of the first row of the grid
+    double m_cellSize;     //!< size of the square cells of the grid
+    uint32_t m_nCellsX;    //!< number of columns of the grid
+    uint32_t m_nCellsY;    //!< number of rows of the grid
+    bool m_indexValid;     //!< true if the grid is up to date
+    uint32_t m_queryId;    //!< identifier of the current line segment query
+    /// For each building, the last line segment query which tested it
+    std::vector<uint32_t> m_lastQuery;
 };
 
+/// Maximum number of columns or rows of the grid
+static const uint32_t MAX_GRID_CELLS_PER_AXIS = 4096;
+
 NS_OBJECT_ENSURE_REGISTERED(BuildingListPriv);
 
 TypeId
@@ -146,6 +212,13 @@ BuildingListPriv::Delete()
 }
 
 BuildingListPriv::BuildingListPriv()
+    : m_gridXMin(0),
+      m_gridYMin(0),
+      m_cellSize(1),
+      m_nCellsX(0),
+      m_nCellsY(0),
+      m_indexValid(false),
+      m_queryId(0)
 {
     NS_LOG_FUNCTION_NOARGS();
 }
@@ -165,6 +238,9 @@ BuildingListPriv::DoDispose()
         *i = nullptr;
     }
     m_buildings.erase(m_buildings.begin(), m_buildings.end());
+    m_cells.clear();
+    m_lastQuery.clear();
+    m_indexValid = false;
     Object::DoDispose();
 }
 
@@ -173,6 +249,7 @@ BuildingListPriv::Add(Ptr<Building> building)
 {
     uint32_t index = m_buildings.size();
     m_buildings.push_back(building);
+    m_indexValid = false;
     Simulator::ScheduleWithContext(index, TimeStep(0), &Building::Initialize, building);
     return index;
 }
@@ -204,6 +281,192 @@ BuildingListPriv::GetBuilding(uint32_t n)
     return m_buildings.at(n);
 }
 
+void
+BuildingListPriv::InvalidateIndex()
+{
+    m_indexValid = false;
+}
+
+void
+BuildingListPriv::BuildIndex()
+{
+    NS_LOG_FUNCTION(this << m_buildings.size());
+    m_cells.clear();
+    m_lastQuery.assign(m_buildings.size(), 0);
+    m_queryId = 0;
+    m_indexValid = true;
+    if (m_buildings.empty())
+    {
+        m_nCellsX = 0;
+        m_nCellsY = 0;
+        return;
+    }
+
+    double xMax = -std::numeric_limits<double>::infinity();
+    double yMax = -std::numeric_limits<double>::infinity();
+    m_gridXMin = std::numeric_limits<double>::infinity();
+    m_gridYMin = std::numeric_limits<double>::infinity();
+    double sideSum = 0;
+    for (const auto& building : m_buildings)
+    {
+        Box box = building->GetBoundaries();
+        m_gridXMin = std::min(m_gridXMin, box.xMin);
+        m_gridYMin = std::min(m_gridYMin, box.yMin);
+        xMax = std::max(xMax, box.xMax);
+        yMax = std::max(yMax, box.yMax);
+        sideSum += std::max(box.xMax - box.xMin, box.yMax - box.yMin);
+    }
+
+    // about one building per cell, but cells not smaller than the average
+    // building, so that each building overlaps only a few cells
+    double width = xMax - m_gridXMin;
+    double height = yMax - m_gridYMin;
+    m_cellSize = std::max({std::sqrt(width * height / m_buildings.size()),
+                           sideSum / m_buildings.size(),
+                           width / MAX_GRID_CELLS_PER_AXIS,
+                           height / MAX_GRID_CELLS_PER_AXIS});
+    if (m_cellSize <= 0)
+    {
+        m_cellSize = 1;
+    }
+    m_nCellsX = std::min(static_cast<uint32_t>(width / m_cellSize) + 1, MAX_GRID_CELLS_PER_AXIS);
+    m_nCellsY = std::min(static_cast<uint32_t>(height / m_cellSize) + 1, MAX_GRID_CELLS_PER_AXIS);
+    m_cells.resize(static_cast<std::size_t>(m_nCellsX) * m_nCellsY);
+
+    for (uint32_t i = 0; i < m_buildings.size(); ++i)
+    {
+        Box box = m_buildings[i]->GetBoundaries();
+        for (uint32_t cy = GetCellY(box.yMin); cy <= GetCellY(box.yMax); ++cy)
+        {
+            for (uint32_t cx = GetCellX(box.xMin); cx <= GetCellX(box.xMax); ++cx)
+            {
+                m_cells[cy * m_nCellsX + cx].push_back(i);
+            }
+        }
+    }
+    NS_LOG_LOGIC("grid of " << m_nCellsX << "x" << m_nCellsY << " cells of " << m_cellSize
+                            << " m");
+}
+
+uint32_t
+BuildingListPriv::GetCellX(double x) const
+{
+    double cell = std::floor((x - m_gridXMin) / m_cellSize);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0, m_nCellsX - 1.0));
+}
+
+uint32_t
+BuildingListPriv::GetCellY(double y) const
+{
+    double cell = std::floor((y - m_gridYMin) / m_cellSize);
+    return static_cast<uint32_t>(std::clamp(cell, 0.0, m_nCellsY - 1.0));
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetBuildingsAt(const Vector& position)
+{
+    if (!m_indexValid)
+    {
+        BuildIndex();
+    }
+    std::vector<Ptr<Building>> buildings;
+    if (m_buildings.empty())
+    {
+        return buildings;
+    }
+    // the indices of each cell are sorted, as the buildings are added in order
+    for (uint32_t i : m_cells[GetCellY(position.y) * m_nCellsX + GetCellX(position.x)])
+    {
+        if (m_buildings[i]->IsInside(position))
+        {
+            buildings.push_back(m_buildings[i]);
+        }
+    }
+    return buildings;
+}
+
+template <typename F>
+void
+BuildingListPriv::VisitIntersectingBuildings(const Vector& l1, const Vector& l2, F visit)
+{
+    if (!m_indexValid)
+    {
+        BuildIndex();
+    }
+    if (m_buildings.empty())
+    {
+        return;
+    }
+    if (++m_queryId == 0)
+    {
+        std::fill(m_lastQuery.begin(), m_lastQuery.end(), 0);
+        m_queryId = 1;
+    }
+
+    // visit the cells overlapped by the projection of the segment on the XY
+    // plane, column by column, with a margin for the rounding errors, and test
+    // each building once
+    double margin = 1e-9 * m_cellSize;
+    double xLo = std::min(l1.x, l2.x) - margin;
+    double xHi = std::max(l1.x, l2.x) + margin;
+    double yLoSegment = std::min(l1.y, l2.y) - margin;
+    double yHiSegment = std::max(l1.y, l2.y) + margin;
+    double slope = (l1.x != l2.x) ? (l2.y - l1.y) / (l2.x - l1.x) : 0;
+    for (uint32_t cx = GetCellX(xLo); cx <= GetCellX(xHi); ++cx)
+    {
+        double yLo = yLoSegment;
+        double yHi = yHiSegment;
+        if (l1.x != l2.x)
+        {
+            double yA = l1.y + (std::max(xLo, m_gridXMin + cx * m_cellSize) - l1.x) * slope;
+            double yB = l1.y + (std::min(xHi, m_gridXMin + (cx + 1) * m_cellSize) - l1.x) * slope;
+            yLo = std::max(yLo, std::min(yA, yB) - margin);
+            yHi = std::min(yHi, std::max(yA, yB) + margin);
+        }
+        for (uint32_t cy = GetCellY(yLo); cy <= GetCellY(yHi); ++cy)
+        {
+            for (uint32_t i : m_cells[cy * m_nCellsX + cx])
+            {
+                if (m_lastQuery[i] == m_queryId)
+                {
+                    continue;
+                }
+                m_lastQuery[i] = m_queryId;
+                if (m_buildings[i]->IsIntersect(l1, l2) && visit(i))
+                {
+                    return;
+                }
+            }
+        }
+    }
+}
+
+bool
+BuildingListPriv::IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2)
+{
+    bool found = false;
+    VisitIntersectingBuildings(l1, l2, [&found](uint32_t) { return (found = true); });
+    return found;
+}
+
+std::vector<Ptr<Building>>
+BuildingListPriv::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    std::vector<uint32_t> indices;
+    VisitIntersectingBuildings(l1, l2, [&indices](uint32_t i) {
+        indices.push_back(i);
+        return false;
+    });
+    std::sort(indices.begin(), indices.end());
+    std::vector<Ptr<Building>> buildings;
+    buildings.reserve(indices.size());
+    for (uint32_t i : indices)
+    {
+        buildings.push_back(m_buildings[i]);
+    }
+    return buildings;
+}
+
 } // namespace ns3
 
 /**
@@ -244,4 +507,28 @@ BuildingList::GetNBuildings()
     return BuildingListPriv::Get()->GetNBuildings();
 }
 
+std::vector<Ptr<Building>>
+BuildingList::GetBuildingsAt(const Vector& position)
+{
+    return BuildingListPriv::Get()->GetBuildingsAt(position);
+}
+
+bool
+BuildingList::IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->IsAnyBuildingIntersecting(l1, l2);
+}
+
+std::vector<Ptr<Building>>
+BuildingList::GetIntersectingBuildings(const Vector& l1, const Vector& l2)
+{
+    return BuildingListPriv::Get()->GetIntersectingBuildings(l1, l2);
+}
+
+void
+BuildingList::NotifyBoundariesChanged()
+{
+    BuildingListPriv::Get()->InvalidateIndex();
+}
+
 } // namespace ns3
@@ -23,6 +23,7 @@
 #define BUILDING_LIST_H_
 
 #include "ns3/ptr.h"
+#include "ns3/vector.h"
 
 #include <vector>
 
@@ -33,6 +34,12 @@ class Building;
 
 /**
  * Container for Building class
+ *
+ * The list also maintains a uniform grid over the footprints of the
+ * buildings, which is used to find the buildings containing a position or
+ * intersecting a line segment without testing every building. The grid is
+ * built on the first query after a building is added or its boundaries are
+ * changed.
  */
 class BuildingList
 {
@@ -67,6 +74,30 @@ class BuildingList
      * \returns the number of buildings currently in the list.
      */
     static uint32_t GetNBuildings();
+    /**
+     * \param position a position
+     * \returns the buildings containing the position, in the order of the list
+     */
+    static std::vector<Ptr<Building>> GetBuildingsAt(const Vector& position);
+    /**
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \returns true if the line segment intersects at least one building
+     */
+    static bool IsAnyBuildingIntersecting(const Vector& l1, const Vector& l2);
+    /**
+     * \param l1 one end of the line segment
+     * \param l2 the other end of the line segment
+     * \returns the buildings intersecting the line segment, in the order of the list
+     */
+    static std::vector<Ptr<Building>> GetIntersectingBuildings(const Vector& l1, const Vector& l2);
+    /**
+     * Rebuild the spatial index before the next query.
+     *
+     * This method is called automatically from Building::SetBoundaries so
+     * the user has little reason to call it himself.
+     */
+    static void NotifyBoundariesChanged();
 };
 
 } // namespace ns3
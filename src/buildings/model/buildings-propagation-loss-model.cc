@@ -39,30 +39,6 @@ NS_LOG_COMPONENT_DEFINE("BuildingsPropagationLossModel");
 
 NS_OBJECT_ENSURE_REGISTERED(BuildingsPropagationLossModel);
 
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss()
-{
-}
-
-BuildingsPropagationLossModel::ShadowingLoss::ShadowingLoss(double shadowingValue,
-                                                            Ptr<MobilityModel> receiver)
-    : m_shadowingValue(shadowingValue),
-      m_receiver(receiver)
-{
-    NS_LOG_INFO(this << " New Shadowing value " << m_shadowingValue);
-}
-
-double
-BuildingsPropagationLossModel::ShadowingLoss::GetLoss() const
-{
-    return (m_shadowingValue);
-}
-
-Ptr<MobilityModel>
-BuildingsPropagationLossModel::ShadowingLoss::GetReceiver() const
-{
-    return m_receiver;
-}
-
 TypeId
 BuildingsPropagationLossModel::GetTypeId()
 {
@@ -99,7 +75,25 @@ BuildingsPropagationLossModel::GetTypeId()
                           "Additional loss for each internal wall [dB]",
                           DoubleValue(5.0),
                           MakeDoubleAccessor(&BuildingsPropagationLossModel::m_lossInternalWall),
-                          MakeDoubleChecker<double>());
+                          MakeDoubleChecker<double>())
+            .AddAttribute("ShadowingCorrelationDistance",
+                          "Correlation distance of the spatially correlated shadowing maps [m]. "
+                          "If 0, the shadowing of each pair of nodes is drawn independently.",
+                          DoubleValue(0.0),
+                          MakeDoubleAccessor(
+                              &BuildingsPropagationLossModel::m_shadowingCorrelationDistance),
+                          MakeDoubleChecker<double>(0.0))
+            .AddAttribute(
+                "ShadowingMapResolution",
+                "Distance between the points of the spatially correlated shadowing maps [m]",
+                DoubleValue(10.0),
+                MakeDoubleAccessor(&BuildingsPropagationLossModel::m_shadowingMapResolution),
+                MakeDoubleChecker<double>(0.001))
+            .AddAttribute("ShadowingMapRadius",
+                          "Distance from a site to the sides of its shadowing map [m]",
+                          DoubleValue(1000.0),
+                          MakeDoubleAccessor(&BuildingsPropagationLossModel::m_shadowingMapRadius),
+                          MakeDoubleChecker<double>(0.0));
 
     return tid;
 }
@@ -109,6 +103,33 @@ BuildingsPropagationLossModel::BuildingsPropagationLossModel()
     m_randVariable = CreateObject<NormalRandomVariable>();
 }
 
+void
+BuildingsPropagationLossModel::DoDispose()
+{
+    m_shadowingStore.Clear();
+    m_correlatedShadowing.Clear();
+    PropagationLossModel::DoDispose();
+}
+
+bool
+BuildingsPropagationLossModel::IsShadowingCorrelated() const
+{
+    return m_shadowingCorrelationDistance > 0;
+}
+
+double
+BuildingsPropagationLossModel::GetCorrelatedShadowing(Ptr<MobilityModel> a,
+                                                      Ptr<MobilityModel> b) const
+{
+    if (m_correlatedShadowing.GetNSites() == 0)
+    {
+        m_correlatedShadowing.SetParameters(m_shadowingCorrelationDistance,
+                                            m_shadowingMapResolution,
+                                            m_shadowingMapRadius);
+    }
+    return m_correlatedShadowing.GetValue(a, b, m_randVariable);
+}
+
 double
 BuildingsPropagationLossModel::ExternalWallLoss(Ptr<MobilityBuildingInfo> a) const
 {
@@ -160,33 +181,19 @@ BuildingsPropagationLossModel::GetShadowing(Ptr<MobilityModel> a, Ptr<MobilityMo
     Ptr<MobilityBuildingInfo> b1 = b->GetObject<MobilityBuildingInfo>();
     NS_ASSERT_MSG(a1 && b1, "BuildingsPropagationLossModel only works with MobilityBuildingInfo");
 
-    auto ait = m_shadowingLossMap.find(a);
-    if (ait != m_shadowingLossMap.end())
+    if (IsShadowingCorrelated())
     {
-        auto bit = ait->second.find(b);
-        if (bit != ait->second.end())
-        {
-            return (bit->second.GetLoss());
-        }
-        else
-        {
-            double sigma = EvaluateSigma(a1, b1);
-            // side effect: will create new entry
-            // sigma is standard deviation, not variance
-            double shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
-            ait->second[b] = ShadowingLoss(shadowingValue, b);
-            return (ait->second[b].GetLoss());
-        }
+        return EvaluateSigma(a1, b1) * GetCorrelatedShadowing(a, b);
     }
-    else
+    double shadowingValue;
+    if (!m_shadowingStore.Lookup(a, b, shadowingValue))
     {
         double sigma = EvaluateSigma(a1, b1);
-        // side effect: will create new entries in both maps
         // sigma is standard deviation, not variance
-        double shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
-        m_shadowingLossMap[a][b] = ShadowingLoss(shadowingValue, b);
-        return (m_shadowingLossMap[a][b].GetLoss());
+        shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
+        m_shadowingStore.Insert(a, b, shadowingValue);
     }
+    return shadowingValue;
 }
 
 double
@@ -24,6 +24,7 @@
 
 #include "building.h"
 #include "mobility-building-info.h"
+#include "shadowing-store.h"
 
 #include "ns3/nstime.h"
 #include "ns3/propagation-loss-model.h"
@@ -48,6 +49,12 @@ class JakesFadingLossModel;
  *  The distance-dependent component of propagation loss is deferred
  *  to derived classes which are expected to implement the GetLoss method.
  *
+ *  The shadowing of a pair of nodes is drawn the first time the pair is
+ *  used and is the same in both directions. If ShadowingCorrelationDistance
+ *  is positive, the shadowing is instead taken from spatially correlated
+ *  maps generated around each site (see CorrelatedShadowingMap), so that it
+ *  changes as the nodes move.
+ *
  *  \warning This model works only when MobilityBuildingInfo is aggreegated
  *  to the mobility model
  *
@@ -106,37 +113,27 @@ class BuildingsPropagationLossModel : public PropagationLossModel
     double m_lossInternalWall; //!< loss from internal walls (in dBm)
 
     /**
-     * \ingroup propagation
-     *
-     * This model allows the computation of shadowing loss
+     * \return true if the shadowing is taken from the spatially correlated maps
+     */
+    bool IsShadowingCorrelated() const;
+    /**
+     * Get the spatially correlated shadowing of a pair of nodes
+     * \param a the mobility model of the source
+     * \param b the mobility model of the destination
+     * \return the shadowing value, with zero mean and unit variance
      */
-    class ShadowingLoss
-    {
-      public:
-        ShadowingLoss();
-        /**
-         * Constructor
-         * \param shadowingValue Value for shadowing
-         * \param receiver Receiver position
-         */
-        ShadowingLoss(double shadowingValue, Ptr<MobilityModel> receiver);
-        /**
-         * \returns the loss (in dBm)
-         */
-        double GetLoss() const;
-        /**
-         * \returns the receiver mobility model
-         */
-        Ptr<MobilityModel> GetReceiver() const;
-
-      protected:
-        double m_shadowingValue;       //!< Shadowing value
-        Ptr<MobilityModel> m_receiver; //!< The receiver mobility model
-    };
-
-    /// Map of the shadowng loss
-    mutable std::map<Ptr<MobilityModel>, std::map<Ptr<MobilityModel>, ShadowingLoss>>
-        m_shadowingLossMap;
+    double GetCorrelatedShadowing(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
+
+    /// Shadowing values of the pairs of nodes
+    mutable ShadowingPairStore m_shadowingStore;
+    /// Spatially correlated shadowing maps of the sites
+    mutable CorrelatedShadowingMap m_correlatedShadowing;
+    /// Correlation distance of the shadowing maps, or 0 for independent values per pair [m]
+    double m_shadowingCorrelationDistance;
+    /// Distance between the points of the shadowing maps [m]
+    double m_shadowingMapResolution;
+    /// Distance from a site to the sides of its shadowing map [m]
+    double m_shadowingMapRadius;
     /**
      * Calculate the Standard deviation of the normal distribution used to calculate the shadowing
      * \param a Room A data
@@ -157,6 +154,7 @@ class BuildingsPropagationLossModel : public PropagationLossModel
     Ptr<NormalRandomVariable> m_randVariable; //!< Random variable
 
     int64_t DoAssignStreams(int64_t stream) override;
+    void DoDispose() override;
 };
 
 } // namespace ns3
@@ -229,8 +229,6 @@ class Hybrid3gppPropagationLossModel : public BuildingsPropagationLossModel
     double m_frequency; ///< The propagation frequency in Hz
     TracedCallback<double, Ptr<Node>, Ptr<Node>, double, bool, bool>
         m_hybrid3gppPathlossTrace; ///< Trace
-    mutable std::map<Ptr<MobilityModel>, std::map<Ptr<MobilityModel>, double>>
-        m_shadowingLossMap;                          ///< Map to keep track of shadowing values
     bool m_cacheLoss;                                ///< Cache the loss or not
     mutable std::map<MobilityDuo, double> m_lossMap; ///< cache for loss values
     mutable bool
@@ -138,8 +138,6 @@ class ScmUrbanMacroCellPropagationLossModel : public BuildingsPropagationLossMod
     Ptr<UniformRandomVariable> m_rand; ///< Random number to generate
     mutable std::map<MobilityDuo, double>
         m_randomMap; ///< Map to keep track of random numbers generated per pair of nodes
-    mutable std::map<Ptr<MobilityModel>, std::map<Ptr<MobilityModel>, double>>
-        m_shadowingLossMap; ///< Map to keep track of shadowing values
 };
 
 } // namespace ns3
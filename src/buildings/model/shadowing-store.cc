@@ -0,0 +1,306 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "shadowing-store.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("ShadowingStore");
+
+/// Initial base 2 logarithm of the size of the hash table
+static const uint32_t INITIAL_TABLE_BITS = 6;
+
+ShadowingPairStore::ShadowingPairStore()
+    : m_table(static_cast<std::size_t>(1) << INITIAL_TABLE_BITS, Entry{EMPTY, 0}),
+      m_size(0),
+      m_shift(64 - INITIAL_TABLE_BITS)
+{
+}
+
+bool
+ShadowingPairStore::GetIndex(const Ptr<MobilityModel>& mm, uint32_t& index) const
+{
+    auto it = m_indices.find(PeekPointer(mm));
+    if (it == m_indices.end())
+    {
+        return false;
+    }
+    index = it->second;
+    return true;
+}
+
+bool
+ShadowingPairStore::GetIndex(const Ptr<MobilityModel>& mm, bool create, uint32_t& index)
+{
+    if (GetIndex(mm, index))
+    {
+        return true;
+    }
+    if (!create)
+    {
+        return false;
+    }
+    index = m_models.size();
+    m_indices[PeekPointer(mm)] = index;
+    m_models.push_back(mm);
+    return true;
+}
+
+std::size_t
+ShadowingPairStore::FindSlot(uint64_t key) const
+{
+    // Fibonacci hashing, then linear probing
+    std::size_t mask = m_table.size() - 1;
+    std::size_t slot = (key * 0x9E3779B97F4A7C15ULL) >> m_shift;
+    while (m_table[slot].key != key && m_table[slot].key != EMPTY)
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+bool
+ShadowingPairStore::Lookup(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double& value) const
+{
+    uint32_t ia;
+    uint32_t ib;
+    if (!GetIndex(a, ia) || !GetIndex(b, ib))
+    {
+        return false;
+    }
+    uint64_t key = (static_cast<uint64_t>(std::min(ia, ib)) << 32) | std::max(ia, ib);
+    const Entry& entry = m_table[FindSlot(key)];
+    if (entry.key == EMPTY)
+    {
+        return false;
+    }
+    value = entry.value;
+    return true;
+}
+
+void
+ShadowingPairStore::Insert(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double value)
+{
+    uint32_t ia;
+    uint32_t ib;
+    GetIndex(a, true, ia);
+    GetIndex(b, true, ib);
+    uint64_t key = (static_cast<uint64_t>(std::min(ia, ib)) << 32) | std::max(ia, ib);
+    Entry& entry = m_table[FindSlot(key)];
+    if (entry.key == EMPTY)
+    {
+        entry.key = key;
+        ++m_size;
+    }
+    entry.value = value;
+    if (2 * m_size > m_table.size())
+    {
+        Grow();
+    }
+}
+
+void
+ShadowingPairStore::Grow()
+{
+    std::vector<Entry> old(2 * m_table.size(), Entry{EMPTY, 0});
+    old.swap(m_table);
+    --m_shift;
+    for (const auto& entry : old)
+    {
+        if (entry.key != EMPTY)
+        {
+            m_table[FindSlot(entry.key)] = entry;
+        }
+    }
+    NS_LOG_LOGIC("shadowing table grown to " << m_table.size() << " entries");
+}
+
+std::size_t
+ShadowingPairStore::GetSize() const
+{
+    return m_size;
+}
+
+void
+ShadowingPairStore::Clear()
+{
+    m_indices.clear();
+    m_models.clear();
+    m_table.assign(static_cast<std::size_t>(1) << INITIAL_TABLE_BITS, Entry{EMPTY, 0});
+    m_table.shrink_to_fit();
+    m_size = 0;
+    m_shift = 64 - INITIAL_TABLE_BITS;
+}
+
+CorrelatedShadowingMap::CorrelatedShadowingMap()
+    : m_correlationDistance(50),
+      m_resolution(10),
+      m_radius(1000)
+{
+}
+
+void
+CorrelatedShadowingMap::SetParameters(double correlationDistance, double resolution, double radius)
+{
+    NS_ASSERT_MSG(correlationDistance > 0 && resolution > 0 && radius >= 0,
+                  "Invalid correlated shadowing parameters");
+    m_correlationDistance = correlationDistance;
+    m_resolution = resolution;
+    m_radius = radius;
+}
+
+CorrelatedShadowingMap::SiteGrid
+CorrelatedShadowingMap::CreateGrid(Ptr<MobilityModel> site, Ptr<NormalRandomVariable> rand) const
+{
+    Vector position = site->GetPosition();
+    SiteGrid grid;
+    grid.nPoints = static_cast<uint32_t>(std::ceil(2 * m_radius / m_resolution)) + 1;
+    grid.xMin = position.x - m_radius;
+    grid.yMin = position.y - m_radius;
+    grid.values.resize(static_cast<std::size_t>(grid.nPoints) * grid.nPoints);
+    NS_LOG_LOGIC("shadowing grid of " << grid.nPoints << "x" << grid.nPoints << " points around "
+                                      << position);
+
+    // x(i, j) = c x(i-1, j) + c x(i, j-1) - c^2 x(i-1, j-1) + (1 - c^2) n(i, j)
+    // has unit variance and a correlation c^(|di| + |dj|), if the first row
+    // and column are first order autoregressive processes with unit variance
+    double c = std::exp(-m_resolution / m_correlationDistance);
+    grid.correlation = c;
+    double edgeGain = std::sqrt(1 - c * c);
+    double innerGain = 1 - c * c;
+    uint32_t n = grid.nPoints;
+    std::vector<float>& v = grid.values;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        for (uint32_t j = 0; j < n; ++j)
+        {
+            double noise = rand->GetValue(0.0, 1.0);
+            double value;
+            if (i == 0 && j == 0)
+            {
+                value = noise;
+            }
+            else if (i == 0)
+            {
+                value = c * v[j - 1] + edgeGain * noise;
+            }
+            else if (j == 0)
+            {
+                value = c * v[(i - 1) * n] + edgeGain * noise;
+            }
+            else
+            {
+                value = c * v[(i - 1) * n + j] + c * v[i * n + j - 1] -
+                        c * c * v[(i - 1) * n + j - 1] + innerGain * noise;
+            }
+            v[i * n + j] = static_cast<float>(value);
+        }
+    }
+    return grid;
+}
+
+double
+CorrelatedShadowingMap::Interpolate(const SiteGrid& grid, const Vector& position) const
+{
+    double last = grid.nPoints - 1;
+    double fx = std::clamp((position.x - grid.xMin) / m_resolution, 0.0, last);
+    double fy = std::clamp((position.y - grid.yMin) / m_resolution, 0.0, last);
+    auto j0 = static_cast<uint32_t>(std::min(std::floor(fx), std::max(last - 1, 0.0)));
+    auto i0 = static_cast<uint32_t>(std::min(std::floor(fy), std::max(last - 1, 0.0)));
+    uint32_t j1 = std::min(j0 + 1, grid.nPoints - 1);
+    uint32_t i1 = std::min(i0 + 1, grid.nPoints - 1);
+    double wx = fx - j0;
+    double wy = fy - i0;
+    const std::vector<float>& v = grid.values;
+    uint32_t n = grid.nPoints;
+    double w00 = (1 - wx) * (1 - wy);
+    double w01 = wx * (1 - wy);
+    double w10 = (1 - wx) * wy;
+    double w11 = wx * wy;
+    double value = w00 * v[i0 * n + j0] + w01 * v[i0 * n + j1] + w10 * v[i1 * n + j0] +
+                   w11 * v[i1 * n + j1];
+    // the interpolation of correlated values has a variance lower than one
+    double c = grid.correlation;
+    double variance = w00 * w00 + w01 * w01 + w10 * w10 + w11 * w11 +
+                      2 * c * (w00 * w01 + w10 * w11 + w00 * w10 + w01 * w11) +
+                      2 * c * c * (w00 * w11 + w01 * w10);
+    return value / std::sqrt(variance);
+}
+
+double
+CorrelatedShadowingMap::GetValue(Ptr<MobilityModel> a,
+                                 Ptr<MobilityModel> b,
+                                 Ptr<NormalRandomVariable> rand)
+{
+    double za = a->GetPosition().z;
+    double zb = b->GetPosition().z;
+    Ptr<MobilityModel> site = a;
+    Ptr<MobilityModel> other = b;
+    bool swap = (zb > za);
+    if (zb == za)
+    {
+        swap = (m_grids.find(a) == m_grids.end() && m_grids.find(b) != m_grids.end());
+    }
+    if (swap)
+    {
+        std::swap(site, other);
+    }
+    auto it = m_grids.find(site);
+    if (it == m_grids.end())
+    {
+        it = m_grids.emplace(site, CreateGrid(site, rand)).first;
+    }
+    return Interpolate(it->second, other->GetPosition());
+}
+
+std::size_t
+CorrelatedShadowingMap::GetNSites() const
+{
+    return m_grids.size();
+}
+
+void
+CorrelatedShadowingMap::Clear()
+{
+    m_grids.clear();
+}
+
+} // namespace ns3
@@ -0,0 +1,227 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef SHADOWING_STORE_H
+#define SHADOWING_STORE_H
+
+#include "ns3/mobility-model.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup buildings
+ *
+ * \brief Symmetric store of the shadowing values of pairs of mobility models
+ *
+ * The value of a pair is stored once, whatever the order of the mobility
+ * models, in an open addressing hash table whose key is made of the
+ * indices given to the mobility models when they are first seen. Each entry
+ * takes 16 bytes, and the table is kept at most half full, instead of the
+ * two tree nodes per pair of a map of maps.
+ */
+class ShadowingPairStore
+{
+  public:
+    ShadowingPairStore();
+
+    /**
+     * \brief Look up the value of a pair
+     * \param a the first mobility model
+     * \param b the second mobility model
+     * \param [out] value the value of the pair, if found
+     * \return true if the pair has a value
+     */
+    bool Lookup(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double& value) const;
+
+    /**
+     * \brief Set the value of a pair
+     * \param a the first mobility model
+     * \param b the second mobility model
+     * \param value the value of the pair
+     */
+    void Insert(Ptr<MobilityModel> a, Ptr<MobilityModel> b, double value);
+
+    /**
+     * \return the number of pairs with a value
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * \brief Remove all the values and mobility models
+     */
+    void Clear();
+
+  private:
+    /// An entry of the hash table
+    struct Entry
+    {
+        uint64_t key; //!< the indices of the pair, the smallest one first, or EMPTY
+        double value; //!< the value of the pair
+    };
+
+    /// Key of the unused entries
+    static const uint64_t EMPTY = ~static_cast<uint64_t>(0);
+
+    /**
+     * \brief Get the index of a mobility model, optionally assigning a new one
+     * \param mm the mobility model
+     * \param create if true, assign an index to a new mobility model
+     * \param [out] index the index
+     * \return true if the mobility model has an index
+     */
+    bool GetIndex(const Ptr<MobilityModel>& mm, bool create, uint32_t& index);
+
+    /**
+     * \brief Get the index of a mobility model
+     * \param mm the mobility model
+     * \param [out] index the index
+     * \return true if the mobility model has an index
+     */
+    bool GetIndex(const Ptr<MobilityModel>& mm, uint32_t& index) const;
+
+    /**
+     * \param key a key
+     * \return the position of the entry of the key, or of the empty entry
+     * where it should be inserted
+     */
+    std::size_t FindSlot(uint64_t key) const;
+
+    /**
+     * \brief Double the size of the table
+     */
+    void Grow();
+
+    /// mobility model --> index
+    std::unordered_map<const MobilityModel*, uint32_t> m_indices;
+    /// index --> mobility model, to keep the mobility models alive as long as their index
+    std::vector<Ptr<MobilityModel>> m_models;
+    std::vector<Entry> m_table; //!< the hash table, whose size is a power of two
+    std::size_t m_size;         //!< the number of used entries
+    uint32_t m_shift;           //!< 64 minus the base 2 logarithm of the size of the table
+};
+
+/**
+ * \ingroup buildings
+ *
+ * \brief Spatially correlated shadowing
+ *
+ * A grid of Gaussian values with zero mean, unit variance and a correlation
+ * exp(-(|dx| + |dy|) / CorrelationDistance) is generated for each site,
+ * around the position of the site when it is first used, with a two
+ * dimensional first order autoregressive filter. The value of a pair of
+ * mobility models is the value of the grid of the highest one (at equal
+ * heights, the one which already has a grid, or else the first one) at the
+ * position of the other one, interpolated between the points of the grid
+ * and normalized to unit variance, so that it is the same for both orders
+ * and it changes smoothly as the nodes move. Positions outside of the grid use the value of its closest
+ * point. The memory used only depends on the number of sites and on the
+ * size and resolution of the grids.
+ */
+class CorrelatedShadowingMap
+{
+  public:
+    CorrelatedShadowingMap();
+
+    /**
+     * \brief Set the parameters of the grids created from now on
+     * \param correlationDistance the correlation distance [m]
+     * \param resolution the distance between the points of a grid [m]
+     * \param radius the distance from the site to the sides of a grid [m]
+     */
+    void SetParameters(double correlationDistance, double resolution, double radius);
+
+    /**
+     * \brief Get the value of a pair of mobility models
+     * \param a the first mobility model
+     * \param b the second mobility model
+     * \param rand the random variable used to generate the grids
+     * \return the value, with zero mean and unit variance
+     */
+    double GetValue(Ptr<MobilityModel> a, Ptr<MobilityModel> b, Ptr<NormalRandomVariable> rand);
+
+    /**
+     * \return the number of sites with a grid
+     */
+    std::size_t GetNSites() const;
+
+    /**
+     * \brief Remove all the grids
+     */
+    void Clear();
+
+  private:
+    /// Grid of a site
+    struct SiteGrid
+    {
+        double xMin;               //!< X coordinate of the first column
+        double yMin;               //!< Y coordinate of the first row
+        uint32_t nPoints;          //!< number of points of each row and column
+        double correlation;        //!< correlation of two neighbour points
+        std::vector<float> values; //!< the values, row by row
+    };
+
+    /**
+     * \brief Create the grid of a site
+     * \param site the mobility model of the site
+     * \param rand the random variable
+     * \return the grid
+     */
+    SiteGrid CreateGrid(Ptr<MobilityModel> site, Ptr<NormalRandomVariable> rand) const;
+
+    /**
+     * \brief Interpolate the value of a grid
+     * \param grid the grid
+     * \param position the position
+     * \return the value
+     */
+    double Interpolate(const SiteGrid& grid, const Vector& position) const;
+
+    std::map<Ptr<MobilityModel>, SiteGrid> m_grids; //!< the grid of each site
+    double m_correlationDistance;                   //!< the correlation distance [m]
+    double m_resolution;                            //!< the distance between points [m]
+    double m_radius;                                //!< the half side of the grids [m]
+};
+
+} // namespace ns3
+
+#endif /* SHADOWING_STORE_H */
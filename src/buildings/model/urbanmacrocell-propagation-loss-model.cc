@@ -226,35 +226,19 @@ UrbanMacroCellPropagationLossModel::GetShadowing(Ptr<MobilityModel> a, Ptr<Mobil
         NS_ABORT_MSG_IF((!a1 || !b1),
                         "UrbanMacroCellPropagationLossModel only works with MobilityBuildingInfo");
 
-        auto ait = m_shadowingLossMap.find(a);
-        if (ait != m_shadowingLossMap.end())
+        if (IsShadowingCorrelated())
         {
-            auto bit = ait->second.find(b);
-            if (bit != ait->second.end())
-            {
-                return (bit->second);
-            }
-            else
-            {
-                double sigma = EvaluateSigma(a1, b1);
-                // side effect: will create new entry
-                // sigma is standard deviation, not variance
-                double shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
-                ait->second[b] = shadowingValue;
-                m_shadowingLossMap[b][a] = shadowingValue;
-                return (shadowingValue);
-            }
+            return EvaluateSigma(a1, b1) * GetCorrelatedShadowing(a, b);
         }
-        else
+        double shadowingValue;
+        if (!m_shadowingStore.Lookup(a, b, shadowingValue))
         {
             double sigma = EvaluateSigma(a1, b1);
-            // side effect: will create new entries in both maps
             // sigma is standard deviation, not variance
-            double shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
-            m_shadowingLossMap[a][b] = shadowingValue;
-            m_shadowingLossMap[b][a] = shadowingValue;
-            return (shadowingValue);
+            shadowingValue = m_randVariable->GetValue(0.0, (sigma * sigma));
+            m_shadowingStore.Insert(a, b, shadowingValue);
         }
+        return shadowingValue;
     }
 
     return 0.0;
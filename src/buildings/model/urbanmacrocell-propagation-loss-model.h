@@ -153,8 +153,6 @@ class UrbanMacroCellPropagationLossModel : public BuildingsPropagationLossModel
     Ptr<UniformRandomVariable> m_rand; ///< Random number to generate
     mutable std::map<MobilityDuo, double>
         m_randomMap; ///< Map to keep track of random numbers generated per pair of nodes
-    mutable std::map<Ptr<MobilityModel>, std::map<Ptr<MobilityModel>, double>>
-        m_shadowingLossMap; ///< Map to keep track of shadowing values
     TracedCallback<Ptr<const MobilityModel>,
                    Ptr<const MobilityModel>,
                    double,
@@ -0,0 +1,171 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include <ns3/building-list.h>
+#include <ns3/building.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/simulator.h>
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BuildingListTest");
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief Compare the queries of the BuildingList spatial index with a test of
+ * every building, for random buildings, positions and line segments
+ */
+class BuildingListIndexTestCase : public TestCase
+{
+  public:
+    BuildingListIndexTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the queries for a position and a line segment
+     * \param l1 the position, and one end of the line segment
+     * \param l2 the other end of the line segment
+     */
+    void CheckQueries(const Vector& l1, const Vector& l2);
+};
+
+BuildingListIndexTestCase::BuildingListIndexTestCase()
+    : TestCase("Compare the BuildingList spatial index with a linear search")
+{
+}
+
+void
+BuildingListIndexTestCase::CheckQueries(const Vector& l1, const Vector& l2)
+{
+    std::vector<Ptr<Building>> inside;
+    std::vector<Ptr<Building>> intersecting;
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        if ((*bit)->IsInside(l1))
+        {
+            inside.push_back(*bit);
+        }
+        if ((*bit)->IsIntersect(l1, l2))
+        {
+            intersecting.push_back(*bit);
+        }
+    }
+    bool sameInside = (BuildingList::GetBuildingsAt(l1) == inside);
+    NS_TEST_ASSERT_MSG_EQ(sameInside, true, "Wrong buildings at " << l1);
+    bool sameIntersecting = (BuildingList::GetIntersectingBuildings(l1, l2) == intersecting);
+    NS_TEST_ASSERT_MSG_EQ(sameIntersecting,
+                          true,
+                          "Wrong buildings intersecting " << l1 << " - " << l2);
+    NS_TEST_ASSERT_MSG_EQ(BuildingList::IsAnyBuildingIntersecting(l1, l2),
+                          !intersecting.empty(),
+                          "Wrong intersection of " << l1 << " - " << l2);
+}
+
+void
+BuildingListIndexTestCase::DoRun()
+{
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+    for (uint32_t i = 0; i < 500; ++i)
+    {
+        Ptr<Building> building = CreateObject<Building>();
+        double x = rand->GetValue(0, 1000);
+        double y = rand->GetValue(0, 1000);
+        building->SetBoundaries(Box(x,
+                                    x + rand->GetValue(5, 50),
+                                    y,
+                                    y + rand->GetValue(5, 50),
+                                    0,
+                                    rand->GetValue(3, 60)));
+    }
+    Ptr<Building> longBuilding = CreateObject<Building>();
+    longBuilding->SetBoundaries(Box(400, 600, 400, 420, 0, 10));
+
+    for (uint32_t i = 0; i < 3000; ++i)
+    {
+        Vector l1(rand->GetValue(-100, 1100), rand->GetValue(-100, 1100), rand->GetValue(0, 60));
+        Vector l2(rand->GetValue(-100, 1100), rand->GetValue(-100, 1100), rand->GetValue(0, 60));
+        CheckQueries(l1, l2);
+        // axis-aligned segments
+        CheckQueries(l1, Vector(l1.x, l2.y, l2.z));
+        CheckQueries(l1, Vector(l2.x, l1.y, l2.z));
+        if (i == 1500)
+        {
+            // the index must follow the changes of the boundaries
+            longBuilding->SetBoundaries(Box(-50, 1500, 10, 12, 0, 10));
+        }
+    }
+
+    // the boundaries of a building are inside it
+    for (auto bit = BuildingList::Begin(); bit != BuildingList::End(); ++bit)
+    {
+        Box box = (*bit)->GetBoundaries();
+        CheckQueries(Vector(box.xMin, box.yMin, box.zMin), Vector(box.xMax, box.yMax, box.zMax));
+        CheckQueries(Vector(box.xMax, box.yMax, box.zMax), Vector(box.xMin, box.yMin, box.zMin));
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief BuildingList TestSuite
+ */
+class BuildingListTestSuite : public TestSuite
+{
+  public:
+    BuildingListTestSuite();
+};
+
+BuildingListTestSuite::BuildingListTestSuite()
+    : TestSuite("building-list", UNIT)
+{
+    NS_LOG_FUNCTION(this);
+
+    AddTestCase(new BuildingListIndexTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static BuildingListTestSuite buildingListTestSuiteInstance;
@@ -0,0 +1,265 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/double.h>
+#include <ns3/hybrid-buildings-propagation-loss-model.h>
+#include <ns3/mobility-building-info.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/shadowing-store.h>
+#include <ns3/simulator.h>
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("ShadowingStoreTest");
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief Compare the ShadowingPairStore with a std::map under random operations
+ */
+class ShadowingPairStoreTestCase : public TestCase
+{
+  public:
+    ShadowingPairStoreTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+ShadowingPairStoreTestCase::ShadowingPairStoreTestCase()
+    : TestCase("Compare the ShadowingPairStore with a std::map")
+{
+}
+
+void
+ShadowingPairStoreTestCase::DoRun()
+{
+    std::vector<Ptr<MobilityModel>> models;
+    for (uint32_t i = 0; i < 200; ++i)
+    {
+        models.push_back(CreateObject<ConstantPositionMobilityModel>());
+    }
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(1);
+
+    ShadowingPairStore store;
+    std::map<std::pair<uint32_t, uint32_t>, double> reference;
+    for (uint32_t n = 0; n < 50000; ++n)
+    {
+        uint32_t i = rand->GetInteger(0, models.size() - 1);
+        uint32_t j = rand->GetInteger(0, models.size() - 1);
+        auto it = reference.find(std::make_pair(std::min(i, j), std::max(i, j)));
+        double value = -1;
+        bool found = store.Lookup(models[i], models[j], value);
+        NS_TEST_ASSERT_MSG_EQ(found, (it != reference.end()), "Wrong presence of a pair");
+        if (found)
+        {
+            NS_TEST_ASSERT_MSG_EQ(value, it->second, "Wrong value of a pair");
+        }
+        if (rand->GetValue() < 0.5)
+        {
+            store.Insert(models[j], models[i], n);
+            reference[std::make_pair(std::min(i, j), std::max(i, j))] = n;
+        }
+    }
+    NS_TEST_ASSERT_MSG_EQ(store.GetSize(), reference.size(), "Wrong number of pairs");
+
+    store.Clear();
+    double value;
+    NS_TEST_ASSERT_MSG_EQ(store.Lookup(models[0], models[1], value), false, "Store not cleared");
+    NS_TEST_ASSERT_MSG_EQ(store.GetSize(), 0, "Store not cleared");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief Check the statistics and the symmetry of the spatially correlated shadowing
+ */
+class CorrelatedShadowingTestCase : public TestCase
+{
+  public:
+    CorrelatedShadowingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+CorrelatedShadowingTestCase::CorrelatedShadowingTestCase()
+    : TestCase("Check the spatially correlated shadowing")
+{
+}
+
+void
+CorrelatedShadowingTestCase::DoRun()
+{
+    const double correlationDistance = 50;
+    CorrelatedShadowingMap map;
+    map.SetParameters(correlationDistance, 10, 500);
+    Ptr<NormalRandomVariable> normal = CreateObject<NormalRandomVariable>();
+    normal->SetStream(1);
+    Ptr<UniformRandomVariable> rand = CreateObject<UniformRandomVariable>();
+    rand->SetStream(2);
+
+    Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+    Ptr<MobilityModel> site;
+    const uint32_t nSites = 100;
+    const uint32_t samplesPerSite = 50;
+    double sum = 0;
+    double sumSquared = 0;
+    double sumProduct = 0;
+    for (uint32_t n = 0; n < nSites * samplesPerSite; ++n)
+    {
+        if (n % samplesPerSite == 0)
+        {
+            site = CreateObject<ConstantPositionMobilityModel>();
+            site->SetPosition(Vector(0, 0, 30));
+        }
+        Vector position(rand->GetValue(-400, 400), rand->GetValue(-400, 400), 1.5);
+        ue->SetPosition(position);
+        double value = map.GetValue(ue, site, normal);
+        NS_TEST_ASSERT_MSG_EQ(map.GetValue(site, ue, normal),
+                              value,
+                              "The shadowing is not symmetric");
+        ue->SetPosition(Vector(position.x + correlationDistance, position.y, position.z));
+        sumProduct += value * map.GetValue(site, ue, normal);
+        sum += value;
+        sumSquared += value * value;
+    }
+    NS_TEST_ASSERT_MSG_EQ(map.GetNSites(), nSites, "Wrong number of sites");
+
+    double samples = nSites * samplesPerSite;
+    double mean = sum / samples;
+    double variance = sumSquared / samples - mean * mean;
+    double correlation = sumProduct / samples;
+    NS_LOG_INFO("mean " << mean << " variance " << variance << " correlation " << correlation);
+    NS_TEST_ASSERT_MSG_EQ_TOL(mean, 0.0, 0.1, "Wrong mean of the shadowing");
+    NS_TEST_ASSERT_MSG_EQ_TOL(variance, 1.0, 0.1, "Wrong variance of the shadowing");
+    NS_TEST_ASSERT_MSG_EQ_TOL(correlation,
+                              std::exp(-1.0),
+                              0.1,
+                              "Wrong correlation at the correlation distance");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief Check the shadowing of a BuildingsPropagationLossModel in both
+ * directions and with the correlated maps
+ */
+class BuildingsShadowingSymmetryTestCase : public TestCase
+{
+  public:
+    BuildingsShadowingSymmetryTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BuildingsShadowingSymmetryTestCase::BuildingsShadowingSymmetryTestCase()
+    : TestCase("Check the symmetry and the correlation of the buildings shadowing")
+{
+}
+
+void
+BuildingsShadowingSymmetryTestCase::DoRun()
+{
+    Ptr<MobilityModel> enb = CreateObject<ConstantPositionMobilityModel>();
+    enb->SetPosition(Vector(0, 0, 30));
+    enb->AggregateObject(CreateObject<MobilityBuildingInfo>());
+    Ptr<MobilityModel> ue = CreateObject<ConstantPositionMobilityModel>();
+    ue->SetPosition(Vector(200, 0, 1.5));
+    ue->AggregateObject(CreateObject<MobilityBuildingInfo>());
+
+    Ptr<HybridBuildingsPropagationLossModel> model =
+        CreateObject<HybridBuildingsPropagationLossModel>();
+    double shadowing = model->GetShadowing(enb, ue);
+    NS_TEST_ASSERT_MSG_EQ(model->GetShadowing(ue, enb), shadowing, "Asymmetric shadowing");
+    ue->SetPosition(Vector(201, 0, 1.5));
+    NS_TEST_ASSERT_MSG_EQ(model->GetShadowing(enb, ue),
+                          shadowing,
+                          "Shadowing of an uncorrelated pair changed with the position");
+
+    Ptr<HybridBuildingsPropagationLossModel> correlated =
+        CreateObject<HybridBuildingsPropagationLossModel>();
+    correlated->SetAttribute("ShadowingCorrelationDistance", DoubleValue(50));
+    double before = correlated->GetShadowing(enb, ue);
+    NS_TEST_ASSERT_MSG_EQ(correlated->GetShadowing(ue, enb), before, "Asymmetric shadowing");
+    ue->SetPosition(Vector(202, 0, 1.5));
+    double after = correlated->GetShadowing(ue, enb);
+    NS_TEST_ASSERT_MSG_NE(after, before, "Correlated shadowing did not change with the position");
+    // with a sigma of 7 dB, a move of 1 m changes the shadowing by 0.14 dB on average
+    NS_TEST_ASSERT_MSG_EQ_TOL(after, before, 2.0, "Correlated shadowing changed too much");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup building-test
+ * \ingroup tests
+ *
+ * \brief Shadowing store TestSuite
+ */
+class ShadowingStoreTestSuite : public TestSuite
+{
+  public:
+    ShadowingStoreTestSuite();
+};
+
+ShadowingStoreTestSuite::ShadowingStoreTestSuite()
+    : TestSuite("buildings-shadowing-store", UNIT)
+{
+    NS_LOG_FUNCTION(this);
+
+    AddTestCase(new ShadowingPairStoreTestCase, TestCase::QUICK);
+    AddTestCase(new CorrelatedShadowingTestCase, TestCase::QUICK);
+    AddTestCase(new BuildingsShadowingSymmetryTestCase, TestCase::QUICK);
+}
+
+/// Static variable for test initialization
+static ShadowingStoreTestSuite shadowingStoreTestSuiteInstance;
@@ -0,0 +1,245 @@
+#! /usr/bin/env python3
+"""
+Convert the snapshots written by ns3::FlowMonitorSnapshotExporter to the XML
+format of FlowMonitor::SerializeToXmlFile (without the probe statistics).
+
+Usage: flowmon-snapshots-to-xml.py SNAPSHOTS [XML] [--until TIME_NS]
+
+The snapshots, in CSV or binary format, are summed up to the given time (all
+of them by default) and the result is written to XML, or to the standard
+output.
+"""
+
+import argparse
+import struct
+import sys
+
+## Magic bytes at the start of a binary snapshot file
+BINARY_MAGIC = b'NS3FMSS1'
+## Names of the histograms, indexed by their identifier in the binary snapshots
+HISTOGRAMS = ['delay', 'jitter', 'packetSize', 'flowInterruptions']
+## Counters of a flow, in the order of the F records
+COUNTERS = ['txBytes', 'rxBytes', 'txPackets', 'rxPackets', 'lostPackets', 'timesForwarded',
+            'delaySum', 'jitterSum']
+## Current values of a flow, in the order of the F records
+TIMES = ['timeFirstTxPacket', 'timeFirstRxPacket', 'timeLastTxPacket', 'timeLastRxPacket',
+         'lastDelay']
+
+
+## Flow
+class Flow(object):
+    ## @var values
+    #  counters and times, by name
+    ## @var packetsDropped
+    #  reason code --> packets dropped
+    ## @var bytesDropped
+    #  reason code --> bytes dropped
+    ## @var histograms
+    #  histogram name --> [bin width, {bin index --> count}]
+    def __init__(self):
+        '''! The initializer.
+        @param self The object pointer.
+        '''
+        self.values = dict((name, 0) for name in COUNTERS + TIMES)
+        self.packetsDropped = {}
+        self.bytesDropped = {}
+        self.histograms = dict((name, [0.0, {}]) for name in HISTOGRAMS)
+
+
+## Snapshots
+class Snapshots(object):
+    ## @var flows
+    #  flow id --> Flow
+    ## @var classifiers
+    #  lines of the XML description of the flows
+    ## @var until
+    #  the snapshots after this time, in nanoseconds, are ignored
+    def __init__(self, until):
+        '''! The initializer.
+        @param self The object pointer.
+        @param until the time of the last snapshot to sum, or None
+        '''
+        self.flows = {}
+        self.classifiers = []
+        self.until = until
+
+    def _flow(self, time, flowId):
+        '''! Get the flow of a record, or None if the record is ignored.
+        @param self The object pointer.
+        @param time the time of the record
+        @param flowId the flow id
+        @return the Flow, or None
+        '''
+        if self.until is not None and time > self.until:
+            return None
+        return self.flows.setdefault(flowId, Flow())
+
+    def add_flow(self, time, flowId, counters, times):
+        '''! Add an F record.
+        @param self The object pointer.
+        @param time the time of the snapshot
+        @param flowId the flow id
+        @param counters the changes of the counters
+        @param times the current times
+        '''
+        flow = self._flow(time, flowId)
+        if flow is None:
+            return
+        for name, value in zip(COUNTERS, counters):
+            flow.values[name] += value
+        for name, value in zip(TIMES, times):
+            flow.values[name] = value
+
+    def add_drops(self, time, flowId, reasonCode, packets, nbytes):
+        '''! Add a D record.
+        @param self The object pointer.
+        @param time the time of the snapshot
+        @param flowId the flow id
+        @param reasonCode the drop reason code
+        @param packets the change of the number of dropped packets
+        @param nbytes the change of the number of dropped bytes
+        '''
+        flow = self._flow(time, flowId)
+        if flow is None:
+            return
+        flow.packetsDropped[reasonCode] = flow.packetsDropped.get(reasonCode, 0) + packets
+        flow.bytesDropped[reasonCode] = flow.bytesDropped.get(reasonCode, 0) + nbytes
+
+    def add_bin(self, time, flowId, histogram, width, index, count):
+        '''! Add an H record.
+        @param self The object pointer.
+        @param time the time of the snapshot
+        @param flowId the flow id
+        @param histogram the histogram name
+        @param width the bin width
+        @param index the bin index
+        @param count the change of the bin count
+        '''
+        flow = self._flow(time, flowId)
+        if flow is None:
+            return
+        hist = flow.histograms[histogram]
+        hist[0] = width
+        hist[1][index] = hist[1].get(index, 0) + count
+
+    def read_csv(self, f):
+        '''! Read a CSV snapshot file.
+        @param self The object pointer.
+        @param f the file, opened in text mode
+        '''
+        for line in f:
+            line = line.rstrip('\n')
+            if not line or line.startswith('#'):
+                continue
+            kind, rest = line.split(',', 1)
+            if kind == 'X':
+                self.classifiers.append(rest)
+                continue
+            fields = rest.split(',')
+            if kind == 'F':
+                values = [int(v) for v in fields]
+                self.add_flow(values[0], values[1], values[2:2 + len(COUNTERS)],
+                              values[2 + len(COUNTERS):])
+            elif kind == 'D':
+                values = [int(v) for v in fields]
+                self.add_drops(*values)
+            elif kind == 'H':
+                self.add_bin(int(fields[0]), int(fields[1]), fields[2], float(fields[3]),
+                             int(fields[4]), int(fields[5]))
+            else:
+                raise ValueError('unknown record: ' + line)
+
+    def read_binary(self, data):
+        '''! Read a binary snapshot file.
+        @param self The object pointer.
+        @param data the content of the file, without the magic bytes
+        '''
+        formats = {
+            b'F': struct.Struct('=qI' + 'q' * (len(COUNTERS) + len(TIMES))),
+            b'D': struct.Struct('=qIIqq'),
+            b'H': struct.Struct('=qIBdIq'),
+            b'X': struct.Struct('=I'),
+        }
+        pos = 0
+        while pos < len(data):
+            kind = data[pos:pos + 1]
+            pos += 1
+            fmt = formats[kind]
+            values = fmt.unpack_from(data, pos)
+            pos += fmt.size
+            if kind == b'F':
+                self.add_flow(values[0], values[1], values[2:2 + len(COUNTERS)],
+                              values[2 + len(COUNTERS):])
+            elif kind == b'D':
+                self.add_drops(*values)
+            elif kind == b'H':
+                self.add_bin(values[0], values[1], HISTOGRAMS[values[2]], *values[3:])
+            else:
+                text = data[pos:pos + values[0]].decode()
+                pos += values[0]
+                self.classifiers.extend(text.splitlines())
+
+    def write_xml(self, out):
+        '''! Write the sums in the XML format of FlowMonitor.
+        @param self The object pointer.
+        @param out the output file
+        '''
+        out.write('<?xml version="1.0" ?>\n')
+        out.write('<FlowMonitor>\n')
+        out.write('  <FlowStats>\n')
+        for flowId in sorted(self.flows):
+            flow = self.flows[flowId]
+            attributes = ''.join(' %s="%+gns"' % (name, flow.values[name]) for name in
+                                 ['timeFirstTxPacket', 'timeFirstRxPacket', 'timeLastTxPacket',
+                                  'timeLastRxPacket', 'delaySum', 'jitterSum', 'lastDelay'])
+            attributes += ''.join(' %s="%d"' % (name, flow.values[name]) for name in
+                                  ['txBytes', 'rxBytes', 'txPackets', 'rxPackets',
+                                   'lostPackets', 'timesForwarded'])
+            out.write('    <Flow flowId="%d"%s>\n' % (flowId, attributes))
+            nReasons = max(list(flow.packetsDropped) + [-1]) + 1
+            for reasonCode in range(nReasons):
+                out.write('      <packetsDropped reasonCode="%d" number="%d" />\n'
+                          % (reasonCode, flow.packetsDropped.get(reasonCode, 0)))
+            for reasonCode in range(nReasons):
+                out.write('      <bytesDropped reasonCode="%d" bytes="%d" />\n'
+                          % (reasonCode, flow.bytesDropped.get(reasonCode, 0)))
+            for name in HISTOGRAMS:
+                width, bins = flow.histograms[name]
+                bins = dict((index, count) for index, count in bins.items() if count)
+                out.write('      <%sHistogram nBins="%d" >\n' % (name, max(list(bins) + [-1]) + 1))
+                for index in sorted(bins):
+                    out.write('        <bin index="%d" start="%g" width="%g" count="%d" />\n'
+                              % (index, index * width, width, bins[index]))
+                out.write('      </%sHistogram>\n' % name)
+            out.write('    </Flow>\n')
+        out.write('  </FlowStats>\n')
+        for line in self.classifiers:
+            out.write(line + '\n')
+        out.write('</FlowMonitor>\n')
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split('\n\n')[1])
+    parser.add_argument('snapshots', help='file written by FlowMonitorSnapshotExporter')
+    parser.add_argument('xml', nargs='?', help='output XML file (default: standard output)')
+    parser.add_argument('--until', type=int, default=None,
+                        help='time, in nanoseconds, of the last snapshot to sum')
+    args = parser.parse_args(argv[1:])
+
+    snapshots = Snapshots(args.until)
+    with open(args.snapshots, 'rb') as f:
+        data = f.read()
+    if data.startswith(BINARY_MAGIC):
+        snapshots.read_binary(data[len(BINARY_MAGIC):])
+    else:
+        snapshots.read_csv(data.decode().splitlines())
+
+    if args.xml:
+        with open(args.xml, 'w') as out:
+            snapshots.write_xml(out)
+    else:
+        snapshots.write_xml(sys.stdout)
+
+
+if __name__ == '__main__':
+    main(sys.argv)
@@ -19,6 +19,9 @@
 
 #include "flow-monitor-helper.h"
 
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/ipv4-flow-classifier.h"
 #include "ns3/ipv4-flow-probe.h"
@@ -171,4 +174,28 @@ FlowMonitorHelper::SerializeToXmlFile(std::string fileName,
     }
 }
 
+Ptr<FlowMonitorSnapshotExporter>
+FlowMonitorHelper::EnableSnapshots(std::string fileName,
+                                   Time interval,
+                                   FlowMonitorSnapshotExporter::Format format,
+                                   bool enableHistograms)
+{
+    NS_ABORT_MSG_UNLESS(m_flowMonitor, "Install flow monitoring before enabling snapshots");
+    Ptr<FlowMonitorSnapshotExporter> exporter = CreateObject<FlowMonitorSnapshotExporter>();
+    exporter->SetAttribute("Interval", TimeValue(interval));
+    exporter->SetAttribute("Format", EnumValue(format));
+    exporter->SetAttribute("EnableHistograms", BooleanValue(enableHistograms));
+    exporter->SetFlowMonitor(m_flowMonitor);
+    if (m_flowClassifier4)
+    {
+        exporter->AddFlowClassifier(m_flowClassifier4);
+    }
+    if (m_flowClassifier6)
+    {
+        exporter->AddFlowClassifier(m_flowClassifier6);
+    }
+    exporter->Start(fileName);
+    return exporter;
+}
+
 } // namespace ns3
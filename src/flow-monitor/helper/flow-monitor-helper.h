@@ -20,6 +20,7 @@
 #define FLOW_MONITOR_HELPER_H
 
 #include "ns3/flow-classifier.h"
+#include "ns3/flow-monitor-snapshot-exporter.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/node-container.h"
 #include "ns3/object-factory.h"
@@ -119,6 +120,21 @@ class FlowMonitorHelper
      */
     void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+    /**
+     * Periodically write the changes of the flow statistics to a file, see
+     * FlowMonitorSnapshotExporter. Must be called after the Install* methods.
+     * \param fileName name or path of the output file that will be created
+     * \param interval the time between two snapshots
+     * \param format the format of the file
+     * \param enableHistograms if true, include also the changes of the histograms
+     * \returns a pointer to the FlowMonitorSnapshotExporter object
+     */
+    Ptr<FlowMonitorSnapshotExporter> EnableSnapshots(
+        std::string fileName,
+        Time interval,
+        FlowMonitorSnapshotExporter::Format format = FlowMonitorSnapshotExporter::CSV,
+        bool enableHistograms = true);
+
   private:
     ObjectFactory m_monitorFactory;        //!< Object factory
     Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
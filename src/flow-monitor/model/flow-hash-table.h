@@ -0,0 +1,412 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef FLOW_HASH_TABLE_H
+#define FLOW_HASH_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup flow-monitor
+ * \brief Open-addressed hash table used by the flow monitor
+ *
+ * The flow monitor and the flow classifiers look up a flow or a packet
+ * several times per forwarded packet. This table stores the entries in a
+ * single array with linear probing, so that a lookup usually touches one
+ * cache line and an insertion does not allocate. Erasing an entry shifts
+ * the following entries of its probe sequence backwards, so there are no
+ * tombstones and the table never needs to be rehashed because of erasures.
+ *
+ * Pointers to the values are invalidated by insertions and erasures.
+ *
+ * \tparam Key the key type, which must be default constructible and
+ *         comparable with operator==
+ * \tparam Value the value type, which must be default constructible
+ * \tparam Hash the hash functor of the keys
+ */
+template <typename Key, typename Value, typename Hash>
+class FlowHashTable
+{
+  public:
+    FlowHashTable();
+
+    /**
+     * \param key the key to look up
+     * \return a pointer to the value of the key, or nullptr if not found
+     */
+    Value* Find(const Key& key);
+
+    /**
+     * \param key the key to look up
+     * \return a pointer to the value of the key, or nullptr if not found
+     */
+    const Value* Find(const Key& key) const;
+
+    /**
+     * Insert a key, if not already present.
+     *
+     * \param key the key to insert
+     * \param value the value of the key, if the key is not present
+     * \return a pointer to the value of the key, and true if the key was inserted
+     */
+    std::pair<Value*, bool> Insert(const Key& key, const Value& value);
+
+    /**
+     * \param key the key to erase
+     * \return true if the key was found and erased
+     */
+    bool Erase(const Key& key);
+
+    /**
+     * Erase all the entries for which a predicate is true.
+     *
+     * \param pred the predicate, called with the key and the value of each entry
+     * \return the number of erased entries
+     */
+    template <typename Pred>
+    std::size_t EraseIf(Pred pred);
+
+    /**
+     * Erase one entry among the entries close to a key.
+     *
+     * The entries are examined starting from the slot where the key would be
+     * stored, so that the cost is bounded regardless of the size of the
+     * table. This provides an approximation of, e.g., a least recently used
+     * eviction without maintaining an ordering of the entries.
+     *
+     * \param key the key around which to look for a victim
+     * \param window the maximum number of entries to examine
+     * \param before the comparison of two values, true if the first value
+     *        should be evicted rather than the second one
+     * \param victim the evicted entry
+     * \return false if the table is empty
+     */
+    template <typename Compare>
+    bool EvictNear(const Key& key,
+                   std::size_t window,
+                   Compare before,
+                   std::pair<Key, Value>& victim);
+
+    /**
+     * Call a function for each entry, in unspecified order.
+     *
+     * \param f the function, called with the key and the value of each entry
+     */
+    template <typename Function>
+    void ForEach(Function f) const;
+
+    /**
+     * \return the number of entries
+     */
+    std::size_t GetSize() const;
+
+    /// Erase all the entries
+    void Clear();
+
+  private:
+    /// A slot of the table
+    struct Slot
+    {
+        Key key;          //!< the key
+        Value value;      //!< the value
+        bool used{false}; //!< true if the slot holds an entry
+    };
+
+    /**
+     * \param key a key
+     * \return the slot where the probe sequence of the key starts
+     */
+    std::size_t GetHomeSlot(const Key& key) const;
+
+    /**
+     * \param key a key
+     * \return the slot of the key, or the first empty slot of its probe sequence
+     */
+    std::size_t FindSlot(const Key& key) const;
+
+    /**
+     * Empty a slot and shift the following entries of the probe sequence backwards.
+     * \param slot the slot to empty
+     */
+    void EraseSlot(std::size_t slot);
+
+    /// Double the number of slots
+    void Grow();
+
+    std::vector<Slot> m_slots; //!< the slots, whose number is a power of two
+    std::size_t m_size;        //!< the number of entries
+    Hash m_hash;               //!< the hash functor
+};
+
+/**
+ * \ingroup flow-monitor
+ * \brief Mix the bits of a 64-bit value, so that all the bits of the result
+ *        depend on all the bits of the input (splitmix64 finalizer)
+ * \param x the value
+ * \return the mixed value
+ */
+inline uint64_t
+FlowHashMix(uint64_t x)
+{
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/****************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************/
+
+template <typename Key, typename Value, typename Hash>
+FlowHashTable<Key, Value, Hash>::FlowHashTable()
+    : m_slots(16),
+      m_size(0)
+{
+}
+
+template <typename Key, typename Value, typename Hash>
+std::size_t
+FlowHashTable<Key, Value, Hash>::GetHomeSlot(const Key& key) const
+{
+    return m_hash(key) & (m_slots.size() - 1);
+}
+
+template <typename Key, typename Value, typename Hash>
+std::size_t
+FlowHashTable<Key, Value, Hash>::FindSlot(const Key& key) const
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = GetHomeSlot(key);
+    while (m_slots[slot].used && !(m_slots[slot].key == key))
+    {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value*
+FlowHashTable<Key, Value, Hash>::Find(const Key& key)
+{
+    Slot& slot = m_slots[FindSlot(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value*
+FlowHashTable<Key, Value, Hash>::Find(const Key& key) const
+{
+    const Slot& slot = m_slots[FindSlot(key)];
+    return slot.used ? &slot.value : nullptr;
+}
+
+template <typename Key, typename Value, typename Hash>
+std::pair<Value*, bool>
+FlowHashTable<Key, Value, Hash>::Insert(const Key& key, const Value& value)
+{
+    std::size_t slot = FindSlot(key);
+    if (m_slots[slot].used)
+    {
+        return std::make_pair(&m_slots[slot].value, false);
+    }
+    // keep the load factor below 1/2, so that the probe sequences stay short
+    if (2 * (m_size + 1) > m_slots.size())
+    {
+        Grow();
+        slot = FindSlot(key);
+    }
+    m_slots[slot].key = key;
+    m_slots[slot].value = value;
+    m_slots[slot].used = true;
+    m_size++;
+    return std::make_pair(&m_slots[slot].value, true);
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashTable<Key, Value, Hash>::EraseSlot(std::size_t slot)
+{
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t hole = slot;
+    std::size_t next = (hole + 1) & mask;
+    while (m_slots[next].used)
+    {
+        // an entry can fill the hole only if the hole is between its home
+        // slot and its current slot, in probe order
+        std::size_t home = GetHomeSlot(m_slots[next].key);
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            m_slots[hole] = std::move(m_slots[next]);
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    m_slots[hole] = Slot();
+    m_size--;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool
+FlowHashTable<Key, Value, Hash>::Erase(const Key& key)
+{
+    std::size_t slot = FindSlot(key);
+    if (!m_slots[slot].used)
+    {
+        return false;
+    }
+    EraseSlot(slot);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Pred>
+std::size_t
+FlowHashTable<Key, Value, Hash>::EraseIf(Pred pred)
+{
+    // start right after an empty slot, so that the backward shifts never
+    // move an entry not yet examined into a slot already examined
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t start = 0;
+    while (m_slots[start].used)
+    {
+        start++; // there is always an empty slot, since the load factor is below 1/2
+    }
+    std::size_t erased = 0;
+    std::size_t count = 0;
+    std::size_t slot = (start + 1) & mask;
+    while (count < m_slots.size() - 1)
+    {
+        if (m_slots[slot].used && pred(m_slots[slot].key, m_slots[slot].value))
+        {
+            // the slot may be filled by a following entry, examine it again
+            EraseSlot(slot);
+            erased++;
+            continue;
+        }
+        slot = (slot + 1) & mask;
+        count++;
+    }
+    return erased;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Compare>
+bool
+FlowHashTable<Key, Value, Hash>::EvictNear(const Key& key,
+                                           std::size_t window,
+                                           Compare before,
+                                           std::pair<Key, Value>& victim)
+{
+    if (m_size == 0)
+    {
+        return false;
+    }
+    std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = GetHomeSlot(key);
+    std::size_t best = m_slots.size();
+    for (std::size_t examined = 0; examined < window && examined < m_size;
+         slot = (slot + 1) & mask)
+    {
+        if (m_slots[slot].used)
+        {
+            if (best == m_slots.size() || before(m_slots[slot].value, m_slots[best].value))
+            {
+                best = slot;
+            }
+            examined++;
+        }
+    }
+    victim = std::make_pair(m_slots[best].key, m_slots[best].value);
+    EraseSlot(best);
+    return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+template <typename Function>
+void
+FlowHashTable<Key, Value, Hash>::ForEach(Function f) const
+{
+    for (const auto& slot : m_slots)
+    {
+        if (slot.used)
+        {
+            f(slot.key, slot.value);
+        }
+    }
+}
+
+template <typename Key, typename Value, typename Hash>
+std::size_t
+FlowHashTable<Key, Value, Hash>::GetSize() const
+{
+    return m_size;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashTable<Key, Value, Hash>::Clear()
+{
+    m_slots.assign(16, Slot());
+    m_size = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashTable<Key, Value, Hash>::Grow()
+{
+    std::vector<Slot> old(m_slots.size() * 2);
+    old.swap(m_slots);
+    for (auto& slot : old)
+    {
+        if (slot.used)
+        {
+            std::size_t newSlot = FindSlot(slot.key);
+            m_slots[newSlot] = std::move(slot);
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* FLOW_HASH_TABLE_H */
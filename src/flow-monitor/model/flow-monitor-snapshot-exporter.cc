@@ -0,0 +1,354 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "flow-monitor-snapshot-exporter.h"
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("FlowMonitorSnapshotExporter");
+
+NS_OBJECT_ENSURE_REGISTERED(FlowMonitorSnapshotExporter);
+
+/// Names of the histograms, indexed by their identifier in the snapshots
+static const char* g_histogramNames[] = {"delay", "jitter", "packetSize", "flowInterruptions"};
+
+TypeId
+FlowMonitorSnapshotExporter::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::FlowMonitorSnapshotExporter")
+            .SetParent<Object>()
+            .SetGroupName("FlowMonitor")
+            .AddConstructor<FlowMonitorSnapshotExporter>()
+            .AddAttribute("Interval",
+                          "The time between two snapshots.",
+                          TimeValue(Seconds(1)),
+                          MakeTimeAccessor(&FlowMonitorSnapshotExporter::m_interval),
+                          MakeTimeChecker(TimeStep(1)))
+            .AddAttribute("Format",
+                          "The format of the snapshot file.",
+                          EnumValue(FlowMonitorSnapshotExporter::CSV),
+                          MakeEnumAccessor(&FlowMonitorSnapshotExporter::m_format),
+                          MakeEnumChecker(FlowMonitorSnapshotExporter::CSV,
+                                          "Csv",
+                                          FlowMonitorSnapshotExporter::BINARY,
+                                          "Binary"))
+            .AddAttribute("EnableHistograms",
+                          "If true, the changes of the histograms are written as well.",
+                          BooleanValue(true),
+                          MakeBooleanAccessor(&FlowMonitorSnapshotExporter::m_histograms),
+                          MakeBooleanChecker());
+    return tid;
+}
+
+FlowMonitorSnapshotExporter::FlowMonitorSnapshotExporter()
+    : m_format(CSV),
+      m_histograms(true)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+FlowMonitorSnapshotExporter::~FlowMonitorSnapshotExporter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+FlowMonitorSnapshotExporter::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    Stop();
+    m_monitor = nullptr;
+    m_classifiers.clear();
+    Object::DoDispose();
+}
+
+void
+FlowMonitorSnapshotExporter::SetFlowMonitor(Ptr<FlowMonitor> monitor)
+{
+    NS_LOG_FUNCTION(this << monitor);
+    m_monitor = monitor;
+}
+
+void
+FlowMonitorSnapshotExporter::AddFlowClassifier(Ptr<FlowClassifier> classifier)
+{
+    NS_LOG_FUNCTION(this);
+    m_classifiers.push_back(classifier);
+}
+
+void
+FlowMonitorSnapshotExporter::Start(std::string fileName)
+{
+    NS_LOG_FUNCTION(this << fileName);
+    NS_ABORT_MSG_UNLESS(m_monitor, "No FlowMonitor to export");
+    NS_ABORT_MSG_IF(m_file.is_open(), "Snapshot exporter already started");
+    m_file.open(fileName, std::ios::out | std::ios::trunc | std::ios::binary);
+    NS_ABORT_MSG_UNLESS(m_file.is_open(), "Can't open file " << fileName);
+    if (m_format == BINARY)
+    {
+        m_file.write("NS3FMSS1", 8);
+    }
+    else
+    {
+        m_file << "# F,time,flowId,txBytes,rxBytes,txPackets,rxPackets,lostPackets,"
+               << "timesForwarded,delaySum,jitterSum,timeFirstTxPacket,timeFirstRxPacket,"
+               << "timeLastTxPacket,timeLastRxPacket,lastDelay\n"
+               << "# D,time,flowId,reasonCode,packetsDropped,bytesDropped\n"
+               << "# H,time,flowId,histogram,binWidth,binIndex,count\n";
+    }
+    m_previous.clear();
+    m_snapshotEvent =
+        Simulator::Schedule(m_interval, &FlowMonitorSnapshotExporter::PeriodicSnapshot, this);
+    Simulator::ScheduleDestroy(&FlowMonitorSnapshotExporter::Stop,
+                               Ptr<FlowMonitorSnapshotExporter>(this));
+}
+
+void
+FlowMonitorSnapshotExporter::Stop()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    m_snapshotEvent.Cancel();
+    WriteSnapshot();
+    for (const auto& classifier : m_classifiers)
+    {
+        std::ostringstream xml;
+        classifier->SerializeToXmlStream(xml, 2);
+        if (m_format == BINARY)
+        {
+            std::string text = xml.str();
+            WriteBinary<char>('X');
+            WriteBinary<uint32_t>(text.size());
+            m_file.write(text.data(), text.size());
+        }
+        else
+        {
+            std::istringstream lines(xml.str());
+            std::string line;
+            while (std::getline(lines, line))
+            {
+                m_file << "X," << line << "\n";
+            }
+        }
+    }
+    m_file.close();
+}
+
+void
+FlowMonitorSnapshotExporter::PeriodicSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    WriteSnapshot();
+    m_snapshotEvent =
+        Simulator::Schedule(m_interval, &FlowMonitorSnapshotExporter::PeriodicSnapshot, this);
+}
+
+template <typename T>
+void
+FlowMonitorSnapshotExporter::WriteBinary(T value)
+{
+    m_file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void
+FlowMonitorSnapshotExporter::WriteHistogram(int64_t now,
+                                            FlowId flowId,
+                                            uint8_t histogram,
+                                            const Histogram& current,
+                                            const Histogram& previous)
+{
+    uint32_t nBins = std::max(current.GetNBins(), previous.GetNBins());
+    for (uint32_t index = 0; index < nBins; index++)
+    {
+        int64_t count = (index < current.GetNBins() ? current.GetBinCount(index) : 0);
+        if (index < previous.GetNBins())
+        {
+            count -= previous.GetBinCount(index);
+        }
+        if (count == 0)
+        {
+            continue;
+        }
+        double width = current.GetNBins() > 0 ? current.GetBinWidth(0) : previous.GetBinWidth(0);
+        if (m_format == BINARY)
+        {
+            WriteBinary<char>('H');
+            WriteBinary<int64_t>(now);
+            WriteBinary<uint32_t>(flowId);
+            WriteBinary<uint8_t>(histogram);
+            WriteBinary<double>(width);
+            WriteBinary<uint32_t>(index);
+            WriteBinary<int64_t>(count);
+        }
+        else
+        {
+            m_file << "H," << now << "," << flowId << "," << g_histogramNames[histogram] << ","
+                   << width << "," << index << "," << count << "\n";
+        }
+    }
+}
+
+void
+FlowMonitorSnapshotExporter::WriteSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    if (!m_file.is_open())
+    {
+        return;
+    }
+    int64_t now = Simulator::Now().GetNanoSeconds();
+    for (const auto& flow : m_monitor->GetFlowStats())
+    {
+        const FlowMonitor::FlowStats& cur = flow.second;
+        FlowMonitor::FlowStats& prev = m_previous[flow.first];
+        if (cur.txPackets == prev.txPackets && cur.rxPackets == prev.rxPackets &&
+            cur.lostPackets == prev.lostPackets && cur.packetsDropped == prev.packetsDropped &&
+            cur.txBytes == prev.txBytes && cur.rxBytes == prev.rxBytes)
+        {
+            continue;
+        }
+
+        // the counters are unsigned but decrease when the statistics are reset
+        int64_t deltas[] = {
+            static_cast<int64_t>(cur.txBytes - prev.txBytes),
+            static_cast<int64_t>(cur.rxBytes - prev.rxBytes),
+            static_cast<int64_t>(cur.txPackets) - prev.txPackets,
+            static_cast<int64_t>(cur.rxPackets) - prev.rxPackets,
+            static_cast<int64_t>(cur.lostPackets) - prev.lostPackets,
+            static_cast<int64_t>(cur.timesForwarded) - prev.timesForwarded,
+            (cur.delaySum - prev.delaySum).GetNanoSeconds(),
+            (cur.jitterSum - prev.jitterSum).GetNanoSeconds(),
+        };
+        int64_t times[] = {
+            cur.timeFirstTxPacket.GetNanoSeconds(),
+            cur.timeFirstRxPacket.GetNanoSeconds(),
+            cur.timeLastTxPacket.GetNanoSeconds(),
+            cur.timeLastRxPacket.GetNanoSeconds(),
+            cur.lastDelay.GetNanoSeconds(),
+        };
+        if (m_format == BINARY)
+        {
+            WriteBinary<char>('F');
+            WriteBinary<int64_t>(now);
+            WriteBinary<uint32_t>(flow.first);
+            for (int64_t value : deltas)
+            {
+                WriteBinary<int64_t>(value);
+            }
+            for (int64_t value : times)
+            {
+                WriteBinary<int64_t>(value);
+            }
+        }
+        else
+        {
+            m_file << "F," << now << "," << flow.first;
+            for (int64_t value : deltas)
+            {
+                m_file << "," << value;
+            }
+            for (int64_t value : times)
+            {
+                m_file << "," << value;
+            }
+            m_file << "\n";
+        }
+
+        std::size_t nReasons = std::max(cur.packetsDropped.size(), prev.packetsDropped.size());
+        for (uint32_t reasonCode = 0; reasonCode < nReasons; reasonCode++)
+        {
+            int64_t packets = 0;
+            int64_t bytes = 0;
+            if (reasonCode < cur.packetsDropped.size())
+            {
+                packets += cur.packetsDropped[reasonCode];
+                bytes += cur.bytesDropped[reasonCode];
+            }
+            if (reasonCode < prev.packetsDropped.size())
+            {
+                packets -= prev.packetsDropped[reasonCode];
+                bytes -= prev.bytesDropped[reasonCode];
+            }
+            if (packets == 0 && bytes == 0)
+            {
+                continue;
+            }
+            if (m_format == BINARY)
+            {
+                WriteBinary<char>('D');
+                WriteBinary<int64_t>(now);
+                WriteBinary<uint32_t>(flow.first);
+                WriteBinary<uint32_t>(reasonCode);
+                WriteBinary<int64_t>(packets);
+                WriteBinary<int64_t>(bytes);
+            }
+            else
+            {
+                m_file << "D," << now << "," << flow.first << "," << reasonCode << ","
+                       << packets << "," << bytes << "\n";
+            }
+        }
+
+        if (m_histograms)
+        {
+            WriteHistogram(now, flow.first, 0, cur.delayHistogram, prev.delayHistogram);
+            WriteHistogram(now, flow.first, 1, cur.jitterHistogram, prev.jitterHistogram);
+            WriteHistogram(now, flow.first, 2, cur.packetSizeHistogram, prev.packetSizeHistogram);
+            WriteHistogram(now,
+                           flow.first,
+                           3,
+                           cur.flowInterruptionsHistogram,
+                           prev.flowInterruptionsHistogram);
+        }
+        prev = cur;
+    }
+    m_file.flush();
+}
+
+} // namespace ns3
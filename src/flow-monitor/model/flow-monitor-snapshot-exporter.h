@@ -0,0 +1,185 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef FLOW_MONITOR_SNAPSHOT_EXPORTER_H
+#define FLOW_MONITOR_SNAPSHOT_EXPORTER_H
+
+#include "flow-classifier.h"
+#include "flow-monitor.h"
+
+#include "ns3/event-id.h"
+#include "ns3/nstime.h"
+#include "ns3/object.h"
+
+#include <fstream>
+#include <list>
+#include <map>
+#include <string>
+
+namespace ns3
+{
+
+/**
+ * \ingroup flow-monitor
+ * \brief Periodically append the changes of the flow statistics to a file
+ *
+ * FlowMonitor::SerializeToXmlFile writes the statistics once, at the end
+ * of the simulation. This class instead writes, every Interval, the
+ * difference between the current statistics of each flow and the ones of
+ * the previous snapshot, so that long simulations produce a time series
+ * without accumulating it in memory. Only the flows whose statistics
+ * changed are written.
+ *
+ * The records of a CSV file are lines whose first field is the record type:
+ *
+ * \verbatim
+   F,time,flowId,txBytes,rxBytes,txPackets,rxPackets,lostPackets,timesForwarded,
+     delaySum,jitterSum,timeFirstTxPacket,timeFirstRxPacket,timeLastTxPacket,
+     timeLastRxPacket,lastDelay
+   D,time,flowId,reasonCode,packetsDropped,bytesDropped
+   H,time,flowId,histogram,binWidth,binIndex,count
+   X,line of XML
+   \endverbatim
+ *
+ * where the times are in nanoseconds, the counters, sums and bin counts are
+ * the increments since the previous snapshot, the timeFirst/timeLast and
+ * lastDelay fields are the current values, the histogram is one of delay,
+ * jitter, packetSize or flowInterruptions, and the X records hold the XML
+ * description of the flows by the classifiers, written when the exporter
+ * is stopped. A binary file starts with the 8 bytes "NS3FMSS1", followed
+ * by the same records, each one starting with the record type character
+ * and using the native byte order: times, counters, sums and counts are
+ * int64, flowId, reasonCode and binIndex are uint32, the histogram is a
+ * uint8 (0: delay, 1: jitter, 2: packetSize, 3: flowInterruptions), the
+ * bin width is a double, and an X record holds a uint32 length followed by
+ * the XML text.
+ *
+ * The script flowmon-snapshots-to-xml.py of the flow-monitor examples sums
+ * the snapshots up to a given time and writes the result in the format of
+ * FlowMonitor::SerializeToXmlFile, without the probe statistics.
+ */
+class FlowMonitorSnapshotExporter : public Object
+{
+  public:
+    /// Format of the snapshot file
+    enum Format
+    {
+        CSV,   //!< comma separated values
+        BINARY //!< binary records
+    };
+
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    FlowMonitorSnapshotExporter();
+    ~FlowMonitorSnapshotExporter() override;
+
+    /**
+     * \brief Set the FlowMonitor whose statistics are exported
+     * \param monitor the FlowMonitor
+     */
+    void SetFlowMonitor(Ptr<FlowMonitor> monitor);
+
+    /**
+     * \brief Add a FlowClassifier whose description of the flows is written
+     * when the exporter is stopped
+     * \param classifier the FlowClassifier
+     */
+    void AddFlowClassifier(Ptr<FlowClassifier> classifier);
+
+    /**
+     * \brief Open the file and start writing a snapshot every Interval
+     *
+     * The exporter is stopped when the simulator is destroyed, if not before.
+     *
+     * \param fileName the name of the file, which is overwritten
+     */
+    void Start(std::string fileName);
+
+    /**
+     * \brief Write a last snapshot and the description of the flows, and close the file
+     */
+    void Stop();
+
+    /**
+     * \brief Write the changes of the statistics since the previous snapshot now
+     */
+    void WriteSnapshot();
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    /// Write a snapshot and schedule the next one
+    void PeriodicSnapshot();
+
+    /**
+     * \brief Write the changes of a histogram
+     * \param now the time of the snapshot, in nanoseconds
+     * \param flowId the flow
+     * \param histogram the identifier of the histogram
+     * \param current the current histogram
+     * \param previous the histogram at the previous snapshot
+     */
+    void WriteHistogram(int64_t now,
+                        FlowId flowId,
+                        uint8_t histogram,
+                        const Histogram& current,
+                        const Histogram& previous);
+
+    /**
+     * \brief Write a value in the binary format
+     * \param value the value
+     */
+    template <typename T>
+    void WriteBinary(T value);
+
+    Ptr<FlowMonitor> m_monitor;                   //!< the FlowMonitor
+    std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
+    /// FlowId --> statistics at the previous snapshot
+    std::map<FlowId, FlowMonitor::FlowStats> m_previous;
+    std::ofstream m_file;    //!< the snapshot file
+    Time m_interval;         //!< the time between snapshots
+    Format m_format;         //!< the format of the file
+    bool m_histograms;       //!< true if the histograms are written
+    EventId m_snapshotEvent; //!< the next snapshot
+};
+
+} // namespace ns3
+
+#endif /* FLOW_MONITOR_SNAPSHOT_EXPORTER_H */
@@ -22,12 +22,19 @@
 #include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/uinteger.h"
 
 #include <fstream>
 #include <sstream>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds(1))
 
+/// FlowIds above this value are looked up in the FlowStats map only
+#define MAX_INDEXED_FLOW_ID (1 << 20)
+
+/// Number of tracked packets examined to choose the one to evict
+#define EVICTION_WINDOW 8
+
 namespace ns3
 {
 
@@ -80,7 +87,22 @@ FlowMonitor::GetTypeId()
                 ("The minimum inter-arrival time that is considered a flow interruption."),
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
-                MakeTimeChecker());
+                MakeTimeChecker())
+            .AddAttribute("MaxTrackedPackets",
+                          "The maximum number of packets in flight that are tracked, or 0 for "
+                          "no limit. When the limit is reached, the tracked packet least "
+                          "recently seen among a few candidates is evicted and counted as lost.",
+                          UintegerValue(0),
+                          MakeUintegerAccessor(&FlowMonitor::m_maxTrackedPackets),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("PacketSamplingInterval",
+                          "Track only one in this number of packets of each flow. The packet "
+                          "and byte counters account for all the packets, while the delay, "
+                          "jitter, forwarding and timeout loss statistics are estimated from "
+                          "the tracked packets.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&FlowMonitor::m_samplingInterval),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
@@ -91,7 +113,10 @@ FlowMonitor::GetInstanceTypeId() const
 }
 
 FlowMonitor::FlowMonitor()
-    : m_enabled(false)
+    : m_maxTrackedPackets(0),
+      m_samplingInterval(1),
+      m_evictedPackets(0),
+      m_enabled(false)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -118,6 +143,10 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow(FlowId flowId)
 {
     NS_LOG_FUNCTION(this);
+    if (flowId < m_flowStatsIndex.size() && m_flowStatsIndex[flowId] != nullptr)
+    {
+        return *m_flowStatsIndex[flowId];
+    }
     auto iter = m_flowStats.find(flowId);
     if (iter == m_flowStats.end())
     {
@@ -135,6 +164,15 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
         ref.jitterHistogram.SetDefaultBinWidth(m_jitterBinWidth);
         ref.packetSizeHistogram.SetDefaultBinWidth(m_packetSizeBinWidth);
         ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
+        if (flowId < MAX_INDEXED_FLOW_ID)
+        {
+            // the map nodes are never moved, so the index can point to them
+            if (flowId >= m_flowStatsIndex.size())
+            {
+                m_flowStatsIndex.resize(flowId + 1, nullptr);
+            }
+            m_flowStatsIndex[flowId] = &ref;
+        }
         return ref;
     }
     else
@@ -143,6 +181,12 @@ FlowMonitor::GetStatsForFlow(FlowId flowId)
     }
 }
 
+inline bool
+FlowMonitor::IsSampled(FlowPacketId packetId) const
+{
+    return m_samplingInterval == 1 || packetId % m_samplingInterval == 0;
+}
+
 void
 FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
                            uint32_t flowId,
@@ -156,16 +200,37 @@ FlowMonitor::ReportFirstTx(Ptr<FlowProbe> probe,
         return;
     }
     Time now = Simulator::Now();
-    TrackedPacket& tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
-    tracked.firstSeenTime = now;
-    tracked.lastSeenTime = tracked.firstSeenTime;
-    tracked.timesForwarded = 0;
-    NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
-                                                                 << packetId << ").");
+    FlowStats& stats = GetStatsForFlow(flowId);
+    if (IsSampled(packetId))
+    {
+        std::pair<FlowId, FlowPacketId> key(flowId, packetId);
+        if (m_maxTrackedPackets > 0 && m_trackedPackets.GetSize() >= m_maxTrackedPackets &&
+            m_trackedPackets.Find(key) == nullptr)
+        {
+            std::pair<std::pair<FlowId, FlowPacketId>, TrackedPacket> victim;
+            m_trackedPackets.EvictNear(
+                key,
+                EVICTION_WINDOW,
+                [](const TrackedPacket& a, const TrackedPacket& b) {
+                    return a.lastSeenTime < b.lastSeenTime;
+                },
+                victim);
+            NS_LOG_DEBUG("ReportFirstTx: evicting tracked packet (flowId="
+                         << victim.first.first << ", packetId=" << victim.first.second << ").");
+            GetStatsForFlow(victim.first.first).lostPackets += m_samplingInterval;
+            m_evictedPackets++;
+        }
+        TrackedPacket tracked;
+        tracked.firstSeenTime = now;
+        tracked.lastSeenTime = tracked.firstSeenTime;
+        tracked.timesForwarded = 0;
+        *m_trackedPackets.Insert(key, tracked).first = tracked;
+        NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId="
+                                                                     << packetId << ").");
+    }
 
     probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
-    FlowStats& stats = GetStatsForFlow(flowId);
     stats.txBytes += packetSize;
     stats.txPackets++;
     if (stats.txPackets == 1)
@@ -187,20 +252,24 @@ FlowMonitor::ReportForwarding(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
-    auto tracked = m_trackedPackets.find(key);
-    if (tracked == m_trackedPackets.end())
+    if (!IsSampled(packetId))
+    {
+        probe->AddPacketStats(flowId, packetSize, Seconds(0));
+        return;
+    }
+    TrackedPacket* tracked = m_trackedPackets.Find(std::make_pair(flowId, packetId));
+    if (tracked == nullptr)
     {
         NS_LOG_WARN("Received packet forward report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
 
-    tracked->second.timesForwarded++;
-    tracked->second.lastSeenTime = Simulator::Now();
+    tracked->timesForwarded++;
+    tracked->lastSeenTime = Simulator::Now();
 
-    Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
+    Time delay = (Simulator::Now() - tracked->firstSeenTime);
+    probe->AddPacketStats(flowId, packetSize, delay * m_samplingInterval);
 }
 
 void
@@ -215,36 +284,55 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         NS_LOG_DEBUG("FlowMonitor not enabled; returning");
         return;
     }
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked == m_trackedPackets.end())
+    bool sampled = IsSampled(packetId);
+    std::pair<FlowId, FlowPacketId> key(flowId, packetId);
+    const TrackedPacket* tracked = sampled ? m_trackedPackets.Find(key) : nullptr;
+    if (sampled && tracked == nullptr)
     {
         NS_LOG_WARN("Received packet last-tx report (flowId="
                     << flowId << ", packetId=" << packetId << ") but not known to be transmitted.");
         return;
     }
+    if (!sampled && (flowId >= m_flowStatsIndex.size() || m_flowStatsIndex[flowId] == nullptr) &&
+        m_flowStats.find(flowId) == m_flowStats.end())
+    {
+        NS_LOG_WARN("Received packet last-tx report (flowId=" << flowId
+                                                              << ") but flow not known.");
+        return;
+    }
 
     Time now = Simulator::Now();
-    Time delay = (now - tracked->second.firstSeenTime);
-    probe->AddPacketStats(flowId, packetSize, delay);
-
     FlowStats& stats = GetStatsForFlow(flowId);
-    stats.delaySum += delay;
-    stats.delayHistogram.AddValue(delay.GetSeconds());
-    if (stats.rxPackets > 0)
+    if (sampled)
     {
-        Time jitter = stats.lastDelay - delay;
-        if (jitter > Seconds(0))
-        {
-            stats.jitterSum += jitter;
-            stats.jitterHistogram.AddValue(jitter.GetSeconds());
-        }
-        else
+        Time delay = (now - tracked->firstSeenTime);
+        probe->AddPacketStats(flowId, packetSize, delay * m_samplingInterval);
+
+        // the jitter is measured between consecutive sampled packets, i.e.,
+        // if the delay of a previous packet is in the histogram
+        if (stats.delayHistogram.GetNBins() > 0)
         {
-            stats.jitterSum -= jitter;
-            stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            Time jitter = stats.lastDelay - delay;
+            if (jitter > Seconds(0))
+            {
+                stats.jitterSum += jitter * m_samplingInterval;
+                stats.jitterHistogram.AddValue(jitter.GetSeconds());
+            }
+            else
+            {
+                stats.jitterSum -= jitter * m_samplingInterval;
+                stats.jitterHistogram.AddValue(-jitter.GetSeconds());
+            }
         }
+        stats.delaySum += delay * m_samplingInterval;
+        stats.delayHistogram.AddValue(delay.GetSeconds());
+        stats.lastDelay = delay;
+        stats.timesForwarded += tracked->timesForwarded * m_samplingInterval;
+    }
+    else
+    {
+        probe->AddPacketStats(flowId, packetSize, Seconds(0));
     }
-    stats.lastDelay = delay;
 
     stats.rxBytes += packetSize;
     stats.packetSizeHistogram.AddValue((double)packetSize);
@@ -263,12 +351,14 @@ FlowMonitor::ReportLastRx(Ptr<FlowProbe> probe,
         }
     }
     stats.timeLastRxPacket = now;
-    stats.timesForwarded += tracked->second.timesForwarded;
 
-    NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
-                                                                  << packetId << ").");
+    if (sampled)
+    {
+        NS_LOG_DEBUG("ReportLastTx: removing tracked packet (flowId=" << flowId << ", packetId="
+                                                                      << packetId << ").");
 
-    m_trackedPackets.erase(tracked); // we don't need to track this packet anymore
+        m_trackedPackets.Erase(key); // we don't need to track this packet anymore
+    }
 }
 
 void
@@ -299,14 +389,12 @@ FlowMonitor::ReportDrop(Ptr<FlowProbe> probe,
     NS_LOG_DEBUG("++stats.packetsDropped["
                  << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-    auto tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
-    if (tracked != m_trackedPackets.end())
+    // we don't need to track this packet anymore
+    // FIXME: this will not necessarily be true with broadcast/multicast
+    if (m_trackedPackets.Erase(std::make_pair(flowId, packetId)))
     {
-        // we don't need to track this packet anymore
-        // FIXME: this will not necessarily be true with broadcast/multicast
-        NS_LOG_DEBUG("ReportDrop: removing tracked packet (flowId=" << flowId << ", packetId="
-                                                                    << packetId << ").");
-        m_trackedPackets.erase(tracked);
+        NS_LOG_DEBUG("ReportDrop: removed tracked packet (flowId=" << flowId << ", packetId="
+                                                                   << packetId << ").");
     }
 }
 
@@ -322,23 +410,19 @@ FlowMonitor::CheckForLostPackets(Time maxDelay)
     NS_LOG_FUNCTION(this << maxDelay.As(Time::S));
     Time now = Simulator::Now();
 
-    for (auto iter = m_trackedPackets.begin(); iter != m_trackedPackets.end();)
-    {
-        if (now - iter->second.lastSeenTime >= maxDelay)
+    m_trackedPackets.EraseIf([this, now, maxDelay](const std::pair<FlowId, FlowPacketId>& key,
+                                                   const TrackedPacket& tracked) {
+        if (now - tracked.lastSeenTime >= maxDelay)
         {
             // packet is considered lost, add it to the loss statistics
-            auto flow = m_flowStats.find(iter->first.first);
-            NS_ASSERT(flow != m_flowStats.end());
-            flow->second.lostPackets++;
+            NS_ASSERT(m_flowStats.find(key.first) != m_flowStats.end());
+            GetStatsForFlow(key.first).lostPackets += m_samplingInterval;
 
             // we won't track it anymore
-            m_trackedPackets.erase(iter++);
-        }
-        else
-        {
-            iter++;
+            return true;
         }
-    }
+        return false;
+    });
 }
 
 void
@@ -367,6 +451,18 @@ FlowMonitor::AddProbe(Ptr<FlowProbe> probe)
     m_flowProbes.push_back(probe);
 }
 
+uint32_t
+FlowMonitor::GetNumTrackedPackets() const
+{
+    return m_trackedPackets.GetSize();
+}
+
+uint64_t
+FlowMonitor::GetNumEvictedPackets() const
+{
+    return m_evictedPackets;
+}
+
 const FlowMonitor::FlowProbeContainer&
 FlowMonitor::GetAllProbes() const
 {
@@ -21,6 +21,7 @@
 #define FLOW_MONITOR_H
 
 #include "flow-classifier.h"
+#include "flow-hash-table.h"
 #include "flow-probe.h"
 
 #include "ns3/event-id.h"
@@ -47,6 +48,14 @@ namespace ns3
  * The FlowMonitor class is responsible for coordinating efforts
  * regarding probes, and collects end-to-end flow statistics.
  *
+ * The packets in flight are tracked in a hash table. For large
+ * simulations, the number of tracked packets can be bounded with the
+ * MaxTrackedPackets attribute, and only one in PacketSamplingInterval
+ * packets of each flow can be tracked. In the latter case, the packet and
+ * byte counters still account for all the packets, while the delay,
+ * jitter, forwarding and timeout loss sums are estimated from the sampled
+ * packets, i.e., each sampled packet accounts for PacketSamplingInterval
+ * packets, and the histograms only contain the sampled packets.
  */
 class FlowMonitor : public Object
 {
@@ -277,6 +286,15 @@ class FlowMonitor : public Object
     /// Reset all the statistics
     void ResetAllStats();
 
+    /// Get the number of packets currently tracked
+    /// \returns the number of packets in flight that are tracked
+    uint32_t GetNumTrackedPackets() const;
+
+    /// Get the number of tracked packets evicted because the
+    /// MaxTrackedPackets limit was reached; they are accounted as lost
+    /// \returns the number of evicted packets
+    uint64_t GetNumEvictedPackets() const;
+
   protected:
     void NotifyConstructionCompleted() override;
     void DoDispose() override;
@@ -290,14 +308,32 @@ class FlowMonitor : public Object
         uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
     };
 
+    /// Hash of the (FlowId,PacketId) pairs
+    struct TrackedPacketKeyHash
+    {
+        /// \param key the (FlowId,PacketId) pair
+        /// \return the hash of the pair
+        std::size_t operator()(const std::pair<FlowId, FlowPacketId>& key) const
+        {
+            return FlowHashMix((static_cast<uint64_t>(key.first) << 32) | key.second);
+        }
+    };
+
     /// FlowId --> FlowStats
     FlowStatsContainer m_flowStats;
+    /// FlowId --> FlowStats, to avoid a map lookup per packet; FlowIds are
+    /// allocated sequentially, so the index is dense
+    std::vector<FlowStats*> m_flowStatsIndex;
 
     /// (FlowId,PacketId) --> TrackedPacket
-    typedef std::map<std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+    typedef FlowHashTable<std::pair<FlowId, FlowPacketId>, TrackedPacket, TrackedPacketKeyHash>
+        TrackedPacketMap;
     TrackedPacketMap m_trackedPackets; //!< Tracked packets
     Time m_maxPerHopDelay;             //!< Minimum per-hop delay
     FlowProbeContainer m_flowProbes;   //!< all the FlowProbes
+    uint32_t m_maxTrackedPackets;      //!< Maximum number of tracked packets (0: no limit)
+    uint32_t m_samplingInterval;       //!< Track one in m_samplingInterval packets of a flow
+    uint64_t m_evictedPackets;         //!< Number of tracked packets evicted
 
     // note: this is needed only for serialization
     std::list<Ptr<FlowClassifier>> m_classifiers; //!< the FlowClassifiers
@@ -316,6 +352,11 @@ class FlowMonitor : public Object
     /// \returns the stats of the flow
     FlowStats& GetStatsForFlow(FlowId flowId);
 
+    /// Check if a packet is sampled, i.e., if its delay is measured
+    /// \param packetId the packet identification
+    /// \returns true if the packet is sampled
+    bool IsSampled(FlowPacketId packetId) const;
+
     /// Periodic function to check for lost packets and prune statistics
     void PeriodicCheckForLostPackets();
 };
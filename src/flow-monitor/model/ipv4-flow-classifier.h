@@ -21,11 +21,12 @@
 #define IPV4_FLOW_CLASSIFIER_H
 
 #include "flow-classifier.h"
+#include "flow-hash-table.h"
 
 #include "ns3/ipv4-header.h"
 
-#include <map>
 #include <stdint.h>
+#include <vector>
 
 namespace ns3
 {
@@ -49,6 +50,14 @@ class Ipv4FlowClassifier : public FlowClassifier
         uint16_t destinationPort;       //!< Destination port
     };
 
+    /// Hash of the FiveTuple structure
+    struct FiveTupleHash
+    {
+        /// \param tuple the five-tuple
+        /// \return the hash of the five-tuple
+        std::size_t operator()(const FiveTuple& tuple) const;
+    };
+
     Ipv4FlowClassifier();
 
     /// \brief try to classify the packet into flow-id and packet-id
@@ -93,12 +102,20 @@ class Ipv4FlowClassifier : public FlowClassifier
     void SerializeToXmlStream(std::ostream& os, uint16_t indent) const override;
 
   private:
-    /// Map to Flows Identifiers to FlowIds
-    std::map<FiveTuple, FlowId> m_flowMap;
-    /// Map to FlowIds to FlowPacketId
-    std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-    /// Map FlowIds to (DSCP value, packet count) pairs
-    std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t>> m_flowDscpMap;
+    /// Information about a flow
+    struct FlowInfo
+    {
+        FiveTuple tuple;             //!< the five-tuple of the flow
+        FlowPacketId lastPacketId;   //!< the identifier of the last packet of the flow
+        /// (DSCP value, packet count) pairs, sorted by DSCP value
+        std::vector<std::pair<Ipv4Header::DscpType, uint32_t>> dscpCounts;
+    };
+
+    /// Map Flows Identifiers to FlowIds
+    FlowHashTable<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+    /// Information of the flows, the flow with FlowId i being at index i - 1,
+    /// since the FlowIds are allocated sequentially from 1
+    std::vector<FlowInfo> m_flows;
 };
 
 /**
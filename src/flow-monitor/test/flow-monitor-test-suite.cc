@@ -0,0 +1,456 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/flow-hash-table.h"
+#include "ns3/flow-monitor-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/ipv4-flow-classifier.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/socket-factory.h"
+#include "ns3/socket.h"
+#include "ns3/test.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \defgroup flow-monitor-tests Tests for flow-monitor
+ * \ingroup flow-monitor
+ * \ingroup tests
+ */
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Compare the FlowHashTable with a std::map under random operations
+ */
+class FlowHashTableTestCase : public TestCase
+{
+  public:
+    FlowHashTableTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// Hash functor used by the test
+    struct Hash
+    {
+        /// \param key the key
+        /// \return the hash of the key
+        std::size_t operator()(uint32_t key) const
+        {
+            // a poor hash, to exercise the collisions and the wrap-around
+            return key % 7;
+        }
+    };
+};
+
+FlowHashTableTestCase::FlowHashTableTestCase()
+    : TestCase("Check the flow hash table against a std::map")
+{
+}
+
+void
+FlowHashTableTestCase::DoRun()
+{
+    FlowHashTable<uint32_t, uint32_t, Hash> table;
+    std::map<uint32_t, uint32_t> reference;
+    std::mt19937 rng(1);
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        uint32_t key = rng() % 500;
+        switch (rng() % 3)
+        {
+        case 0: {
+            auto inserted = table.Insert(key, i);
+            bool expected = reference.insert(std::make_pair(key, i)).second;
+            NS_TEST_ASSERT_MSG_EQ(inserted.second, expected, "Wrong insertion of key " << key);
+            NS_TEST_ASSERT_MSG_EQ(*inserted.first, reference[key], "Wrong value of key " << key);
+            break;
+        }
+        case 1: {
+            bool erased = table.Erase(key);
+            bool expected = (reference.erase(key) == 1);
+            NS_TEST_ASSERT_MSG_EQ(erased, expected, "Wrong erasure of " << key);
+            break;
+        }
+        default: {
+            const uint32_t* value = table.Find(key);
+            auto it = reference.find(key);
+            bool found = (value != nullptr);
+            NS_TEST_ASSERT_MSG_EQ(found, (it != reference.end()), "Wrong lookup");
+            if (value != nullptr)
+            {
+                NS_TEST_ASSERT_MSG_EQ(*value, it->second, "Wrong value of key " << key);
+            }
+        }
+        }
+        NS_TEST_ASSERT_MSG_EQ(table.GetSize(), reference.size(), "Wrong size");
+
+        if (i % 1000 == 999)
+        {
+            // erase the entries with an odd value
+            std::size_t erased =
+                table.EraseIf([](uint32_t, uint32_t value) { return value % 2 == 1; });
+            std::size_t expected = 0;
+            for (auto it = reference.begin(); it != reference.end();)
+            {
+                if (it->second % 2 == 1)
+                {
+                    it = reference.erase(it);
+                    expected++;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            NS_TEST_ASSERT_MSG_EQ(erased, expected, "Wrong number of erased entries");
+            std::size_t count = 0;
+            table.ForEach([&](uint32_t key, uint32_t value) {
+                NS_TEST_EXPECT_MSG_EQ(reference.count(key), 1, "Unexpected key " << key);
+                NS_TEST_EXPECT_MSG_EQ(value % 2, 0, "Entry " << key << " not erased");
+                count++;
+            });
+            NS_TEST_ASSERT_MSG_EQ(count, reference.size(), "Wrong number of entries");
+        }
+    }
+
+    // evict the entries with the lowest values, one at a time
+    while (table.GetSize() > 0)
+    {
+        std::pair<uint32_t, uint32_t> victim;
+        bool evicted = table.EvictNear(
+            0,
+            table.GetSize(),
+            [](uint32_t a, uint32_t b) { return a < b; },
+            victim);
+        NS_TEST_ASSERT_MSG_EQ(evicted, true, "Nothing evicted");
+        auto lowest = reference.begin();
+        for (auto it = reference.begin(); it != reference.end(); ++it)
+        {
+            if (it->second < lowest->second)
+            {
+                lowest = it;
+            }
+        }
+        NS_TEST_ASSERT_MSG_EQ(victim.first, lowest->first, "Wrong entry evicted");
+        reference.erase(lowest);
+        NS_TEST_ASSERT_MSG_EQ(table.Find(victim.first), nullptr, "Evicted entry still present");
+    }
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Check the flow statistics with packet sampling and a limited
+ * number of tracked packets
+ *
+ * A node sends UDP packets at a constant rate to another one over a
+ * channel with a constant delay, so that all the packets have the same
+ * delay.
+ */
+class FlowMonitorTrackingTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     * \param samplingInterval the PacketSamplingInterval attribute
+     * \param maxTrackedPackets the MaxTrackedPackets attribute
+     */
+    FlowMonitorTrackingTestCase(uint32_t samplingInterval, uint32_t maxTrackedPackets);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a packet
+     * \param socket the socket
+     * \param remaining the number of packets still to send
+     */
+    void Send(Ptr<Socket> socket, uint32_t remaining);
+
+    uint32_t m_samplingInterval;  ///< the PacketSamplingInterval attribute
+    uint32_t m_maxTrackedPackets; ///< the MaxTrackedPackets attribute
+};
+
+FlowMonitorTrackingTestCase::FlowMonitorTrackingTestCase(uint32_t samplingInterval,
+                                                         uint32_t maxTrackedPackets)
+    : TestCase("Check the flow statistics with sampling interval " +
+               std::to_string(samplingInterval) + " and at most " +
+               std::to_string(maxTrackedPackets) + " tracked packets"),
+      m_samplingInterval(samplingInterval),
+      m_maxTrackedPackets(maxTrackedPackets)
+{
+}
+
+void
+FlowMonitorTrackingTestCase::Send(Ptr<Socket> socket, uint32_t remaining)
+{
+    socket->Send(Create<Packet>(100));
+    if (remaining > 1)
+    {
+        Simulator::Schedule(MilliSeconds(1),
+                            &FlowMonitorTrackingTestCase::Send,
+                            this,
+                            socket,
+                            remaining - 1);
+    }
+}
+
+void
+FlowMonitorTrackingTestCase::DoRun()
+{
+    const uint32_t nPackets = 200;
+    const Time delay = MilliSeconds(50);
+
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(delay));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    Ptr<Socket> rxSocket = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    Ptr<Socket> txSocket = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    txSocket->Connect(InetSocketAddress(interfaces.GetAddress(1), 9));
+
+    FlowMonitorHelper flowmonHelper;
+    flowmonHelper.SetMonitorAttribute("PacketSamplingInterval", UintegerValue(m_samplingInterval));
+    flowmonHelper.SetMonitorAttribute("MaxTrackedPackets", UintegerValue(m_maxTrackedPackets));
+    Ptr<FlowMonitor> monitor = flowmonHelper.InstallAll();
+
+    // the ARP resolution delays the first packet, so start with a packet
+    // which is not accounted for in the delay checks
+    Simulator::Schedule(Seconds(1), &FlowMonitorTrackingTestCase::Send, this, txSocket, 1);
+    Simulator::Schedule(Seconds(2),
+                        &FlowMonitorTrackingTestCase::Send,
+                        this,
+                        txSocket,
+                        nPackets);
+    Simulator::Stop(Seconds(4));
+    Simulator::Run();
+
+    const FlowMonitor::FlowStatsContainer& stats = monitor->GetFlowStats();
+    NS_TEST_ASSERT_MSG_EQ(stats.size(), 1, "Wrong number of flows");
+    const FlowMonitor::FlowStats& flow = stats.begin()->second;
+    NS_TEST_ASSERT_MSG_EQ(flow.txPackets, nPackets + 1, "Wrong number of transmitted packets");
+    NS_TEST_ASSERT_MSG_EQ(monitor->GetNumTrackedPackets(), 0, "Packets still tracked");
+    if (m_maxTrackedPackets == 0)
+    {
+        NS_TEST_ASSERT_MSG_EQ(monitor->GetNumEvictedPackets(), 0, "Unexpected evictions");
+        NS_TEST_ASSERT_MSG_EQ(flow.rxPackets, nPackets + 1, "Wrong number of received packets");
+        NS_TEST_ASSERT_MSG_EQ(flow.lostPackets, 0, "Unexpected losses");
+        // all the packets but the first one have the same delay, and the first
+        // packet, which waited for the ARP resolution, is sampled
+        Time firstDelay = (flow.delaySum - delay * (nPackets / m_samplingInterval) *
+                                               m_samplingInterval) /
+                          m_samplingInterval;
+        NS_TEST_ASSERT_MSG_EQ((firstDelay >= delay && firstDelay <= delay * 4),
+                              true,
+                              "Wrong delay sum " << flow.delaySum.As(Time::MS));
+    }
+    else
+    {
+        // 50 packets are in flight, the oldest ones are evicted and counted as lost
+        NS_TEST_ASSERT_MSG_GT(monitor->GetNumEvictedPackets(), 0, "No evictions");
+        NS_TEST_ASSERT_MSG_EQ(flow.rxPackets + flow.lostPackets,
+                              flow.txPackets,
+                              "Received and lost packets do not add up");
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Check that the sums of the periodic snapshots are the final statistics
+ */
+class FlowMonitorSnapshotTestCase : public TestCase
+{
+  public:
+    FlowMonitorSnapshotTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Send a packet
+     * \param socket the socket
+     * \param remaining the number of packets still to send
+     */
+    void Send(Ptr<Socket> socket, uint32_t remaining);
+};
+
+FlowMonitorSnapshotTestCase::FlowMonitorSnapshotTestCase()
+    : TestCase("Check the sums of the periodic snapshots")
+{
+}
+
+void
+FlowMonitorSnapshotTestCase::Send(Ptr<Socket> socket, uint32_t remaining)
+{
+    socket->Send(Create<Packet>(100 + remaining % 7));
+    if (remaining > 1)
+    {
+        Simulator::Schedule(MilliSeconds(1),
+                            &FlowMonitorSnapshotTestCase::Send,
+                            this,
+                            socket,
+                            remaining - 1);
+    }
+}
+
+void
+FlowMonitorSnapshotTestCase::DoRun()
+{
+    NodeContainer nodes;
+    nodes.Create(2);
+    SimpleNetDeviceHelper simpleHelper;
+    simpleHelper.SetChannelAttribute("Delay", TimeValue(MilliSeconds(20)));
+    NetDeviceContainer devices = simpleHelper.Install(nodes);
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv4AddressHelper ipv4;
+    ipv4.SetBase("10.0.0.0", "255.255.255.0");
+    Ipv4InterfaceContainer interfaces = ipv4.Assign(devices);
+
+    Ptr<Socket> rxSocket = Socket::CreateSocket(nodes.Get(1), UdpSocketFactory::GetTypeId());
+    rxSocket->Bind(InetSocketAddress(Ipv4Address::GetAny(), 9));
+    Ptr<Socket> txSocket = Socket::CreateSocket(nodes.Get(0), UdpSocketFactory::GetTypeId());
+    txSocket->Connect(InetSocketAddress(interfaces.GetAddress(1), 9));
+
+    FlowMonitorHelper flowmonHelper;
+    Ptr<FlowMonitor> monitor = flowmonHelper.InstallAll();
+    std::string fileName = CreateTempDirFilename("flowmon-snapshots.csv");
+    Ptr<FlowMonitorSnapshotExporter> exporter =
+        flowmonHelper.EnableSnapshots(fileName, MilliSeconds(30));
+
+    Simulator::Schedule(Seconds(1), &FlowMonitorSnapshotTestCase::Send, this, txSocket, 300);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+    exporter->Stop();
+
+    int64_t txPackets = 0;
+    int64_t rxPackets = 0;
+    int64_t rxBytes = 0;
+    int64_t delaySum = 0;
+    int64_t delayCount = 0;
+    uint32_t nSnapshots = 0;
+    uint32_t nClassifierLines = 0;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields(line);
+        std::string kind;
+        std::getline(fields, kind, ',');
+        std::vector<std::string> values;
+        std::string value;
+        while (std::getline(fields, value, ','))
+        {
+            values.push_back(value);
+        }
+        if (kind == "F")
+        {
+            nSnapshots++;
+            rxBytes += std::stoll(values[3]);
+            txPackets += std::stoll(values[4]);
+            rxPackets += std::stoll(values[5]);
+            delaySum += std::stoll(values[9]);
+        }
+        else if (kind == "H" && values[2] == "delay")
+        {
+            delayCount += std::stoll(values[5]);
+        }
+        else if (kind == "X")
+        {
+            nClassifierLines++;
+        }
+    }
+
+    const FlowMonitor::FlowStats& flow = monitor->GetFlowStats().begin()->second;
+    NS_TEST_ASSERT_MSG_GT(nSnapshots, 5, "Too few snapshots");
+    NS_TEST_ASSERT_MSG_GT(nClassifierLines, 0, "No description of the flows");
+    NS_TEST_ASSERT_MSG_EQ(txPackets, flow.txPackets, "Wrong sum of the transmitted packets");
+    NS_TEST_ASSERT_MSG_EQ(rxPackets, flow.rxPackets, "Wrong sum of the received packets");
+    NS_TEST_ASSERT_MSG_EQ(rxBytes,
+                          static_cast<int64_t>(flow.rxBytes),
+                          "Wrong sum of the received bytes");
+    NS_TEST_ASSERT_MSG_EQ(delaySum, flow.delaySum.GetNanoSeconds(), "Wrong sum of the delays");
+    NS_TEST_ASSERT_MSG_EQ(delayCount, flow.rxPackets, "Wrong sum of the delay histogram");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup flow-monitor-tests
+ *
+ * \brief Flow monitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+  public:
+    FlowMonitorTestSuite();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite()
+    : TestSuite("flow-monitor", UNIT)
+{
+    AddTestCase(new FlowHashTableTestCase, TestCase::QUICK);
+    AddTestCase(new FlowMonitorTrackingTestCase(1, 0), TestCase::QUICK);
+    AddTestCase(new FlowMonitorTrackingTestCase(4, 0), TestCase::QUICK);
+    AddTestCase(new FlowMonitorTrackingTestCase(1, 10), TestCase::QUICK);
+    AddTestCase(new FlowMonitorSnapshotTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
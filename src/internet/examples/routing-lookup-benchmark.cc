@@ -0,0 +1,313 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/network-module.h"
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup internet
+ *
+ * Benchmark of the unicast route lookups of Ipv4StaticRouting,
+ * Ipv4GlobalRouting and Ipv6StaticRouting.
+ *
+ * For each size of routing table, the program fills the tables with random
+ * routes resembling those of a gateway of a large network: half of them are
+ * host routes, e.g., towards UEs, and the others are routes to networks of
+ * 8 to 24 bits. It then measures the rate of route lookups towards random
+ * destinations covered by the routes, through RouteOutput. As a reference,
+ * the IPv4 static routes are also searched linearly, as done before the
+ * routes were indexed by prefix, e.g.:
+ *
+ * \code
+ *   ./ns3 run "routing-lookup-benchmark --routes=100,1000,10000 --lookups=100000"
+ * \endcode
+ */
+
+NS_LOG_COMPONENT_DEFINE("RoutingLookupBenchmark");
+
+/**
+ * Parse a comma separated list of unsigned integers.
+ *
+ * \param list the list
+ * \return the values of the list
+ */
+static std::vector<uint32_t>
+ParseList(std::string list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Create a node with two interfaces, on 10.0.0.0/16 and 10.1.0.0/16, and on
+ * 2001:0::/64 and 2001:1::/64.
+ *
+ * \return the node
+ */
+static Ptr<Node>
+CreateRouter()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    Ptr<Ipv6> ipv6 = node->GetObject<Ipv6>();
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        int32_t ifIndex = ipv4->AddInterface(device);
+        ipv4->AddAddress(ifIndex,
+                         Ipv4InterfaceAddress(Ipv4Address(0x0a000001 + (i << 16)), "/16"));
+        ipv4->SetUp(ifIndex);
+        ifIndex = ipv6->AddInterface(device);
+        std::ostringstream address;
+        address << "2001:" << i << "::1";
+        ipv6->AddAddress(ifIndex,
+                         Ipv6InterfaceAddress(Ipv6Address(address.str().c_str()), Ipv6Prefix(64)));
+        ipv6->SetUp(ifIndex);
+    }
+    return node;
+}
+
+/**
+ * Time the lookups of a routing protocol and print the rate of lookups.
+ *
+ * \tparam R the type of the routing protocol
+ * \tparam H the type of the IP header
+ * \tparam A the type of the addresses
+ * \param name the name of the routing protocol
+ * \param nRoutes the number of routes of the table
+ * \param routing the routing protocol
+ * \param destinations the destinations of the lookups
+ */
+template <typename R, typename H, typename A>
+static void
+TimeLookups(std::string name, uint32_t nRoutes, Ptr<R> routing, const std::vector<A>& destinations)
+{
+    Ptr<Packet> packet = Create<Packet>();
+    H header;
+    Socket::SocketErrno sockerr;
+    uint32_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& destination : destinations)
+    {
+        header.SetDestination(destination);
+        found += bool(routing->RouteOutput(packet, header, nullptr, sockerr));
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << nRoutes << "\t" << name << "\t" << std::fixed << std::setprecision(0)
+              << destinations.size() / s << "\t" << found << std::defaultfloat << std::endl;
+}
+
+/**
+ * Time a linear search of IPv4 static routes, as done by Ipv4StaticRouting
+ * before its routes were indexed by prefix, and print the rate of lookups.
+ *
+ * \param nRoutes the number of routes of the table
+ * \param routing the routing protocol holding the routes
+ * \param destinations the destinations of the lookups
+ */
+static void
+TimeLinearLookups(uint32_t nRoutes,
+                  Ptr<Ipv4StaticRouting> routing,
+                  const std::vector<Ipv4Address>& destinations)
+{
+    std::list<std::pair<Ipv4RoutingTableEntry, uint32_t>> routes;
+    for (uint32_t i = 0; i < routing->GetNRoutes(); ++i)
+    {
+        routes.emplace_back(routing->GetRoute(i), routing->GetMetric(i));
+    }
+    uint32_t found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& destination : destinations)
+    {
+        const Ipv4RoutingTableEntry* selected = nullptr;
+        uint16_t longestMask = 0;
+        uint32_t shortestMetric = 0xffffffff;
+        for (const auto& [route, metric] : routes)
+        {
+            Ipv4Mask mask = route.GetDestNetworkMask();
+            uint16_t masklen = mask.GetPrefixLength();
+            if (!mask.IsMatch(destination, route.GetDestNetwork()) || masklen < longestMask)
+            {
+                continue;
+            }
+            if (masklen > longestMask)
+            {
+                shortestMetric = 0xffffffff;
+            }
+            longestMask = masklen;
+            if (metric > shortestMetric)
+            {
+                continue;
+            }
+            shortestMetric = metric;
+            selected = &route;
+            if (masklen == 32)
+            {
+                break;
+            }
+        }
+        found += (selected != nullptr);
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << nRoutes << "\tipv4-static-linear\t" << std::fixed << std::setprecision(0)
+              << destinations.size() / s << "\t" << found << std::defaultfloat << std::endl;
+}
+
+/**
+ * Fill the routing tables with random routes and time the lookups.
+ *
+ * \param nRoutes the number of routes
+ * \param nLookups the number of lookups
+ * \param linear whether to time a linear search of the IPv4 static routes
+ */
+static void
+Run(uint32_t nRoutes, uint32_t nLookups, bool linear)
+{
+    Ptr<Node> node = CreateRouter();
+    Ptr<Ipv4StaticRouting> ipv4Static = CreateObject<Ipv4StaticRouting>();
+    ipv4Static->SetIpv4(node->GetObject<Ipv4>());
+    Ptr<Ipv4GlobalRouting> ipv4Global = CreateObject<Ipv4GlobalRouting>();
+    ipv4Global->SetIpv4(node->GetObject<Ipv4>());
+    Ptr<Ipv6StaticRouting> ipv6Static = CreateObject<Ipv6StaticRouting>();
+    ipv6Static->SetIpv6(node->GetObject<Ipv6>());
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::vector<Ipv4Address> prefixes4;
+    std::vector<Ipv6Address> prefixes6;
+    for (uint32_t i = 0; i < nRoutes; ++i)
+    {
+        // the routes are spread over 20.0.0.0/8 to 59.0.0.0/8, and the
+        // corresponding IPv6 prefixes of 2001:db8::/32
+        uint32_t address = ((20 + rng->GetInteger(0, 39)) << 24) | rng->GetInteger(0, 0xffffff);
+        uint32_t length = (i % 2 == 0) ? 32 : 8 * rng->GetInteger(1, 3);
+        Ipv4Mask mask(~0U << (32 - length));
+        Ipv4Address network = Ipv4Address(address).CombineMask(mask);
+        Ipv4Address gateway(0x0a000002 + (rng->GetInteger(0, 1) << 16));
+        uint32_t interface = (gateway.Get() >> 16 & 1) + 1;
+        uint8_t bytes[16] = {0x20, 0x01, 0x0d, 0xb8};
+        network.Serialize(bytes + 4);
+        Ipv6Address network6(bytes);
+        Ipv6Prefix prefix6(32 + length);
+        std::ostringstream gateway6;
+        gateway6 << "2001:" << interface - 1 << "::2";
+        if (length == 32)
+        {
+            ipv4Static->AddHostRouteTo(network, gateway, interface);
+            ipv4Global->AddHostRouteTo(network, gateway, interface);
+        }
+        else
+        {
+            ipv4Static->AddNetworkRouteTo(network, mask, gateway, interface);
+            ipv4Global->AddNetworkRouteTo(network, mask, gateway, interface);
+        }
+        ipv6Static->AddNetworkRouteTo(network6,
+                                      prefix6,
+                                      Ipv6Address(gateway6.str().c_str()),
+                                      interface);
+        prefixes4.push_back(network);
+        prefixes6.push_back(network6);
+    }
+
+    // the destinations are in the prefixes of the routes, with random host bits
+    std::vector<Ipv4Address> destinations4;
+    std::vector<Ipv6Address> destinations6;
+    for (uint32_t i = 0; i < nLookups; ++i)
+    {
+        uint32_t index = rng->GetInteger(0, nRoutes - 1);
+        uint32_t host = (index % 2 == 0) ? 0 : rng->GetInteger(0, 0xff);
+        destinations4.emplace_back(prefixes4[index].Get() | host);
+        uint8_t bytes[16];
+        prefixes6[index].Serialize(bytes);
+        bytes[15] |= host;
+        destinations6.emplace_back(bytes);
+    }
+
+    TimeLookups<Ipv4StaticRouting, Ipv4Header>("ipv4-static", nRoutes, ipv4Static, destinations4);
+    if (linear)
+    {
+        TimeLinearLookups(nRoutes, ipv4Static, destinations4);
+    }
+    TimeLookups<Ipv4GlobalRouting, Ipv4Header>("ipv4-global", nRoutes, ipv4Global, destinations4);
+    TimeLookups<Ipv6StaticRouting, Ipv6Header>("ipv6-static", nRoutes, ipv6Static, destinations6);
+
+    ipv4Static->Dispose();
+    ipv4Global->Dispose();
+    ipv6Static->Dispose();
+    Simulator::Destroy();
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string routes = "100,1000,10000";
+    uint32_t lookups = 100000;
+    bool linear = true;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("routes", "Comma separated numbers of routes", routes);
+    cmd.AddValue("lookups", "The number of lookups of each routing protocol", lookups);
+    cmd.AddValue("linear", "Time a linear search of the IPv4 static routes", linear);
+    cmd.Parse(argc, argv);
+
+    std::cout << "routes\tprotocol\tlookups/s\tfound" << std::endl;
+    for (uint32_t nRoutes : ParseList(routes))
+    {
+        Run(nRoutes, lookups, linear);
+    }
+    return 0;
+}
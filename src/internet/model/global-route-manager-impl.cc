@@ -30,13 +30,18 @@
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
+#include "ns3/global-value.h"
 #include "ns3/log.h"
 #include "ns3/node-list.h"
 #include "ns3/simulator.h"
+#include "ns3/system-wall-clock-ms.h"
+#include "ns3/uinteger.h"
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <queue>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -45,6 +50,19 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("GlobalRouteManagerImpl");
 
+/**
+ * \ingroup globalrouting
+ * \anchor GlobalValueGlobalRoutingSPFThreads
+ * \brief The number of threads sharing the SPF calculations of the routers.
+ */
+static GlobalValue g_spfThreads =
+    GlobalValue("GlobalRoutingSPFThreads",
+                "The number of threads sharing the SPF calculations of the global routing. "
+                "0 means one thread per hardware thread. The log messages of the "
+                "calculations are interleaved when more than one thread runs them.",
+                UintegerValue(1),
+                MakeUintegerChecker<uint32_t>());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -469,9 +487,26 @@ GlobalRouteManagerLSDB::Insert(Ipv4Address addr, GlobalRoutingLSA* lsa)
     {
         m_extdatabase.push_back(lsa);
     }
-    else
+    else if (m_database.insert(LSDBPair_t(addr, lsa)).second)
     {
-        m_database.insert(LSDBPair_t(addr, lsa));
+        //
+        // Index the LSA by the link data of its transit network link records.
+        // When several LSAs have the same link data, GetLSAByLinkData () returns
+        // the first one of the database, i.e., the one with the lowest address.
+        //
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                continue;
+            }
+            auto it = m_linkDataLSAs.emplace(lr->GetLinkData(), lsa).first;
+            if (addr < it->second->GetLinkStateId())
+            {
+                it->second = lsa;
+            }
+        }
     }
 }
 
@@ -496,12 +531,10 @@ GlobalRouteManagerLSDB::GetLSA(Ipv4Address addr) const
     //
     // Look up an LSA by its address.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_database.find(addr);
+    if (i != m_database.end())
     {
-        if (i->first == addr)
-        {
-            return i->second;
-        }
+        return i->second;
     }
     return nullptr;
 }
@@ -511,23 +544,180 @@ GlobalRouteManagerLSDB::GetLSAByLinkData(Ipv4Address addr) const
 {
     NS_LOG_FUNCTION(this << addr);
     //
-    // Look up an LSA by its address.
+    // Look up an LSA by the link data of its transit network link records.
     //
-    for (auto i = m_database.begin(); i != m_database.end(); i++)
+    auto i = m_linkDataLSAs.find(addr);
+    if (i != m_linkDataLSAs.end())
     {
-        GlobalRoutingLSA* temp = i->second;
-        // Iterate among temp's Link Records
-        for (uint32_t j = 0; j < temp->GetNLinkRecords(); j++)
+        return i->second;
+    }
+    return nullptr;
+}
+
+GlobalRouteManagerLSDB*
+GlobalRouteManagerLSDB::Copy() const
+{
+    NS_LOG_FUNCTION(this);
+    auto lsdb = new GlobalRouteManagerLSDB();
+    for (const auto& [addr, lsa] : m_database)
+    {
+        lsdb->Insert(addr, new GlobalRoutingLSA(*lsa));
+    }
+    for (GlobalRoutingLSA* lsa : m_extdatabase)
+    {
+        lsdb->Insert(lsa->GetLinkStateId(), new GlobalRoutingLSA(*lsa));
+    }
+    return lsdb;
+}
+
+/**
+ * \brief Compare the contents of two Link State Advertisements.
+ *
+ * \param a the first LSA
+ * \param b the second LSA
+ * \returns true if the LSAs are identical, apart from their SPF status
+ */
+static bool
+IsSameLSA(const GlobalRoutingLSA* a, const GlobalRoutingLSA* b)
+{
+    if (a->GetLSType() != b->GetLSType() || a->GetLinkStateId() != b->GetLinkStateId() ||
+        a->GetAdvertisingRouter() != b->GetAdvertisingRouter() ||
+        a->GetNetworkLSANetworkMask() != b->GetNetworkLSANetworkMask() ||
+        a->GetNLinkRecords() != b->GetNLinkRecords() ||
+        a->GetNAttachedRouters() != b->GetNAttachedRouters())
+    {
+        return false;
+    }
+    for (uint32_t j = 0; j < a->GetNLinkRecords(); j++)
+    {
+        const GlobalRoutingLinkRecord* la = a->GetLinkRecord(j);
+        const GlobalRoutingLinkRecord* lb = b->GetLinkRecord(j);
+        if (la->GetLinkType() != lb->GetLinkType() || la->GetLinkId() != lb->GetLinkId() ||
+            la->GetLinkData() != lb->GetLinkData() || la->GetMetric() != lb->GetMetric())
+        {
+            return false;
+        }
+    }
+    for (uint32_t j = 0; j < a->GetNAttachedRouters(); j++)
+    {
+        if (a->GetAttachedRouter(j) != b->GetAttachedRouter(j))
         {
-            GlobalRoutingLinkRecord* lr = temp->GetLinkRecord(j);
-            if (lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork &&
-                lr->GetLinkData() == addr)
+            return false;
+        }
+    }
+    return true;
+}
+
+std::set<Ipv4Address>
+GlobalRouteManagerLSDB::GetChangedLSAs(const GlobalRouteManagerLSDB& other) const
+{
+    NS_LOG_FUNCTION(this << &other);
+    std::set<Ipv4Address> changed;
+    //
+    // Both databases are sorted by address: walk them together.
+    //
+    auto i = m_database.begin();
+    auto j = other.m_database.begin();
+    while (i != m_database.end() || j != other.m_database.end())
+    {
+        if (j == other.m_database.end() || (i != m_database.end() && i->first < j->first))
+        {
+            changed.insert(i->first);
+            i++;
+        }
+        else if (i == m_database.end() || j->first < i->first)
+        {
+            changed.insert(j->first);
+            j++;
+        }
+        else
+        {
+            if (!IsSameLSA(i->second, j->second))
             {
-                return temp;
+                changed.insert(i->first);
             }
+            i++;
+            j++;
         }
     }
-    return nullptr;
+    NS_LOG_LOGIC(changed.size() << " LSAs changed");
+    return changed;
+}
+
+bool
+GlobalRouteManagerLSDB::GetChangedExtLSAs(const GlobalRouteManagerLSDB& other) const
+{
+    NS_LOG_FUNCTION(this << &other);
+    if (m_extdatabase.size() != other.m_extdatabase.size())
+    {
+        return true;
+    }
+    for (std::size_t j = 0; j < m_extdatabase.size(); j++)
+    {
+        if (!IsSameLSA(m_extdatabase[j], other.m_extdatabase[j]))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::set<Ipv4Address>
+GlobalRouteManagerLSDB::GetConnectedLSAs(const std::set<Ipv4Address>& lsas) const
+{
+    NS_LOG_FUNCTION(this << lsas.size());
+    //
+    // Build the undirected graph of the LSAs, with the same edges as the ones
+    // followed by SPFNext () and CheckForStubNode ().
+    //
+    std::unordered_map<Ipv4Address, std::vector<Ipv4Address>, Ipv4AddressHash> neighbors;
+    auto addEdge = [&neighbors](Ipv4Address a, Ipv4Address b) {
+        neighbors[a].push_back(b);
+        neighbors[b].push_back(a);
+    };
+    for (const auto& [addr, lsa] : m_database)
+    {
+        for (uint32_t j = 0; j < lsa->GetNLinkRecords(); j++)
+        {
+            GlobalRoutingLinkRecord* lr = lsa->GetLinkRecord(j);
+            if (lr->GetLinkType() == GlobalRoutingLinkRecord::PointToPoint ||
+                lr->GetLinkType() == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+                addEdge(addr, lr->GetLinkId());
+            }
+        }
+        for (uint32_t j = 0; j < lsa->GetNAttachedRouters(); j++)
+        {
+            GlobalRoutingLSA* w_lsa = GetLSAByLinkData(lsa->GetAttachedRouter(j));
+            if (w_lsa)
+            {
+                addEdge(addr, w_lsa->GetLinkStateId());
+            }
+        }
+    }
+    //
+    // Visit the graph from the given LSAs.
+    //
+    std::set<Ipv4Address> connected(lsas);
+    std::vector<Ipv4Address> toVisit(lsas.begin(), lsas.end());
+    while (!toVisit.empty())
+    {
+        Ipv4Address addr = toVisit.back();
+        toVisit.pop_back();
+        auto it = neighbors.find(addr);
+        if (it == neighbors.end())
+        {
+            continue;
+        }
+        for (const auto& neighbor : it->second)
+        {
+            if (connected.insert(neighbor).second)
+            {
+                toVisit.push_back(neighbor);
+            }
+        }
+    }
+    return connected;
 }
 
 // ---------------------------------------------------------------------------
@@ -30,7 +30,9 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <set>
 #include <stdint.h>
+#include <unordered_map>
 #include <vector>
 
 namespace ns3
@@ -40,6 +42,7 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -672,15 +675,64 @@ class GlobalRouteManagerLSDB
      */
     uint32_t GetNumExtLSAs() const;
 
+    /**
+     * @brief Copy the Link State Advertisements of this database.
+     *
+     * The copy has its own LSAs, so that an SPF calculation can run on it
+     * concurrently with the calculations run on this database.
+     *
+     * @returns a new database, owned by the caller
+     */
+    GlobalRouteManagerLSDB* Copy() const;
+
+    /**
+     * @brief Compare the Link State Advertisements with the ones of another
+     * database.
+     *
+     * The SPF status of the LSAs is not compared.  The External LSAs are
+     * compared by GetChangedExtLSAs ().
+     *
+     * @param other the other database
+     * @returns the link state IDs of the LSAs that are in only one of the
+     * databases, or that have different contents in the two databases
+     */
+    std::set<Ipv4Address> GetChangedLSAs(const GlobalRouteManagerLSDB& other) const;
+
+    /**
+     * @brief Compare the External Link State Advertisements with the ones of
+     * another database.
+     *
+     * @param other the other database
+     * @returns true if the External LSAs of the two databases differ
+     */
+    bool GetChangedExtLSAs(const GlobalRouteManagerLSDB& other) const;
+
+    /**
+     * @brief Find the Link State Advertisements connected to the given ones.
+     *
+     * The LSAs are the vertices of a graph whose edges are the point-to-point
+     * and transit network link records of the Router-LSAs and the attached
+     * routers of the Network-LSAs, regardless of their direction.  The SPF
+     * calculation rooted at a router only reads the LSAs connected to it.
+     *
+     * @param lsas the link state IDs of the LSAs to start from
+     * @returns the link state IDs of the given LSAs and of all the LSAs
+     * connected to them
+     */
+    std::set<Ipv4Address> GetConnectedLSAs(const std::set<Ipv4Address>& lsas) const;
+
   private:
     typedef std::map<Ipv4Address, GlobalRoutingLSA*>
         LSDBMap_t; //!< container of IPv4 addresses / Link State Advertisements
     typedef std::pair<Ipv4Address, GlobalRoutingLSA*>
         LSDBPair_t; //!< pair of IPv4 addresses / Link State Advertisements
+    /// container of the LSAs indexed by the link data of their transit network link records
+    typedef std::unordered_map<Ipv4Address, GlobalRoutingLSA*, Ipv4AddressHash> LinkDataMap_t;
 
     LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
     std::vector<GlobalRoutingLSA*>
-        m_extdatabase; //!< database of External Link State Advertisements
+        m_extdatabase;            //!< database of External Link State Advertisements
+    LinkDataMap_t m_linkDataLSAs; //!< index of m_database used by GetLSAByLinkData ()
 };
 
 /**
@@ -725,6 +777,40 @@ class GlobalRouteManagerImpl
      */
     virtual void InitializeRoutes();
 
+    /**
+     * @brief Recompute the routes after a change of the topology.
+     *
+     * The routing database is built again and compared with the one of the
+     * previous route computation.  Only the routers connected to a Link State
+     * Advertisement that changed have their routes deleted and their SPF tree
+     * calculated again: the other routers keep their routing tables, which
+     * the SPF calculation would fill with the same routes.  All the routers
+     * are calculated again when the External LSAs changed.
+     */
+    virtual void RecomputeRoutingTables();
+
+    /**
+     * @brief Get the wall-clock time spent by the last build of the routing
+     * database, including the comparison with the previous database made by
+     * RecomputeRoutingTables ().
+     * @returns the duration in milliseconds
+     */
+    int64_t GetBuildDuration() const;
+
+    /**
+     * @brief Get the wall-clock time spent by the last SPF calculations,
+     * including the update of the routing tables.
+     * @returns the duration in milliseconds
+     */
+    int64_t GetSPFDuration() const;
+
+    /**
+     * @brief Get the number of routers whose SPF tree was calculated by the
+     * last call to InitializeRoutes () or RecomputeRoutingTables ().
+     * @returns the number of SPF calculations
+     */
+    uint32_t GetNSPFCalculations() const;
+
     /**
      * @brief Debugging routine; allow client code to supply a pre-built LSDB
      * @param lsdb the pre-built LSDB
@@ -738,8 +824,115 @@ class GlobalRouteManagerImpl
     void DebugSPFCalculate(Ipv4Address root);
 
   private:
+    /// Interfaces of a router: interface index and local address of each address
+    typedef std::vector<std::pair<int32_t, Ipv4Address>> RouterInterfaces_t;
+
+    /**
+     * @brief A route computed by the SPF calculation for the root router.
+     */
+    struct SPFRoute
+    {
+        /// Type of route
+        enum RouteType
+        {
+            HOST_ROUTE,    //!< host route, see Ipv4GlobalRouting::AddHostRouteTo
+            NETWORK_ROUTE, //!< network route, see Ipv4GlobalRouting::AddNetworkRouteTo
+            EXTERNAL_ROUTE //!< external route, see Ipv4GlobalRouting::AddASExternalRouteTo
+        };
+
+        RouteType type;      //!< type of the route
+        Ipv4Address dest;    //!< destination host or network
+        Ipv4Mask mask;       //!< network mask, unused by host routes
+        Ipv4Address nextHop; //!< next hop address
+        uint32_t outIf;      //!< outgoing interface
+    };
+
+    /**
+     * @brief The SPF calculation rooted at a router.
+     *
+     * The calculation only reads the LSDB and this structure, and writes the
+     * routes it computes in this structure, so that several calculations can
+     * run concurrently on copies of the LSDB.  The routes are then added to
+     * the routing table of the router by InstallSPFRoutes ().
+     */
+    struct SPFRun
+    {
+        Ipv4Address root;              //!< router ID of the root
+        Ptr<Node> node;                //!< node of the root, if any
+        RouterInterfaces_t interfaces; //!< interfaces of the root
+        bool checkForStubNode;         //!< whether to shortcut the calculation for stub nodes
+        std::vector<SPFRoute> routes;  //!< routes computed for the root
+    };
+
     SPFVertex* m_spfroot;           //!< the root node
     GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+    SPFRun* m_spfRun;               //!< the SPF calculation in progress
+    int64_t m_buildDuration;        //!< wall-clock duration of the last build of the LSDB, in ms
+    int64_t m_spfDuration;          //!< wall-clock duration of the last SPF calculations, in ms
+    uint32_t m_nSpfCalculations;    //!< number of routers of the last SPF calculations
+    std::map<Ipv4Address, RouterInterfaces_t>
+        m_spfRouters; //!< interfaces of the routers whose routes were calculated, by router ID
+
+    /**
+     * \brief Get the interfaces of a router.
+     *
+     * \param node the node of the router
+     * \returns the index and local address of each address of the interfaces
+     */
+    static RouterInterfaces_t GetRouterInterfaces(Ptr<Node> node);
+
+    /**
+     * \brief Delete the routes of a node that has a GlobalRouterInterface
+     *
+     * \param node the node
+     */
+    void DeleteGlobalRoutes(Ptr<Node> node);
+
+    /**
+     * \brief Calculate the SPF trees rooted at the given routers and add the
+     * resulting routes to their routing tables.
+     *
+     * The calculations are shared among the threads set by the
+     * GlobalRoutingSPFThreads global value.
+     *
+     * \param roots the nodes of the routers
+     */
+    void SPFCalculate(const std::vector<Ptr<Node>>& roots);
+
+    /**
+     * \brief Run some SPF calculations.
+     *
+     * This method can run in a separate thread, with its own LSDB: it only
+     * accesses the LSDB and the given calculations.
+     *
+     * \param runs the SPF calculations
+     * \param first the index of the first calculation to run
+     * \param step the distance between the indices of the calculations to run
+     */
+    void SPFCalculateRuns(std::vector<SPFRun>& runs, std::size_t first, std::size_t step);
+
+    /**
+     * \brief Add the routes computed by an SPF calculation to the routing table
+     * of its root.
+     *
+     * \param run the SPF calculation
+     */
+    void InstallSPFRoutes(const SPFRun& run);
+
+    /**
+     * \brief Store a route computed by the SPF calculation in progress.
+     *
+     * \param type the type of the route
+     * \param dest the destination host or network
+     * \param mask the network mask
+     * \param nextHop the next hop address
+     * \param outIf the outgoing interface
+     */
+    void AddSPFRoute(SPFRoute::RouteType type,
+                     Ipv4Address dest,
+                     Ipv4Mask mask,
+                     Ipv4Address nextHop,
+                     uint32_t outIf);
 
     /**
      * \brief Test if a node is a stub, from an OSPF sense.
@@ -757,9 +950,9 @@ class GlobalRouteManagerImpl
      * \brief Calculate the shortest path first (SPF) tree
      *
      * Equivalent to quagga ospf_spf_calculate
-     * \param root the root node
+     * \param run the SPF calculation, whose routes are filled
      */
-    void SPFCalculate(Ipv4Address root);
+    void SPFCalculate(SPFRun& run);
 
     /**
      * \brief Process Stub nodes
@@ -910,8 +1103,8 @@ class GlobalRouteManagerImpl
     /**
      * \brief Return the interface number corresponding to a given IP address and mask
      *
-     * This is a wrapper around GetInterfaceForPrefix(), but we first
-     * have to find the right node pointer to pass to that function.
+     * This is equivalent to GetInterfaceForPrefix() on the root node, but
+     * looks through the interfaces of the SPF calculation in progress.
      * If no such interface is found, return -1 (note:  unit test framework
      * for routing assumes -1 to be a legal return value)
      *
@@ -30,6 +30,7 @@
 #include "ns3/packet.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <vector>
 
@@ -40,6 +41,18 @@ NS_LOG_COMPONENT_DEFINE("Ipv4GlobalRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4GlobalRouting);
 
+/**
+ * \param address an address
+ * \return the key of the address in the routes tries
+ */
+static std::array<uint8_t, 4>
+GetTrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
 TypeId
 Ipv4GlobalRouting::GetTypeId()
 {
@@ -64,7 +77,8 @@ Ipv4GlobalRouting::GetTypeId()
 
 Ipv4GlobalRouting::Ipv4GlobalRouting()
     : m_randomEcmpRouting(false),
-      m_respondToInterfaceEvents(false)
+      m_respondToInterfaceEvents(false),
+      m_nextRank(0)
 {
     NS_LOG_FUNCTION(this);
 
@@ -83,6 +97,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, Ipv4Address nextHop, uint32_
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, nextHop, interface);
     m_hostRoutes.push_back(route);
+    m_hostRoutesTrie.Insert(GetTrieKey(dest), 32, route);
 }
 
 void
@@ -92,6 +107,7 @@ Ipv4GlobalRouting::AddHostRouteTo(Ipv4Address dest, uint32_t interface)
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateHostRouteTo(dest, interface);
     m_hostRoutes.push_back(route);
+    m_hostRoutesTrie.Insert(GetTrieKey(dest), 32, route);
 }
 
 void
@@ -104,6 +120,9 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_networkRoutes.push_back(route);
+    m_networkRoutesTrie.Insert(GetTrieKey(network),
+                               networkMask.GetPrefixLength(),
+                               std::make_pair(m_nextRank++, route));
 }
 
 void
@@ -113,6 +132,9 @@ Ipv4GlobalRouting::AddNetworkRouteTo(Ipv4Address network, Ipv4Mask networkMask,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     m_networkRoutes.push_back(route);
+    m_networkRoutesTrie.Insert(GetTrieKey(network),
+                               networkMask.GetPrefixLength(),
+                               std::make_pair(m_nextRank++, route));
 }
 
 void
@@ -125,6 +147,9 @@ Ipv4GlobalRouting::AddASExternalRouteTo(Ipv4Address network,
     auto route = new Ipv4RoutingTableEntry();
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, nextHop, interface);
     m_ASexternalRoutes.push_back(route);
+    m_ASexternalRoutesTrie.Insert(GetTrieKey(network),
+                                  networkMask.GetPrefixLength(),
+                                  std::make_pair(m_nextRank++, route));
 }
 
 Ptr<Ipv4Route>
@@ -137,66 +162,89 @@ Ipv4GlobalRouting::LookupGlobal(Ipv4Address dest, Ptr<NetDevice> oif)
     typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
     RouteVec_t allRoutes;
 
+    auto key = GetTrieKey(dest);
     NS_LOG_LOGIC("Number of m_hostRoutes = " << m_hostRoutes.size());
-    for (auto i = m_hostRoutes.begin(); i != m_hostRoutes.end(); i++)
+    if (auto hostRoutes = m_hostRoutesTrie.Find(key, 32))
     {
-        NS_ASSERT((*i)->IsHost());
-        if ((*i)->GetDest() == dest)
+        for (auto route : *hostRoutes)
         {
+            NS_ASSERT(route->IsHost() && route->GetDest() == dest);
             if (oif)
             {
-                if (oif != m_ipv4->GetNetDevice((*i)->GetInterface()))
+                if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
                 {
                     NS_LOG_LOGIC("Not on requested interface, skipping");
                     continue;
                 }
             }
-            allRoutes.push_back(*i);
-            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << *i);
+            allRoutes.push_back(route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global host route" << route);
         }
     }
     if (allRoutes.empty()) // if no host route is found
     {
         NS_LOG_LOGIC("Number of m_networkRoutes" << m_networkRoutes.size());
-        for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
-        {
-            Ipv4Mask mask = (*j)->GetDestNetworkMask();
-            Ipv4Address entry = (*j)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // all the matching network routes are equal cost candidates, whatever
+        // the length of their prefix, in the order of the routing table
+        std::vector<std::pair<uint64_t, Ipv4RoutingTableEntry*>> matches;
+        m_networkRoutesTrie.ForEachMatch(key, [&](const auto& routes) {
+            for (const auto& rankedRoute : routes)
             {
+                Ipv4RoutingTableEntry* route = rankedRoute.second;
+                if (!route->GetDestNetworkMask().IsMatch(dest, route->GetDestNetwork()))
+                {
+                    continue;
+                }
                 if (oif)
                 {
-                    if (oif != m_ipv4->GetNetDevice((*j)->GetInterface()))
+                    if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
                     {
                         NS_LOG_LOGIC("Not on requested interface, skipping");
                         continue;
                     }
                 }
-                allRoutes.push_back(*j);
-                NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << *j);
+                matches.push_back(rankedRoute);
             }
+            return false;
+        });
+        std::sort(matches.begin(), matches.end());
+        for (const auto& [rank, route] : matches)
+        {
+            allRoutes.push_back(route);
+            NS_LOG_LOGIC(allRoutes.size() << "Found global network route" << route);
         }
     }
     if (allRoutes.empty()) // consider external if no host/network found
     {
-        for (auto k = m_ASexternalRoutes.begin(); k != m_ASexternalRoutes.end(); k++)
-        {
-            Ipv4Mask mask = (*k)->GetDestNetworkMask();
-            Ipv4Address entry = (*k)->GetDestNetwork();
-            if (mask.IsMatch(dest, entry))
+        // the first matching route in the order of the routing table is selected
+        const std::pair<uint64_t, Ipv4RoutingTableEntry*>* first = nullptr;
+        m_ASexternalRoutesTrie.ForEachMatch(key, [&](const auto& routes) {
+            for (const auto& rankedRoute : routes)
             {
-                NS_LOG_LOGIC("Found external route" << *k);
+                Ipv4RoutingTableEntry* route = rankedRoute.second;
+                if (!route->GetDestNetworkMask().IsMatch(dest, route->GetDestNetwork()))
+                {
+                    continue;
+                }
+                NS_LOG_LOGIC("Found external route" << route);
                 if (oif)
                 {
-                    if (oif != m_ipv4->GetNetDevice((*k)->GetInterface()))
+                    if (oif != m_ipv4->GetNetDevice(route->GetInterface()))
                     {
                         NS_LOG_LOGIC("Not on requested interface, skipping");
                         continue;
                     }
                 }
-                allRoutes.push_back(*k);
-                break;
+                if (!first || rankedRoute.first < first->first)
+                {
+                    first = &rankedRoute;
+                }
             }
+            return false;
+        });
+        if (first)
+        {
+            allRoutes.push_back(first->second);
         }
     }
     if (!allRoutes.empty()) // if route(s) is found
@@ -297,6 +345,9 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
             if (tmp == index)
             {
                 NS_LOG_LOGIC("Removing route " << index << "; size = " << m_hostRoutes.size());
+                m_hostRoutesTrie.Remove(GetTrieKey((*i)->GetDest()), 32, [i](auto route) {
+                    return route == *i;
+                });
                 delete *i;
                 m_hostRoutes.erase(i);
                 NS_LOG_LOGIC("Done removing host route "
@@ -313,6 +364,9 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_networkRoutes.size());
+            m_networkRoutesTrie.Remove(GetTrieKey((*j)->GetDestNetwork()),
+                                       (*j)->GetDestNetworkMask().GetPrefixLength(),
+                                       [j](const auto& route) { return route.second == *j; });
             delete *j;
             m_networkRoutes.erase(j);
             NS_LOG_LOGIC("Done removing network route "
@@ -328,6 +382,9 @@ Ipv4GlobalRouting::RemoveRoute(uint32_t index)
         if (tmp == index)
         {
             NS_LOG_LOGIC("Removing route " << index << "; size = " << m_ASexternalRoutes.size());
+            m_ASexternalRoutesTrie.Remove(GetTrieKey((*k)->GetDestNetwork()),
+                                          (*k)->GetDestNetworkMask().GetPrefixLength(),
+                                          [k](const auto& route) { return route.second == *k; });
             delete *k;
             m_ASexternalRoutes.erase(k);
             NS_LOG_LOGIC("Done removing network route "
@@ -364,6 +421,9 @@ Ipv4GlobalRouting::DoDispose()
     {
         delete (*l);
     }
+    m_hostRoutesTrie.Clear();
+    m_networkRoutesTrie.Clear();
+    m_ASexternalRoutesTrie.Clear();
 
     Ipv4RoutingProtocol::DoDispose();
 }
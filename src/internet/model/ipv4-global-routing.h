@@ -22,6 +22,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -266,6 +267,12 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
     typedef std::list<Ipv4RoutingTableEntry*>::iterator ASExternalRoutesI;
 
+    /// trie of the routes to hosts, indexed by destination address
+    typedef PrefixTrie<4, Ipv4RoutingTableEntry*> HostRoutesTrie;
+    /// trie of the routes to networks or to external AS, indexed by destination
+    /// prefix, with the rank of each route in the order of the routing table
+    typedef PrefixTrie<4, std::pair<uint64_t, Ipv4RoutingTableEntry*>> NetworkRoutesTrie;
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -278,6 +285,11 @@ class Ipv4GlobalRouting : public Ipv4RoutingProtocol
     NetworkRoutes m_networkRoutes;       //!< Routes to networks
     ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
 
+    HostRoutesTrie m_hostRoutesTrie;          //!< Routes to hosts, by destination
+    NetworkRoutesTrie m_networkRoutesTrie;    //!< Routes to networks, by destination
+    NetworkRoutesTrie m_ASexternalRoutesTrie; //!< External routes, by destination
+    uint64_t m_nextRank;                      //!< Rank of the next route added to a trie
+
     Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
 
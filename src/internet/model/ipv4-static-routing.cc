@@ -47,6 +47,18 @@ NS_LOG_COMPONENT_DEFINE("Ipv4StaticRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv4StaticRouting);
 
+/**
+ * \param address an address
+ * \return the key of the address in the network routes trie
+ */
+static std::array<uint8_t, 4>
+GetTrieKey(Ipv4Address address)
+{
+    std::array<uint8_t, 4> key;
+    address.Serialize(key.data());
+    return key;
+}
+
 TypeId
 Ipv4StaticRouting::GetTypeId()
 {
@@ -78,8 +90,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -95,9 +106,7 @@ Ipv4StaticRouting::AddNetworkRouteTo(Ipv4Address network,
         Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv4RoutingTableEntry(route);
-
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv4RoutingTableEntry(route), metric);
     }
 }
 
@@ -152,7 +161,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv4Address network("224.0.0.0");
     Ipv4Mask networkMask("240.0.0.0");
     *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -224,14 +233,19 @@ Ipv4StaticRouting::RemoveMulticastRoute(uint32_t index)
 bool
 Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // identical routes have the same destination prefix
+    auto routes = m_networkRoutesTrie.Find(GetTrieKey(route.GetDestNetwork()),
+                                           route.GetDestNetworkMask().GetPrefixLength());
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rtentry, rtmetric] : *routes)
     {
-        Ipv4RoutingTableEntry* rtentry = j->first;
-
         if (rtentry->GetDest() == route.GetDest() &&
             rtentry->GetDestNetworkMask() == route.GetDestNetworkMask() &&
             rtentry->GetGateway() == route.GetGateway() &&
-            rtentry->GetInterface() == route.GetInterface() && j->second == metric)
+            rtentry->GetInterface() == route.GetInterface() && rtmetric == metric)
         {
             return true;
         }
@@ -239,6 +253,26 @@ Ipv4StaticRouting::LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv4StaticRouting::AppendNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesTrie.Insert(GetTrieKey(route->GetDestNetwork()),
+                               route->GetDestNetworkMask().GetPrefixLength(),
+                               std::make_pair(route, metric));
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv4RoutingTableEntry* route = it->first;
+    m_networkRoutesTrie.Remove(GetTrieKey(route->GetDestNetwork()),
+                               route->GetDestNetworkMask().GetPrefixLength(),
+                               [route](const auto& value) { return value.first == route; });
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv4Route>
 Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
 {
@@ -261,17 +295,22 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
         return rtentry;
     }
 
-    for (auto i = m_networkRoutes.begin(); i != m_networkRoutes.end(); i++)
-    {
-        Ipv4RoutingTableEntry* j = i->first;
-        uint32_t metric = i->second;
-        Ipv4Mask mask = (j)->GetDestNetworkMask();
-        uint16_t masklen = mask.GetPrefixLength();
-        Ipv4Address entry = (j)->GetDestNetwork();
-        NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to " << entry
-                                               << "/" << masklen);
-        if (mask.IsMatch(dest, entry))
+    // The matching routes are visited from the longest prefix to the shortest
+    // one, and in the order of the forwarding table for each prefix. Routes
+    // with a non-contiguous mask are indexed by the prefix of the leading ones
+    // of their mask, hence the full match is still checked.
+    m_networkRoutesTrie.ForEachMatch(GetTrieKey(dest), [&](const auto& routes) {
+        for (const auto& [j, metric] : routes)
         {
+            Ipv4Mask mask = j->GetDestNetworkMask();
+            uint16_t masklen = mask.GetPrefixLength();
+            Ipv4Address entry = j->GetDestNetwork();
+            NS_LOG_LOGIC("Searching for route to " << dest << ", checking against route to "
+                                                   << entry << "/" << masklen);
+            if (!mask.IsMatch(dest, entry))
+            {
+                continue;
+            }
             NS_LOG_LOGIC("Found global network route " << j << ", mask length " << masklen
                                                        << ", metric " << metric);
             if (oif)
@@ -298,7 +337,7 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
                 continue;
             }
             shortest_metric = metric;
-            Ipv4RoutingTableEntry* route = (j);
+            Ipv4RoutingTableEntry* route = j;
             uint32_t interfaceIdx = route->GetInterface();
             rtentry = Create<Ipv4Route>();
             rtentry->SetDestination(route->GetDest());
@@ -307,10 +346,12 @@ Ipv4StaticRouting::LookupStatic(Ipv4Address dest, Ptr<NetDevice> oif)
             rtentry->SetOutputDevice(m_ipv4->GetNetDevice(interfaceIdx));
             if (masklen == 32)
             {
-                break;
+                return true;
             }
         }
-    }
+        // the routes of the shorter prefixes are not considered once a route is found
+        return bool(rtentry);
+    });
     if (rtentry)
     {
         NS_LOG_LOGIC("Matching route via " << rtentry->GetGateway() << " at the end");
@@ -457,8 +498,7 @@ Ipv4StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete j->first;
-            m_networkRoutes.erase(j);
+            EraseNetworkRoute(j);
             return;
         }
         tmp++;
@@ -592,6 +632,7 @@ Ipv4StaticRouting::DoDispose()
     {
         delete (j->first);
     }
+    m_networkRoutesTrie.Clear();
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
     {
@@ -631,8 +672,7 @@ Ipv4StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -676,8 +716,7 @@ Ipv4StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv4InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkMask() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -24,6 +24,7 @@
 #include "ipv4-header.h"
 #include "ipv4-routing-protocol.h"
 #include "ipv4.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv4-address.h"
 #include "ns3/ptr.h"
@@ -381,6 +382,9 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv4MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Trie of the network routes, indexed by destination prefix
+    typedef PrefixTrie<4, std::pair<Ipv4RoutingTableEntry*, uint32_t>> NetworkRoutesTrie;
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -389,6 +393,20 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     bool LookupRoute(const Ipv4RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a network route at the end of the forwarding table.
+     * \param route the route, owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AppendNetworkRoute(Ipv4RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a network route from the forwarding table and delete it.
+     * \param it the route
+     * \return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -411,6 +429,12 @@ class Ipv4StaticRouting : public Ipv4RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the network routes indexed by destination prefix, in the order of
+     * the forwarding table, for the longest prefix match lookups.
+     */
+    NetworkRoutesTrie m_networkRoutesTrie;
+
     /**
      * \brief the forwarding table for multicast.
      */
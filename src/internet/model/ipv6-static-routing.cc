@@ -38,6 +38,18 @@ NS_LOG_COMPONENT_DEFINE("Ipv6StaticRouting");
 
 NS_OBJECT_ENSURE_REGISTERED(Ipv6StaticRouting);
 
+/**
+ * \param address an address
+ * \return the key of the address in the network routes trie
+ */
+static std::array<uint8_t, 16>
+GetTrieKey(Ipv6Address address)
+{
+    std::array<uint8_t, 16> key;
+    address.Serialize(key.data());
+    return key;
+}
+
 TypeId
 Ipv6StaticRouting::GetTypeId()
 {
@@ -181,8 +193,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
 
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -208,8 +219,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
                                                                               prefixToUse);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -225,8 +235,7 @@ Ipv6StaticRouting::AddNetworkRouteTo(Ipv6Address network,
         Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkPrefix, interface);
     if (!LookupRoute(route, metric))
     {
-        auto routePtr = new Ipv6RoutingTableEntry(route);
-        m_networkRoutes.emplace_back(routePtr, metric);
+        AppendNetworkRoute(new Ipv6RoutingTableEntry(route), metric);
     }
 }
 
@@ -268,7 +277,7 @@ Ipv6StaticRouting::SetDefaultMulticastRoute(uint32_t outputInterface)
     Ipv6Address network = Ipv6Address("ff00::"); /* RFC 3513 */
     Ipv6Prefix networkMask = Ipv6Prefix(8);
     *route = Ipv6RoutingTableEntry::CreateNetworkRouteTo(network, networkMask, outputInterface);
-    m_networkRoutes.emplace_back(route, 0);
+    AppendNetworkRoute(route, 0);
 }
 
 uint32_t
@@ -363,15 +372,20 @@ Ipv6StaticRouting::HasNetworkDest(Ipv6Address network, uint32_t interfaceIndex)
 bool
 Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric)
 {
-    for (auto j = m_networkRoutes.begin(); j != m_networkRoutes.end(); j++)
+    // identical routes have the same destination prefix
+    auto routes = m_networkRoutesTrie.Find(GetTrieKey(route.GetDestNetwork()),
+                                           route.GetDestNetworkPrefix().GetPrefixLength());
+    if (!routes)
+    {
+        return false;
+    }
+    for (const auto& [rtentry, rtmetric] : *routes)
     {
-        Ipv6RoutingTableEntry* rtentry = j->first;
-
         if (rtentry->GetDest() == route.GetDest() &&
             rtentry->GetDestNetworkPrefix() == route.GetDestNetworkPrefix() &&
             rtentry->GetGateway() == route.GetGateway() &&
             rtentry->GetInterface() == route.GetInterface() &&
-            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && j->second == metric)
+            rtentry->GetPrefixToUse() == route.GetPrefixToUse() && rtmetric == metric)
         {
             return true;
         }
@@ -379,6 +393,26 @@ Ipv6StaticRouting::LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metr
     return false;
 }
 
+void
+Ipv6StaticRouting::AppendNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric)
+{
+    m_networkRoutes.emplace_back(route, metric);
+    m_networkRoutesTrie.Insert(GetTrieKey(route->GetDestNetwork()),
+                               route->GetDestNetworkPrefix().GetPrefixLength(),
+                               std::make_pair(route, metric));
+}
+
+Ipv6StaticRouting::NetworkRoutesI
+Ipv6StaticRouting::EraseNetworkRoute(NetworkRoutesI it)
+{
+    Ipv6RoutingTableEntry* route = it->first;
+    m_networkRoutesTrie.Remove(GetTrieKey(route->GetDestNetwork()),
+                               route->GetDestNetworkPrefix().GetPrefixLength(),
+                               [route](const auto& value) { return value.first == route; });
+    delete route;
+    return m_networkRoutes.erase(it);
+}
+
 Ptr<Ipv6Route>
 Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
 {
@@ -402,19 +436,24 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
         return rtentry;
     }
 
-    for (auto it = m_networkRoutes.begin(); it != m_networkRoutes.end(); it++)
-    {
-        Ipv6RoutingTableEntry* j = it->first;
-        uint32_t metric = it->second;
-        Ipv6Prefix mask = j->GetDestNetworkPrefix();
-        uint16_t maskLen = mask.GetPrefixLength();
-        Ipv6Address entry = j->GetDestNetwork();
+    // The matching routes are visited from the longest prefix to the shortest
+    // one, and in the order of the forwarding table for each prefix. Routes
+    // with a non-contiguous prefix are indexed by the leading ones of their
+    // prefix, hence the full match is still checked.
+    m_networkRoutesTrie.ForEachMatch(GetTrieKey(dst), [&](const auto& routes) {
+        for (const auto& [j, metric] : routes)
+        {
+            Ipv6Prefix mask = j->GetDestNetworkPrefix();
+            uint16_t maskLen = mask.GetPrefixLength();
+            Ipv6Address entry = j->GetDestNetwork();
 
-        NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen << ", metric "
-                                               << metric);
+            NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen
+                                                   << ", metric " << metric);
 
-        if (mask.IsMatch(dst, entry))
-        {
+            if (!mask.IsMatch(dst, entry))
+            {
+                continue;
+            }
             NS_LOG_LOGIC("Found global network route " << *j << ", mask length " << maskLen
                                                        << ", metric " << metric);
 
@@ -466,11 +505,13 @@ Ipv6StaticRouting::LookupStatic(Ipv6Address dst, Ptr<NetDevice> interface)
                 rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
                 if (maskLen == 128)
                 {
-                    break;
+                    return true;
                 }
             }
         }
-    }
+        // the routes of the shorter prefixes are not considered once a route is found
+        return bool(rtentry);
+    });
 
     if (rtentry)
     {
@@ -490,6 +531,7 @@ Ipv6StaticRouting::DoDispose()
         delete j->first;
     }
     m_networkRoutes.clear();
+    m_networkRoutesTrie.Clear();
 
     for (auto i = m_multicastRoutes.begin(); i != m_multicastRoutes.end();
          i = m_multicastRoutes.erase(i))
@@ -647,8 +689,7 @@ Ipv6StaticRouting::RemoveRoute(uint32_t index)
     {
         if (tmp == index)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
         tmp++;
@@ -670,8 +711,7 @@ Ipv6StaticRouting::RemoveRoute(Ipv6Address network,
         if (network == rtentry->GetDest() && rtentry->GetInterface() == ifIndex &&
             rtentry->GetPrefixToUse() == prefixToUse)
         {
-            delete it->first;
-            m_networkRoutes.erase(it);
+            EraseNetworkRoute(it);
             return;
         }
     }
@@ -812,8 +852,7 @@ Ipv6StaticRouting::NotifyInterfaceDown(uint32_t i)
     {
         if (it->first->GetInterface() == i)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -850,8 +889,7 @@ Ipv6StaticRouting::NotifyRemoveAddress(uint32_t interface, Ipv6InterfaceAddress
             it->first->GetDestNetwork() == networkAddress &&
             it->first->GetDestNetworkPrefix() == networkMask)
         {
-            delete it->first;
-            it = m_networkRoutes.erase(it);
+            it = EraseNetworkRoute(it);
         }
         else
         {
@@ -908,8 +946,7 @@ Ipv6StaticRouting::NotifyRemoveRoute(Ipv6Address dst,
 
             if (dst == entry && prefix == mask && rtentry->GetInterface() == interface)
             {
-                delete j->first;
-                j = m_networkRoutes.erase(j);
+                j = EraseNetworkRoute(j);
             }
             else
             {
@@ -23,6 +23,7 @@
 #include "ipv6-header.h"
 #include "ipv6-routing-protocol.h"
 #include "ipv6.h"
+#include "prefix-trie.h"
 
 #include "ns3/ipv6-address.h"
 #include "ns3/ptr.h"
@@ -306,6 +307,9 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
     /// Iterator for container for the multicast routes
     typedef std::list<Ipv6MulticastRoutingTableEntry*>::iterator MulticastRoutesI;
 
+    /// Trie of the network routes, indexed by destination prefix
+    typedef PrefixTrie<16, std::pair<Ipv6RoutingTableEntry*, uint32_t>> NetworkRoutesTrie;
+
     /**
      * \brief Checks if a route is already present in the forwarding table.
      * \param route route
@@ -314,6 +318,20 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     bool LookupRoute(const Ipv6RoutingTableEntry& route, uint32_t metric);
 
+    /**
+     * \brief Add a network route at the end of the forwarding table.
+     * \param route the route, owned by the forwarding table
+     * \param metric metric of route
+     */
+    void AppendNetworkRoute(Ipv6RoutingTableEntry* route, uint32_t metric);
+
+    /**
+     * \brief Remove a network route from the forwarding table and delete it.
+     * \param it the route
+     * \return the route following the removed one
+     */
+    NetworkRoutesI EraseNetworkRoute(NetworkRoutesI it);
+
     /**
      * \brief Lookup in the forwarding table for destination.
      * \param dest destination address
@@ -336,6 +354,12 @@ class Ipv6StaticRouting : public Ipv6RoutingProtocol
      */
     NetworkRoutes m_networkRoutes;
 
+    /**
+     * \brief the network routes indexed by destination prefix, in the order of
+     * the forwarding table, for the longest prefix match lookups.
+     */
+    NetworkRoutesTrie m_networkRoutesTrie;
+
     /**
      * \brief the forwarding table for multicast.
      */
@@ -0,0 +1,364 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef PREFIX_TRIE_H
+#define PREFIX_TRIE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup internet
+ *
+ * \brief A path-compressed binary trie of address prefixes, for longest
+ * prefix match lookups in routing tables.
+ *
+ * Each prefix of the trie holds a list of values, e.g., the routes to that
+ * prefix, in insertion order. The nodes of the trie only exist for the
+ * prefixes holding values and for the prefixes where the paths to them
+ * branch, so that a lookup visits at most one node per distinct prefix
+ * length on the path to the address, rather than one per bit.
+ *
+ * \tparam N the size of the addresses (bytes)
+ * \tparam T the type of the values
+ */
+template <std::size_t N, typename T>
+class PrefixTrie
+{
+  public:
+    /// The bytes of an address or of a prefix, in network order
+    using Key = std::array<uint8_t, N>;
+
+    /// The number of bits of an address
+    static constexpr uint8_t BITS = N * 8;
+
+    /**
+     * Add a value to a prefix.
+     *
+     * \param prefix the prefix; the bits after its length are ignored
+     * \param length the length of the prefix (bits)
+     * \param value the value, appended to the values of the prefix
+     */
+    void Insert(const Key& prefix, uint8_t length, const T& value);
+
+    /**
+     * Remove the first value of a prefix matching a predicate.
+     *
+     * \tparam P the type of the predicate
+     * \param prefix the prefix; the bits after its length are ignored
+     * \param length the length of the prefix (bits)
+     * \param pred the predicate, called with the values of the prefix
+     * \return true if a value was removed
+     */
+    template <typename P>
+    bool Remove(const Key& prefix, uint8_t length, P pred);
+
+    /**
+     * Get the values of a prefix.
+     *
+     * \param prefix the prefix; the bits after its length are ignored
+     * \param length the length of the prefix (bits)
+     * \return the values of the prefix, or nullptr if it has none
+     */
+    const std::vector<T>* Find(const Key& prefix, uint8_t length) const;
+
+    /**
+     * Visit the values of the prefixes matching an address, from the longest
+     * prefix to the shortest one.
+     *
+     * \tparam F the type of the visitor
+     * \param address the address
+     * \param visit the visitor, called with the values of each matching
+     *              prefix, which returns true to stop the visit
+     */
+    template <typename F>
+    void ForEachMatch(const Key& address, F visit) const;
+
+    /**
+     * \return the number of values in the trie
+     */
+    std::size_t GetSize() const;
+
+    /**
+     * Remove all the values.
+     */
+    void Clear();
+
+  private:
+    /// A node of the trie
+    struct Node
+    {
+        Key prefix;                        //!< the prefix, with the bits after length cleared
+        uint8_t length;                    //!< the length of the prefix (bits)
+        std::vector<T> values;             //!< the values of the prefix
+        std::unique_ptr<Node> children[2]; //!< the subtries, by the bit after the prefix
+    };
+
+    /**
+     * \param key a key
+     * \param length a number of bits
+     * \return the key with the bits after length cleared
+     */
+    static Key Mask(const Key& key, uint8_t length);
+
+    /**
+     * \param key a key
+     * \param index the index of a bit, from the most significant one
+     * \return the bit of the key
+     */
+    static uint8_t GetBit(const Key& key, uint8_t index);
+
+    /**
+     * \param a a key
+     * \param b another key
+     * \param max the maximum length to compare (bits)
+     * \return the length of the common prefix of the keys, at most max
+     */
+    static uint8_t GetCommonLength(const Key& a, const Key& b, uint8_t max);
+
+    std::unique_ptr<Node> m_root; //!< the root of the trie
+    std::size_t m_size{0};        //!< the number of values
+};
+
+/***************************************************************
+ *  Implementation of the templates declared above.
+ ***************************************************************/
+
+template <std::size_t N, typename T>
+void
+PrefixTrie<N, T>::Insert(const Key& prefix, uint8_t length, const T& value)
+{
+    Key masked = Mask(prefix, length);
+    ++m_size;
+    std::unique_ptr<Node>* link = &m_root;
+    while (*link)
+    {
+        Node* node = link->get();
+        uint8_t common = GetCommonLength(node->prefix, masked, std::min(node->length, length));
+        if (common == node->length)
+        {
+            if (node->length == length)
+            {
+                node->values.push_back(value);
+                return;
+            }
+            link = &node->children[GetBit(masked, node->length)];
+            continue;
+        }
+        // the prefix diverges from the path to the node, or ends on it
+        auto parent = std::make_unique<Node>();
+        parent->prefix = Mask(masked, common);
+        parent->length = common;
+        parent->children[GetBit(node->prefix, common)] = std::move(*link);
+        if (common == length)
+        {
+            parent->values.push_back(value);
+        }
+        else
+        {
+            auto leaf = std::make_unique<Node>();
+            leaf->prefix = masked;
+            leaf->length = length;
+            leaf->values.push_back(value);
+            parent->children[GetBit(masked, common)] = std::move(leaf);
+        }
+        *link = std::move(parent);
+        return;
+    }
+    *link = std::make_unique<Node>();
+    (*link)->prefix = masked;
+    (*link)->length = length;
+    (*link)->values.push_back(value);
+}
+
+template <std::size_t N, typename T>
+template <typename P>
+bool
+PrefixTrie<N, T>::Remove(const Key& prefix, uint8_t length, P pred)
+{
+    Key masked = Mask(prefix, length);
+    std::unique_ptr<Node>* path[BITS + 1];
+    std::size_t depth = 0;
+    std::unique_ptr<Node>* link = &m_root;
+    while (*link && (*link)->length <= length &&
+           GetCommonLength((*link)->prefix, masked, (*link)->length) == (*link)->length)
+    {
+        path[depth++] = link;
+        if ((*link)->length == length)
+        {
+            break;
+        }
+        link = &(*link)->children[GetBit(masked, (*link)->length)];
+    }
+    if (depth == 0 || (*path[depth - 1])->length != length)
+    {
+        return false;
+    }
+    auto& values = (*path[depth - 1])->values;
+    auto it = std::find_if(values.begin(), values.end(), pred);
+    if (it == values.end())
+    {
+        return false;
+    }
+    values.erase(it);
+    --m_size;
+
+    // remove the nodes which neither hold values nor branch any more
+    while (depth > 0)
+    {
+        std::unique_ptr<Node>& node = *path[--depth];
+        if (!node->values.empty() || (node->children[0] && node->children[1]))
+        {
+            break;
+        }
+        node = std::move(node->children[0] ? node->children[0] : node->children[1]);
+    }
+    return true;
+}
+
+template <std::size_t N, typename T>
+const std::vector<T>*
+PrefixTrie<N, T>::Find(const Key& prefix, uint8_t length) const
+{
+    Key masked = Mask(prefix, length);
+    const Node* node = m_root.get();
+    while (node && node->length <= length &&
+           GetCommonLength(node->prefix, masked, node->length) == node->length)
+    {
+        if (node->length == length)
+        {
+            return node->values.empty() ? nullptr : &node->values;
+        }
+        node = node->children[GetBit(masked, node->length)].get();
+    }
+    return nullptr;
+}
+
+template <std::size_t N, typename T>
+template <typename F>
+void
+PrefixTrie<N, T>::ForEachMatch(const Key& address, F visit) const
+{
+    const Node* matches[BITS + 1];
+    std::size_t nMatches = 0;
+    const Node* node = m_root.get();
+    while (node && GetCommonLength(node->prefix, address, node->length) == node->length)
+    {
+        if (!node->values.empty())
+        {
+            matches[nMatches++] = node;
+        }
+        if (node->length == BITS)
+        {
+            break;
+        }
+        node = node->children[GetBit(address, node->length)].get();
+    }
+    while (nMatches > 0)
+    {
+        if (visit(matches[--nMatches]->values))
+        {
+            return;
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+std::size_t
+PrefixTrie<N, T>::GetSize() const
+{
+    return m_size;
+}
+
+template <std::size_t N, typename T>
+void
+PrefixTrie<N, T>::Clear()
+{
+    m_root.reset();
+    m_size = 0;
+}
+
+template <std::size_t N, typename T>
+typename PrefixTrie<N, T>::Key
+PrefixTrie<N, T>::Mask(const Key& key, uint8_t length)
+{
+    Key masked{};
+    for (std::size_t i = 0; i < N && length > 0; ++i)
+    {
+        uint8_t bits = std::min<uint8_t>(length, 8);
+        masked[i] = key[i] & static_cast<uint8_t>(0xff << (8 - bits));
+        length -= bits;
+    }
+    return masked;
+}
+
+template <std::size_t N, typename T>
+uint8_t
+PrefixTrie<N, T>::GetBit(const Key& key, uint8_t index)
+{
+    return (key[index / 8] >> (7 - index % 8)) & 1;
+}
+
+template <std::size_t N, typename T>
+uint8_t
+PrefixTrie<N, T>::GetCommonLength(const Key& a, const Key& b, uint8_t max)
+{
+    uint8_t length = 0;
+    for (std::size_t i = 0; i < N && length < max; ++i)
+    {
+        uint8_t diff = a[i] ^ b[i];
+        if (diff != 0)
+        {
+            while (!(diff & 0x80))
+            {
+                diff <<= 1;
+                ++length;
+            }
+            break;
+        }
+        length += 8;
+    }
+    return std::min(length, max);
+}
+
+} // namespace ns3
+
+#endif /* PREFIX_TRIE_H */
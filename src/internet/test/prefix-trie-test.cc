@@ -0,0 +1,434 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-static-routing-helper.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/node.h"
+#include "ns3/prefix-trie.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the lookups of a PrefixTrie against a linear search of its prefixes.
+ *
+ * \tparam N the size of the addresses (bytes)
+ */
+template <std::size_t N>
+class PrefixTrieTestCase : public TestCase
+{
+  public:
+    PrefixTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /// The trie under test, whose values are the ranks of the insertions
+    using Trie = PrefixTrie<N, uint32_t>;
+
+    /// A prefix inserted in the trie
+    struct Entry
+    {
+        typename Trie::Key prefix; //!< the prefix
+        uint8_t length;            //!< the length of the prefix (bits)
+        uint32_t value;            //!< the value inserted with the prefix
+    };
+
+    /**
+     * \param a an address
+     * \param prefix a prefix
+     * \param length the length of the prefix (bits)
+     * \return true if the address matches the prefix
+     */
+    static bool IsMatch(const typename Trie::Key& a,
+                        const typename Trie::Key& prefix,
+                        uint8_t length);
+
+    /**
+     * Check the matches of an address.
+     *
+     * \param trie the trie
+     * \param entries the prefixes of the trie, in insertion order
+     * \param address the address
+     */
+    void CheckMatches(const Trie& trie,
+                      const std::vector<Entry>& entries,
+                      const typename Trie::Key& address);
+
+    Ptr<UniformRandomVariable> m_rng; //!< the random numbers
+};
+
+template <std::size_t N>
+PrefixTrieTestCase<N>::PrefixTrieTestCase()
+    : TestCase("Check the longest prefix match lookups of a trie of " + std::to_string(N * 8) +
+               "-bit addresses")
+{
+}
+
+template <std::size_t N>
+bool
+PrefixTrieTestCase<N>::IsMatch(const typename Trie::Key& a,
+                               const typename Trie::Key& prefix,
+                               uint8_t length)
+{
+    for (uint8_t i = 0; i < length; ++i)
+    {
+        uint8_t mask = 0x80 >> (i % 8);
+        if ((a[i / 8] & mask) != (prefix[i / 8] & mask))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <std::size_t N>
+void
+PrefixTrieTestCase<N>::CheckMatches(const Trie& trie,
+                                    const std::vector<Entry>& entries,
+                                    const typename Trie::Key& address)
+{
+    // the values of the matching prefixes, by decreasing length and in insertion order
+    std::vector<std::pair<int, uint32_t>> expected;
+    for (const auto& entry : entries)
+    {
+        if (IsMatch(address, entry.prefix, entry.length))
+        {
+            expected.emplace_back(-entry.length, entry.value);
+        }
+    }
+    std::stable_sort(expected.begin(), expected.end(), [](const auto& a, const auto& b) {
+        return a.first < b.first;
+    });
+
+    std::vector<uint32_t> visited;
+    trie.ForEachMatch(address, [&visited](const std::vector<uint32_t>& values) {
+        visited.insert(visited.end(), values.begin(), values.end());
+        return false;
+    });
+    NS_TEST_ASSERT_MSG_EQ(visited.size(), expected.size(), "Unexpected number of matches");
+    for (std::size_t i = 0; i < visited.size(); ++i)
+    {
+        NS_TEST_ASSERT_MSG_EQ(visited[i], expected[i].second, "Unexpected match " << i);
+    }
+
+    // the visit stops when requested
+    std::size_t nVisits = 0;
+    trie.ForEachMatch(address, [&nVisits](const std::vector<uint32_t>&) {
+        ++nVisits;
+        return true;
+    });
+    NS_TEST_ASSERT_MSG_EQ(nVisits, std::min<std::size_t>(expected.size(), 1), "Visit not stopped");
+}
+
+template <std::size_t N>
+void
+PrefixTrieTestCase<N>::DoRun()
+{
+    m_rng = CreateObject<UniformRandomVariable>();
+    m_rng->SetStream(1);
+
+    // the prefixes derive from a few addresses, so that many of them are nested
+    std::vector<typename Trie::Key> bases(4);
+    for (auto& base : bases)
+    {
+        for (auto& byte : base)
+        {
+            byte = m_rng->GetInteger(0, 255);
+        }
+    }
+    auto randomAddress = [this, &bases]() {
+        auto address = bases[m_rng->GetInteger(0, bases.size() - 1)];
+        // flip a few random bits
+        for (uint32_t i = m_rng->GetInteger(0, 3); i > 0; --i)
+        {
+            uint32_t bit = m_rng->GetInteger(0, N * 8 - 1);
+            address[bit / 8] ^= 0x80 >> (bit % 8);
+        }
+        return address;
+    };
+
+    Trie trie;
+    std::vector<Entry> entries;
+    for (uint32_t value = 0; value < 500; ++value)
+    {
+        Entry entry{randomAddress(), static_cast<uint8_t>(m_rng->GetInteger(0, N * 8)), value};
+        trie.Insert(entry.prefix, entry.length, entry.value);
+        entries.push_back(entry);
+    }
+    // a few identical prefixes, holding several values
+    for (uint32_t value = 500; value < 520; ++value)
+    {
+        Entry entry = entries[m_rng->GetInteger(0, entries.size() - 1)];
+        entry.value = value;
+        trie.Insert(entry.prefix, entry.length, entry.value);
+        entries.push_back(entry);
+    }
+    NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), entries.size(), "Unexpected size of the trie");
+
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        CheckMatches(trie, entries, randomAddress());
+    }
+    for (const auto& entry : entries)
+    {
+        CheckMatches(trie, entries, entry.prefix);
+        auto values = trie.Find(entry.prefix, entry.length);
+        NS_TEST_ASSERT_MSG_NE(values, nullptr, "Prefix not found");
+        NS_TEST_ASSERT_MSG_EQ((std::find(values->begin(), values->end(), entry.value) !=
+                               values->end()),
+                              true,
+                              "Value not found");
+    }
+
+    // remove half of the values, in random order
+    for (uint32_t i = 0; i < 260; ++i)
+    {
+        auto it = entries.begin() + m_rng->GetInteger(0, entries.size() - 1);
+        uint32_t value = it->value;
+        NS_TEST_ASSERT_MSG_EQ(trie.Remove(it->prefix, it->length, [value](uint32_t v) {
+            return v == value;
+        }),
+                              true,
+                              "Value not removed");
+        NS_TEST_ASSERT_MSG_EQ(trie.Remove(it->prefix, it->length, [value](uint32_t v) {
+            return v == value;
+        }),
+                              false,
+                              "Value removed twice");
+        entries.erase(it);
+    }
+    NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), entries.size(), "Unexpected size of the trie");
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        CheckMatches(trie, entries, randomAddress());
+    }
+
+    trie.Clear();
+    NS_TEST_ASSERT_MSG_EQ(trie.GetSize(), 0, "Trie not cleared");
+    CheckMatches(trie, {}, randomAddress());
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief Check the routes selected by Ipv4StaticRouting against a linear search
+ * of its routing table, as done before the routes were indexed by a trie.
+ */
+class Ipv4StaticRoutingTrieTestCase : public TestCase
+{
+  public:
+    Ipv4StaticRoutingTrieTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Check the route to a destination.
+     *
+     * \param routing the static routing
+     * \param ipv4 the IPv4 stack of the node
+     * \param dest the destination
+     * \param oif the output device, if any
+     */
+    void CheckRoute(Ptr<Ipv4StaticRouting> routing,
+                    Ptr<Ipv4> ipv4,
+                    Ipv4Address dest,
+                    Ptr<NetDevice> oif);
+};
+
+Ipv4StaticRoutingTrieTestCase::Ipv4StaticRoutingTrieTestCase()
+    : TestCase("Check the routes selected by Ipv4StaticRouting against a linear search")
+{
+}
+
+void
+Ipv4StaticRoutingTrieTestCase::CheckRoute(Ptr<Ipv4StaticRouting> routing,
+                                          Ptr<Ipv4> ipv4,
+                                          Ipv4Address dest,
+                                          Ptr<NetDevice> oif)
+{
+    int expected = -1;
+    uint16_t longestMask = 0;
+    uint32_t shortestMetric = 0xffffffff;
+    for (uint32_t i = 0; i < routing->GetNRoutes(); ++i)
+    {
+        Ipv4RoutingTableEntry route = routing->GetRoute(i);
+        uint32_t metric = routing->GetMetric(i);
+        Ipv4Mask mask = route.GetDestNetworkMask();
+        uint16_t masklen = mask.GetPrefixLength();
+        if (!mask.IsMatch(dest, route.GetDestNetwork()) ||
+            (oif && oif != ipv4->GetNetDevice(route.GetInterface())) || masklen < longestMask)
+        {
+            continue;
+        }
+        if (masklen > longestMask)
+        {
+            shortestMetric = 0xffffffff;
+        }
+        longestMask = masklen;
+        if (metric > shortestMetric)
+        {
+            continue;
+        }
+        shortestMetric = metric;
+        expected = i;
+        if (masklen == 32)
+        {
+            break;
+        }
+    }
+
+    Ipv4Header header;
+    header.SetDestination(dest);
+    Socket::SocketErrno sockerr;
+    Ptr<Ipv4Route> route = routing->RouteOutput(Create<Packet>(), header, oif, sockerr);
+    if (expected < 0)
+    {
+        NS_TEST_ASSERT_MSG_EQ(route, nullptr, "Unexpected route to " << dest);
+        return;
+    }
+    NS_TEST_ASSERT_MSG_NE(route, nullptr, "No route to " << dest);
+    Ipv4RoutingTableEntry entry = routing->GetRoute(expected);
+    NS_TEST_ASSERT_MSG_EQ(route->GetGateway(),
+                          entry.GetGateway(),
+                          "Unexpected gateway to " << dest);
+    NS_TEST_ASSERT_MSG_EQ(route->GetOutputDevice(),
+                          ipv4->GetNetDevice(entry.GetInterface()),
+                          "Unexpected output device to " << dest);
+}
+
+void
+Ipv4StaticRoutingTrieTestCase::DoRun()
+{
+    Ptr<Node> node = CreateObject<Node>();
+    InternetStackHelper internet;
+    internet.Install(node);
+    Ptr<Ipv4> ipv4 = node->GetObject<Ipv4>();
+    std::vector<Ptr<NetDevice>> devices;
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice>();
+        device->SetAddress(Mac48Address::Allocate());
+        node->AddDevice(device);
+        int32_t ifIndex = ipv4->AddInterface(device);
+        ipv4->AddAddress(ifIndex, Ipv4InterfaceAddress(Ipv4Address(0x0a000001 + (i << 16)),
+                                                       Ipv4Mask("/16")));
+        ipv4->SetUp(ifIndex);
+        devices.push_back(device);
+    }
+    Ptr<Ipv4StaticRouting> routing = Ipv4StaticRoutingHelper().GetStaticRouting(ipv4);
+
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable>();
+    rng->SetStream(1);
+    std::vector<uint32_t> bases{0x0a000000, 0x0a010000, 0xc0a80000, 0x2d2d0000};
+    auto randomAddress = [&rng, &bases]() {
+        return Ipv4Address(bases[rng->GetInteger(0, bases.size() - 1)] ^
+                           (1U << rng->GetInteger(0, 31) >> rng->GetInteger(0, 31)));
+    };
+    for (uint32_t i = 0; i < 400; ++i)
+    {
+        uint32_t length = rng->GetInteger(0, 32);
+        Ipv4Mask mask(length == 0 ? 0 : ~0U << (32 - length));
+        if (i % 50 == 0)
+        {
+            mask = Ipv4Mask(0xff00ff00); // a non-contiguous mask
+        }
+        Ipv4Address gateway(0x0a000000 + (rng->GetInteger(0, 1) << 16) + 2 + i);
+        uint32_t interface = rng->GetInteger(1, 2);
+        uint32_t metric = rng->GetInteger(0, 2);
+        if (length == 32 && i % 2 == 0)
+        {
+            routing->AddHostRouteTo(randomAddress(), gateway, interface, metric);
+        }
+        else
+        {
+            routing->AddNetworkRouteTo(randomAddress().CombineMask(mask),
+                                       mask,
+                                       gateway,
+                                       interface,
+                                       metric);
+        }
+    }
+    routing->SetDefaultRoute(Ipv4Address("10.0.0.254"), 1, 5);
+
+    for (uint32_t round = 0; round < 2; ++round)
+    {
+        for (uint32_t i = 0; i < 2000; ++i)
+        {
+            Ipv4Address dest = randomAddress();
+            CheckRoute(routing, ipv4, dest, nullptr);
+            CheckRoute(routing, ipv4, dest, devices[i % 2]);
+        }
+        // remove routes, including some on the same prefixes as remaining ones
+        for (uint32_t i = 0; i < 150; ++i)
+        {
+            routing->RemoveRoute(rng->GetInteger(0, routing->GetNRoutes() - 1));
+        }
+    }
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup internet-test
+ *
+ * \brief PrefixTrie TestSuite
+ */
+class PrefixTrieTestSuite : public TestSuite
+{
+  public:
+    PrefixTrieTestSuite();
+};
+
+PrefixTrieTestSuite::PrefixTrieTestSuite()
+    : TestSuite("prefix-trie", UNIT)
+{
+    AddTestCase(new PrefixTrieTestCase<4>, TestCase::QUICK);
+    AddTestCase(new PrefixTrieTestCase<16>, TestCase::QUICK);
+    AddTestCase(new Ipv4StaticRoutingTrieTestCase, TestCase::QUICK);
+}
+
+static PrefixTrieTestSuite g_prefixTrieTestSuite; //!< Static variable for test initialization
@@ -155,13 +155,8 @@ main(int argc, char* argv[])
     // keep track of all path loss values in two centralized objects
     DownlinkLteGlobalPathlossDatabase dlPathlossDb;
     UplinkLteGlobalPathlossDatabase ulPathlossDb;
-    // we rely on the fact that LteHelper creates the DL channel object first, then the UL channel
-    // object, hence the former will have index 0 and the latter 1
-    Config::Connect(
-        "/ChannelList/0/PathLoss",
-        MakeCallback(&DownlinkLteGlobalPathlossDatabase::UpdatePathloss, &dlPathlossDb));
-    Config::Connect("/ChannelList/1/PathLoss",
-                    MakeCallback(&UplinkLteGlobalPathlossDatabase::UpdatePathloss, &ulPathlossDb));
+    dlPathlossDb.ConnectWithoutContext(lteHelper->GetDownlinkSpectrumChannel());
+    ulPathlossDb.ConnectWithoutContext(lteHelper->GetUplinkSpectrumChannel());
 
     Simulator::Run();
 
@@ -0,0 +1,505 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#ifdef __GNUC__
+#include <cxxabi.h>
+#endif
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup lte
+ *
+ * Scaling benchmark of the LTE module.
+ *
+ * The program sweeps the number of three-sector sites of a 3GPP hexagonal
+ * grid, the number of UEs per cell and the offered load of a bidirectional
+ * UDP flow per UE going through a point-to-point EPC. For each
+ * configuration, it prints one line with the wall clock time per simulated
+ * second, the number of events per second, the peak resident set size and
+ * the share of the wall clock time spent in the events of each layer, e.g.:
+ *
+ * \code
+ *   ./ns3 run "lena-scaling-benchmark --rings=1,2,3 --uesPerCell=1,10 --rates=64,1024"
+ * \endcode
+ *
+ * The layer of an event is derived from the class of the function invoked
+ * by the event, and the time of an event is measured by the
+ * LayerProfilingScheduler, from the moment the event is removed from the
+ * scheduler until the next event is removed. Peak RSS is reset between
+ * configurations on Linux only; on other systems it is the peak of the
+ * whole process.
+ */
+
+NS_LOG_COMPONENT_DEFINE("LenaScalingBenchmark");
+
+/// Layers to which the simulation events are attributed
+enum Layer
+{
+    LAYER_PHY,
+    LAYER_MAC,
+    LAYER_RLC_PDCP,
+    LAYER_RRC,
+    LAYER_EPC,
+    LAYER_APP,
+    LAYER_OTHER,
+    LAYER_N
+};
+
+/// Names of the layers, in the order of the Layer enum
+static const char* g_layerNames[LAYER_N] = {"phy", "mac", "rlc-pdcp", "rrc", "epc", "app", "other"};
+
+/// Wall clock time spent in the events of each layer, in seconds
+static double g_layerTime[LAYER_N];
+
+/// Number of events of each layer
+static uint64_t g_layerEvents[LAYER_N];
+
+/**
+ * Get the name of the class whose method is invoked by an event, or the
+ * whole name of the event type if the event does not invoke a method.
+ *
+ * \param event the event
+ * \return the name used to classify the event
+ */
+static std::string
+GetEventName(EventImpl* event)
+{
+    std::string name = typeid(*event).name();
+#ifdef __GNUC__
+    int status;
+    char* demangled = abi::__cxa_demangle(name.c_str(), nullptr, nullptr, &status);
+    if (status == 0)
+    {
+        name = demangled;
+    }
+    std::free(demangled);
+#endif
+    // member function events are named after their pointer to member,
+    // e.g., "void (ns3::LteEnbPhy::*)()"
+    std::size_t end = name.find("::*)");
+    if (end != std::string::npos)
+    {
+        std::size_t begin = name.rfind('(', end);
+        if (begin != std::string::npos)
+        {
+            return name.substr(begin + 1, end - begin - 1);
+        }
+    }
+    return name;
+}
+
+/**
+ * Attribute an event to a layer.
+ *
+ * \param event the event
+ * \return the layer of the event
+ */
+static Layer
+ClassifyEvent(EventImpl* event)
+{
+    // the first matching pattern wins, so the most specific ones come first
+    static const std::vector<std::pair<std::string, Layer>> patterns = {
+        {"Application", LAYER_APP},   {"UdpClient", LAYER_APP},
+        {"UdpServer", LAYER_APP},     {"PacketSink", LAYER_APP},
+        {"MacScheduler", LAYER_MAC},  {"Mac", LAYER_MAC},
+        {"LteRlc", LAYER_RLC_PDCP},   {"LtePdcp", LAYER_RLC_PDCP},
+        {"Rrc", LAYER_RRC},           {"Phy", LAYER_PHY},
+        {"Spectrum", LAYER_PHY},      {"Interference", LAYER_PHY},
+        {"ChunkProcessor", LAYER_PHY}, {"Epc", LAYER_EPC},
+        {"Gtp", LAYER_EPC},           {"PointToPoint", LAYER_EPC},
+        {"Ipv4", LAYER_EPC},          {"Udp", LAYER_EPC},
+        {"Tcp", LAYER_EPC},           {"Arp", LAYER_EPC},
+        {"QueueDisc", LAYER_EPC},     {"TrafficControl", LAYER_EPC},
+    };
+    // typeid lookups are cheap, demangling and matching are done once
+    static std::unordered_map<std::type_index, Layer> cache;
+    std::type_index type = typeid(*event);
+    auto it = cache.find(type);
+    if (it != cache.end())
+    {
+        return it->second;
+    }
+    std::string name = GetEventName(event);
+    Layer layer = LAYER_OTHER;
+    for (const auto& pattern : patterns)
+    {
+        if (name.find(pattern.first) != std::string::npos)
+        {
+            layer = pattern.second;
+            break;
+        }
+    }
+    NS_LOG_DEBUG("event " << name << " attributed to " << g_layerNames[layer]);
+    cache.emplace(type, layer);
+    return layer;
+}
+
+/**
+ * \ingroup lte
+ *
+ * Map scheduler measuring the wall clock time spent in each event, and
+ * attributing it to the layer of the event.
+ */
+class LayerProfilingScheduler : public MapScheduler
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LayerProfilingScheduler();
+    ~LayerProfilingScheduler() override;
+
+    // Inherited
+    Scheduler::Event RemoveNext() override;
+
+  private:
+    /// Attribute the time elapsed since the last event was removed to it.
+    void CloseCurrentEvent();
+
+    Layer m_currentLayer; ///< layer of the event being executed
+    bool m_running;       ///< true if an event is being executed
+    std::chrono::steady_clock::time_point m_start; ///< start of the event being executed
+};
+
+NS_OBJECT_ENSURE_REGISTERED(LayerProfilingScheduler);
+
+TypeId
+LayerProfilingScheduler::GetTypeId()
+{
+    static TypeId tid = TypeId("ns3::LayerProfilingScheduler")
+                            .SetParent<MapScheduler>()
+                            .SetGroupName("Lte")
+                            .AddConstructor<LayerProfilingScheduler>();
+    return tid;
+}
+
+LayerProfilingScheduler::LayerProfilingScheduler()
+    : m_currentLayer(LAYER_OTHER),
+      m_running(false)
+{
+}
+
+LayerProfilingScheduler::~LayerProfilingScheduler()
+{
+    CloseCurrentEvent();
+}
+
+void
+LayerProfilingScheduler::CloseCurrentEvent()
+{
+    if (m_running)
+    {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - m_start;
+        g_layerTime[m_currentLayer] += elapsed.count();
+        m_running = false;
+    }
+}
+
+Scheduler::Event
+LayerProfilingScheduler::RemoveNext()
+{
+    CloseCurrentEvent();
+    Scheduler::Event ev = MapScheduler::RemoveNext();
+    m_currentLayer = ClassifyEvent(ev.impl);
+    g_layerEvents[m_currentLayer]++;
+    m_running = true;
+    m_start = std::chrono::steady_clock::now();
+    return ev;
+}
+
+/**
+ * Reset the peak resident set size of the process, where supported.
+ */
+static void
+ResetPeakRss()
+{
+#ifdef __linux__
+    // writing 5 to clear_refs resets the VmHWM of /proc/self/status
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    clearRefs << "5";
+#endif
+}
+
+/**
+ * \return the peak resident set size of the process, in MiB
+ */
+static double
+GetPeakRssMib()
+{
+#ifdef __linux__
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line))
+    {
+        if (line.compare(0, 6, "VmHWM:") == 0)
+        {
+            return std::stod(line.substr(6)) / 1024.0;
+        }
+    }
+#endif
+#ifndef _WIN32
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024.0 / 1024.0; // bytes
+#else
+    return usage.ru_maxrss / 1024.0; // kilobytes
+#endif
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Parse a comma separated list of unsigned integers.
+ *
+ * \param list the list
+ * \return the values of the list
+ */
+static std::vector<uint32_t>
+ParseList(std::string list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Run one configuration of the benchmark and print its results.
+ *
+ * \param nRings number of rings of sites
+ * \param uesPerCell number of UEs per cell
+ * \param rateKbps offered load per UE and per direction, in kbps
+ * \param packetSize size of the UDP packets, in bytes
+ * \param simTime duration of the simulation
+ */
+static void
+RunConfiguration(uint32_t nRings,
+                 uint32_t uesPerCell,
+                 uint32_t rateKbps,
+                 uint32_t packetSize,
+                 Time simTime)
+{
+    ResetPeakRss();
+    for (uint32_t i = 0; i < LAYER_N; ++i)
+    {
+        g_layerTime[i] = 0;
+        g_layerEvents[i] = 0;
+    }
+    SystemWallClockMs clock;
+    clock.Start();
+
+    Simulator::SetScheduler(ObjectFactory("ns3::LayerProfilingScheduler"));
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    Ptr<PointToPointEpcHelper> epcHelper = CreateObject<PointToPointEpcHelper>();
+    lteHelper->SetEpcHelper(epcHelper);
+    lteHelper->SetAttribute("PathlossModel",
+                            StringValue("ns3::LogDistancePropagationLossModel"));
+    lteHelper->SetEnbAntennaModelType("ns3::Parabolic3dAntennaModel");
+
+    Ptr<Lte3gppHexGridEnbTopologyHelper> topoHelper =
+        CreateObject<Lte3gppHexGridEnbTopologyHelper>();
+    topoHelper->AssignStreams(1);
+    topoHelper->SetLteHelper(lteHelper);
+    topoHelper->SetNumRings(nRings);
+    topoHelper->SetInterSiteDistance(500);
+
+    NodeContainer enbNodes;
+    enbNodes.Create(topoHelper->GetNumNodes());
+    NodeContainer ueNodes;
+    ueNodes.Create(uesPerCell * enbNodes.GetN());
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+    NetDeviceContainer enbDevs = topoHelper->SetPositionAndInstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = topoHelper->DropUEsUniformlyPerSector(ueNodes);
+
+    NodeContainer remoteHostContainer;
+    remoteHostContainer.Create(1);
+    Ptr<Node> remoteHost = remoteHostContainer.Get(0);
+    InternetStackHelper internet;
+    internet.Install(remoteHostContainer);
+    PointToPointHelper p2ph;
+    p2ph.SetDeviceAttribute("DataRate", DataRateValue(DataRate("100Gb/s")));
+    p2ph.SetChannelAttribute("Delay", TimeValue(MilliSeconds(10)));
+    NetDeviceContainer internetDevices = p2ph.Install(epcHelper->GetPgwNode(), remoteHost);
+    Ipv4AddressHelper ipv4h;
+    ipv4h.SetBase("1.0.0.0", "255.0.0.0");
+    Ipv4InterfaceContainer internetIpIfaces = ipv4h.Assign(internetDevices);
+    Ipv4Address remoteHostAddr = internetIpIfaces.GetAddress(1);
+    Ipv4StaticRoutingHelper ipv4RoutingHelper;
+    Ptr<Ipv4StaticRouting> remoteHostStaticRouting =
+        ipv4RoutingHelper.GetStaticRouting(remoteHost->GetObject<Ipv4>());
+    remoteHostStaticRouting->AddNetworkRouteTo(Ipv4Address("7.0.0.0"), Ipv4Mask("255.0.0.0"), 1);
+
+    internet.Install(ueNodes);
+    Ipv4InterfaceContainer ueIpIfaces = epcHelper->AssignUeIpv4Address(ueDevs);
+    for (uint32_t u = 0; u < ueNodes.GetN(); ++u)
+    {
+        Ptr<Ipv4StaticRouting> ueStaticRouting =
+            ipv4RoutingHelper.GetStaticRouting(ueNodes.Get(u)->GetObject<Ipv4>());
+        ueStaticRouting->SetDefaultRoute(epcHelper->GetUeDefaultGatewayAddress(), 1);
+    }
+    lteHelper->Attach(ueDevs);
+
+    Time interval = Seconds(packetSize * 8.0 / (rateKbps * 1000.0));
+    uint16_t dlPort = 1100;
+    uint16_t ulPort = 2000;
+    ApplicationContainer clientApps;
+    ApplicationContainer serverApps;
+    PacketSinkHelper dlSinkHelper("ns3::UdpSocketFactory",
+                                  InetSocketAddress(Ipv4Address::GetAny(), dlPort));
+    PacketSinkHelper ulSinkHelper("ns3::UdpSocketFactory",
+                                  InetSocketAddress(Ipv4Address::GetAny(), ulPort));
+    serverApps.Add(ulSinkHelper.Install(remoteHost));
+    for (uint32_t u = 0; u < ueNodes.GetN(); ++u)
+    {
+        serverApps.Add(dlSinkHelper.Install(ueNodes.Get(u)));
+        UdpClientHelper dlClient(ueIpIfaces.GetAddress(u), dlPort);
+        dlClient.SetAttribute("Interval", TimeValue(interval));
+        dlClient.SetAttribute("MaxPackets", UintegerValue(1000000000));
+        dlClient.SetAttribute("PacketSize", UintegerValue(packetSize));
+        clientApps.Add(dlClient.Install(remoteHost));
+        UdpClientHelper ulClient(remoteHostAddr, ulPort);
+        ulClient.SetAttribute("Interval", TimeValue(interval));
+        ulClient.SetAttribute("MaxPackets", UintegerValue(1000000000));
+        ulClient.SetAttribute("PacketSize", UintegerValue(packetSize));
+        clientApps.Add(ulClient.Install(ueNodes.Get(u)));
+    }
+    serverApps.Start(MilliSeconds(100));
+    clientApps.Start(MilliSeconds(100));
+
+    int64_t setupMs = clock.End();
+    clock.Start();
+    Simulator::Stop(simTime);
+    Simulator::Run();
+    int64_t runMs = clock.End();
+    uint64_t nEvents = Simulator::GetEventCount();
+    double peakRssMib = GetPeakRssMib();
+    Simulator::Destroy(); // also destroys the scheduler, which closes the last event
+
+    double runS = std::max<int64_t>(runMs, 1) / 1000.0;
+    double profiledS = 0;
+    for (uint32_t i = 0; i < LAYER_N; ++i)
+    {
+        profiledS += g_layerTime[i];
+    }
+    std::cout << std::fixed << std::setprecision(3) << enbNodes.GetN() / 3 << "\t"
+              << enbNodes.GetN() << "\t" << ueNodes.GetN() << "\t" << rateKbps << "\t"
+              << setupMs / 1000.0 << "\t" << runS << "\t" << runS / simTime.GetSeconds() << "\t"
+              << nEvents << "\t" << std::setprecision(0) << nEvents / runS << "\t"
+              << std::setprecision(1) << peakRssMib;
+    for (uint32_t i = 0; i < LAYER_N; ++i)
+    {
+        std::cout << "\t" << (profiledS > 0 ? 100 * g_layerTime[i] / profiledS : 0);
+    }
+    std::cout << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string rings = "1,2,3";
+    std::string uesPerCell = "1,5,10";
+    std::string rates = "64,512";
+    uint32_t packetSize = 1024;
+    double simTime = 1.0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("rings",
+                 "Comma separated numbers of rings of sites (1, 2, 3 rings = 1, 7, 19 sites)",
+                 rings);
+    cmd.AddValue("uesPerCell", "Comma separated numbers of UEs per cell", uesPerCell);
+    cmd.AddValue("rates", "Comma separated offered loads per UE and direction [kbps]", rates);
+    cmd.AddValue("packetSize", "Size of the UDP packets [bytes]", packetSize);
+    cmd.AddValue("simTime", "Duration of each simulation [s]", simTime);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue(320));
+    Config::SetDefault("ns3::LteRlcUm::MaxTxBufferSize", UintegerValue(100 * 1024));
+
+    std::cout << "sites\tcells\tUEs\tkbps\tsetup(s)\twall(s)\twall/sim\tevents\tevents/s\t"
+              << "peakRSS(MiB)";
+    for (uint32_t i = 0; i < LAYER_N; ++i)
+    {
+        std::cout << "\t" << g_layerNames[i] << "(%)";
+    }
+    std::cout << std::endl;
+
+    for (uint32_t nRings : ParseList(rings))
+    {
+        for (uint32_t nUes : ParseList(uesPerCell))
+        {
+            for (uint32_t rate : ParseList(rates))
+            {
+                RunConfiguration(nRings, nUes, rate, packetSize, Seconds(simTime));
+            }
+        }
+    }
+    return 0;
+}
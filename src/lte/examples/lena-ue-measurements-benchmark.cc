@@ -0,0 +1,173 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/lte-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup lte
+ *
+ * Benchmark of the UE physical layer measurements (CQI, RSRP and RSRQ).
+ *
+ * The scenario is a 3GPP hexagonal grid of three-sector sites (19 sites with
+ * the default 3 rings) where every UE detects the PSS of all the cells in
+ * range and reports wideband and subband CQI. Only the radio access network
+ * is simulated, with saturated RLC SM bearers.
+ *
+ * At the end of the simulation, the program prints the wall clock time spent
+ * in Simulator::Run (), the number of simulated events and the number of
+ * per-cell measurement samples reported by the UEs, e.g.:
+ *
+ * \code
+ *   ./ns3 run "lena-ue-measurements-benchmark --nRings=3 --nUesPerSector=10"
+ * \endcode
+ */
+
+NS_LOG_COMPONENT_DEFINE("LenaUeMeasurementsBenchmark");
+
+/// Number of per-cell measurement samples reported by the UEs
+static uint64_t g_nMeasurements = 0;
+
+/**
+ * Count the measurement samples reported by the UE PHY.
+ *
+ * \param context the trace context
+ * \param rnti the RNTI of the UE
+ * \param cellId the cell ID of the measured cell
+ * \param rsrp the averaged RSRP
+ * \param rsrq the averaged RSRQ
+ * \param isServingCell true if the measured cell is the serving cell
+ * \param componentCarrierId the component carrier ID
+ */
+void
+UeMeasurementsCallback(std::string context,
+                       uint16_t rnti,
+                       uint16_t cellId,
+                       double rsrp,
+                       double rsrq,
+                       bool isServingCell,
+                       uint8_t componentCarrierId)
+{
+    g_nMeasurements++;
+}
+
+int
+main(int argc, char* argv[])
+{
+    uint32_t nRings = 3;
+    uint32_t nUesPerSector = 5;
+    uint16_t bandwidth = 50;
+    double interSiteDistance = 500;
+    double simTime = 1.0;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("nRings",
+                 "Number of rings of hexagonal sites (3 rings correspond to 19 sites)",
+                 nRings);
+    cmd.AddValue("nUesPerSector", "Number of UEs per sector", nUesPerSector);
+    cmd.AddValue("bandwidth", "DL and UL bandwidth [num RBs]", bandwidth);
+    cmd.AddValue("interSiteDistance", "Distance between sites [m]", interSiteDistance);
+    cmd.AddValue("simTime", "Total duration of the simulation [s]", simTime);
+    cmd.Parse(argc, argv);
+
+    // Report subband CQI every TTI so that the AMC is exercised as much as
+    // the RSRP/RSRQ measurements
+    Config::SetDefault("ns3::LteUePhy::DownlinkCqiPeriodicity", TimeValue(MilliSeconds(1)));
+    Config::SetDefault("ns3::LteEnbRrc::SrsPeriodicity", UintegerValue(320));
+
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetEnbDeviceAttribute("DlBandwidth", UintegerValue(bandwidth));
+    lteHelper->SetEnbDeviceAttribute("UlBandwidth", UintegerValue(bandwidth));
+    lteHelper->SetAttribute("PathlossModel",
+                            StringValue("ns3::LogDistancePropagationLossModel"));
+    lteHelper->SetEnbAntennaModelType("ns3::Parabolic3dAntennaModel");
+
+    Ptr<Lte3gppHexGridEnbTopologyHelper> topoHelper =
+        CreateObject<Lte3gppHexGridEnbTopologyHelper>();
+    topoHelper->AssignStreams(1);
+    topoHelper->SetLteHelper(lteHelper);
+    topoHelper->SetNumRings(nRings);
+    topoHelper->SetInterSiteDistance(interSiteDistance);
+
+    NodeContainer enbNodes;
+    enbNodes.Create(topoHelper->GetNumNodes());
+    NodeContainer ueNodes;
+    ueNodes.Create(nUesPerSector * enbNodes.GetN());
+
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(enbNodes);
+    mobility.Install(ueNodes);
+
+    NetDeviceContainer enbDevs = topoHelper->SetPositionAndInstallEnbDevice(enbNodes);
+    NetDeviceContainer ueDevs = topoHelper->DropUEsUniformlyPerSector(ueNodes);
+
+    lteHelper->Attach(ueDevs);
+    EpsBearer bearer(EpsBearer::NGBR_VIDEO_TCP_DEFAULT);
+    lteHelper->ActivateDataRadioBearer(ueDevs, bearer);
+
+    Config::Connect("/NodeList/*/DeviceList/*/ComponentCarrierMapUe/*/LteUePhy/"
+                    "ReportUeMeasurements",
+                    MakeCallback(&UeMeasurementsCallback));
+
+    Simulator::Stop(Seconds(simTime));
+
+    SystemWallClockMs clock;
+    clock.Start();
+    Simulator::Run();
+    int64_t elapsedMs = clock.End();
+    uint64_t nEvents = Simulator::GetEventCount();
+    Simulator::Destroy();
+
+    double elapsedS = std::max<int64_t>(elapsedMs, 1) / 1000.0;
+    std::cout << "sites: " << enbNodes.GetN() / 3 << " cells: " << enbNodes.GetN()
+              << " UEs: " << ueNodes.GetN() << std::endl;
+    std::cout << std::fixed << std::setprecision(3) << "wall clock time: " << elapsedS << " s ("
+              << elapsedS / simTime << " s per simulated second)" << std::endl;
+    std::cout << "events: " << nEvents << " (" << nEvents / elapsedS << " events/s)" << std::endl;
+    std::cout << "UE measurement samples: " << g_nMeasurements << " ("
+              << g_nMeasurements / elapsedS << " samples/s)" << std::endl;
+
+    return 0;
+}
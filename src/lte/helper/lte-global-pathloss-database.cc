@@ -22,7 +22,10 @@
 #include "ns3/lte-enb-net-device.h"
 #include "ns3/lte-spectrum-phy.h"
 #include "ns3/lte-ue-net-device.h"
+#include "ns3/simulator.h"
+#include "ns3/spectrum-channel.h"
 
+#include <algorithm>
 #include <limits>
 
 namespace ns3
@@ -30,20 +33,120 @@ namespace ns3
 
 NS_LOG_COMPONENT_DEFINE("LteGlobalPathlossDatabase");
 
+LteGlobalPathlossDatabase::LteGlobalPathlossDatabase()
+    : m_imsiCapacity(0)
+{
+}
+
 LteGlobalPathlossDatabase::~LteGlobalPathlossDatabase()
 {
+    m_snapshotEvent.Cancel();
+}
+
+void
+LteGlobalPathlossDatabase::UpdatePathloss(std::string context,
+                                          Ptr<const SpectrumPhy> txPhy,
+                                          Ptr<const SpectrumPhy> rxPhy,
+                                          double lossDb)
+{
+    UpdatePathlossWithoutContext(txPhy, rxPhy, lossDb);
+}
+
+void
+LteGlobalPathlossDatabase::ConnectWithoutContext(Ptr<SpectrumChannel> channel)
+{
+    NS_LOG_FUNCTION(this << channel);
+    channel->TraceConnectWithoutContext(
+        "PathLoss",
+        MakeCallback(&LteGlobalPathlossDatabase::UpdatePathlossWithoutContext, this));
+}
+
+std::size_t
+LteGlobalPathlossDatabase::GetIndex(uint16_t cellId, uint64_t imsi)
+{
+    auto cellIt = m_cellIndex.find(cellId);
+    if (cellIt == m_cellIndex.end())
+    {
+        cellIt = m_cellIndex.emplace(cellId, m_cellIds.size()).first;
+        m_cellIds.push_back(cellId);
+        m_pathloss.resize(m_cellIds.size() * m_imsiCapacity,
+                          std::numeric_limits<double>::infinity());
+    }
+    auto imsiIt = m_imsiIndex.find(imsi);
+    if (imsiIt == m_imsiIndex.end())
+    {
+        imsiIt = m_imsiIndex.emplace(imsi, m_imsis.size()).first;
+        m_imsis.push_back(imsi);
+        if (m_imsis.size() > m_imsiCapacity)
+        {
+            // grow the rows geometrically, so that the matrix is moved
+            // only a logarithmic number of times
+            uint32_t capacity = std::max<uint32_t>(2 * m_imsiCapacity, 16);
+            std::vector<double> pathloss(m_cellIds.size() * capacity,
+                                         std::numeric_limits<double>::infinity());
+            for (std::size_t row = 0; row < m_cellIds.size(); ++row)
+            {
+                std::copy(m_pathloss.begin() + row * m_imsiCapacity,
+                          m_pathloss.begin() + (row + 1) * m_imsiCapacity,
+                          pathloss.begin() + row * capacity);
+            }
+            m_pathloss.swap(pathloss);
+            m_imsiCapacity = capacity;
+        }
+    }
+    return static_cast<std::size_t>(cellIt->second) * m_imsiCapacity + imsiIt->second;
+}
+
+uint16_t
+LteGlobalPathlossDatabase::GetCellId(Ptr<const SpectrumPhy> phy)
+{
+    auto it = m_phyIds.find(PeekPointer(phy));
+    if (it == m_phyIds.end())
+    {
+        uint16_t cellId = phy->GetDevice()->GetObject<LteEnbNetDevice>()->GetCellId();
+        it = m_phyIds.emplace(PeekPointer(phy), cellId).first;
+        m_phys.push_back(phy);
+    }
+    return static_cast<uint16_t>(it->second);
+}
+
+uint64_t
+LteGlobalPathlossDatabase::GetImsi(Ptr<const SpectrumPhy> phy)
+{
+    auto it = m_phyIds.find(PeekPointer(phy));
+    if (it == m_phyIds.end())
+    {
+        uint64_t imsi = phy->GetDevice()->GetObject<LteUeNetDevice>()->GetImsi();
+        it = m_phyIds.emplace(PeekPointer(phy), imsi).first;
+        m_phys.push_back(phy);
+    }
+    return it->second;
+}
+
+void
+LteGlobalPathlossDatabase::SetPathloss(uint16_t cellId, uint64_t imsi, double lossDb)
+{
+    m_pathloss[GetIndex(cellId, imsi)] = lossDb;
 }
 
 void
 LteGlobalPathlossDatabase::Print()
 {
     NS_LOG_FUNCTION(this);
-    for (auto cellIdIt = m_pathlossMap.begin(); cellIdIt != m_pathlossMap.end(); ++cellIdIt)
+    std::vector<uint16_t> cellIds = m_cellIds;
+    std::sort(cellIds.begin(), cellIds.end());
+    std::vector<uint64_t> imsis = m_imsis;
+    std::sort(imsis.begin(), imsis.end());
+    for (auto cellId : cellIds)
     {
-        for (auto imsiIt = cellIdIt->second.begin(); imsiIt != cellIdIt->second.end(); ++imsiIt)
+        for (auto imsi : imsis)
         {
-            std::cout << "CellId: " << cellIdIt->first << " IMSI: " << imsiIt->first
-                      << " pathloss: " << imsiIt->second << " dB" << std::endl;
+            double pathloss = GetPathloss(cellId, imsi);
+            if (pathloss != std::numeric_limits<double>::infinity())
+            {
+                std::cout << "CellId: " << cellId << " IMSI: " << imsi << " pathloss: " << pathloss
+                          << " dB" << std::endl;
+            }
         }
     }
 }
@@ -52,41 +155,78 @@ double
 LteGlobalPathlossDatabase::GetPathloss(uint16_t cellId, uint64_t imsi)
 {
     NS_LOG_FUNCTION(this);
-    auto cellIt = m_pathlossMap.find(cellId);
-    if (cellIt == m_pathlossMap.end())
+    auto cellIt = m_cellIndex.find(cellId);
+    if (cellIt == m_cellIndex.end())
     {
         return std::numeric_limits<double>::infinity();
     }
-    auto ueIt = cellIt->second.find(imsi);
-    if (ueIt == cellIt->second.end())
+    auto imsiIt = m_imsiIndex.find(imsi);
+    if (imsiIt == m_imsiIndex.end())
     {
         return std::numeric_limits<double>::infinity();
     }
-    return ueIt->second;
+    return m_pathloss[static_cast<std::size_t>(cellIt->second) * m_imsiCapacity + imsiIt->second];
+}
+
+void
+LteGlobalPathlossDatabase::WriteSnapshot(std::ostream& os) const
+{
+    NS_LOG_FUNCTION(this);
+    double now = Simulator::Now().GetSeconds();
+    uint32_t nCells = m_cellIds.size();
+    uint32_t nImsis = m_imsis.size();
+    os.write(reinterpret_cast<const char*>(&now), sizeof(now));
+    os.write(reinterpret_cast<const char*>(&nCells), sizeof(nCells));
+    os.write(reinterpret_cast<const char*>(&nImsis), sizeof(nImsis));
+    os.write(reinterpret_cast<const char*>(m_cellIds.data()), nCells * sizeof(uint16_t));
+    os.write(reinterpret_cast<const char*>(m_imsis.data()), nImsis * sizeof(uint64_t));
+    for (uint32_t row = 0; row < nCells; ++row)
+    {
+        os.write(reinterpret_cast<const char*>(m_pathloss.data() + row * m_imsiCapacity),
+                 nImsis * sizeof(double));
+    }
+}
+
+void
+LteGlobalPathlossDatabase::EnablePeriodicSnapshots(std::string fileName, Time interval)
+{
+    NS_LOG_FUNCTION(this << fileName << interval);
+    NS_ABORT_MSG_IF(!interval.IsStrictlyPositive(), "the snapshot interval must be positive");
+    m_snapshotFile.open(fileName, std::ios_base::out | std::ios_base::binary);
+    NS_ABORT_MSG_IF(!m_snapshotFile.is_open(), "Can't open file " << fileName);
+    m_snapshotInterval = interval;
+    m_snapshotEvent.Cancel();
+    m_snapshotEvent =
+        Simulator::Schedule(interval, &LteGlobalPathlossDatabase::PeriodicSnapshot, this);
+}
+
+void
+LteGlobalPathlossDatabase::PeriodicSnapshot()
+{
+    NS_LOG_FUNCTION(this);
+    WriteSnapshot(m_snapshotFile);
+    m_snapshotFile.flush();
+    m_snapshotEvent = Simulator::Schedule(m_snapshotInterval,
+                                          &LteGlobalPathlossDatabase::PeriodicSnapshot,
+                                          this);
 }
 
 void
-DownlinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context,
-                                                  Ptr<const SpectrumPhy> txPhy,
-                                                  Ptr<const SpectrumPhy> rxPhy,
-                                                  double lossDb)
+DownlinkLteGlobalPathlossDatabase::UpdatePathlossWithoutContext(Ptr<const SpectrumPhy> txPhy,
+                                                                Ptr<const SpectrumPhy> rxPhy,
+                                                                double lossDb)
 {
     NS_LOG_FUNCTION(this << lossDb);
-    uint16_t cellId = txPhy->GetDevice()->GetObject<LteEnbNetDevice>()->GetCellId();
-    uint16_t imsi = rxPhy->GetDevice()->GetObject<LteUeNetDevice>()->GetImsi();
-    m_pathlossMap[cellId][imsi] = lossDb;
+    SetPathloss(GetCellId(txPhy), GetImsi(rxPhy), lossDb);
 }
 
 void
-UplinkLteGlobalPathlossDatabase::UpdatePathloss(std::string context,
-                                                Ptr<const SpectrumPhy> txPhy,
-                                                Ptr<const SpectrumPhy> rxPhy,
-                                                double lossDb)
+UplinkLteGlobalPathlossDatabase::UpdatePathlossWithoutContext(Ptr<const SpectrumPhy> txPhy,
+                                                              Ptr<const SpectrumPhy> rxPhy,
+                                                              double lossDb)
 {
     NS_LOG_FUNCTION(this << lossDb);
-    uint16_t imsi = txPhy->GetDevice()->GetObject<LteUeNetDevice>()->GetImsi();
-    uint16_t cellId = rxPhy->GetDevice()->GetObject<LteEnbNetDevice>()->GetCellId();
-    m_pathlossMap[cellId][imsi] = lossDb;
+    SetPathloss(GetCellId(rxPhy), GetImsi(txPhy), lossDb);
 }
 
 } // namespace ns3
@@ -20,16 +20,22 @@
 #ifndef LTE_GLOBAL_PATHLOSS_DATABASE_H
 #define LTE_GLOBAL_PATHLOSS_DATABASE_H
 
+#include <ns3/event-id.h>
 #include <ns3/log.h>
+#include <ns3/nstime.h>
 #include <ns3/ptr.h>
 
-#include <map>
+#include <fstream>
+#include <ostream>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
 
 class SpectrumPhy;
+class SpectrumChannel;
 
 /**
  * \ingroup lte
@@ -38,10 +44,28 @@ class SpectrumPhy;
  * example of how the PathlossTrace (provided by some SpectrumChannel
  * implementations) work.
  *
+ * The pathloss values are stored in a dense matrix with one row per cell
+ * and one column per UE, in the order in which cells and UEs are first
+ * seen, so that updates do not allocate memory once all the pairs have been
+ * seen. The cell ID and IMSI of each PHY are resolved only once.
+ *
+ * The database can be connected to the PathLoss trace source of a channel
+ * either with a context (UpdatePathloss) or, more efficiently, without it
+ * (UpdatePathlossWithoutContext or ConnectWithoutContext). The content of
+ * the database can be periodically exported to a binary file for offline
+ * coverage analysis (see EnablePeriodicSnapshots).
+ *
+ * Each snapshot of the binary file, in host byte order, is made of:
+ * - the snapshot time in seconds (double);
+ * - the number of cells C and of UEs U (two uint32_t);
+ * - the C cell IDs (uint16_t) followed by the U IMSIs (uint64_t);
+ * - the C x U pathloss values in dB (double), cell by cell, where pairs
+ *   never updated are set to infinity.
  */
 class LteGlobalPathlossDatabase
 {
   public:
+    LteGlobalPathlossDatabase();
     virtual ~LteGlobalPathlossDatabase();
 
     /**
@@ -52,10 +76,39 @@ class LteGlobalPathlossDatabase
      * \param rxPhy the receiving PHY
      * \param lossDb the loss in dB
      */
-    virtual void UpdatePathloss(std::string context,
-                                Ptr<const SpectrumPhy> txPhy,
-                                Ptr<const SpectrumPhy> rxPhy,
-                                double lossDb) = 0;
+    void UpdatePathloss(std::string context,
+                        Ptr<const SpectrumPhy> txPhy,
+                        Ptr<const SpectrumPhy> rxPhy,
+                        double lossDb);
+
+    /**
+     * update the pathloss value; to be connected to the PathLoss trace source
+     * of a channel without context
+     *
+     * \param txPhy the transmitting PHY
+     * \param rxPhy the receiving PHY
+     * \param lossDb the loss in dB
+     */
+    virtual void UpdatePathlossWithoutContext(Ptr<const SpectrumPhy> txPhy,
+                                              Ptr<const SpectrumPhy> rxPhy,
+                                              double lossDb) = 0;
+
+    /**
+     * Connect UpdatePathlossWithoutContext to the PathLoss trace source of a
+     * channel.
+     *
+     * \param channel the channel
+     */
+    void ConnectWithoutContext(Ptr<SpectrumChannel> channel);
+
+    /**
+     * Store a pathloss value.
+     *
+     * \param cellId the id of the eNB
+     * \param imsi the id of the UE
+     * \param lossDb the loss in dB
+     */
+    void SetPathloss(uint16_t cellId, uint64_t imsi, double lossDb);
 
     /**
      *
@@ -73,12 +126,60 @@ class LteGlobalPathlossDatabase
      */
     void Print();
 
+    /**
+     * Write a binary snapshot of the stored pathloss values.
+     *
+     * \param os the output stream
+     */
+    void WriteSnapshot(std::ostream& os) const;
+
+    /**
+     * Periodically append a binary snapshot of the stored pathloss values to
+     * a file, starting after the first interval.
+     *
+     * \param fileName the name of the file
+     * \param interval the time between two snapshots
+     */
+    void EnablePeriodicSnapshots(std::string fileName, Time interval);
+
   protected:
     /**
-     * List of the last pathloss value for each UE by CellId.
-     * ( CELL ID,  ( IMSI,PATHLOSS ))
+     * Get the position of the pathloss value of a cell and UE in the matrix,
+     * adding a row and/or a column if needed.
+     *
+     * \param cellId the id of the eNB
+     * \param imsi the id of the UE
+     * \return the index of the value in m_pathloss
+     */
+    std::size_t GetIndex(uint16_t cellId, uint64_t imsi);
+
+    /**
+     * \param phy the PHY of an eNB
+     * \return the cell ID of the eNB, cached after the first call
+     */
+    uint16_t GetCellId(Ptr<const SpectrumPhy> phy);
+
+    /**
+     * \param phy the PHY of a UE
+     * \return the IMSI of the UE, cached after the first call
      */
-    std::map<uint16_t, std::map<uint64_t, double>> m_pathlossMap;
+    uint64_t GetImsi(Ptr<const SpectrumPhy> phy);
+
+  private:
+    /// Write a snapshot to the snapshot file and schedule the next one.
+    void PeriodicSnapshot();
+
+    std::vector<uint16_t> m_cellIds;                     ///< cell ID of each row
+    std::vector<uint64_t> m_imsis;                       ///< IMSI of each column
+    std::unordered_map<uint16_t, uint32_t> m_cellIndex;  ///< row of each cell ID
+    std::unordered_map<uint64_t, uint32_t> m_imsiIndex;  ///< column of each IMSI
+    uint32_t m_imsiCapacity;                             ///< number of allocated columns
+    std::vector<double> m_pathloss;                      ///< pathloss matrix, row by row
+    std::unordered_map<const SpectrumPhy*, uint64_t> m_phyIds; ///< cell ID or IMSI of each PHY
+    std::vector<Ptr<const SpectrumPhy>> m_phys; ///< PHYs in m_phyIds, kept alive
+    std::ofstream m_snapshotFile;               ///< file of the periodic snapshots
+    Time m_snapshotInterval;                    ///< time between two snapshots
+    EventId m_snapshotEvent;                    ///< next periodic snapshot
 };
 
 /**
@@ -89,10 +190,9 @@ class DownlinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
   public:
     // inherited from LteGlobalPathlossDatabase
-    void UpdatePathloss(std::string context,
-                        Ptr<const SpectrumPhy> txPhy,
-                        Ptr<const SpectrumPhy> rxPhy,
-                        double lossDb) override;
+    void UpdatePathlossWithoutContext(Ptr<const SpectrumPhy> txPhy,
+                                      Ptr<const SpectrumPhy> rxPhy,
+                                      double lossDb) override;
 };
 
 /**
@@ -103,10 +203,9 @@ class UplinkLteGlobalPathlossDatabase : public LteGlobalPathlossDatabase
 {
   public:
     // inherited from LteGlobalPathlossDatabase
-    void UpdatePathloss(std::string context,
-                        Ptr<const SpectrumPhy> txPhy,
-                        Ptr<const SpectrumPhy> rxPhy,
-                        double lossDb) override;
+    void UpdatePathlossWithoutContext(Ptr<const SpectrumPhy> txPhy,
+                                      Ptr<const SpectrumPhy> rxPhy,
+                                      double lossDb) override;
 };
 
 } // namespace ns3
@@ -269,26 +269,33 @@ LteSidelinkHelper::AssociateForBroadcast(double txPower,
         uint32_t nRxDevices = remainingUes.GetN();
         double rsrpRx = 0;
 
+        // compute the RSRP of all the remaining UEs at once
+        Ptr<SpectrumPhy> txPhy = tx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
+        std::vector<Ptr<SpectrumPhy>> rxPhys;
         for (uint32_t j = 0; j < nRxDevices; ++j)
         {
             Ptr<NetDevice> rx = remainingUes.Get(j);
+            rxPhys.push_back(rx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy());
+        }
+        std::vector<double> rsrps;
+        if (compMethod == LteSidelinkHelper::SLRSRP_PSBCH)
+        {
+            rsrps = SidelinkRsrpCalculator::CalcSlRsrpPsbch(lossModel,
+                                                            txPower,
+                                                            ulEarfcn,
+                                                            ulBandwidth,
+                                                            txPhy,
+                                                            rxPhys);
+        }
+        else
+        {
+            rsrps = SidelinkRsrpCalculator::CalcSlRsrpTxPw(lossModel, txPower, txPhy, rxPhys);
+        }
 
-            Ptr<SpectrumPhy> txPhy = tx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
-            Ptr<SpectrumPhy> rxPhy = rx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
-
-            if (compMethod == LteSidelinkHelper::SLRSRP_PSBCH)
-            {
-                rsrpRx = SidelinkRsrpCalculator::CalcSlRsrpPsbch(lossModel,
-                                                                 txPower,
-                                                                 ulEarfcn,
-                                                                 ulBandwidth,
-                                                                 txPhy,
-                                                                 rxPhy);
-            }
-            else
-            {
-                rsrpRx = SidelinkRsrpCalculator::CalcSlRsrpTxPw(lossModel, txPower, txPhy, rxPhy);
-            }
+        for (uint32_t j = 0; j < nRxDevices; ++j)
+        {
+            Ptr<NetDevice> rx = remainingUes.Get(j);
+            rsrpRx = rsrps[j];
             // If receiver UE is not within RSRP* of X dBm of the transmitter UE then randomly
             // reselect the receiver UE among the UEs that are within the RSRP of X dBm of the
             // transmitter UE and are not part of a group already.
@@ -310,8 +317,6 @@ LteSidelinkHelper::AssociateForBroadcast(double txPower,
             {
                 Ptr<NetDevice> othertx = selectedTx.Get(k);
 
-                Ptr<SpectrumPhy> txPhy =
-                    tx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
                 Ptr<SpectrumPhy> otherTxPhy =
                     othertx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
 
@@ -386,42 +391,49 @@ LteSidelinkHelper::AssociateForBroadcastWithTxEnabledToReceive(double txPower,
         uint32_t nRxDevices = remainingUes.GetN();
         double rsrpRx = 0;
 
+        // compute the RSRP of all the remaining UEs at once
+        Ptr<SpectrumPhy> txPhy = tx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
+        NetDeviceContainer candidateRx;
+        std::vector<Ptr<SpectrumPhy>> rxPhys;
         for (uint32_t j = 0; j < nRxDevices; ++j)
         {
             Ptr<NetDevice> rx = remainingUes.Get(j);
             if (rx->GetNode()->GetId() !=
                 tx->GetNode()->GetId()) // No loopback link possible due to half-duplex
             {
-                Ptr<SpectrumPhy> txPhy =
-                    tx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
-                Ptr<SpectrumPhy> rxPhy =
-                    rx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy();
+                candidateRx.Add(rx);
+                rxPhys.push_back(rx->GetObject<LteUeNetDevice>()->GetPhy()->GetUlSpectrumPhy());
+            }
+        }
+        std::vector<double> rsrps;
+        if (compMethod == LteSidelinkHelper::SLRSRP_PSBCH)
+        {
+            rsrps = SidelinkRsrpCalculator::CalcSlRsrpPsbch(lossModel,
+                                                            txPower,
+                                                            ulEarfcn,
+                                                            ulBandwidth,
+                                                            txPhy,
+                                                            rxPhys);
+        }
+        else
+        {
+            rsrps = SidelinkRsrpCalculator::CalcSlRsrpTxPw(lossModel, txPower, txPhy, rxPhys);
+        }
 
-                if (compMethod == LteSidelinkHelper::SLRSRP_PSBCH)
-                {
-                    rsrpRx = SidelinkRsrpCalculator::CalcSlRsrpPsbch(lossModel,
-                                                                     txPower,
-                                                                     ulEarfcn,
-                                                                     ulBandwidth,
-                                                                     txPhy,
-                                                                     rxPhy);
-                }
-                else
-                {
-                    rsrpRx =
-                        SidelinkRsrpCalculator::CalcSlRsrpTxPw(lossModel, txPower, txPhy, rxPhy);
-                }
-                // If receiver UE is not within RSRP* of X dBm of the transmitter UE then randomly
-                // reselect the receiver UE among the UEs that are within the RSRP of X dBm of the
-                // transmitter UE and are not part of a group already.
-                NS_LOG_DEBUG("\tCandidate Rx= " << rx->GetNode()->GetId() << " Rsrp=" << rsrpRx
-                                                << " required=" << rsrpThreshold);
-                if (rsrpRx >= rsrpThreshold)
-                {
-                    // good receiver
-                    NS_LOG_DEBUG("\tAdding Rx to group");
-                    newGroup.Add(rx);
-                }
+        for (uint32_t j = 0; j < candidateRx.GetN(); ++j)
+        {
+            Ptr<NetDevice> rx = candidateRx.Get(j);
+            rsrpRx = rsrps[j];
+            // If receiver UE is not within RSRP* of X dBm of the transmitter UE then randomly
+            // reselect the receiver UE among the UEs that are within the RSRP of X dBm of the
+            // transmitter UE and are not part of a group already.
+            NS_LOG_DEBUG("\tCandidate Rx= " << rx->GetNode()->GetId() << " Rsrp=" << rsrpRx
+                                            << " required=" << rsrpThreshold);
+            if (rsrpRx >= rsrpThreshold)
+            {
+                // good receiver
+                NS_LOG_DEBUG("\tAdding Rx to group");
+                newGroup.Add(rx);
             }
         }
         groups.push_back(newGroup);
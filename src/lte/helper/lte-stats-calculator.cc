@@ -20,7 +20,9 @@
 
 #include "lte-stats-calculator.h"
 
+#include <ns3/boolean.h>
 #include <ns3/config.h>
+#include <ns3/enum.h>
 #include <ns3/log.h>
 #include <ns3/lte-enb-net-device.h>
 #include <ns3/lte-enb-rrc.h>
@@ -39,7 +41,9 @@ LteStatsCalculator::LteStatsCalculator()
       m_ulOutputFilename(""),
       m_slOutputFilename(""),
       m_slPscchOutputFilename(""),
-      m_slPsdchOutputFilename("")
+      m_slPsdchOutputFilename(""),
+      m_binaryOutput(false),
+      m_binaryCompression(AsyncFileWriter::NONE)
 {
     // Nothing to do here
 }
@@ -52,10 +56,27 @@ LteStatsCalculator::~LteStatsCalculator()
 TypeId
 LteStatsCalculator::GetTypeId()
 {
-    static TypeId tid = TypeId("ns3::LteStatsCalculator")
-                            .SetParent<Object>()
-                            .SetGroupName("Lte")
-                            .AddConstructor<LteStatsCalculator>();
+    static TypeId tid =
+        TypeId("ns3::LteStatsCalculator")
+            .SetParent<Object>()
+            .SetGroupName("Lte")
+            .AddConstructor<LteStatsCalculator>()
+            .AddAttribute("BinaryOutput",
+                          "Whether the statistics with fixed fields are written as binary "
+                          "records, in files named after the text files with a .bin suffix, "
+                          "which are converted to text by utils/binary-trace-to-text.py",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&LteStatsCalculator::m_binaryOutput),
+                          MakeBooleanChecker())
+            .AddAttribute("BinaryCompression",
+                          "Compression of the binary records (GZIP requires zlib), "
+                          "done by the thread which writes them",
+                          EnumValue(AsyncFileWriter::NONE),
+                          MakeEnumAccessor(&LteStatsCalculator::m_binaryCompression),
+                          MakeEnumChecker(AsyncFileWriter::NONE,
+                                          "NONE",
+                                          AsyncFileWriter::GZIP,
+                                          "GZIP"));
     return tid;
 }
 
@@ -331,4 +352,26 @@ LteStatsCalculator::FindImsiForUe(std::string path, uint16_t rnti)
     return imsi;
 }
 
+bool
+LteStatsCalculator::IsBinaryOutput() const
+{
+    return m_binaryOutput;
+}
+
+Ptr<BinaryTraceSink>
+LteStatsCalculator::CreateBinarySink(std::string filename,
+                                     std::string header,
+                                     std::string terminator)
+{
+    NS_LOG_FUNCTION(this << filename);
+    filename += m_binaryCompression == AsyncFileWriter::GZIP ? ".bin.gz" : ".bin";
+    Ptr<BinaryTraceSink> sink =
+        Create<BinaryTraceSink>(filename, header + "\n", terminator, true, m_binaryCompression);
+    if (sink->Fail())
+    {
+        NS_LOG_ERROR("Can't open file " << filename);
+    }
+    return sink;
+}
+
 } // namespace ns3
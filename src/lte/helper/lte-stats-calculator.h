@@ -21,6 +21,7 @@
 #ifndef LTE_STATS_CALCULATOR_H_
 #define LTE_STATS_CALCULATOR_H_
 
+#include "ns3/binary-trace-sink.h"
 #include "ns3/object.h"
 #include "ns3/string.h"
 
@@ -35,6 +36,11 @@ namespace ns3
  * Base class for ***StatsCalculator classes. Provides
  * basic functionality to parse and store IMSI and CellId.
  * Also stores names of output files.
+ *
+ * When the "BinaryOutput" attribute is set, the statistics with fixed
+ * fields are written as binary records by a BinaryTraceSink, in a file
+ * named after the text file with a ".bin" suffix (".bin.gz" if compressed),
+ * which utils/binary-trace-to-text.py converts to the text file.
  */
 
 class LteStatsCalculator : public Object
@@ -224,6 +230,23 @@ class LteStatsCalculator : public Object
      */
     static uint64_t FindImsiForUe(std::string path, uint16_t rnti);
 
+    /**
+     * Checks if the statistics are written as binary records
+     * @return true if the "BinaryOutput" attribute is set
+     */
+    bool IsBinaryOutput() const;
+
+    /**
+     * Creates the binary sink of the records of a text file
+     * @param filename Name of the text file
+     * @param header Header line of the text file, without its line end
+     * @param terminator Characters after the last field of each record
+     * @return the sink
+     */
+    Ptr<BinaryTraceSink> CreateBinarySink(std::string filename,
+                                          std::string header,
+                                          std::string terminator = "\n");
+
   private:
     /**
      * List of IMSI by path in the attribute system
@@ -259,6 +282,16 @@ class LteStatsCalculator : public Object
      * Name of the file where the Sidlink PSDCH results will be saved
      */
     std::string m_slPsdchOutputFilename;
+
+    /**
+     * Whether the statistics are written as binary records
+     */
+    bool m_binaryOutput;
+
+    /**
+     * Compression of the binary records
+     */
+    AsyncFileWriter::Compression m_binaryCompression;
 };
 
 } // namespace ns3
@@ -33,6 +33,21 @@ NS_LOG_COMPONENT_DEFINE("MacStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(MacStatsCalculator);
 
+/// Header of the DL MAC statistics file
+static const char* const DL_HEADER =
+    "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
+/// Header of the UL MAC statistics file
+static const char* const UL_HEADER = "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
+/// Header of the SL UE CCH MAC statistics file
+static const char* const SL_UE_CCH_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tframe\tsframe\tscPrdStartFr\tscPrdStartSf\tresPscch\t"
+    "sizeTb\tpscchRbLen\tpscchStartRb\thopping\thoppingInfo\tpsschRbLen\tpsschStartRb\t"
+    "iTrp\tmcs\tl1GroupDstId\tdropped";
+/// Header of the SL UE SCH MAC statistics file
+static const char* const SL_UE_SCH_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tcurrFr\tcurrSf\tscPrdStartFr\tscPrdStartSf\tpsschRbLen\t"
+    "psschStartRb\tmcs\tsizeTb\trv\tdropped";
+
 MacStatsCalculator::MacStatsCalculator()
     : m_dlFirstWrite(true),
       m_ulFirstWrite(true),
@@ -165,6 +180,26 @@ MacStatsCalculator::DlScheduling(uint16_t cellId,
              << (uint32_t)dlSchedulingCallbackInfo.mcsTb2 << dlSchedulingCallbackInfo.sizeTb2);
     NS_LOG_INFO("Write DL Mac Stats in " << GetDlOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_dlSink)
+        {
+            m_dlSink = CreateBinarySink(GetDlOutputFilename(), DL_HEADER);
+        }
+        m_dlSink->Write(Simulator::Now().GetSeconds(),
+                        (uint32_t)cellId,
+                        imsi,
+                        dlSchedulingCallbackInfo.frameNo,
+                        dlSchedulingCallbackInfo.subframeNo,
+                        dlSchedulingCallbackInfo.rnti,
+                        (uint32_t)dlSchedulingCallbackInfo.mcsTb1,
+                        dlSchedulingCallbackInfo.sizeTb1,
+                        (uint32_t)dlSchedulingCallbackInfo.mcsTb2,
+                        dlSchedulingCallbackInfo.sizeTb2,
+                        (uint32_t)dlSchedulingCallbackInfo.componentCarrierId);
+        return;
+    }
+
     if (m_dlFirstWrite)
     {
         m_dlOutFile.open(GetDlOutputFilename());
@@ -174,8 +209,7 @@ MacStatsCalculator::DlScheduling(uint16_t cellId,
             return;
         }
         m_dlFirstWrite = false;
-        m_dlOutFile
-            << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcsTb1\tsizeTb1\tmcsTb2\tsizeTb2\tccId";
+        m_dlOutFile << DL_HEADER;
         m_dlOutFile << "\n";
     }
 
@@ -206,6 +240,24 @@ MacStatsCalculator::UlScheduling(uint16_t cellId,
                          << size);
     NS_LOG_INFO("Write UL Mac Stats in " << GetUlOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_ulSink)
+        {
+            m_ulSink = CreateBinarySink(GetUlOutputFilename(), UL_HEADER);
+        }
+        m_ulSink->Write(Simulator::Now().GetSeconds(),
+                        (uint32_t)cellId,
+                        imsi,
+                        frameNo,
+                        subframeNo,
+                        rnti,
+                        (uint32_t)mcsTb,
+                        size,
+                        (uint32_t)componentCarrierId);
+        return;
+    }
+
     if (m_ulFirstWrite)
     {
         m_ulOutFile.open(GetUlOutputFilename());
@@ -215,7 +267,7 @@ MacStatsCalculator::UlScheduling(uint16_t cellId,
             return;
         }
         m_ulFirstWrite = false;
-        m_ulOutFile << "% time\tcellId\tIMSI\tframe\tsframe\tRNTI\tmcs\tsize\tccId";
+        m_ulOutFile << UL_HEADER;
         m_ulOutFile << "\n";
     }
 
@@ -239,6 +291,35 @@ MacStatsCalculator::SlUeCchScheduling(SlUeMacStatParameters params)
                          << params.m_psschItrp << params.m_sidelinkDropped);
     NS_LOG_INFO("Write SL UE Mac Stats in " << GetSlUeCchOutputFilename().c_str());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_slUeCchSink)
+        {
+            m_slUeCchSink = CreateBinarySink(GetSlUeCchOutputFilename(), SL_UE_CCH_HEADER);
+        }
+        m_slUeCchSink->Write(params.m_timestamp,
+                             params.m_cellId,
+                             params.m_imsi,
+                             params.m_rnti,
+                             params.m_frameNo,
+                             params.m_subframeNo,
+                             params.m_periodStartFrame,
+                             params.m_periodStartSubframe,
+                             params.m_resIndex,
+                             params.m_tbSize,
+                             (uint16_t)params.m_pscchTxLengthRB,
+                             (uint16_t)params.m_pscchTxStartRB,
+                             (uint16_t)params.m_hopping,
+                             (uint16_t)params.m_hoppingInfo,
+                             (uint16_t)params.m_txLengthRB,
+                             (uint16_t)params.m_txStartRB,
+                             (uint16_t)params.m_psschItrp,
+                             (uint16_t)params.m_mcs,
+                             (uint16_t)params.m_groupDstId,
+                             (uint16_t)params.m_sidelinkDropped);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_slUeCchFirstWrite)
     {
@@ -249,10 +330,7 @@ MacStatsCalculator::SlUeCchScheduling(SlUeMacStatParameters params)
             return;
         }
         m_slUeCchFirstWrite = false;
-        outFile << "% "
-                   "time\tcellId\tIMSI\tRNTI\tframe\tsframe\tscPrdStartFr\tscPrdStartSf\tresPscch\t"
-                   "sizeTb\tpscchRbLen\tpscchStartRb\thopping\thoppingInfo\tpsschRbLen\tpsschStartR"
-                   "b\tiTrp\tmcs\tl1GroupDstId\tdropped";
+        outFile << SL_UE_CCH_HEADER;
         outFile << std::endl;
     }
     else
@@ -297,6 +375,29 @@ MacStatsCalculator::SlUeSchScheduling(SlUeMacStatParameters params)
                          << params.m_txStartRB << params.m_txLengthRB);
     NS_LOG_INFO("Write SL Shared Channel UE Mac Stats in " << GetSlUeSchOutputFilename().c_str());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_slUeSchSink)
+        {
+            m_slUeSchSink = CreateBinarySink(GetSlUeSchOutputFilename(), SL_UE_SCH_HEADER);
+        }
+        m_slUeSchSink->Write(params.m_timestamp,
+                             params.m_cellId,
+                             params.m_imsi,
+                             params.m_rnti,
+                             params.m_frameNo,
+                             params.m_subframeNo,
+                             params.m_periodStartFrame,
+                             params.m_periodStartSubframe,
+                             (uint16_t)params.m_txLengthRB,
+                             (uint16_t)params.m_txStartRB,
+                             (uint16_t)params.m_mcs,
+                             params.m_tbSize,
+                             (uint16_t)params.m_rv,
+                             (uint16_t)params.m_sidelinkDropped);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_slUeSchFirstWrite)
     {
@@ -307,9 +408,7 @@ MacStatsCalculator::SlUeSchScheduling(SlUeMacStatParameters params)
             return;
         }
         m_slUeSchFirstWrite = false;
-        outFile << "% "
-                   "time\tcellId\tIMSI\tRNTI\tcurrFr\tcurrSf\tscPrdStartFr\tscPrdStartSf\tpsschRbLe"
-                   "n\tpsschStartRb\tmcs\tsizeTb\trv\tdropped";
+        outFile << SL_UE_SCH_HEADER;
         outFile << std::endl;
     }
     else
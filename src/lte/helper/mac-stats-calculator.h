@@ -314,6 +314,26 @@ class MacStatsCalculator : public LteStatsCalculator
      * Uplink output trace file
      */
     std::ofstream m_ulOutFile;
+
+    /**
+     * DL MAC binary sink
+     */
+    Ptr<BinaryTraceSink> m_dlSink;
+
+    /**
+     * UL MAC binary sink
+     */
+    Ptr<BinaryTraceSink> m_ulSink;
+
+    /**
+     * SL UE CCH MAC binary sink
+     */
+    Ptr<BinaryTraceSink> m_slUeCchSink;
+
+    /**
+     * SL UE SCH MAC binary sink
+     */
+    Ptr<BinaryTraceSink> m_slUeSchSink;
 };
 
 } // namespace ns3
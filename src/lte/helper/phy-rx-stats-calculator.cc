@@ -33,6 +33,20 @@ NS_LOG_COMPONENT_DEFINE("PhyRxStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(PhyRxStatsCalculator);
 
+/// Header of the DL RX PHY statistics file
+static const char* const DL_RX_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+/// Header of the UL RX PHY statistics file
+static const char* const UL_RX_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+/// Header of the SL RX PHY statistics file
+static const char* const SL_RX_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tavrgSinrPerRb";
+/// Header of the SL RX PSCCH statistics file
+static const char* const SL_PSCCH_RX_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tresPscch\tsizeTb\thopping\thoppingInfo\tpsschRbLen\t"
+    "psschStartRb\tiTrp\tmcs\tl1GroupDstId\tcorrect";
+
 PhyRxStatsCalculator::PhyRxStatsCalculator()
     : m_dlRxFirstWrite(true),
       m_ulRxFirstWrite(true),
@@ -144,6 +158,27 @@ PhyRxStatsCalculator::DlPhyReception(PhyReceptionStatParameters params)
                          << params.m_ndi << params.m_correctness);
     NS_LOG_INFO("Write DL Rx Phy Stats in " << GetDlRxOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_dlRxSink)
+        {
+            m_dlRxSink = CreateBinarySink(GetDlRxOutputFilename(), DL_RX_HEADER);
+        }
+        m_dlRxSink->Write(params.m_timestamp,
+                          (uint32_t)params.m_cellId,
+                          params.m_imsi,
+                          params.m_rnti,
+                          (uint32_t)params.m_txMode,
+                          (uint32_t)params.m_layer,
+                          (uint32_t)params.m_mcs,
+                          params.m_size,
+                          (uint32_t)params.m_rv,
+                          (uint32_t)params.m_ndi,
+                          (uint32_t)params.m_correctness,
+                          (uint32_t)params.m_ccId);
+        return;
+    }
+
     if (m_dlRxFirstWrite)
     {
         m_dlRxOutFile.open(GetDlRxOutputFilename());
@@ -153,8 +188,7 @@ PhyRxStatsCalculator::DlPhyReception(PhyReceptionStatParameters params)
             return;
         }
         m_dlRxFirstWrite = false;
-        m_dlRxOutFile
-            << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+        m_dlRxOutFile << DL_RX_HEADER;
         m_dlRxOutFile << "\n";
     }
 
@@ -180,6 +214,26 @@ PhyRxStatsCalculator::UlPhyReception(PhyReceptionStatParameters params)
                          << params.m_ndi << params.m_correctness);
     NS_LOG_INFO("Write UL Rx Phy Stats in " << GetUlRxOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_ulRxSink)
+        {
+            m_ulRxSink = CreateBinarySink(GetUlRxOutputFilename(), UL_RX_HEADER);
+        }
+        m_ulRxSink->Write(params.m_timestamp,
+                          (uint32_t)params.m_cellId,
+                          params.m_imsi,
+                          params.m_rnti,
+                          (uint32_t)params.m_layer,
+                          (uint32_t)params.m_mcs,
+                          params.m_size,
+                          (uint32_t)params.m_rv,
+                          (uint32_t)params.m_ndi,
+                          (uint32_t)params.m_correctness,
+                          (uint32_t)params.m_ccId);
+        return;
+    }
+
     if (m_ulRxFirstWrite)
     {
         m_ulRxOutFile.open(GetUlRxOutputFilename());
@@ -189,7 +243,7 @@ PhyRxStatsCalculator::UlPhyReception(PhyReceptionStatParameters params)
             return;
         }
         m_ulRxFirstWrite = false;
-        m_ulRxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tccId";
+        m_ulRxOutFile << UL_RX_HEADER;
         m_ulRxOutFile << "\n";
     }
 
@@ -214,6 +268,26 @@ PhyRxStatsCalculator::SlPhyReception(PhyReceptionStatParameters params)
                          << params.m_ndi << params.m_correctness);
     NS_LOG_INFO("Write SL Rx Phy Stats in " << GetSlRxOutputFilename().c_str());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_slRxSink)
+        {
+            m_slRxSink = CreateBinarySink(GetSlRxOutputFilename(), SL_RX_HEADER);
+        }
+        m_slRxSink->Write(params.m_timestamp,
+                          (uint32_t)params.m_cellId,
+                          params.m_imsi,
+                          params.m_rnti,
+                          (uint32_t)params.m_layer,
+                          (uint32_t)params.m_mcs,
+                          params.m_size,
+                          (uint32_t)params.m_rv,
+                          (uint32_t)params.m_ndi,
+                          (uint32_t)params.m_correctness,
+                          (double)params.m_sinrPerRb);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_slRxFirstWrite)
     {
@@ -224,7 +298,7 @@ PhyRxStatsCalculator::SlPhyReception(PhyReceptionStatParameters params)
             return;
         }
         m_slRxFirstWrite = false;
-        outFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tcorrect\tavrgSinrPerRb";
+        outFile << SL_RX_HEADER;
         outFile << std::endl;
     }
     else
@@ -261,6 +335,29 @@ PhyRxStatsCalculator::SlPscchReception(SlPhyReceptionStatParameters params)
                          << (uint16_t)params.m_groupDstId << (uint16_t)params.m_correctness);
     NS_LOG_INFO("Write SL Rx PSCCH Stats in " << GetSlPscchRxOutputFilename().c_str());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_slPscchRxSink)
+        {
+            m_slPscchRxSink = CreateBinarySink(GetSlPscchRxOutputFilename(), SL_PSCCH_RX_HEADER);
+        }
+        m_slPscchRxSink->Write(params.m_timestamp,
+                               params.m_cellId,
+                               params.m_imsi,
+                               params.m_rnti,
+                               params.m_resPscch,
+                               params.m_size,
+                               (uint32_t)params.m_hopping,
+                               (uint32_t)params.m_hoppingInfo,
+                               (uint32_t)params.m_rbLen,
+                               (uint32_t)params.m_rbStart,
+                               (uint32_t)params.m_iTrp,
+                               (uint32_t)params.m_mcs,
+                               (uint32_t)params.m_groupDstId,
+                               (uint32_t)params.m_correctness);
+        return;
+    }
+
     std::ofstream outFile;
     if (m_slPscchRxFirstWrite)
     {
@@ -271,9 +368,7 @@ PhyRxStatsCalculator::SlPscchReception(SlPhyReceptionStatParameters params)
             return;
         }
         m_slPscchRxFirstWrite = false;
-        outFile << "% "
-                   "time\tcellId\tIMSI\tRNTI\tresPscch\tsizeTb\thopping\thoppingInfo\tpsschRbLen\tp"
-                   "sschStartRb\tiTrp\tmcs\tl1GroupDstId\tcorrect";
+        outFile << SL_PSCCH_RX_HEADER;
         outFile << std::endl;
     }
     else
@@ -233,6 +233,26 @@ class PhyRxStatsCalculator : public LteStatsCalculator
      * UL RX PHY output trace file
      */
     std::ofstream m_ulRxOutFile;
+
+    /**
+     * DL RX PHY binary sink
+     */
+    Ptr<BinaryTraceSink> m_dlRxSink;
+
+    /**
+     * UL RX PHY binary sink
+     */
+    Ptr<BinaryTraceSink> m_ulRxSink;
+
+    /**
+     * SL RX PHY binary sink
+     */
+    Ptr<BinaryTraceSink> m_slRxSink;
+
+    /**
+     * SL RX PSCCH binary sink
+     */
+    Ptr<BinaryTraceSink> m_slPscchRxSink;
 };
 
 } // namespace ns3
@@ -32,6 +32,12 @@ NS_LOG_COMPONENT_DEFINE("PhyStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(PhyStatsCalculator);
 
+/// Header of the RSRP/SINR statistics file
+static const char* const RSRP_HEADER = "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
+/// Header of the UE SINR statistics file
+static const char* const UE_SINR_HEADER =
+    "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
+
 PhyStatsCalculator::PhyStatsCalculator()
     : m_RsrpSinrFirstWrite(true),
       m_UeSinrFirstWrite(true),
@@ -132,6 +138,22 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr(uint16_t cellId,
     NS_LOG_FUNCTION(this << cellId << imsi << rnti << rsrp << sinr);
     NS_LOG_INFO("Write RSRP/SINR Phy Stats in " << GetCurrentCellRsrpSinrFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_rsrpSink)
+        {
+            m_rsrpSink = CreateBinarySink(GetCurrentCellRsrpSinrFilename(), RSRP_HEADER);
+        }
+        m_rsrpSink->Write(Simulator::Now().GetSeconds(),
+                          cellId,
+                          imsi,
+                          rnti,
+                          rsrp,
+                          sinr,
+                          (uint32_t)componentCarrierId);
+        return;
+    }
+
     if (m_RsrpSinrFirstWrite)
     {
         m_rsrpOutFile.open(GetCurrentCellRsrpSinrFilename());
@@ -141,7 +163,7 @@ PhyStatsCalculator::ReportCurrentCellRsrpSinr(uint16_t cellId,
             return;
         }
         m_RsrpSinrFirstWrite = false;
-        m_rsrpOutFile << "% time\tcellId\tIMSI\tRNTI\trsrp\tsinr\tComponentCarrierId";
+        m_rsrpOutFile << RSRP_HEADER;
         m_rsrpOutFile << "\n";
     }
 
@@ -164,6 +186,21 @@ PhyStatsCalculator::ReportUeSinr(uint16_t cellId,
     NS_LOG_FUNCTION(this << cellId << imsi << rnti << sinrLinear);
     NS_LOG_INFO("Write SINR Linear Phy Stats in " << GetUeSinrFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_ueSinrSink)
+        {
+            m_ueSinrSink = CreateBinarySink(GetUeSinrFilename(), UE_SINR_HEADER);
+        }
+        m_ueSinrSink->Write(Simulator::Now().GetSeconds(),
+                            cellId,
+                            imsi,
+                            rnti,
+                            sinrLinear,
+                            (uint32_t)componentCarrierId);
+        return;
+    }
+
     if (m_UeSinrFirstWrite)
     {
         m_ueSinrOutFile.open(GetUeSinrFilename());
@@ -173,7 +210,7 @@ PhyStatsCalculator::ReportUeSinr(uint16_t cellId,
             return;
         }
         m_UeSinrFirstWrite = false;
-        m_ueSinrOutFile << "% time\tcellId\tIMSI\tRNTI\tsinrLinear\tcomponentCarrierId";
+        m_ueSinrOutFile << UE_SINR_HEADER;
         m_ueSinrOutFile << "\n";
     }
     m_ueSinrOutFile << Simulator::Now().GetSeconds() << "\t";
@@ -251,6 +251,16 @@ class PhyStatsCalculator : public LteStatsCalculator
      */
     std::ofstream m_ueSinrOutFile;
 
+    /**
+     * RSRP/SINR binary sink
+     */
+    Ptr<BinaryTraceSink> m_rsrpSink;
+
+    /**
+     * UE SINR binary sink
+     */
+    Ptr<BinaryTraceSink> m_ueSinrSink;
+
     /**
      * Interference statistics output trace file
      */
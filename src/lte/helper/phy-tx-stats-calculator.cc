@@ -33,6 +33,9 @@ NS_LOG_COMPONENT_DEFINE("PhyTxStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(PhyTxStatsCalculator);
 
+/// Header of the TX PHY statistics files
+static const char* const TX_HEADER = "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
+
 PhyTxStatsCalculator::PhyTxStatsCalculator()
     : m_dlTxFirstWrite(true),
       m_ulTxFirstWrite(true)
@@ -107,6 +110,25 @@ PhyTxStatsCalculator::DlPhyTransmission(PhyTransmissionStatParameters params)
                          << params.m_ndi);
     NS_LOG_INFO("Write DL Tx Phy Stats in " << GetDlTxOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_dlTxSink)
+        {
+            m_dlTxSink = CreateBinarySink(GetDlTxOutputFilename(), TX_HEADER);
+        }
+        m_dlTxSink->Write(params.m_timestamp,
+                          (uint32_t)params.m_cellId,
+                          params.m_imsi,
+                          params.m_rnti,
+                          (uint32_t)params.m_layer,
+                          (uint32_t)params.m_mcs,
+                          params.m_size,
+                          (uint32_t)params.m_rv,
+                          (uint32_t)params.m_ndi,
+                          (uint32_t)params.m_ccId);
+        return;
+    }
+
     if (m_dlTxFirstWrite)
     {
         m_dlTxOutFile.open(GetDlOutputFilename());
@@ -116,7 +138,7 @@ PhyTxStatsCalculator::DlPhyTransmission(PhyTransmissionStatParameters params)
             return;
         }
         m_dlTxFirstWrite = false;
-        m_dlTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
+        m_dlTxOutFile << TX_HEADER;
         m_dlTxOutFile << "\n";
     }
 
@@ -141,6 +163,25 @@ PhyTxStatsCalculator::UlPhyTransmission(PhyTransmissionStatParameters params)
                          << params.m_ndi);
     NS_LOG_INFO("Write UL Tx Phy Stats in " << GetUlTxOutputFilename());
 
+    if (IsBinaryOutput())
+    {
+        if (!m_ulTxSink)
+        {
+            m_ulTxSink = CreateBinarySink(GetUlTxOutputFilename(), TX_HEADER);
+        }
+        m_ulTxSink->Write(params.m_timestamp,
+                          (uint32_t)params.m_cellId,
+                          params.m_imsi,
+                          params.m_rnti,
+                          (uint32_t)params.m_layer,
+                          (uint32_t)params.m_mcs,
+                          params.m_size,
+                          (uint32_t)params.m_rv,
+                          (uint32_t)params.m_ndi,
+                          (uint32_t)params.m_ccId);
+        return;
+    }
+
     if (m_ulTxFirstWrite)
     {
         m_ulTxOutFile.open(GetUlTxOutputFilename());
@@ -151,7 +192,7 @@ PhyTxStatsCalculator::UlPhyTransmission(PhyTransmissionStatParameters params)
         }
         m_ulTxFirstWrite = false;
         // m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\ttxMode\tlayer\tmcs\tsize\trv\tndi";
-        m_ulTxOutFile << "% time\tcellId\tIMSI\tRNTI\tlayer\tmcs\tsize\trv\tndi\tccId";
+        m_ulTxOutFile << TX_HEADER;
         m_ulTxOutFile << "\n";
     }
 
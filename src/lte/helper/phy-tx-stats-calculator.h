@@ -156,6 +156,16 @@ class PhyTxStatsCalculator : public LteStatsCalculator
      * UL TX PHY statistics output trace file
      */
     std::ofstream m_ulTxOutFile;
+
+    /**
+     * DL TX PHY statistics binary sink
+     */
+    Ptr<BinaryTraceSink> m_dlTxSink;
+
+    /**
+     * UL TX PHY statistics binary sink
+     */
+    Ptr<BinaryTraceSink> m_ulTxSink;
 };
 
 } // namespace ns3
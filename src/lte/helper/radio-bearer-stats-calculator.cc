@@ -34,6 +34,11 @@ NS_LOG_COMPONENT_DEFINE("RadioBearerStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(RadioBearerStatsCalculator);
 
+/// Header of the UL and DL RLC/PDCP statistics files
+static const char* const RESULTS_HEADER =
+    "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t"
+    "delay\tstdDev\tmin\tmax\tPduSize\tstdDev\tmin\tmax";
+
 RadioBearerStatsCalculator::RadioBearerStatsCalculator()
     : m_firstWrite(true),
       m_pendingOutput(false),
@@ -244,7 +249,15 @@ RadioBearerStatsCalculator::ShowResults()
     std::ofstream ulOutFile;
     std::ofstream dlOutFile;
 
-    if (m_firstWrite)
+    if (IsBinaryOutput())
+    {
+        if (!m_ulSink)
+        {
+            m_ulSink = CreateBinarySink(GetUlOutputFilename(), RESULTS_HEADER, "\t\n");
+            m_dlSink = CreateBinarySink(GetDlOutputFilename(), RESULTS_HEADER, "\t\n");
+        }
+    }
+    else if (m_firstWrite)
     {
         ulOutFile.open(GetUlOutputFilename());
         if (!ulOutFile.is_open())
@@ -260,14 +273,8 @@ RadioBearerStatsCalculator::ShowResults()
             return;
         }
         m_firstWrite = false;
-        ulOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-        ulOutFile << "delay\tstdDev\tmin\tmax\t";
-        ulOutFile << "PduSize\tstdDev\tmin\tmax";
-        ulOutFile << std::endl;
-        dlOutFile << "% start\tend\tCellId\tIMSI\tRNTI\tLCID\tnTxPDUs\tTxBytes\tnRxPDUs\tRxBytes\t";
-        dlOutFile << "delay\tstdDev\tmin\tmax\t";
-        dlOutFile << "PduSize\tstdDev\tmin\tmax";
-        dlOutFile << std::endl;
+        ulOutFile << RESULTS_HEADER << std::endl;
+        dlOutFile << RESULTS_HEADER << std::endl;
     }
     else
     {
@@ -325,6 +332,31 @@ RadioBearerStatsCalculator::WriteUlResults(std::ofstream& outFile)
         LteFlowId_t flowId = flowIdIt->second;
         NS_ASSERT_MSG(flowId.m_lcId == p.m_lcId, "lcid mismatch");
 
+        if (m_ulSink)
+        {
+            std::vector<double> delay = GetUlDelayStats(p.m_imsi, p.m_lcId);
+            std::vector<double> pduSize = GetUlPduSizeStats(p.m_imsi, p.m_lcId);
+            m_ulSink->Write(m_startTime.GetSeconds(),
+                            endTime.GetSeconds(),
+                            GetUlCellId(p.m_imsi, p.m_lcId),
+                            p.m_imsi,
+                            flowId.m_rnti,
+                            (uint32_t)flowId.m_lcId,
+                            GetUlTxPackets(p.m_imsi, p.m_lcId),
+                            GetUlTxData(p.m_imsi, p.m_lcId),
+                            GetUlRxPackets(p.m_imsi, p.m_lcId),
+                            GetUlRxData(p.m_imsi, p.m_lcId),
+                            delay[0] * 1e-9,
+                            delay[1] * 1e-9,
+                            delay[2] * 1e-9,
+                            delay[3] * 1e-9,
+                            pduSize[0],
+                            pduSize[1],
+                            pduSize[2],
+                            pduSize[3]);
+            continue;
+        }
+
         outFile << m_startTime.GetSeconds() << "\t";
         outFile << endTime.GetSeconds() << "\t";
         outFile << GetUlCellId(p.m_imsi, p.m_lcId) << "\t";
@@ -385,6 +417,31 @@ RadioBearerStatsCalculator::WriteDlResults(std::ofstream& outFile)
         LteFlowId_t flowId = flowIdIt->second;
         NS_ASSERT_MSG(flowId.m_lcId == p.m_lcId, "lcid mismatch");
 
+        if (m_dlSink)
+        {
+            std::vector<double> delay = GetDlDelayStats(p.m_imsi, p.m_lcId);
+            std::vector<double> pduSize = GetDlPduSizeStats(p.m_imsi, p.m_lcId);
+            m_dlSink->Write(m_startTime.GetSeconds(),
+                            endTime.GetSeconds(),
+                            GetDlCellId(p.m_imsi, p.m_lcId),
+                            p.m_imsi,
+                            flowId.m_rnti,
+                            (uint32_t)flowId.m_lcId,
+                            GetDlTxPackets(p.m_imsi, p.m_lcId),
+                            GetDlTxData(p.m_imsi, p.m_lcId),
+                            GetDlRxPackets(p.m_imsi, p.m_lcId),
+                            GetDlRxData(p.m_imsi, p.m_lcId),
+                            delay[0] * 1e-9,
+                            delay[1] * 1e-9,
+                            delay[2] * 1e-9,
+                            delay[3] * 1e-9,
+                            pduSize[0],
+                            pduSize[1],
+                            pduSize[2],
+                            pduSize[3]);
+            continue;
+        }
+
         outFile << m_startTime.GetSeconds() << "\t";
         outFile << endTime.GetSeconds() << "\t";
         outFile << GetDlCellId(p.m_imsi, p.m_lcId) << "\t";
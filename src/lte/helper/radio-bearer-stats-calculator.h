@@ -348,14 +348,14 @@ class RadioBearerStatsCalculator : public LteStatsCalculator
 
     /**
      * Writes collected statistics to UL output file and
-     * closes UL output file.
+     * closes UL output file, or to the UL binary sink if it exists.
      * @param outFile ofstream for UL statistics
      */
     void WriteUlResults(std::ofstream& outFile);
 
     /**
      * Writes collected statistics to DL output file and
-     * closes DL output file.
+     * closes DL output file, or to the DL binary sink if it exists.
      * @param outFile ofstream for DL statistics
      */
     void WriteDlResults(std::ofstream& outFile);
@@ -418,6 +418,16 @@ class RadioBearerStatsCalculator : public LteStatsCalculator
      */
     bool m_pendingOutput;
 
+    /**
+     * UL binary sink
+     */
+    Ptr<BinaryTraceSink> m_ulSink;
+
+    /**
+     * DL binary sink
+     */
+    Ptr<BinaryTraceSink> m_dlSink;
+
     /**
      * Protocol type, by default RLC
      */
@@ -20,25 +20,40 @@
 #include "radio-environment-map-helper.h"
 
 #include <ns3/abort.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
 #include <ns3/boolean.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/component-carrier-enb.h>
+#include <ns3/component-carrier-ue.h>
 #include <ns3/config.h>
 #include <ns3/constant-position-mobility-model.h>
 #include <ns3/double.h>
 #include <ns3/integer.h>
 #include <ns3/log.h>
+#include <ns3/lte-enb-net-device.h>
+#include <ns3/lte-enb-phy.h>
+#include <ns3/lte-spectrum-phy.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-ue-net-device.h>
+#include <ns3/lte-ue-phy.h>
+#include <ns3/lte-ue-power-control.h>
 #include <ns3/mobility-building-info.h>
+#include <ns3/node-list.h>
 #include <ns3/node.h>
 #include <ns3/pointer.h>
+#include <ns3/propagation-loss-model.h>
 #include <ns3/rem-spectrum-phy.h>
 #include <ns3/simulator.h>
 #include <ns3/spectrum-channel.h>
 #include <ns3/string.h>
 #include <ns3/uinteger.h>
 
+#include <algorithm>
+#include <cmath>
 #include <fstream>
 #include <limits>
+#include <thread>
 
 namespace ns3
 {
@@ -169,7 +184,33 @@ RadioEnvironmentMapHelper::GetTypeId()
                           "default value is -1, what means REM will be averaged from all RBs",
                           IntegerValue(-1),
                           MakeIntegerAccessor(&RadioEnvironmentMapHelper::m_rbId),
-                          MakeIntegerChecker<int32_t>());
+                          MakeIntegerChecker<int32_t>())
+            .AddAttribute("ComputeOffline",
+                          "If true, the REM is computed directly from the transmitters attached "
+                          "to the channel and from the propagation loss model of the channel, "
+                          "assuming that all the transmitters use the whole bandwidth, instead "
+                          "of deploying RemSpectrumPhy listeners on the channel. "
+                          "UseDataChannel is ignored, and the spectrum propagation loss model "
+                          "(e.g., fading) of the channel is not taken into account.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_computeOffline),
+                          MakeBooleanChecker())
+            .AddAttribute("NumThreads",
+                          "Number of threads combining the received powers into the SINR of an "
+                          "offline REM. The propagation loss and antenna models are always "
+                          "evaluated by the simulation thread. 0 means one thread per hardware "
+                          "thread.",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&RadioEnvironmentMapHelper::m_numThreads),
+                          MakeUintegerChecker<uint32_t>())
+            .AddAttribute("Sidelink",
+                          "If true, the transmitters of an offline REM are the UEs whose "
+                          "sidelink PHY is attached to the channel and whose UL EARFCN is "
+                          "Earfcn, transmitting with the PSSCH power, instead of the eNBs. "
+                          "Requires ComputeOffline to be true.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&RadioEnvironmentMapHelper::m_sidelink),
+                          MakeBooleanChecker());
     return tid;
 }
 
@@ -203,10 +244,11 @@ void
 RadioEnvironmentMapHelper::Install()
 {
     NS_LOG_FUNCTION(this);
-    if (!m_rem.empty())
+    if (!m_rem.empty() || m_outFile.is_open())
     {
         NS_FATAL_ERROR("only one REM supported per instance of RadioEnvironmentMapHelper");
     }
+    NS_ABORT_MSG_IF(m_sidelink && !m_computeOffline, "sidelink REM requires ComputeOffline");
 
     if (!m_channel) // if Channel attribute is not set, then use the ChannelPath attribute
     {
@@ -227,6 +269,14 @@ RadioEnvironmentMapHelper::Install()
         return;
     }
 
+    if (m_computeOffline)
+    {
+        // no need to wait for any transmission, but let the simulation
+        // start so that the configuration of the devices is complete
+        Simulator::ScheduleNow(&RadioEnvironmentMapHelper::RunOffline, this);
+        return;
+    }
+
     double startDelay = 0.0026;
 
     if (m_useDataChannel)
@@ -370,4 +420,207 @@ RadioEnvironmentMapHelper::Finalize()
     }
 }
 
+void
+RadioEnvironmentMapHelper::RunOffline()
+{
+    NS_LOG_FUNCTION(this);
+    m_xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+    m_yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+
+    std::vector<RemTransmitter> transmitters = GetOfflineTransmitters();
+    NS_LOG_INFO("computing offline REM with " << transmitters.size() << " transmitters");
+
+    uint32_t numThreads = m_numThreads;
+    if (numThreads == 0)
+    {
+        numThreads = std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    uint32_t numPoints = static_cast<uint32_t>(m_xRes) * m_yRes;
+    uint32_t batchSize = std::min(m_maxPointsPerIteration, numPoints);
+
+    std::vector<Ptr<MobilityModel>> points;
+    points.reserve(batchSize);
+    for (uint32_t i = 0; i < batchSize; ++i)
+    {
+        Ptr<MobilityModel> mm = CreateObject<ConstantPositionMobilityModel>();
+        mm->AggregateObject(CreateObject<MobilityBuildingInfo>());
+        points.push_back(mm);
+    }
+    std::vector<double> rxPowerDbm(static_cast<std::size_t>(batchSize) * transmitters.size());
+    std::vector<double> sinr(batchSize);
+    Ptr<PropagationLossModel> lossModel = m_channel->GetPropagationLossModel();
+
+    uint32_t pointId = 0;
+    while (pointId < numPoints)
+    {
+        // place the points of the batch, following the same order of the
+        // points as the online REM (x first, then y)
+        std::size_t n = std::min(batchSize, numPoints - pointId);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            uint32_t xId = (pointId + i) / m_yRes;
+            uint32_t yId = (pointId + i) % m_yRes;
+            points[i]->SetPosition(Vector(m_xMin + xId * m_xStep, m_yMin + yId * m_yStep, m_z));
+            points[i]->GetObject<MobilityBuildingInfo>()->MakeConsistent(points[i]);
+        }
+
+        // The propagation loss and antenna models may update their state
+        // (e.g., shadowing and pathloss caches, random variables, traces), so
+        // they are always evaluated in this thread, with the mobility models
+        // of the actual transmitters
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Vector rxPos = points[i]->GetPosition();
+            for (std::size_t j = 0; j < transmitters.size(); ++j)
+            {
+                const RemTransmitter& tx = transmitters[j];
+                double power = tx.txPowerDbm;
+                if (lossModel)
+                {
+                    power = lossModel->CalcRxPower(power, tx.mobility, points[i]);
+                }
+                if (tx.antenna)
+                {
+                    Angles txAngles(rxPos, tx.mobility->GetPosition());
+                    power += tx.antenna->GetGainDb(txAngles);
+                }
+                rxPowerDbm[i * transmitters.size() + j] = power;
+            }
+        }
+
+        std::size_t tileSize = (n + numThreads - 1) / numThreads;
+        if (numThreads == 1)
+        {
+            ComputeOfflineTile(rxPowerDbm, transmitters.size(), 0, n, sinr);
+        }
+        else
+        {
+            std::vector<std::thread> threads;
+            for (uint32_t t = 0; t < numThreads && t * tileSize < n; ++t)
+            {
+                threads.emplace_back(&RadioEnvironmentMapHelper::ComputeOfflineTile,
+                                     this,
+                                     std::cref(rxPowerDbm),
+                                     transmitters.size(),
+                                     t * tileSize,
+                                     std::min((t + 1) * tileSize, n),
+                                     std::ref(sinr));
+            }
+            for (auto& thread : threads)
+            {
+                thread.join();
+            }
+        }
+
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            Vector pos = points[i]->GetPosition();
+            m_outFile << pos.x << "\t" << pos.y << "\t" << pos.z << "\t" << sinr[i] << "\n";
+        }
+        m_outFile.flush();
+        pointId += n;
+    }
+
+    Finalize();
+}
+
+std::vector<RadioEnvironmentMapHelper::RemTransmitter>
+RadioEnvironmentMapHelper::GetOfflineTransmitters() const
+{
+    NS_LOG_FUNCTION(this);
+    std::vector<RemTransmitter> transmitters;
+    for (auto it = NodeList::Begin(); it != NodeList::End(); ++it)
+    {
+        for (uint32_t i = 0; i < (*it)->GetNDevices(); ++i)
+        {
+            Ptr<NetDevice> device = (*it)->GetDevice(i);
+            Ptr<LteEnbNetDevice> enbDevice = DynamicCast<LteEnbNetDevice>(device);
+            if (enbDevice && !m_sidelink)
+            {
+                for (const auto& cc : enbDevice->GetCcMap())
+                {
+                    Ptr<ComponentCarrierEnb> ccEnb = DynamicCast<ComponentCarrierEnb>(cc.second);
+                    if (ccEnb->GetDlEarfcn() == m_earfcn)
+                    {
+                        Ptr<LteEnbPhy> phy = ccEnb->GetPhy();
+                        AddOfflineTransmitter(transmitters,
+                                              phy->GetDownlinkSpectrumPhy(),
+                                              phy->GetTxPower(),
+                                              ccEnb->GetDlBandwidth());
+                    }
+                }
+            }
+            Ptr<LteUeNetDevice> ueDevice = DynamicCast<LteUeNetDevice>(device);
+            if (ueDevice && m_sidelink)
+            {
+                for (const auto& cc : ueDevice->GetCcMap())
+                {
+                    // the sidelink uses the UL carrier
+                    if (cc.second->GetUlEarfcn() != m_earfcn)
+                    {
+                        continue;
+                    }
+                    // use the configured PSSCH power, without firing the
+                    // trace source of LteUePowerControl::GetPsschTxPower
+                    Ptr<LteUePowerControl> powerControl =
+                        cc.second->GetPhy()->GetUplinkPowerControl();
+                    DoubleValue psschTxPower;
+                    powerControl->GetAttribute("PsschTxPower", psschTxPower);
+                    AddOfflineTransmitter(transmitters,
+                                          cc.second->GetPhy()->GetSlSpectrumPhy(),
+                                          std::min(psschTxPower.Get(), powerControl->GetPcmax()),
+                                          m_bandwidth);
+                }
+            }
+        }
+    }
+    return transmitters;
+}
+
+void
+RadioEnvironmentMapHelper::AddOfflineTransmitter(std::vector<RemTransmitter>& transmitters,
+                                                 Ptr<LteSpectrumPhy> phy,
+                                                 double txPowerDbm,
+                                                 uint16_t bandwidth) const
+{
+    if (!phy || phy->GetChannel() != m_channel)
+    {
+        return;
+    }
+    NS_ABORT_MSG_IF(!phy->GetMobility(), "transmitter without mobility model");
+    RemTransmitter tx;
+    tx.mobility = phy->GetMobility();
+    tx.antenna = DynamicCast<AntennaModel>(phy->GetAntenna());
+    tx.txPowerDbm = txPowerDbm;
+    if (m_rbId >= 0)
+    {
+        // the power is uniformly distributed over the RBs
+        tx.txPowerDbm -= 10 * std::log10(bandwidth);
+    }
+    transmitters.push_back(tx);
+}
+
+void
+RadioEnvironmentMapHelper::ComputeOfflineTile(const std::vector<double>& rxPowerDbm,
+                                              std::size_t numTransmitters,
+                                              std::size_t begin,
+                                              std::size_t end,
+                                              std::vector<double>& sinr) const
+{
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        double sumPower = 0;
+        double referenceSignalPower = 0;
+        for (std::size_t j = 0; j < numTransmitters; ++j)
+        {
+            double power = std::pow(10.0, (rxPowerDbm[i * numTransmitters + j] - 30) / 10);
+            sumPower += power;
+            referenceSignalPower = std::max(referenceSignalPower, power);
+        }
+        // same definition as RemSpectrumPhy::GetSinr ()
+        sinr[i] = referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower);
+    }
+}
+
 } // namespace ns3
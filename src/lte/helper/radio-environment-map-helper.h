@@ -23,6 +23,7 @@
 #include <ns3/object.h>
 
 #include <fstream>
+#include <vector>
 
 namespace ns3
 {
@@ -33,6 +34,8 @@ class NetDevice;
 class SpectrumChannel;
 // class BuildingsMobilityModel;
 class MobilityModel;
+class AntennaModel;
+class LteSpectrumPhy;
 
 /**
  * \ingroup lte
@@ -40,6 +43,13 @@ class MobilityModel;
  * Generates a 2D map of the SINR from the strongest transmitter in the
  * downlink of an LTE FDD system. For instructions on usage, please refer to
  * the User Documentation.
+ *
+ * By default, the map is generated by attaching RemSpectrumPhy listeners to
+ * the channel and letting the simulation deliver the transmitted signals to
+ * them. If the `ComputeOffline` attribute is set, the map is instead computed
+ * directly from the transmitters attached to the channel and from the
+ * propagation loss model of the channel, which is much faster and also
+ * allows generating maps of the sidelink, i.e., with the UEs as transmitters.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -104,6 +114,70 @@ class RadioEnvironmentMapHelper : public Object
     /// Called when the map generation procedure has been completed.
     void Finalize();
 
+    /// Transmitter taken into account when computing the map offline.
+    struct RemTransmitter
+    {
+        /// Position of the transmitter in the environment.
+        Ptr<MobilityModel> mobility;
+        /// Antenna of the transmitter, or nullptr for an isotropic antenna.
+        Ptr<AntennaModel> antenna;
+        /// Power transmitted over the measured bandwidth, in dBm.
+        double txPowerDbm;
+    };
+
+    /**
+     * Scheduled by Install() when the `ComputeOffline` attribute is set, to
+     * compute the whole map without RemSpectrumPhy listeners.
+     *
+     * The map is divided into batches of at most `MaxPointsPerIteration`
+     * points. For each batch, the received powers are evaluated by the
+     * simulation thread, then `NumThreads` threads combine them into the SINR
+     * of contiguous tiles of the batch, and the batch is written to the
+     * output file before the next batch is evaluated.
+     */
+    void RunOffline();
+
+    /**
+     * Collect the transmitters attached to the channel, i.e., the eNBs or, if
+     * the `Sidelink` attribute is set, the sidelink PHY of the UEs.
+     *
+     * \return the list of transmitters
+     */
+    std::vector<RemTransmitter> GetOfflineTransmitters() const;
+
+    /**
+     * Add a transmitter to the list of transmitters of an offline map.
+     *
+     * \param transmitters the list of transmitters
+     * \param phy the spectrum PHY of the transmitter
+     * \param txPowerDbm the total transmission power in dBm
+     * \param bandwidth the transmission bandwidth in number of RBs
+     */
+    void AddOfflineTransmitter(std::vector<RemTransmitter>& transmitters,
+                               Ptr<LteSpectrumPhy> phy,
+                               double txPowerDbm,
+                               uint16_t bandwidth) const;
+
+    /**
+     * Compute the SINR of a tile of points of an offline map from the power
+     * received from each transmitter.
+     *
+     * This method can run in a separate thread: it only reads the received
+     * powers and writes the SINR of the points of its own tile.
+     *
+     * \param rxPowerDbm the power in dBm received at each point of the
+     *        current batch from each transmitter, stored point by point
+     * \param numTransmitters the number of transmitters
+     * \param begin index of the first point of the tile
+     * \param end index following the last point of the tile
+     * \param sinr the SINR of the points of the current batch
+     */
+    void ComputeOfflineTile(const std::vector<double>& rxPowerDbm,
+                            std::size_t numTransmitters,
+                            std::size_t begin,
+                            std::size_t end,
+                            std::vector<double>& sinr) const;
+
     /// A complete Radio Environment Map is composed of many of this structure.
     struct RemPoint
     {
@@ -159,6 +233,10 @@ class RadioEnvironmentMapHelper : public Object
     bool m_useDataChannel; ///< The `UseDataChannel` attribute.
     int32_t m_rbId;        ///< The `RbId` attribute.
 
+    bool m_computeOffline; ///< The `ComputeOffline` attribute.
+    uint32_t m_numThreads; ///< The `NumThreads` attribute.
+    bool m_sidelink;       ///< The `Sidelink` attribute.
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 } // namespace ns3
@@ -39,6 +39,8 @@
 #include <ns3/log.h>
 #include <ns3/simulator.h>
 
+#include <sstream>
+
 namespace ns3
 {
 
@@ -46,6 +48,10 @@ NS_LOG_COMPONENT_DEFINE("RrcStatsCalculator");
 
 NS_OBJECT_ENSURE_REGISTERED(RrcStatsCalculator);
 
+/// Header of the discovery monitoring statistics file
+static const char* const DISC_MONITORING_HEADER =
+    "Time\tIMSI\tCellId\tRNTI\tDiscType\tContentType\tDiscModel\tContent";
+
 RrcStatsCalculator::RrcStatsCalculator()
     : m_discoveryMonitoringRrcFirstWrite(true)
 {
@@ -94,6 +100,53 @@ RrcStatsCalculator::RrcDiscoveryMonitoring(uint64_t imsi,
 {
     NS_LOG_INFO("Writing Discovery Monitoring Stats in " << GetSlDiscRrcOutputFilename().c_str());
 
+    std::ostringstream content;
+    uint8_t msgType = discMsg.GetDiscoveryMsgType();
+    switch (msgType)
+    {
+    case LteSlDiscHeader::DISC_RELAY_ANNOUNCEMENT: // UE-to-Network Relay Discovery Announcement in
+                                                   // model A
+    case LteSlDiscHeader::DISC_RELAY_RESPONSE: // UE-to-Network Relay Discovery Response in model B
+    {
+        // write fields, include spare (0) as the last field
+        content << discMsg.GetRelayServiceCode() << ";" << discMsg.GetInfo() << ";"
+                << discMsg.GetRelayUeId() << ";" << (uint16_t)discMsg.GetStatusIndicator() << ";0";
+    }
+    break;
+    case LteSlDiscHeader::DISC_RELAY_SOLICITATION: {
+        // write fields, include spare (0) as the last field
+        content << discMsg.GetRelayServiceCode() << ";" << discMsg.GetInfo() << ";"
+                << (uint16_t)discMsg.GetURDSComposition() << ";" << discMsg.GetRelayUeId() << ";0";
+    }
+    break;
+    case LteSlDiscHeader::DISC_OPEN_ANNOUNCEMENT:
+    case LteSlDiscHeader::DISC_RESTRICTED_QUERY:
+    case LteSlDiscHeader::DISC_RESTRICTED_RESPONSE: { // open or restricted announcement
+        content << discMsg.GetApplicationCode();
+    }
+    break;
+    default:
+        NS_FATAL_ERROR("Invalid discovery message type " << msgType);
+    }
+
+    if (IsBinaryOutput())
+    {
+        if (!m_discoveryMonitoringRrcSink)
+        {
+            m_discoveryMonitoringRrcSink =
+                CreateBinarySink(GetSlDiscRrcOutputFilename(), DISC_MONITORING_HEADER);
+        }
+        m_discoveryMonitoringRrcSink->Write(Simulator::Now().GetMilliSeconds(),
+                                            imsi,
+                                            cellId,
+                                            rnti,
+                                            (uint16_t)discMsg.GetDiscoveryType(),
+                                            (uint16_t)discMsg.GetDiscoveryContentType(),
+                                            (uint16_t)discMsg.GetDiscoveryModel(),
+                                            content.str());
+        return;
+    }
+
     std::ofstream outFile;
     if (m_discoveryMonitoringRrcFirstWrite)
     {
@@ -104,8 +157,7 @@ RrcStatsCalculator::RrcDiscoveryMonitoring(uint64_t imsi,
             return;
         }
         m_discoveryMonitoringRrcFirstWrite = false;
-        outFile << "Time\tIMSI\tCellId\tRNTI\tDiscType\tContentType\tDiscModel\tContent"
-                << std::endl;
+        outFile << DISC_MONITORING_HEADER << std::endl;
     }
     else
     {
@@ -119,41 +171,10 @@ RrcStatsCalculator::RrcDiscoveryMonitoring(uint64_t imsi,
 
     outFile << Simulator::Now().GetMilliSeconds() << "\t" << imsi << "\t" << cellId << "\t" << rnti
             << "\t";
-
-    uint8_t msgType = discMsg.GetDiscoveryMsgType();
-
     outFile << (uint16_t)discMsg.GetDiscoveryType() << "\t"
             << (uint16_t)discMsg.GetDiscoveryContentType() << "\t"
             << (uint16_t)discMsg.GetDiscoveryModel() << "\t";
-
-    switch (msgType)
-    {
-    case LteSlDiscHeader::DISC_RELAY_ANNOUNCEMENT: // UE-to-Network Relay Discovery Announcement in
-                                                   // model A
-    case LteSlDiscHeader::DISC_RELAY_RESPONSE: // UE-to-Network Relay Discovery Response in model B
-    {
-        // write fields, include spare (0) as the last field
-        outFile << discMsg.GetRelayServiceCode() << ";" << discMsg.GetInfo() << ";"
-                << discMsg.GetRelayUeId() << ";" << (uint16_t)discMsg.GetStatusIndicator() << ";0"
-                << std::endl;
-    }
-    break;
-    case LteSlDiscHeader::DISC_RELAY_SOLICITATION: {
-        // write fields, include spare (0) as the last field
-        outFile << discMsg.GetRelayServiceCode() << ";" << discMsg.GetInfo() << ";"
-                << (uint16_t)discMsg.GetURDSComposition() << ";" << discMsg.GetRelayUeId() << ";0"
-                << std::endl;
-    }
-    break;
-    case LteSlDiscHeader::DISC_OPEN_ANNOUNCEMENT:
-    case LteSlDiscHeader::DISC_RESTRICTED_QUERY:
-    case LteSlDiscHeader::DISC_RESTRICTED_RESPONSE: { // open or restricted announcement
-        outFile << discMsg.GetApplicationCode() << std::endl;
-    }
-    break;
-    default:
-        NS_FATAL_ERROR("Invalid discovery message type " << msgType);
-    }
+    outFile << content.str() << std::endl;
 }
 
 void
@@ -125,6 +125,11 @@ class RrcStatsCalculator : public LteStatsCalculator
      * files have not been opened yet
      */
     bool m_discoveryMonitoringRrcFirstWrite;
+
+    /**
+     * Discovery monitoring binary sink
+     */
+    Ptr<BinaryTraceSink> m_discoveryMonitoringRrcSink;
 };
 
 } // namespace ns3
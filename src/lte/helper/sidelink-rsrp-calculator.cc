@@ -110,6 +110,79 @@ SidelinkRsrpCalculator::CalcSlRsrpPsbch(Ptr<PropagationLossModel> lossModel,
       reference signals associated with PSBCH, within the central 6 PRBs of the applicable
       subframes.
     */
+    Ptr<SpectrumValue> psd = CreatePsbchPsd(txPower, ulEarfcn, ulBandwidth);
+    double propagationGainDb =
+        lossModel->CalcRxPower(0, txPhy->GetMobility(), rxPhy->GetMobility());
+    double rsrp = DoCalcRsrp(propagationGainDb, psd, txPhy, rxPhy);
+
+    NS_LOG_INFO("S-RSRP=" << rsrp);
+
+    return rsrp;
+}
+
+double
+SidelinkRsrpCalculator::CalcSlRsrpTxPw(Ptr<PropagationLossModel> lossModel,
+                                       double txPower,
+                                       Ptr<SpectrumPhy> txPhy,
+                                       Ptr<SpectrumPhy> rxPhy)
+{
+    NS_ASSERT_MSG(lossModel != nullptr, "No PropagationLossModel provided");
+
+    /*
+      36.843: RSRP is calculated for transmit power of 23dBm by the transmitter UE and is the
+      received power at the receiver UE calculated after accounting for large scale path loss and
+      shadowing. Additionally note that wrap around is used for path loss calculations except for
+      the case of partial -coverage.
+    */
+    double propagationGainDb =
+        lossModel->CalcRxPower(0, txPhy->GetMobility(), rxPhy->GetMobility());
+    double rsrp = DoCalcRsrp(propagationGainDb, txPower, txPhy, rxPhy);
+
+    NS_LOG_INFO("RSRP=" << rsrp);
+
+    return rsrp;
+}
+
+std::vector<double>
+SidelinkRsrpCalculator::CalcSlRsrpPsbch(Ptr<PropagationLossModel> lossModel,
+                                        double txPower,
+                                        double ulEarfcn,
+                                        double ulBandwidth,
+                                        Ptr<SpectrumPhy> txPhy,
+                                        const std::vector<Ptr<SpectrumPhy>>& rxPhys)
+{
+    NS_ASSERT_MSG(lossModel != nullptr, "No PropagationLossModel provided");
+
+    Ptr<SpectrumValue> psd = CreatePsbchPsd(txPower, ulEarfcn, ulBandwidth);
+    std::vector<double> rsrps = CalcPropagationGains(lossModel, txPhy, rxPhys);
+    for (std::size_t i = 0; i < rxPhys.size(); ++i)
+    {
+        rsrps[i] = DoCalcRsrp(rsrps[i], psd, txPhy, rxPhys[i]);
+        NS_LOG_INFO("S-RSRP=" << rsrps[i]);
+    }
+    return rsrps;
+}
+
+std::vector<double>
+SidelinkRsrpCalculator::CalcSlRsrpTxPw(Ptr<PropagationLossModel> lossModel,
+                                       double txPower,
+                                       Ptr<SpectrumPhy> txPhy,
+                                       const std::vector<Ptr<SpectrumPhy>>& rxPhys)
+{
+    NS_ASSERT_MSG(lossModel != nullptr, "No PropagationLossModel provided");
+
+    std::vector<double> rsrps = CalcPropagationGains(lossModel, txPhy, rxPhys);
+    for (std::size_t i = 0; i < rxPhys.size(); ++i)
+    {
+        rsrps[i] = DoCalcRsrp(rsrps[i], txPower, txPhy, rxPhys[i]);
+        NS_LOG_INFO("RSRP=" << rsrps[i]);
+    }
+    return rsrps;
+}
+
+Ptr<SpectrumValue>
+SidelinkRsrpCalculator::CreatePsbchPsd(double txPower, double ulEarfcn, double ulBandwidth)
+{
     // This method returned very low values of RSRP
     std::vector<int> rbMask;
     int indexLowerRb = 0;
@@ -134,37 +207,28 @@ SidelinkRsrpCalculator::CalcSlRsrpPsbch(Ptr<PropagationLossModel> lossModel,
                                                                     txPower,
                                                                     rbMask);
 
-    double rsrp = DoCalcRsrp(lossModel, psd, txPhy, rxPhy);
-
-    NS_LOG_INFO("S-RSRP=" << rsrp);
-
-    return rsrp;
+    return psd;
 }
 
-double
-SidelinkRsrpCalculator::CalcSlRsrpTxPw(Ptr<PropagationLossModel> lossModel,
-                                       double txPower,
-                                       Ptr<SpectrumPhy> txPhy,
-                                       Ptr<SpectrumPhy> rxPhy)
+std::vector<double>
+SidelinkRsrpCalculator::CalcPropagationGains(Ptr<PropagationLossModel> lossModel,
+                                             Ptr<SpectrumPhy> txPhy,
+                                             const std::vector<Ptr<SpectrumPhy>>& rxPhys)
 {
-    NS_ASSERT_MSG(lossModel != nullptr, "No PropagationLossModel provided");
-
-    /*
-      36.843: RSRP is calculated for transmit power of 23dBm by the transmitter UE and is the
-      received power at the receiver UE calculated after accounting for large scale path loss and
-      shadowing. Additionally note that wrap around is used for path loss calculations except for
-      the case of partial -coverage.
-    */
-    double rsrp = DoCalcRsrp(lossModel, txPower, txPhy, rxPhy);
-
-    NS_LOG_INFO("RSRP=" << rsrp);
-
-    return rsrp;
+    std::vector<Ptr<MobilityModel>> rxMobilities;
+    rxMobilities.reserve(rxPhys.size());
+    for (const auto& rxPhy : rxPhys)
+    {
+        rxMobilities.push_back(rxPhy->GetMobility());
+    }
+    std::vector<double> propagationGainsDb;
+    lossModel->CalcRxPowerBatch(0, txPhy->GetMobility(), rxMobilities, propagationGainsDb);
+    return propagationGainsDb;
 }
 
 // called by CalcSlRsrpPsbch function
 double
-SidelinkRsrpCalculator::DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
+SidelinkRsrpCalculator::DoCalcRsrp(double propagationGainDb,
                                    Ptr<SpectrumValue> psd,
                                    Ptr<SpectrumPhy> txPhy,
                                    Ptr<SpectrumPhy> rxPhy)
@@ -189,12 +253,8 @@ SidelinkRsrpCalculator::DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
         NS_LOG_DEBUG("rxAntennaGain = " << rxAntennaGain << " dB");
         pathLossDb -= rxAntennaGain;
     }
-    if (propagationLoss)
-    {
-        double propagationGainDb = propagationLoss->CalcRxPower(0, txMobility, rxMobility);
-        NS_LOG_DEBUG("propagationGainDb = " << propagationGainDb << " dB");
-        pathLossDb -= propagationGainDb;
-    }
+    NS_LOG_DEBUG("propagationGainDb = " << propagationGainDb << " dB");
+    pathLossDb -= propagationGainDb;
     NS_LOG_DEBUG("total pathLoss = " << pathLossDb << " dB");
 
     double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
@@ -228,7 +288,7 @@ SidelinkRsrpCalculator::DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
 
 // used by CalcSlRsrpTxPw function
 double
-SidelinkRsrpCalculator::DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
+SidelinkRsrpCalculator::DoCalcRsrp(double propagationGainDb,
                                    double txPower,
                                    Ptr<SpectrumPhy> txPhy,
                                    Ptr<SpectrumPhy> rxPhy)
@@ -253,12 +313,8 @@ SidelinkRsrpCalculator::DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
         NS_LOG_DEBUG("rxAntennaGain = " << rxAntennaGain << " dB");
         pathLossDb -= rxAntennaGain;
     }
-    if (propagationLoss)
-    {
-        double propagationGainDb = propagationLoss->CalcRxPower(0, txMobility, rxMobility);
-        NS_LOG_DEBUG("propagationGainDb = " << propagationGainDb << " dB");
-        pathLossDb -= propagationGainDb;
-    }
+    NS_LOG_DEBUG("propagationGainDb = " << propagationGainDb << " dB");
+    pathLossDb -= propagationGainDb;
     NS_LOG_DEBUG("total pathLoss = " << pathLossDb << " dB");
 
     double rsrp = txPower - pathLossDb;
@@ -101,17 +101,75 @@ class SidelinkRsrpCalculator : public Object
                                  Ptr<SpectrumPhy> txPhy,
                                  Ptr<SpectrumPhy> rxPhy);
 
+    /**
+     * Computes the S-RSRP between a transmitter UE and several receiver UEs as defined in
+     * TS 36.214. The propagation loss to all the receivers is computed at once with
+     * PropagationLossModel::CalcRxPowerBatch.
+     * \param lossModel The loss model to use in the calculation
+     * \param txPower Transmit power for the reference signal
+     * \param ulEarfcn Uplink frequency
+     * \param ulBandwidth Uplink bandwidth
+     * \param txPhy The transmitter
+     * \param rxPhys The receivers
+     *
+     * \return the RSRP value in dBm of each receiver
+     */
+    static std::vector<double> CalcSlRsrpPsbch(Ptr<PropagationLossModel> lossModel,
+                                               double txPower,
+                                               double ulEarfcn,
+                                               double ulBandwidth,
+                                               Ptr<SpectrumPhy> txPhy,
+                                               const std::vector<Ptr<SpectrumPhy>>& rxPhys);
+
+    /**
+     * Computes the S-RSRP between a transmitter UE and several receiver UEs as defined in
+     * TR 36.843. The propagation loss to all the receivers is computed at once with
+     * PropagationLossModel::CalcRxPowerBatch.
+     * \param lossModel The loss model to use in the calculation
+     * \param txPower Transmit power for the reference signal
+     * \param txPhy The transmitter
+     * \param rxPhys The receivers
+     *
+     * \return the RSRP value in dBm of each receiver
+     */
+    static std::vector<double> CalcSlRsrpTxPw(Ptr<PropagationLossModel> lossModel,
+                                              double txPower,
+                                              Ptr<SpectrumPhy> txPhy,
+                                              const std::vector<Ptr<SpectrumPhy>>& rxPhys);
+
   private:
+    /**
+     * Create the power spectral density of the PSBCH, within the central 6 PRBs
+     * \param txPower Transmit power for the reference signal
+     * \param ulEarfcn Uplink frequency
+     * \param ulBandwidth Uplink bandwidth
+     *
+     * \return the power spectral density of the transmitter
+     */
+    static Ptr<SpectrumValue> CreatePsbchPsd(double txPower, double ulEarfcn, double ulBandwidth);
+
+    /**
+     * Compute the propagation gain from the transmitter to each receiver
+     * \param lossModel The loss model
+     * \param txPhy The transmitter
+     * \param rxPhys The receivers
+     *
+     * \return the propagation gain in dB of each receiver
+     */
+    static std::vector<double> CalcPropagationGains(Ptr<PropagationLossModel> lossModel,
+                                                    Ptr<SpectrumPhy> txPhy,
+                                                    const std::vector<Ptr<SpectrumPhy>>& rxPhys);
+
     /**
      * Compute the RSRP between the given nodes for the given propagation loss model (used by
      * CalcSidelinkRsrp function) This code is derived from the multi-model-spectrum-channel class.
-     * It can be used for both uplink and downlink \param propagationLoss The loss model \param psd
-     * The power spectral density of the transmitter \param txPhy The transmitter \param rxPhy The
-     * receiver
+     * It can be used for both uplink and downlink \param propagationGainDb The propagation gain
+     * in dB \param psd The power spectral density of the transmitter \param txPhy The transmitter
+     * \param rxPhy The receiver
      *
      * \return The RSRP in dBm
      */
-    static double DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
+    static double DoCalcRsrp(double propagationGainDb,
                              Ptr<SpectrumValue> psd,
                              Ptr<SpectrumPhy> txPhy,
                              Ptr<SpectrumPhy> rxPhy);
@@ -119,14 +177,15 @@ class SidelinkRsrpCalculator : public Object
     /**
      * Compute the RSRP between the given nodes for the given propagation loss model (used by
      * CalcSidelinkRsrpEval function) This code is derived from the multi-model-spectrum-channel
-     * class. It can be used for both uplink and downlink \param propagationLoss The loss model
+     * class. It can be used for both uplink and downlink \param propagationGainDb The propagation
+     * gain in dB
      * \param txPower The transmit power
      * \param txPhy The transmitter
      * \param rxPhy The receiver
      *
      * \return The RSRP in dBm
      */
-    static double DoCalcRsrp(Ptr<PropagationLossModel> propagationLoss,
+    static double DoCalcRsrp(double propagationGainDb,
                              double txPower,
                              Ptr<SpectrumPhy> txPhy,
                              Ptr<SpectrumPhy> rxPhy);
@@ -31,6 +31,7 @@
 #include <ns3/math.h>
 #include <ns3/spectrum-value.h>
 
+#include <algorithm>
 #include <vector>
 
 namespace ns3
@@ -496,11 +497,10 @@ LteAmc::GetCqiFromSpectralEfficiency(double s)
 {
     NS_LOG_FUNCTION(s);
     NS_ASSERT_MSG(s >= 0.0, "negative spectral efficiency = " << s);
-    int cqi = 0;
-    while ((cqi < 15) && (SpectralEfficiencyForCqi[cqi + 1] < s))
-    {
-        ++cqi;
-    }
+    // the table is sorted, so the CQI is the number of entries (after the
+    // "out of range" one) whose spectral efficiency is lower than s
+    int cqi = std::lower_bound(SpectralEfficiencyForCqi + 1, SpectralEfficiencyForCqi + 16, s) -
+              (SpectralEfficiencyForCqi + 1);
     NS_LOG_LOGIC("cqi = " << cqi);
     return cqi;
 }
@@ -590,9 +590,12 @@ LteAmc::CreateCqiFeedbacks(const SpectrumValue& sinr, uint8_t rbgSize)
     NS_LOG_FUNCTION(this);
 
     std::vector<int> cqi;
+    cqi.reserve(sinr.GetValuesN());
 
     if (m_amcModel == PiroEW2010)
     {
+        // SINR gap of the BER target, constant for all the RBs
+        const double gap = (-std::log(5.0 * m_ber)) / 1.5;
         for (auto it = sinr.ConstValuesBegin(); it != sinr.ConstValuesEnd(); it++)
         {
             double sinr_ = (*it);
@@ -610,7 +613,7 @@ LteAmc::CreateCqiFeedbacks(const SpectrumValue& sinr, uint8_t rbgSize)
                  * NB: SINR must be expressed in linear units
                  */
 
-                double s = log2(1 + (sinr_ / ((-std::log(5.0 * m_ber)) / 1.5)));
+                double s = log2(1 + (sinr_ / gap));
 
                 int cqi_ = GetCqiFromSpectralEfficiency(s);
 
@@ -25,11 +25,115 @@
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 
+#include <vector>
+
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("LteControlMessage");
 
+namespace
+{
+
+/**
+ * \ingroup lte
+ *
+ * Memory of the released control messages, per size class.
+ */
+class LteControlMessagePool
+{
+  public:
+    /// Granularity of the size classes, in bytes
+    static constexpr std::size_t GRANULARITY = 16;
+    /// Size of the largest pooled messages, larger messages are not pooled
+    static constexpr std::size_t MAX_SIZE = 512;
+    /// Maximum number of released messages kept per size class
+    static constexpr std::size_t MAX_FREE = 1024;
+
+    LteControlMessagePool()
+        : m_freeLists(MAX_SIZE / GRANULARITY)
+    {
+    }
+
+    ~LteControlMessagePool()
+    {
+        for (auto& freeList : m_freeLists)
+        {
+            for (void* ptr : freeList)
+            {
+                ::operator delete(ptr);
+            }
+        }
+        // messages released during the destruction of other static objects
+        // are not pooled anymore
+        g_destroyed = true;
+    }
+
+    /**
+     * \return the pool, or nullptr if it has already been destroyed
+     */
+    static LteControlMessagePool* Get()
+    {
+        if (g_destroyed)
+        {
+            return nullptr;
+        }
+        static LteControlMessagePool pool;
+        return &pool;
+    }
+
+    /**
+     * \param size the size of a message
+     * \return the size class of the message
+     */
+    static std::size_t GetSizeClass(std::size_t size)
+    {
+        return (size + GRANULARITY - 1) / GRANULARITY - 1;
+    }
+
+    /**
+     * \param size the size of the message
+     * \return the memory of the message
+     */
+    void* Allocate(std::size_t size)
+    {
+        std::vector<void*>& freeList = m_freeLists[GetSizeClass(size)];
+        if (freeList.empty())
+        {
+            // allocate the whole size class, so that any message of the class can reuse it
+            return ::operator new((GetSizeClass(size) + 1) * GRANULARITY);
+        }
+        void* ptr = freeList.back();
+        freeList.pop_back();
+        return ptr;
+    }
+
+    /**
+     * \param ptr the memory of the message
+     * \param size the size of the message
+     */
+    void Release(void* ptr, std::size_t size)
+    {
+        std::vector<void*>& freeList = m_freeLists[GetSizeClass(size)];
+        if (freeList.size() < MAX_FREE)
+        {
+            freeList.push_back(ptr);
+        }
+        else
+        {
+            ::operator delete(ptr);
+        }
+    }
+
+  private:
+    std::vector<std::vector<void*>> m_freeLists; ///< released messages per size class
+    static bool g_destroyed;                      ///< true once the pool has been destroyed
+};
+
+bool LteControlMessagePool::g_destroyed = false;
+
+} // namespace
+
 LteControlMessage::LteControlMessage()
 {
 }
@@ -38,6 +142,33 @@ LteControlMessage::~LteControlMessage()
 {
 }
 
+void*
+LteControlMessage::operator new(std::size_t size)
+{
+    LteControlMessagePool* pool = LteControlMessagePool::Get();
+    if (pool == nullptr || size > LteControlMessagePool::MAX_SIZE)
+    {
+        return ::operator new(size);
+    }
+    return pool->Allocate(size);
+}
+
+void
+LteControlMessage::operator delete(void* ptr, std::size_t size)
+{
+    if (ptr == nullptr)
+    {
+        return;
+    }
+    LteControlMessagePool* pool = LteControlMessagePool::Get();
+    if (pool == nullptr || size > LteControlMessagePool::MAX_SIZE)
+    {
+        ::operator delete(ptr);
+        return;
+    }
+    pool->Release(ptr, size);
+}
+
 void
 LteControlMessage::SetMessageType(LteControlMessage::MessageType type)
 {
@@ -52,6 +183,19 @@ LteControlMessage::GetMessageType()
 
 // ----------------------------------------------------------------------------------------------------------
 
+LteControlMessageBurst::LteControlMessageBurst(std::list<Ptr<LteControlMessage>> msgs)
+    : m_msgs(std::move(msgs))
+{
+}
+
+const std::list<Ptr<LteControlMessage>>&
+LteControlMessageBurst::GetMessages() const
+{
+    return m_msgs;
+}
+
+// ----------------------------------------------------------------------------------------------------------
+
 DlDciLteControlMessage::DlDciLteControlMessage()
 {
     SetMessageType(LteControlMessage::DL_DCI);
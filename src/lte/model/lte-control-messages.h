@@ -71,6 +71,24 @@ class LteControlMessage : public SimpleRefCount<LteControlMessage>
     LteControlMessage();
     virtual ~LteControlMessage();
 
+    /**
+     * \brief Allocate a control message
+     *
+     * Control messages are created and released every TTI, so the memory of
+     * the released messages is kept in a pool per size class and reused by
+     * the next messages of the same size.
+     *
+     * \param size the size of the message
+     * \return the memory of the message
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * \brief Release a control message to the pool of its size class
+     * \param ptr the memory of the message
+     * \param size the size of the message
+     */
+    static void operator delete(void* ptr, std::size_t size);
+
     /**
      * \brief Set the type of the message
      * \param type the type of the message
@@ -86,6 +104,32 @@ class LteControlMessage : public SimpleRefCount<LteControlMessage>
     MessageType m_type; ///< message type
 };
 
+/**
+ * \ingroup lte
+ *
+ * The control messages carried by a frame. The burst is not modified once
+ * handed to the channel, so that the signal parameters delivered to all the
+ * receivers of the frame share it instead of copying the list.
+ */
+class LteControlMessageBurst : public SimpleRefCount<LteControlMessageBurst>
+{
+  public:
+    /**
+     * \brief Constructor
+     * \param msgs the control messages of the burst
+     */
+    LteControlMessageBurst(std::list<Ptr<LteControlMessage>> msgs);
+
+    /**
+     * \brief Get the control messages of the burst
+     * \return the control messages
+     */
+    const std::list<Ptr<LteControlMessage>>& GetMessages() const;
+
+  private:
+    std::list<Ptr<LteControlMessage>> m_msgs; ///< control messages
+};
+
 // -----------------------------------------------------------------------
 
 /**
@@ -528,7 +528,7 @@ LteEnbPhy::ReceiveLteControlMessage(Ptr<LteControlMessage> msg)
 }
 
 void
-LteEnbPhy::ReceiveLteControlMessageList(std::list<Ptr<LteControlMessage>> msgList)
+LteEnbPhy::ReceiveLteControlMessageList(const std::list<Ptr<LteControlMessage>>& msgList)
 {
     NS_LOG_FUNCTION(this);
     for (auto it = msgList.begin(); it != msgList.end(); it++)
@@ -774,7 +774,7 @@ LteEnbPhy::StartSubFrame()
 }
 
 void
-LteEnbPhy::SendControlChannels(std::list<Ptr<LteControlMessage>> ctrlMsgList)
+LteEnbPhy::SendControlChannels(const std::list<Ptr<LteControlMessage>>& ctrlMsgList)
 {
     NS_LOG_FUNCTION(this << " eNB " << m_cellId << " start tx ctrl frame");
     // set the current tx power spectral density (full bandwidth)
@@ -800,9 +800,7 @@ LteEnbPhy::SendDataChannels(Ptr<PacketBurst> pb)
     SetDownlinkSubChannelsWithPowerAllocation(m_dlDataRbMap);
     // send the current burst of packets
     NS_LOG_LOGIC(this << " eNB start TX DATA");
-    std::list<Ptr<LteControlMessage>> ctrlMsgList;
-    ctrlMsgList.clear();
-    m_downlinkSpectrumPhy->StartTxDataFrame(pb, ctrlMsgList, DL_DATA_DURATION);
+    m_downlinkSpectrumPhy->StartTxDataFrame(pb, {}, DL_DATA_DURATION);
 }
 
 void
@@ -228,7 +228,7 @@ class LteEnbPhy : public LtePhy
      * \brief Send the PDCCH and PCFICH in the first 3 symbols
      * \param ctrlMsgList the list of control messages of PDCCH
      */
-    void SendControlChannels(std::list<Ptr<LteControlMessage>> ctrlMsgList);
+    void SendControlChannels(const std::list<Ptr<LteControlMessage>>& ctrlMsgList);
 
     /**
      * \brief Send the PDSCH
@@ -273,7 +273,7 @@ class LteEnbPhy : public LtePhy
      * \brief PhySpectrum received a new list of LteControlMessage
      * \param msgList List of control messages
      */
-    virtual void ReceiveLteControlMessageList(std::list<Ptr<LteControlMessage>> msgList);
+    virtual void ReceiveLteControlMessageList(const std::list<Ptr<LteControlMessage>>& msgList);
 
     // inherited from LtePhy
     void GenerateCtrlCqiReport(const SpectrumValue& sinr) override;
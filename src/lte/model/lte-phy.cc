@@ -218,22 +218,12 @@ std::list<Ptr<LteControlMessage>>
 LtePhy::GetControlMessages()
 {
     NS_LOG_FUNCTION(this);
-    if (!m_controlMessagesQueue.at(0).empty())
-    {
-        std::list<Ptr<LteControlMessage>> ret = m_controlMessagesQueue.at(0);
-        m_controlMessagesQueue.erase(m_controlMessagesQueue.begin());
-        std::list<Ptr<LteControlMessage>> newlist;
-        m_controlMessagesQueue.push_back(newlist);
-        return (ret);
-    }
-    else
-    {
-        m_controlMessagesQueue.erase(m_controlMessagesQueue.begin());
-        std::list<Ptr<LteControlMessage>> newlist;
-        m_controlMessagesQueue.push_back(newlist);
-        std::list<Ptr<LteControlMessage>> emptylist;
-        return (emptylist);
-    }
+    // move the messages out of the queue instead of copying them, the
+    // remaining lists are moved as well when erasing the head of the queue
+    std::list<Ptr<LteControlMessage>> ret = std::move(m_controlMessagesQueue.at(0));
+    m_controlMessagesQueue.erase(m_controlMessagesQueue.begin());
+    m_controlMessagesQueue.emplace_back();
+    return ret;
 }
 
 void
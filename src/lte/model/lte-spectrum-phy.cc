@@ -272,7 +272,8 @@ LteSpectrumPhy::DoDispose()
     m_ulDataSlCheck = false;
     m_ltePhyRxDataEndErrorCallback = MakeNullCallback<void>();
     m_ltePhyRxDataEndOkCallback = MakeNullCallback<void, Ptr<Packet>>();
-    m_ltePhyRxCtrlEndOkCallback = MakeNullCallback<void, std::list<Ptr<LteControlMessage>>>();
+    m_ltePhyRxCtrlEndOkCallback =
+        MakeNullCallback<void, const std::list<Ptr<LteControlMessage>>&>();
     m_ltePhyRxCtrlEndErrorCallback = MakeNullCallback<void>();
     m_ltePhyDlHarqFeedbackCallback = MakeNullCallback<void, DlInfoListElement_s>();
     m_ltePhyUlHarqFeedbackCallback = MakeNullCallback<void, UlInfoListElement_s>();
@@ -663,7 +664,7 @@ LteSpectrumPhy::ClearExpectedDiscTb()
 
 bool
 LteSpectrumPhy::StartTxDataFrame(Ptr<PacketBurst> pb,
-                                 std::list<Ptr<LteControlMessage>> ctrlMsgList,
+                                 const std::list<Ptr<LteControlMessage>>& ctrlMsgList,
                                  Time duration)
 {
     NS_LOG_FUNCTION(this << pb);
@@ -697,7 +698,7 @@ LteSpectrumPhy::StartTxDataFrame(Ptr<PacketBurst> pb,
 
         // we need to convey some PHY meta information to the receiver
         // to be used for simulation purposes (e.g., the CellId). This
-        // is done by setting the ctrlMsgList parameter of
+        // is done by setting the ctrlMsgBurst parameter of
         // LteSpectrumSignalParametersDataFrame
         ChangeState(TX_DATA);
         NS_ASSERT(m_channel);
@@ -708,7 +709,10 @@ LteSpectrumPhy::StartTxDataFrame(Ptr<PacketBurst> pb,
         txParams->txAntenna = m_antenna;
         txParams->psd = m_txPsd;
         txParams->packetBurst = pb;
-        txParams->ctrlMsgList = ctrlMsgList;
+        if (!ctrlMsgList.empty())
+        {
+            txParams->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList);
+        }
         txParams->cellId = m_cellId;
         if (pb)
         {
@@ -977,7 +981,7 @@ LteSpectrumPhy::StartTxSlDiscFrame(Ptr<PacketBurst> pb, uint32_t resNo, uint8_t
 }
 
 bool
-LteSpectrumPhy::StartTxDlCtrlFrame(std::list<Ptr<LteControlMessage>> ctrlMsgList, bool pss)
+LteSpectrumPhy::StartTxDlCtrlFrame(const std::list<Ptr<LteControlMessage>>& ctrlMsgList, bool pss)
 {
     NS_LOG_FUNCTION(this << " PSS " << (uint16_t)pss);
     NS_LOG_LOGIC(this << " state: " << m_state);
@@ -1020,7 +1024,10 @@ LteSpectrumPhy::StartTxDlCtrlFrame(std::list<Ptr<LteControlMessage>> ctrlMsgList
         txParams->psd = m_txPsd;
         txParams->cellId = m_cellId;
         txParams->pss = pss;
-        txParams->ctrlMsgList = ctrlMsgList;
+        if (!ctrlMsgList.empty())
+        {
+            txParams->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList);
+        }
         m_channel->StartTx(txParams);
         m_endTxEvent = Simulator::Schedule(DL_CTRL_DURATION, &LteSpectrumPhy::EndTxDlCtrl, this);
     }
@@ -1239,10 +1246,14 @@ LteSpectrumPhy::StartRxData(Ptr<LteSpectrumSignalParametersDataFrame> params)
 
                     m_phyRxStartTrace(params->packetBurst);
                 }
-                NS_LOG_DEBUG(this << " insert msgs " << params->ctrlMsgList.size());
-                m_rxControlMessageList.insert(m_rxControlMessageList.end(),
-                                              params->ctrlMsgList.begin(),
-                                              params->ctrlMsgList.end());
+                if (params->ctrlMsgBurst)
+                {
+                    const auto& msgs = params->ctrlMsgBurst->GetMessages();
+                    NS_LOG_DEBUG(this << " insert msgs " << msgs.size());
+                    m_rxControlMessageList.insert(m_rxControlMessageList.end(),
+                                                  msgs.begin(),
+                                                  msgs.end());
+                }
 
                 NS_LOG_LOGIC(this << " numSimultaneousRxEvents = " << m_rxPacketBurstList.size());
             }
@@ -1433,7 +1444,10 @@ LteSpectrumPhy::StartRxDlCtrl(Ptr<LteSpectrumSignalParametersDlCtrlFrame> lteDlC
                                   << lteDlCtrlRxParams->duration);
 
                 // store the DCIs
-                m_rxControlMessageList = lteDlCtrlRxParams->ctrlMsgList;
+                if (lteDlCtrlRxParams->ctrlMsgBurst)
+                {
+                    m_rxControlMessageList = lteDlCtrlRxParams->ctrlMsgBurst->GetMessages();
+                }
                 m_endRxDlCtrlEvent = Simulator::Schedule(lteDlCtrlRxParams->duration,
                                                          &LteSpectrumPhy::EndRxDlCtrl,
                                                          this);
@@ -273,7 +273,7 @@ typedef Callback<void, Ptr<Packet>, uint16_t> LtePhyRxPsbchEndOkCallback;
  * previously started RX of a control frame attempt has been
  * successfully completed.
  */
-typedef Callback<void, std::list<Ptr<LteControlMessage>>> LtePhyRxCtrlEndOkCallback;
+typedef Callback<void, const std::list<Ptr<LteControlMessage>>&> LtePhyRxCtrlEndOkCallback;
 
 /**
  * This method is used by the LteSpectrumPhy to notify the PHY that a
@@ -441,7 +441,7 @@ class LteSpectrumPhy : public SpectrumPhy
      * started, false otherwise.
      */
     bool StartTxDataFrame(Ptr<PacketBurst> pb,
-                          std::list<Ptr<LteControlMessage>> ctrlMsgList,
+                          const std::list<Ptr<LteControlMessage>>& ctrlMsgList,
                           Time duration);
 
     /**
@@ -520,7 +520,7 @@ class LteSpectrumPhy : public SpectrumPhy
      * \return true if an error occurred and the transmission was not
      * started, false otherwise.
      */
-    bool StartTxDlCtrlFrame(std::list<Ptr<LteControlMessage>> ctrlMsgList, bool pss);
+    bool StartTxDlCtrlFrame(const std::list<Ptr<LteControlMessage>>& ctrlMsgList, bool pss);
 
     /**
      * Start a transmission of control frame in UL
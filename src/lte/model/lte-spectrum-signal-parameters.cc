@@ -66,7 +66,7 @@ LteSpectrumSignalParametersDataFrame::LteSpectrumSignalParametersDataFrame(
     {
         packetBurst = p.packetBurst->Copy();
     }
-    ctrlMsgList = p.ctrlMsgList;
+    ctrlMsgBurst = p.ctrlMsgBurst;
 }
 
 Ptr<SpectrumSignalParameters>
@@ -88,7 +88,7 @@ LteSpectrumSignalParametersDlCtrlFrame::LteSpectrumSignalParametersDlCtrlFrame(
     NS_LOG_FUNCTION(this << &p);
     cellId = p.cellId;
     pss = p.pss;
-    ctrlMsgList = p.ctrlMsgList;
+    ctrlMsgBurst = p.ctrlMsgBurst;
 }
 
 Ptr<SpectrumSignalParameters>
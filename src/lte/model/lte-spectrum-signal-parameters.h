@@ -31,6 +31,7 @@ namespace ns3
 
 class PacketBurst;
 class LteControlMessage;
+class LteControlMessageBurst;
 
 /**
  * \ingroup lte
@@ -85,7 +86,11 @@ struct LteSpectrumSignalParametersDataFrame : public SpectrumSignalParameters
      */
     Ptr<PacketBurst> packetBurst;
 
-    std::list<Ptr<LteControlMessage>> ctrlMsgList; ///< the control message list
+    /**
+     * The control messages transmitted with the data, shared by all the
+     * receivers, or nullptr if there are none
+     */
+    Ptr<const LteControlMessageBurst> ctrlMsgBurst;
 
     uint16_t cellId; ///< cell ID
 };
@@ -110,7 +115,11 @@ struct LteSpectrumSignalParametersDlCtrlFrame : public SpectrumSignalParameters
      */
     LteSpectrumSignalParametersDlCtrlFrame(const LteSpectrumSignalParametersDlCtrlFrame& p);
 
-    std::list<Ptr<LteControlMessage>> ctrlMsgList; ///< control message list
+    /**
+     * The control messages of the PDCCH, shared by all the receivers, or
+     * nullptr if there are none
+     */
+    Ptr<const LteControlMessageBurst> ctrlMsgBurst;
 
     uint16_t cellId; ///< cell ID
     bool pss;        ///< primary synchronization signal
@@ -46,6 +46,7 @@
 #include <ns3/pointer.h>
 #include <ns3/simulator.h>
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 
@@ -944,48 +945,44 @@ LteUePhy::GenerateCqiRsrpRsrq(const SpectrumValue& sinr)
         // measure instantaneous RSRQ now
         NS_ASSERT_MSG(m_rsInterferencePowerUpdated, " RS interference power info obsolete");
 
-        auto itPss = m_pssList.begin();
-        while (itPss != m_pssList.end())
+        // the RSSI does not depend on the cell that sent the PSS, hence it
+        // is evaluated once for all the cells detected in this subframe
+        uint16_t rbNum = 0;
+        double rssiSum = 0.0;
+        auto itIntN = m_rsInterferencePower.ConstValuesBegin();
+        for (auto itPj = m_rsReceivedPower.ConstValuesBegin();
+             itPj != m_rsReceivedPower.ConstValuesEnd();
+             itIntN++, itPj++)
         {
-            uint16_t rbNum = 0;
-            double rssiSum = 0.0;
-
-            auto itIntN = m_rsInterferencePower.ConstValuesBegin();
-            auto itPj = m_rsReceivedPower.ConstValuesBegin();
-            for (itPj = m_rsReceivedPower.ConstValuesBegin();
-                 itPj != m_rsReceivedPower.ConstValuesEnd();
-                 itIntN++, itPj++)
-            {
-                rbNum++;
-                // convert PSD [W/Hz] to linear power [W] for the single RE
-                double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
-                double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
-                rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
-            }
+            rbNum++;
+            // convert PSD [W/Hz] to linear power [W] for the single RE
+            double interfPlusNoisePowerTxW = ((*itIntN) * 180000.0) / 12.0;
+            double signalPowerTxW = ((*itPj) * 180000.0) / 12.0;
+            rssiSum += (2 * (interfPlusNoisePowerTxW + signalPowerTxW));
+        }
 
-            NS_ASSERT(rbNum == (*itPss).nRB);
-            double rsrq_dB = 10 * log10((*itPss).pssPsdSum / rssiSum);
+        for (const auto& pss : m_pssList)
+        {
+            NS_ASSERT(rbNum == pss.nRB);
+            double rsrq_dB = 10 * log10(pss.pssPsdSum / rssiSum);
 
             if (rsrq_dB > m_pssReceptionThreshold)
             {
                 NS_LOG_INFO(this << " PSS RNTI " << m_rnti << " cellId " << m_cellId << " has RSRQ "
                                  << rsrq_dB << " and RBnum " << rbNum);
                 // store measurements
-                auto itMeasMap = m_ueMeasurementsMap.find((*itPss).cellId);
-                if (itMeasMap != m_ueMeasurementsMap.end())
+                auto itMeas = FindUeMeasurements(pss.cellId);
+                if (itMeas != m_ueMeasurements.end() && itMeas->first == pss.cellId)
                 {
-                    (*itMeasMap).second.rsrqSum += rsrq_dB;
-                    (*itMeasMap).second.rsrqNum++;
+                    itMeas->second.rsrqSum += rsrq_dB;
+                    itMeas->second.rsrqNum++;
                 }
                 else
                 {
                     NS_LOG_WARN("race condition of bug 2091 occurred");
                 }
             }
-
-            itPss++;
-
-        } // end of while (itPss != m_pssList.end ())
+        }
 
         m_pssList.clear();
 
@@ -1235,7 +1232,7 @@ LteUePhy::ReportUeMeasurements()
     LteUeCphySapUser::UeMeasurementsParameters ret;
     ret.m_componentCarrierId = m_componentCarrierId;
 
-    for (auto it = m_ueMeasurementsMap.begin(); it != m_ueMeasurementsMap.end(); it++)
+    for (auto it = m_ueMeasurements.begin(); it != m_ueMeasurements.end(); it++)
     {
         double avg_rsrp = (*it).second.rsrpSum / static_cast<double>((*it).second.rsrpNum);
         double avg_rsrq = (*it).second.rsrqSum / static_cast<double>((*it).second.rsrqNum);
@@ -1270,7 +1267,7 @@ LteUePhy::ReportUeMeasurements()
     // report to RRC
     m_ueCphySapUser->ReportUeMeasurements(ret);
 
-    m_ueMeasurementsMap.clear();
+    m_ueMeasurements.clear();
     Simulator::Schedule(m_ueMeasurementsFilterPeriod, &LteUePhy::ReportUeMeasurements, this);
 }
 
@@ -1320,7 +1317,7 @@ LteUePhy::DoNotifyConnectionSuccessful()
 }
 
 void
-LteUePhy::ReceiveLteControlMessageList(std::list<Ptr<LteControlMessage>> msgList)
+LteUePhy::ReceiveLteControlMessageList(const std::list<Ptr<LteControlMessage>>& msgList)
 {
     NS_LOG_FUNCTION(this);
 
@@ -1519,21 +1516,21 @@ LteUePhy::ReceivePss(uint16_t cellId, Ptr<SpectrumValue> p)
     // note that m_pssReceptionThreshold does not apply here
 
     // store measurements
-    auto itMeasMap = m_ueMeasurementsMap.find(cellId);
-    if (itMeasMap == m_ueMeasurementsMap.end())
+    auto itMeas = FindUeMeasurements(cellId);
+    if (itMeas == m_ueMeasurements.end() || itMeas->first != cellId)
     {
-        // insert new entry
+        // insert new entry, keeping the entries sorted by cell ID
         UeMeasurementsElement newEl;
         newEl.rsrpSum = rsrp_dBm;
         newEl.rsrpNum = 1;
         newEl.rsrqSum = 0;
         newEl.rsrqNum = 0;
-        m_ueMeasurementsMap.insert(std::pair<uint16_t, UeMeasurementsElement>(cellId, newEl));
+        m_ueMeasurements.insert(itMeas, CellUeMeasurements(cellId, newEl));
     }
     else
     {
-        (*itMeasMap).second.rsrpSum += rsrp_dBm;
-        (*itMeasMap).second.rsrpNum++;
+        itMeas->second.rsrpSum += rsrp_dBm;
+        itMeas->second.rsrpNum++;
     }
 
     /*
@@ -1549,6 +1546,17 @@ LteUePhy::ReceivePss(uint16_t cellId, Ptr<SpectrumValue> p)
 
 } // end of void LteUePhy::ReceivePss (uint16_t cellId, Ptr<SpectrumValue> p)
 
+std::vector<LteUePhy::CellUeMeasurements>::iterator
+LteUePhy::FindUeMeasurements(uint16_t cellId)
+{
+    return std::lower_bound(m_ueMeasurements.begin(),
+                            m_ueMeasurements.end(),
+                            cellId,
+                            [](const CellUeMeasurements& el, uint16_t id) {
+                                return el.first < id;
+                            });
+}
+
 void
 LteUePhy::QueueSubChannelsForTransmission(std::vector<int> rbMap)
 {
@@ -36,6 +36,7 @@
 #include <ns3/ptr.h>
 
 #include <set>
+#include <vector>
 
 namespace ns3
 {
@@ -251,7 +252,7 @@ class LteUePhy : public LtePhy
      *
      * \param msgList LTE control message list
      */
-    virtual void ReceiveLteControlMessageList(std::list<Ptr<LteControlMessage>> msgList);
+    virtual void ReceiveLteControlMessageList(const std::list<Ptr<LteControlMessage>>& msgList);
     /**
      * \brief Receive PSS function
      *
@@ -910,7 +911,11 @@ class LteUePhy : public LtePhy
         uint16_t nRB;     ///< number of RB
     };
 
-    std::list<PssElement> m_pssList; ///< PSS list
+    /**
+     * PSS received in the current subframe. Kept as a vector so that its
+     * storage is reused from one subframe to the next.
+     */
+    std::vector<PssElement> m_pssList;
 
     /**
      * The `RsrqUeMeasThreshold` attribute. Receive threshold for PSS on RSRQ
@@ -932,11 +937,25 @@ class LteUePhy : public LtePhy
         uint8_t rsrqNum; ///< Number of RSRQ samples.
     };
 
+    /// Measurement results of a cell, paired with the cell ID.
+    typedef std::pair<uint16_t, UeMeasurementsElement> CellUeMeasurements;
+
     /**
      * Store measurement results during the last layer-1 filtering period.
-     * Indexed by the cell ID where the measurements come from.
+     * Sorted by the cell ID where the measurements come from; the storage
+     * is reused across filtering periods.
+     */
+    std::vector<CellUeMeasurements> m_ueMeasurements;
+
+    /**
+     * Find the measurement results of a cell in the current layer-1
+     * filtering period.
+     *
+     * \param cellId the cell ID
+     * \return an iterator to the first element whose cell ID is not less
+     *         than cellId
      */
-    std::map<uint16_t, UeMeasurementsElement> m_ueMeasurementsMap;
+    std::vector<CellUeMeasurements>::iterator FindUeMeasurements(uint16_t cellId);
     /**
      * The `UeMeasurementsFilterPeriod` attribute. Time period for reporting UE
      * measurements, i.e., the length of layer-1 filtering (default 200 ms).
@@ -395,7 +395,7 @@ LteDownlinkCtrlSinrTestCase::DoRun()
     sp1->psd = m_sv;
     sp1->txPhy = nullptr;
     sp1->duration = ds;
-    sp1->ctrlMsgList = ctrlMsgList[0];
+    sp1->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList[0]);
     sp1->cellId = pbCellId[0];
     sp1->pss = false;
     Simulator::Schedule(ts, &LteSpectrumPhy::StartRx, dlPhy, sp1);
@@ -405,7 +405,7 @@ LteDownlinkCtrlSinrTestCase::DoRun()
     ip1->psd = i1;
     ip1->txPhy = nullptr;
     ip1->duration = di1;
-    ip1->ctrlMsgList = ctrlMsgList[1];
+    ip1->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList[1]);
     ip1->cellId = pbCellId[1];
     ip1->pss = false;
     Simulator::Schedule(ti1, &LteSpectrumPhy::StartRx, dlPhy, ip1);
@@ -415,7 +415,7 @@ LteDownlinkCtrlSinrTestCase::DoRun()
     ip2->psd = i2;
     ip2->txPhy = nullptr;
     ip2->duration = di2;
-    ip2->ctrlMsgList = ctrlMsgList[2];
+    ip2->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList[2]);
     ip2->cellId = pbCellId[2];
     ip2->pss = false;
     Simulator::Schedule(ti2, &LteSpectrumPhy::StartRx, dlPhy, ip2);
@@ -425,7 +425,7 @@ LteDownlinkCtrlSinrTestCase::DoRun()
     ip3->psd = i3;
     ip3->txPhy = nullptr;
     ip3->duration = di3;
-    ip3->ctrlMsgList = ctrlMsgList[3];
+    ip3->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList[3]);
     ip3->cellId = pbCellId[3];
     ip3->pss = false;
     Simulator::Schedule(ti3, &LteSpectrumPhy::StartRx, dlPhy, ip3);
@@ -435,7 +435,7 @@ LteDownlinkCtrlSinrTestCase::DoRun()
     ip4->psd = i4;
     ip4->txPhy = nullptr;
     ip4->duration = di4;
-    ip4->ctrlMsgList = ctrlMsgList[4];
+    ip4->ctrlMsgBurst = Create<LteControlMessageBurst>(ctrlMsgList[4]);
     ip4->cellId = pbCellId[4];
     ip4->pss = false;
     Simulator::Schedule(ti4, &LteSpectrumPhy::StartRx, dlPhy, ip4);
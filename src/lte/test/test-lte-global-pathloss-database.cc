@@ -0,0 +1,139 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/lte-global-pathloss-database.h"
+#include "ns3/test.h"
+
+#include <limits>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup lte-test
+ *
+ * Check that the values stored in a LteGlobalPathlossDatabase are preserved
+ * while the matrix grows, and that the binary snapshot contains them.
+ */
+class LteGlobalPathlossDatabaseTestCase : public TestCase
+{
+  public:
+    LteGlobalPathlossDatabaseTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+LteGlobalPathlossDatabaseTestCase::LteGlobalPathlossDatabaseTestCase()
+    : TestCase("Dense pathloss matrix and binary snapshot")
+{
+}
+
+void
+LteGlobalPathlossDatabaseTestCase::DoRun()
+{
+    DownlinkLteGlobalPathlossDatabase db;
+    const uint16_t nCells = 3;
+    const uint64_t nImsis = 40; // enough to grow the rows twice
+    for (uint64_t imsi = 1; imsi <= nImsis; ++imsi)
+    {
+        for (uint16_t cellId = 1; cellId <= nCells; ++cellId)
+        {
+            db.SetPathloss(cellId * 10, imsi, cellId * 1000.0 + imsi);
+        }
+    }
+    db.SetPathloss(10, 1, 55.5); // overwrite a value
+
+    NS_TEST_ASSERT_MSG_EQ(db.GetPathloss(10, 1), 55.5, "Wrong overwritten value");
+    NS_TEST_ASSERT_MSG_EQ(db.GetPathloss(30, 40), 3040.0, "Wrong value after growth");
+    NS_TEST_ASSERT_MSG_EQ(db.GetPathloss(20, 17), 2017.0, "Wrong value after growth");
+    NS_TEST_ASSERT_MSG_EQ(db.GetPathloss(40, 1),
+                          std::numeric_limits<double>::infinity(),
+                          "Unknown cell should have infinite pathloss");
+    NS_TEST_ASSERT_MSG_EQ(db.GetPathloss(10, 41),
+                          std::numeric_limits<double>::infinity(),
+                          "Unknown UE should have infinite pathloss");
+
+    std::stringstream ss;
+    db.WriteSnapshot(ss);
+    double time;
+    uint32_t cells;
+    uint32_t imsis;
+    ss.read(reinterpret_cast<char*>(&time), sizeof(time));
+    ss.read(reinterpret_cast<char*>(&cells), sizeof(cells));
+    ss.read(reinterpret_cast<char*>(&imsis), sizeof(imsis));
+    NS_TEST_ASSERT_MSG_EQ(cells, nCells, "Wrong number of cells in the snapshot");
+    NS_TEST_ASSERT_MSG_EQ(imsis, nImsis, "Wrong number of UEs in the snapshot");
+    std::vector<uint16_t> cellIds(cells);
+    std::vector<uint64_t> imsiList(imsis);
+    std::vector<double> pathloss(cells * imsis);
+    ss.read(reinterpret_cast<char*>(cellIds.data()), cells * sizeof(uint16_t));
+    ss.read(reinterpret_cast<char*>(imsiList.data()), imsis * sizeof(uint64_t));
+    ss.read(reinterpret_cast<char*>(pathloss.data()), pathloss.size() * sizeof(double));
+    NS_TEST_ASSERT_MSG_EQ(ss.good(), true, "Truncated snapshot");
+    for (uint32_t row = 0; row < cells; ++row)
+    {
+        for (uint32_t col = 0; col < imsis; ++col)
+        {
+            NS_TEST_ASSERT_MSG_EQ(pathloss[row * imsis + col],
+                                  db.GetPathloss(cellIds[row], imsiList[col]),
+                                  "Wrong value in the snapshot");
+        }
+    }
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * Test suite of the LteGlobalPathlossDatabase.
+ */
+class LteGlobalPathlossDatabaseTestSuite : public TestSuite
+{
+  public:
+    LteGlobalPathlossDatabaseTestSuite();
+};
+
+LteGlobalPathlossDatabaseTestSuite::LteGlobalPathlossDatabaseTestSuite()
+    : TestSuite("lte-global-pathloss-database", UNIT)
+{
+    AddTestCase(new LteGlobalPathlossDatabaseTestCase(), TestCase::QUICK);
+}
+
+/**
+ * \ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteGlobalPathlossDatabaseTestSuite g_lteGlobalPathlossDatabaseTestSuite;
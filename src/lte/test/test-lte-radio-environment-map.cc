@@ -0,0 +1,192 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/lte-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/pointer.h"
+#include "ns3/radio-environment-map-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("LteRadioEnvironmentMapTest");
+
+/**
+ * \ingroup lte-test
+ *
+ * Check that the SINR of a REM computed offline matches the SINR measured by
+ * the RemSpectrumPhy listeners of an online REM, for a scenario with two eNBs
+ * and the Friis propagation loss model.
+ */
+class LteRemOfflineTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param numThreads number of threads computing the offline REM
+     */
+    LteRemOfflineTestCase(uint32_t numThreads);
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Read the SINR values of a REM output file.
+     *
+     * \param fileName the name of the REM output file
+     * \return the SINR of the points of the REM, in the order of the file
+     */
+    std::vector<double> ReadSinr(std::string fileName);
+
+    uint32_t m_numThreads; ///< number of threads computing the offline REM
+};
+
+LteRemOfflineTestCase::LteRemOfflineTestCase(uint32_t numThreads)
+    : TestCase("Offline REM with " + std::to_string(numThreads) + " threads"),
+      m_numThreads(numThreads)
+{
+}
+
+std::vector<double>
+LteRemOfflineTestCase::ReadSinr(std::string fileName)
+{
+    std::vector<double> sinr;
+    std::ifstream inFile(fileName);
+    NS_ABORT_MSG_IF(!inFile.is_open(), "Can't open file " << fileName);
+    double x;
+    double y;
+    double z;
+    double value;
+    while (inFile >> x >> y >> z >> value)
+    {
+        sinr.push_back(value);
+    }
+    return sinr;
+}
+
+void
+LteRemOfflineTestCase::DoRun()
+{
+    Ptr<LteHelper> lteHelper = CreateObject<LteHelper>();
+    lteHelper->SetAttribute("PathlossModel", StringValue("ns3::FriisPropagationLossModel"));
+
+    NodeContainer enbNodes;
+    enbNodes.Create(2);
+    Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator>();
+    positionAlloc->Add(Vector(0.0, 0.0, 30.0));
+    positionAlloc->Add(Vector(300.0, 0.0, 30.0));
+    MobilityHelper mobility;
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.SetPositionAllocator(positionAlloc);
+    mobility.Install(enbNodes);
+    lteHelper->InstallEnbDevice(enbNodes);
+
+    std::string onlineFile = CreateTempDirFilename("rem-online.out");
+    std::string offlineFile = CreateTempDirFilename("rem-offline.out");
+
+    Ptr<RadioEnvironmentMapHelper> remHelpers[2];
+    for (uint32_t i = 0; i < 2; ++i)
+    {
+        bool offline = (i == 1);
+        remHelpers[i] = CreateObject<RadioEnvironmentMapHelper>();
+        remHelpers[i]->SetAttribute("Channel",
+                                    PointerValue(lteHelper->GetDownlinkSpectrumChannel()));
+        remHelpers[i]->SetAttribute("OutputFile", StringValue(offline ? offlineFile : onlineFile));
+        remHelpers[i]->SetAttribute("XMin", DoubleValue(-100.0));
+        remHelpers[i]->SetAttribute("XMax", DoubleValue(400.0));
+        remHelpers[i]->SetAttribute("XRes", UintegerValue(3));
+        remHelpers[i]->SetAttribute("YMin", DoubleValue(-100.0));
+        remHelpers[i]->SetAttribute("YMax", DoubleValue(100.0));
+        remHelpers[i]->SetAttribute("YRes", UintegerValue(3));
+        remHelpers[i]->SetAttribute("Z", DoubleValue(1.5));
+        remHelpers[i]->SetAttribute("StopWhenDone", BooleanValue(!offline));
+        remHelpers[i]->SetAttribute("ComputeOffline", BooleanValue(offline));
+        remHelpers[i]->SetAttribute("NumThreads", UintegerValue(m_numThreads));
+        remHelpers[i]->Install();
+    }
+
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+    Simulator::Destroy();
+
+    std::vector<double> onlineSinr = ReadSinr(onlineFile);
+    std::vector<double> offlineSinr = ReadSinr(offlineFile);
+    NS_TEST_ASSERT_MSG_EQ(onlineSinr.size(), 9, "Wrong number of points in the online REM");
+    NS_TEST_ASSERT_MSG_EQ(offlineSinr.size(), 9, "Wrong number of points in the offline REM");
+    for (std::size_t i = 0; i < onlineSinr.size(); ++i)
+    {
+        NS_LOG_INFO("point " << i << " online SINR " << onlineSinr[i] << " offline SINR "
+                             << offlineSinr[i]);
+        NS_TEST_ASSERT_MSG_EQ_TOL(10 * std::log10(offlineSinr[i]),
+                                  10 * std::log10(onlineSinr[i]),
+                                  0.001,
+                                  "Wrong offline SINR at point " << i);
+    }
+}
+
+/**
+ * \ingroup lte-test
+ *
+ * Test suite of the RadioEnvironmentMapHelper.
+ */
+class LteRadioEnvironmentMapTestSuite : public TestSuite
+{
+  public:
+    LteRadioEnvironmentMapTestSuite();
+};
+
+LteRadioEnvironmentMapTestSuite::LteRadioEnvironmentMapTestSuite()
+    : TestSuite("lte-radio-environment-map", SYSTEM)
+{
+    AddTestCase(new LteRemOfflineTestCase(1), TestCase::QUICK);
+    AddTestCase(new LteRemOfflineTestCase(2), TestCase::QUICK);
+}
+
+/**
+ * \ingroup lte-test
+ * Static variable for test initialization
+ */
+static LteRadioEnvironmentMapTestSuite g_lteRadioEnvironmentMapTestSuite;
@@ -210,6 +210,17 @@ AsciiTraceHelper::CreateFileStream(std::string filename, std::ios::openmode file
     return StreamWrapper;
 }
 
+Ptr<BinaryTraceSink>
+AsciiTraceHelper::CreateBinaryFile(std::string filename,
+                                   std::string header,
+                                   std::string terminator)
+{
+    NS_LOG_FUNCTION(filename << header << terminator);
+    Ptr<BinaryTraceSink> sink = Create<BinaryTraceSink>(filename, header, terminator);
+    NS_ABORT_MSG_IF(sink->Fail(), "Unable to Open " << filename);
+    return sink;
+}
+
 std::string
 AsciiTraceHelper::GetFilenameFromDevice(std::string prefix,
                                         Ptr<NetDevice> device,
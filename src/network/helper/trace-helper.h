@@ -22,6 +22,7 @@
 #include "node-container.h"
 
 #include "ns3/assert.h"
+#include "ns3/binary-trace-sink.h"
 #include "ns3/output-stream-wrapper.h"
 #include "ns3/pcap-file-wrapper.h"
 #include "ns3/simulator.h"
@@ -238,6 +239,22 @@ class AsciiTraceHelper
     Ptr<OutputStreamWrapper> CreateFileStream(std::string filename,
                                               std::ios::openmode filemode = std::ios::out);
 
+    /**
+     * @brief Create a sink of binary trace records, as an alternative to an
+     * output stream for the trace sinks whose records have fixed fields.
+     *
+     * The records are written without formatting, in batches, and the file
+     * is converted to the text format by utils/binary-trace-to-text.py.
+     *
+     * @param filename file name
+     * @param header header lines of the text file, with their line ends
+     * @param terminator characters after the last field of each record
+     * @returns a smart pointer to the binary trace sink
+     */
+    Ptr<BinaryTraceSink> CreateBinaryFile(std::string filename,
+                                          std::string header,
+                                          std::string terminator = "\n");
+
     /**
      * @brief Hook a trace source to the default enqueue operation trace sink that
      * does not accept nor log a trace context.
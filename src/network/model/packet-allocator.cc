@@ -0,0 +1,466 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "packet-allocator.h"
+
+#include "ns3/log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <new>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PacketAllocator");
+
+namespace
+{
+
+constexpr uint32_t N_SIZE_CLASSES = 23;        //!< Number of size classes
+constexpr std::size_t MIN_BLOCK_SIZE = 32;     //!< Size of the blocks of the first class
+constexpr std::size_t MAX_BLOCK_SIZE = 65536;  //!< Size of the blocks of the last class
+constexpr std::size_t CACHE_BYTES = 1 << 20;   //!< Target size of a thread cache, per class
+constexpr std::size_t MIN_CACHE_BLOCKS = 16;   //!< Minimum capacity of a thread cache
+constexpr std::size_t MAX_CACHE_BLOCKS = 1024; //!< Maximum capacity of a thread cache
+constexpr std::size_t GLOBAL_POOL_FACTOR = 8;  //!< Capacity of the global pool, in thread caches
+
+/**
+ * \brief Get the size class of a requested size
+ * \param size the requested size, not larger than MAX_BLOCK_SIZE
+ * \returns the index of the size class
+ */
+inline uint32_t
+GetSizeClass(std::size_t size)
+{
+    if (size <= MIN_BLOCK_SIZE)
+    {
+        return 0;
+    }
+    // the block sizes between 2^p (excluded) and 2^(p+1) are 1.5 * 2^p and 2^(p+1)
+    uint32_t p = 5;
+    while ((std::size_t(2) << p) < size)
+    {
+        p++;
+    }
+    return 2 * (p - 5) + (size <= (std::size_t(3) << (p - 1)) ? 1 : 2);
+}
+
+/**
+ * \brief Get the size of the blocks of a size class
+ * \param sizeClass the index of the size class
+ * \returns the size of the blocks, in bytes
+ */
+inline std::size_t
+GetClassBlockSize(uint32_t sizeClass)
+{
+    if (sizeClass == 0)
+    {
+        return MIN_BLOCK_SIZE;
+    }
+    uint32_t p = 5 + (sizeClass - 1) / 2;
+    return (sizeClass % 2 == 1) ? (std::size_t(3) << (p - 1)) : (std::size_t(2) << p);
+}
+
+/**
+ * \brief Get the maximum number of free blocks of a size class in a thread cache
+ * \param sizeClass the index of the size class
+ * \returns the capacity of the thread cache
+ */
+inline std::size_t
+GetCacheCapacity(uint32_t sizeClass)
+{
+    return std::min(std::max(CACHE_BYTES / GetClassBlockSize(sizeClass), MIN_CACHE_BLOCKS),
+                    MAX_CACHE_BLOCKS);
+}
+
+/**
+ * \brief Counters of live objects
+ */
+struct LiveCounter
+{
+    std::atomic<uint64_t> live{0};        //!< Number of live objects
+    std::atomic<uint64_t> peak{0};        //!< Maximum number of live objects
+    std::atomic<uint64_t> allocations{0}; //!< Number of allocations
+
+    /// Count an allocation
+    void Increment()
+    {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+        uint64_t n = live.fetch_add(1, std::memory_order_relaxed) + 1;
+        uint64_t p = peak.load(std::memory_order_relaxed);
+        while (n > p && !peak.compare_exchange_weak(p, n, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// Count a deallocation
+    void Decrement()
+    {
+        live.fetch_sub(1, std::memory_order_relaxed);
+    }
+};
+
+LiveCounter g_packets;                     //!< Counters of the Packet objects
+LiveCounter g_sizeClasses[N_SIZE_CLASSES]; //!< Counters of the blocks of each size class
+std::atomic<bool> g_pooling{true};         //!< Whether the free blocks are kept for reuse
+bool g_globalPoolDestroyed = false;        //!< Whether the global pool has been destroyed
+
+/// Free blocks of each size class
+typedef std::vector<void*> FreeBlocks[N_SIZE_CLASSES];
+
+/**
+ * \brief Return free blocks to the heap
+ * \param blocks the free blocks
+ */
+void
+ReleaseBlocks(std::vector<void*>& blocks)
+{
+    for (void* block : blocks)
+    {
+        ::operator delete(block);
+    }
+    blocks.clear();
+}
+
+/**
+ * \brief Free blocks shared by all the threads
+ */
+struct GlobalPool
+{
+    std::mutex mutex;  //!< Mutex protecting the free blocks
+    FreeBlocks blocks; //!< Free blocks of each size class
+
+    ~GlobalPool()
+    {
+        for (auto& classBlocks : blocks)
+        {
+            ReleaseBlocks(classBlocks);
+        }
+        g_globalPoolDestroyed = true;
+    }
+};
+
+/**
+ * \returns the global pool, which must not have been destroyed
+ */
+GlobalPool&
+GetGlobalPool()
+{
+    static GlobalPool pool;
+    return pool;
+}
+
+/**
+ * \brief Move free blocks of a thread cache to the global pool
+ * \param sizeClass the index of the size class
+ * \param blocks the free blocks of the thread cache
+ * \param count the number of blocks to move
+ */
+void
+SpillBlocks(uint32_t sizeClass, std::vector<void*>& blocks, std::size_t count)
+{
+    if (g_globalPoolDestroyed)
+    {
+        ReleaseBlocks(blocks);
+        return;
+    }
+    GlobalPool& pool = GetGlobalPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    std::vector<void*>& poolBlocks = pool.blocks[sizeClass];
+    std::size_t capacity = GLOBAL_POOL_FACTOR * GetCacheCapacity(sizeClass);
+    while (count > 0)
+    {
+        void* block = blocks.back();
+        blocks.pop_back();
+        count--;
+        if (poolBlocks.size() < capacity)
+        {
+            poolBlocks.push_back(block);
+        }
+        else
+        {
+            ::operator delete(block);
+        }
+    }
+}
+
+/**
+ * \brief Move free blocks of the global pool to a thread cache
+ * \param sizeClass the index of the size class
+ * \param blocks the free blocks of the thread cache
+ */
+void
+RefillBlocks(uint32_t sizeClass, std::vector<void*>& blocks)
+{
+    GlobalPool& pool = GetGlobalPool();
+    std::lock_guard<std::mutex> lock(pool.mutex);
+    std::vector<void*>& poolBlocks = pool.blocks[sizeClass];
+    std::size_t count = std::min(poolBlocks.size(), GetCacheCapacity(sizeClass) / 2);
+    blocks.insert(blocks.end(), poolBlocks.end() - count, poolBlocks.end());
+    poolBlocks.resize(poolBlocks.size() - count);
+}
+
+thread_local FreeBlocks* t_cache = nullptr; //!< Free blocks of the thread
+thread_local bool t_cacheDestroyed = false; //!< Whether the cache of the thread has been destroyed
+
+/**
+ * \brief Return the free blocks of the thread to the global pool when the thread exits
+ */
+struct ThreadCacheOwner
+{
+    ~ThreadCacheOwner()
+    {
+        if (t_cache != nullptr)
+        {
+            for (uint32_t i = 0; i < N_SIZE_CLASSES; i++)
+            {
+                SpillBlocks(i, (*t_cache)[i], (*t_cache)[i].size());
+            }
+            delete[] t_cache;
+            t_cache = nullptr;
+        }
+        t_cacheDestroyed = true;
+    }
+};
+
+thread_local ThreadCacheOwner t_cacheOwner; //!< Owner of the cache of the thread
+
+/**
+ * \returns the free blocks of the thread, or nullptr if the thread or the
+ *          program is exiting
+ */
+inline FreeBlocks*
+GetThreadCache()
+{
+    if (t_cache == nullptr && !t_cacheDestroyed && !g_globalPoolDestroyed)
+    {
+        // construct the global pool and the owner first, so that they are
+        // destroyed after the cache is used
+        GetGlobalPool();
+        (void)&t_cacheOwner;
+        t_cache = new FreeBlocks[1];
+    }
+    return t_cache;
+}
+
+} // namespace
+
+void*
+PacketAllocator::Allocate(std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        return ::operator new(size);
+    }
+    uint32_t sizeClass = GetSizeClass(size);
+    g_sizeClasses[sizeClass].Increment();
+    if (g_pooling.load(std::memory_order_relaxed))
+    {
+        FreeBlocks* cache = GetThreadCache();
+        if (cache != nullptr)
+        {
+            std::vector<void*>& blocks = (*cache)[sizeClass];
+            if (blocks.empty())
+            {
+                RefillBlocks(sizeClass, blocks);
+            }
+            if (!blocks.empty())
+            {
+                void* block = blocks.back();
+                blocks.pop_back();
+                return block;
+            }
+        }
+    }
+    return ::operator new(GetClassBlockSize(sizeClass));
+}
+
+void
+PacketAllocator::Deallocate(void* block, std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        ::operator delete(block);
+        return;
+    }
+    uint32_t sizeClass = GetSizeClass(size);
+    g_sizeClasses[sizeClass].Decrement();
+    if (g_pooling.load(std::memory_order_relaxed))
+    {
+        FreeBlocks* cache = GetThreadCache();
+        if (cache != nullptr)
+        {
+            std::vector<void*>& blocks = (*cache)[sizeClass];
+            std::size_t capacity = GetCacheCapacity(sizeClass);
+            if (blocks.capacity() == 0)
+            {
+                blocks.reserve(capacity + 1);
+            }
+            blocks.push_back(block);
+            if (blocks.size() > capacity)
+            {
+                SpillBlocks(sizeClass, blocks, blocks.size() / 2);
+            }
+            return;
+        }
+    }
+    ::operator delete(block);
+}
+
+void*
+PacketAllocator::AllocatePacket(std::size_t size)
+{
+    g_packets.Increment();
+    return Allocate(size);
+}
+
+void
+PacketAllocator::DeallocatePacket(void* block, std::size_t size)
+{
+    g_packets.Decrement();
+    Deallocate(block, size);
+}
+
+std::size_t
+PacketAllocator::GetBlockSize(std::size_t size)
+{
+    if (size > MAX_BLOCK_SIZE)
+    {
+        return size;
+    }
+    return GetClassBlockSize(GetSizeClass(size));
+}
+
+void
+PacketAllocator::SetPooling(bool enable)
+{
+    NS_LOG_FUNCTION(enable);
+    g_pooling.store(enable, std::memory_order_relaxed);
+    if (!enable)
+    {
+        if (t_cache != nullptr)
+        {
+            for (auto& classBlocks : *t_cache)
+            {
+                ReleaseBlocks(classBlocks);
+            }
+        }
+        if (!g_globalPoolDestroyed)
+        {
+            GlobalPool& pool = GetGlobalPool();
+            std::lock_guard<std::mutex> lock(pool.mutex);
+            for (auto& classBlocks : pool.blocks)
+            {
+                ReleaseBlocks(classBlocks);
+            }
+        }
+    }
+}
+
+bool
+PacketAllocator::IsPooling()
+{
+    return g_pooling.load(std::memory_order_relaxed);
+}
+
+uint64_t
+PacketAllocator::GetLivePackets()
+{
+    return g_packets.live.load(std::memory_order_relaxed);
+}
+
+uint64_t
+PacketAllocator::GetPeakPackets()
+{
+    return g_packets.peak.load(std::memory_order_relaxed);
+}
+
+std::vector<PacketAllocator::SizeClassStats>
+PacketAllocator::GetStats()
+{
+    std::vector<SizeClassStats> stats;
+    stats.reserve(N_SIZE_CLASSES);
+    for (uint32_t i = 0; i < N_SIZE_CLASSES; i++)
+    {
+        SizeClassStats classStats;
+        classStats.blockSize = GetClassBlockSize(i);
+        classStats.liveBlocks = g_sizeClasses[i].live.load(std::memory_order_relaxed);
+        classStats.peakBlocks = g_sizeClasses[i].peak.load(std::memory_order_relaxed);
+        classStats.allocations = g_sizeClasses[i].allocations.load(std::memory_order_relaxed);
+        classStats.liveBytes = classStats.liveBlocks * classStats.blockSize;
+        classStats.peakBytes = classStats.peakBlocks * classStats.blockSize;
+        stats.push_back(classStats);
+    }
+    return stats;
+}
+
+void
+PacketAllocator::ResetPeaks()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    g_packets.peak.store(g_packets.live.load(std::memory_order_relaxed),
+                         std::memory_order_relaxed);
+    for (auto& counter : g_sizeClasses)
+    {
+        counter.peak.store(counter.live.load(std::memory_order_relaxed),
+                           std::memory_order_relaxed);
+    }
+}
+
+void
+PacketAllocator::PrintStats(std::ostream& os)
+{
+    os << "live packets: " << GetLivePackets() << ", peak packets: " << GetPeakPackets()
+       << std::endl;
+    os << std::setw(10) << "block size" << std::setw(13) << "live blocks" << std::setw(13)
+       << "peak blocks" << std::setw(13) << "live bytes" << std::setw(13) << "peak bytes"
+       << std::setw(13) << "allocations" << std::endl;
+    for (const auto& classStats : GetStats())
+    {
+        if (classStats.allocations == 0)
+        {
+            continue;
+        }
+        os << std::setw(10) << classStats.blockSize << std::setw(13) << classStats.liveBlocks
+           << std::setw(13) << classStats.peakBlocks << std::setw(13) << classStats.liveBytes
+           << std::setw(13) << classStats.peakBytes << std::setw(13) << classStats.allocations
+           << std::endl;
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,160 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef PACKET_ALLOCATOR_H
+#define PACKET_ALLOCATOR_H
+
+#include <cstddef>
+#include <ostream>
+#include <stdint.h>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup packet
+ *
+ * \brief Pooled allocator for the internals of the packets
+ *
+ * The Packet objects, the Buffer data, the PacketMetadata data and the
+ * PacketTagList tags are allocated by this class. The blocks are grouped
+ * in size classes (32 bytes, then 1.5 and 2 times each power of two up to
+ * 64 KiB) and the free blocks of each class are kept for reuse instead of
+ * being returned to the heap. Larger blocks are always allocated from the
+ * heap.
+ *
+ * Each thread has its own cache of free blocks, so that the realtime and
+ * distributed simulators can allocate packets from several threads without
+ * locking; the caches exchange blocks in batches with a global pool, which
+ * is protected by a mutex.
+ *
+ * The allocator counts the live Packet objects and the live blocks of each
+ * size class, with their peaks. The pooling can be disabled with
+ * SetPooling, e.g., to compare the performance of both modes, in which case
+ * the blocks are allocated from and returned to the heap, and the counts are
+ * still updated.
+ */
+class PacketAllocator
+{
+  public:
+    /**
+     * \brief Allocation statistics of a size class
+     */
+    struct SizeClassStats
+    {
+        uint32_t blockSize;   //!< Size of the blocks, in bytes
+        uint64_t liveBlocks;  //!< Number of allocated blocks
+        uint64_t peakBlocks;  //!< Maximum number of allocated blocks
+        uint64_t allocations; //!< Number of allocations since the start
+        uint64_t liveBytes;   //!< Bytes in the allocated blocks
+        uint64_t peakBytes;   //!< Bytes in the maximum number of allocated blocks
+    };
+
+    /**
+     * \brief Allocate a block
+     * \param size the requested size, in bytes
+     * \returns a block of at least GetBlockSize (size) bytes
+     */
+    static void* Allocate(std::size_t size);
+    /**
+     * \brief Deallocate a block
+     * \param block the block, returned by Allocate
+     * \param size the size requested to Allocate, or any size with the same
+     *        block size
+     */
+    static void Deallocate(void* block, std::size_t size);
+    /**
+     * \brief Allocate the memory of a Packet object
+     * \param size the size of the object
+     * \returns the memory of the object
+     */
+    static void* AllocatePacket(std::size_t size);
+    /**
+     * \brief Deallocate the memory of a Packet object
+     * \param block the memory of the object, returned by AllocatePacket
+     * \param size the size of the object
+     */
+    static void DeallocatePacket(void* block, std::size_t size);
+
+    /**
+     * \brief Get the size of the blocks allocated for a requested size
+     * \param size the requested size, in bytes
+     * \returns the size of the block, in bytes, which is \p size itself
+     *          for the sizes larger than the largest size class
+     */
+    static std::size_t GetBlockSize(std::size_t size);
+
+    /**
+     * \brief Enable or disable the pooling of the free blocks
+     * \param enable whether the free blocks are kept for reuse
+     *
+     * The pooling is enabled by default. When it is disabled, the blocks
+     * cached by the calling thread are returned to the heap.
+     */
+    static void SetPooling(bool enable);
+    /**
+     * \returns whether the free blocks are kept for reuse
+     */
+    static bool IsPooling();
+
+    /**
+     * \returns the number of live Packet objects
+     */
+    static uint64_t GetLivePackets();
+    /**
+     * \returns the maximum number of live Packet objects
+     */
+    static uint64_t GetPeakPackets();
+    /**
+     * \returns the statistics of each size class, by increasing block size
+     */
+    static std::vector<SizeClassStats> GetStats();
+    /**
+     * \brief Set the peaks of the Packet objects and of the size classes to
+     *        their current number
+     */
+    static void ResetPeaks();
+    /**
+     * \brief Print the statistics of the Packet objects and of the size
+     *        classes which have been used
+     * \param os the output stream
+     */
+    static void PrintStats(std::ostream& os);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ALLOCATOR_H */
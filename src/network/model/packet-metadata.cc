@@ -20,15 +20,28 @@
 
 #include "buffer.h"
 #include "header.h"
+#include "packet-allocator.h"
 #include "trailer.h"
 
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <limits>
 #include <list>
 #include <utility>
 
+namespace
+{
+
+/// Initial number of entries of a log
+constexpr uint32_t INITIAL_LOG_CAPACITY = 8;
+/// Number of entries of a log after which it is replayed
+constexpr uint32_t MAX_LOG_ENTRIES = 64;
+
+} // namespace
+
 namespace ns3
 {
 
@@ -36,20 +49,10 @@ NS_LOG_COMPONENT_DEFINE("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+bool PacketMetadata::m_lazy = false;
 bool PacketMetadata::m_metadataSkipped = false;
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList()
-{
-    NS_LOG_FUNCTION(this);
-    for (auto i = begin(); i != end(); i++)
-    {
-        PacketMetadata::Deallocate(*i);
-    }
-    PacketMetadata::m_enable = false;
-}
 
 void
 PacketMetadata::Enable()
@@ -73,6 +76,21 @@ PacketMetadata::EnableChecking()
     m_enableChecking = true;
 }
 
+void
+PacketMetadata::EnableLazy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    Enable();
+    m_lazy = true;
+}
+
+void
+PacketMetadata::DisableLazy()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    m_lazy = false;
+}
+
 void
 PacketMetadata::ReserveCopy(uint32_t size)
 {
@@ -572,20 +590,6 @@ PacketMetadata::Create(uint32_t size)
     {
         m_maxSize = size;
     }
-    while (!m_freeList.empty())
-    {
-        PacketMetadata::Data* data = m_freeList.back();
-        m_freeList.pop_back();
-        if (data->m_size >= size)
-        {
-            NS_LOG_LOGIC("create found size=" << data->m_size);
-            data->m_count = 1;
-            return data;
-        }
-        NS_LOG_LOGIC("create dealloc size=" << data->m_size);
-        PacketMetadata::Deallocate(data);
-    }
-    NS_LOG_LOGIC("create alloc size=" << m_maxSize);
     return PacketMetadata::Allocate(m_maxSize);
 }
 
@@ -593,21 +597,9 @@ void
 PacketMetadata::Recycle(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    if (!m_enable)
-    {
-        PacketMetadata::Deallocate(data);
-        return;
-    }
-    NS_LOG_LOGIC("recycle size=" << data->m_size << ", list=" << m_freeList.size());
-    NS_ASSERT(data->m_count == 0);
-    if (m_freeList.size() > 1000 || data->m_size < m_maxSize)
-    {
-        PacketMetadata::Deallocate(data);
-    }
-    else
-    {
-        m_freeList.push_back(data);
-    }
+    NS_LOG_LOGIC("recycle size=" << data->m_size);
+    NS_ASSERT(!m_enable || data->m_count == 0);
+    PacketMetadata::Deallocate(data);
 }
 
 PacketMetadata::Data*
@@ -620,8 +612,11 @@ PacketMetadata::Allocate(uint32_t n)
         n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
     size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-    auto buf = new uint8_t[size];
-    auto data = (PacketMetadata::Data*)buf;
+    // the whole block of the size class is usable, within the range of m_size
+    size = PacketAllocator::GetBlockSize(size);
+    n = std::min<uint32_t>(size - sizeof(Data) + PACKET_METADATA_DATA_M_DATA_SIZE,
+                           std::numeric_limits<uint16_t>::max());
+    auto data = static_cast<PacketMetadata::Data*>(PacketAllocator::Allocate(size));
     data->m_size = n;
     data->m_count = 1;
     data->m_dirtyEnd = 0;
@@ -632,8 +627,8 @@ void
 PacketMetadata::Deallocate(PacketMetadata::Data* data)
 {
     NS_LOG_FUNCTION(data);
-    auto buf = (uint8_t*)data;
-    delete[] buf;
+    PacketAllocator::Deallocate(data,
+                                sizeof(Data) + data->m_size - PACKET_METADATA_DATA_M_DATA_SIZE);
 }
 
 PacketMetadata
@@ -665,13 +660,27 @@ PacketMetadata::DoAddHeader(uint32_t uid, uint32_t size)
         return;
     }
 
+    uint16_t chunkUid = m_chunkUid;
+    m_chunkUid++;
+    if (m_lazy)
+    {
+        Record(LOG_ADD_HEADER, uid, size, chunkUid);
+        return;
+    }
+    Materialize();
+    AddHeaderItem(uid, size, chunkUid);
+}
+
+void
+PacketMetadata::AddHeaderItem(uint32_t uid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << uid << size << chunkUid);
     PacketMetadata::SmallItem item;
     item.next = m_head;
     item.prev = 0xffff;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = chunkUid;
     uint16_t written = AddSmall(&item);
     UpdateHead(written);
 }
@@ -686,6 +695,22 @@ PacketMetadata::RemoveHeader(const Header& header, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (m_lazy)
+    {
+        if (!CancelRecord(LOG_ADD_HEADER, uid, size))
+        {
+            Record(LOG_REMOVE_HEADER, uid, size, 0);
+        }
+        return;
+    }
+    Materialize();
+    RemoveHeaderItem(uid, size);
+}
+
+void
+PacketMetadata::RemoveHeaderItem(uint32_t uid, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << uid << size);
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_head, &item, &extraItem);
@@ -731,13 +756,27 @@ PacketMetadata::AddTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    uint16_t chunkUid = m_chunkUid;
+    m_chunkUid++;
+    if (m_lazy)
+    {
+        Record(LOG_ADD_TRAILER, uid, size, chunkUid);
+        return;
+    }
+    Materialize();
+    AddTrailerItem(uid, size, chunkUid);
+}
+
+void
+PacketMetadata::AddTrailerItem(uint32_t uid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << uid << size << chunkUid);
     PacketMetadata::SmallItem item;
     item.next = 0xffff;
     item.prev = m_tail;
     item.typeUid = uid;
     item.size = size;
-    item.chunkUid = m_chunkUid;
-    m_chunkUid++;
+    item.chunkUid = chunkUid;
     uint16_t written = AddSmall(&item);
     UpdateTail(written);
     NS_ASSERT(IsStateOk());
@@ -753,6 +792,22 @@ PacketMetadata::RemoveTrailer(const Trailer& trailer, uint32_t size)
         m_metadataSkipped = true;
         return;
     }
+    if (m_lazy)
+    {
+        if (!CancelRecord(LOG_ADD_TRAILER, uid, size))
+        {
+            Record(LOG_REMOVE_TRAILER, uid, size, 0);
+        }
+        return;
+    }
+    Materialize();
+    RemoveTrailerItem(uid, size);
+}
+
+void
+PacketMetadata::RemoveTrailerItem(uint32_t uid, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << uid << size);
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
     uint32_t read = ReadItems(m_tail, &item, &extraItem);
@@ -797,6 +852,8 @@ PacketMetadata::AddAtEnd(const PacketMetadata& o)
         m_metadataSkipped = true;
         return;
     }
+    Materialize();
+    o.Materialize();
     if (m_tail == 0xffff)
     {
         // We have no items so 'AddAtEnd' is
@@ -884,6 +941,22 @@ PacketMetadata::RemoveAtStart(uint32_t start)
         m_metadataSkipped = true;
         return;
     }
+    if (m_lazy)
+    {
+        if (start > 0)
+        {
+            Record(LOG_REMOVE_AT_START, 0, start, 0);
+        }
+        return;
+    }
+    Materialize();
+    RemoveItemsAtStart(start);
+}
+
+void
+PacketMetadata::RemoveItemsAtStart(uint32_t start)
+{
+    NS_LOG_FUNCTION(this << start);
     NS_ASSERT(m_data != nullptr);
     uint32_t leftToRemove = start;
     uint16_t current = m_head;
@@ -945,6 +1018,22 @@ PacketMetadata::RemoveAtEnd(uint32_t end)
         m_metadataSkipped = true;
         return;
     }
+    if (m_lazy)
+    {
+        if (end > 0)
+        {
+            Record(LOG_REMOVE_AT_END, 0, end, 0);
+        }
+        return;
+    }
+    Materialize();
+    RemoveItemsAtEnd(end);
+}
+
+void
+PacketMetadata::RemoveItemsAtEnd(uint32_t end)
+{
+    NS_LOG_FUNCTION(this << end);
     NS_ASSERT(m_data != nullptr);
 
     uint32_t leftToRemove = end;
@@ -1033,6 +1122,7 @@ PacketMetadata::ItemIterator
 PacketMetadata::BeginItem(Buffer buffer) const
 {
     NS_LOG_FUNCTION(this << &buffer);
+    Materialize();
     return ItemIterator(this, buffer);
 }
 
@@ -1128,6 +1218,7 @@ PacketMetadata::GetSerializedSize() const
     {
         return totalSize;
     }
+    Materialize();
 
     PacketMetadata::SmallItem item;
     PacketMetadata::ExtraItem extraItem;
@@ -1161,6 +1252,7 @@ uint32_t
 PacketMetadata::Serialize(uint8_t* buffer, uint32_t maxSize) const
 {
     NS_LOG_FUNCTION(this << &buffer << maxSize);
+    Materialize();
     uint8_t* start = buffer;
 
     buffer = AddToRawU64(m_packetUid, start, buffer, maxSize);
@@ -1267,6 +1359,7 @@ uint32_t
 PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
 {
     NS_LOG_FUNCTION(this << &buffer << size);
+    Materialize();
     const uint8_t* start = buffer;
     uint32_t desSize = size - 4;
 
@@ -1324,6 +1417,140 @@ PacketMetadata::Deserialize(const uint8_t* buffer, uint32_t size)
     return (desSize != 0) ? 0 : 1;
 }
 
+PacketMetadata::Log*
+PacketMetadata::CreateLog(uint32_t capacity)
+{
+    NS_LOG_FUNCTION(capacity);
+    void* p = PacketAllocator::Allocate(sizeof(Log) + capacity * sizeof(LogEntry));
+    auto log = new (p) Log;
+    log->count = 1;
+    log->used = 0;
+    log->capacity = capacity;
+    return log;
+}
+
+void
+PacketMetadata::ReleaseLog(Log* log)
+{
+    NS_LOG_FUNCTION(log);
+    NS_ASSERT(log->count > 0);
+    log->count--;
+    if (log->count == 0)
+    {
+        uint32_t capacity = log->capacity;
+        log->~Log();
+        PacketAllocator::Deallocate(log, sizeof(Log) + capacity * sizeof(LogEntry));
+    }
+}
+
+void
+PacketMetadata::Record(uint16_t operation, uint32_t typeUid, uint32_t size, uint16_t chunkUid)
+{
+    NS_LOG_FUNCTION(this << operation << typeUid << size << chunkUid);
+    if (m_logUsed == MAX_LOG_ENTRIES)
+    {
+        // bound the log, and the time to replay it
+        Materialize();
+    }
+    if (m_log == nullptr)
+    {
+        m_log = CreateLog(INITIAL_LOG_CAPACITY);
+    }
+    else if (m_log->count == 1)
+    {
+        // drop the entries recorded by the copies which released the log
+        m_log->used = m_logUsed;
+    }
+    if (m_log->used != m_logUsed || m_logUsed == m_log->capacity)
+    {
+        // the copies sharing the log recorded other operations after ours, or it is full
+        uint32_t capacity = m_log->capacity;
+        if (m_logUsed == capacity)
+        {
+            capacity = std::min(2 * capacity, MAX_LOG_ENTRIES);
+        }
+        Log* log = CreateLog(capacity);
+        std::copy_n(reinterpret_cast<const LogEntry*>(m_log + 1),
+                    m_logUsed,
+                    reinterpret_cast<LogEntry*>(log + 1));
+        log->used = m_logUsed;
+        ReleaseLog(m_log);
+        m_log = log;
+    }
+    LogEntry& entry = reinterpret_cast<LogEntry*>(m_log + 1)[m_logUsed];
+    entry.operation = operation;
+    entry.chunkUid = chunkUid;
+    entry.typeUid = typeUid;
+    entry.size = size;
+    m_logUsed++;
+    m_log->used = m_logUsed;
+}
+
+bool
+PacketMetadata::CancelRecord(uint16_t operation, uint32_t typeUid, uint32_t size)
+{
+    NS_LOG_FUNCTION(this << operation << typeUid << size);
+    if (m_logUsed == 0)
+    {
+        return false;
+    }
+    const LogEntry& last = reinterpret_cast<const LogEntry*>(m_log + 1)[m_logUsed - 1];
+    if (last.operation != operation || last.typeUid != typeUid || last.size != size)
+    {
+        return false;
+    }
+    // the entry is left in the log, until it is overwritten or copied
+    m_logUsed--;
+    return true;
+}
+
+void
+PacketMetadata::Materialize() const
+{
+    if (m_log == nullptr)
+    {
+        return;
+    }
+    NS_LOG_FUNCTION(this << m_logUsed);
+    // replaying the log changes the items but not the metadata they describe
+    auto self = const_cast<PacketMetadata*>(this);
+    Log* log = m_log;
+    uint32_t used = m_logUsed;
+    self->m_log = nullptr;
+    self->m_logUsed = 0;
+    const LogEntry* entries = reinterpret_cast<const LogEntry*>(log + 1);
+    for (uint32_t i = 0; i < used; i++)
+    {
+        const LogEntry& entry = entries[i];
+        switch (entry.operation)
+        {
+        case LOG_ADD_HEADER:
+            self->AddHeaderItem(entry.typeUid, entry.size, entry.chunkUid);
+            break;
+        case LOG_REMOVE_HEADER:
+            self->RemoveHeaderItem(entry.typeUid, entry.size);
+            break;
+        case LOG_ADD_TRAILER:
+            self->AddTrailerItem(entry.typeUid, entry.size, entry.chunkUid);
+            break;
+        case LOG_REMOVE_TRAILER:
+            self->RemoveTrailerItem(entry.typeUid, entry.size);
+            break;
+        case LOG_REMOVE_AT_START:
+            self->RemoveItemsAtStart(entry.size);
+            break;
+        case LOG_REMOVE_AT_END:
+            self->RemoveItemsAtEnd(entry.size);
+            break;
+        default:
+            NS_ASSERT_MSG(false, "Unknown log operation " << entry.operation);
+            break;
+        }
+    }
+    ReleaseLog(log);
+    NS_ASSERT(IsStateOk());
+}
+
 uint8_t*
 PacketMetadata::AddToRawU8(const uint8_t& data, uint8_t* start, uint8_t* current, uint32_t maxSize)
 {
@@ -76,6 +76,15 @@ class Trailer;
  * integers, and some others as variable-size 32-bit integers.
  * The variable-size 32 bit integers are stored using the uleb128
  * encoding.
+ *
+ * In the lazy mode (see EnableLazy), the operations on the headers and
+ * trailers are not applied to the items when they happen: they are
+ * recorded, with the TypeId and the size of the header or trailer, in a
+ * compact log which is shared by the copies of the packet like the
+ * items. The log is replayed on the items only when they are needed,
+ * by BeginItem (to print the packet), by the serialization of the packet,
+ * and by AddAtEnd. A header removed right after being added, as in most
+ * protocol stacks, is simply dropped from the log.
  */
 class PacketMetadata
 {
@@ -169,6 +178,23 @@ class PacketMetadata
      * \brief Enable the packet metadata checking
      */
     static void EnableChecking();
+    /**
+     * \brief Enable the packet metadata, in the lazy mode
+     *
+     * The metadata of the packets is then only built when it is needed.
+     * If the checking is enabled, the unexpected removal of a header or
+     * trailer is detected when the metadata is built, instead of when the
+     * header or trailer is removed.
+     */
+    static void EnableLazy();
+    /**
+     * \brief Apply the operations on the headers and trailers to the metadata
+     * items as they happen
+     *
+     * This is the default, and the metadata of the packets still recorded
+     * lazily is built on the next operation.
+     */
+    static void DisableLazy();
 
     /**
      * \brief Constructor
@@ -509,16 +535,6 @@ class PacketMetadata
         uint64_t packetUid;
     };
 
-    /**
-     * \brief Class to hold all the metadata
-     */
-    class DataFreeList : public std::vector<Data*>
-    {
-      public:
-        ~DataFreeList();
-    };
-
-    friend DataFreeList::~DataFreeList();
     /// Friend class
     friend class ItemIterator;
 
@@ -634,6 +650,42 @@ class PacketMetadata
      * \param size header serialized size
      */
     void DoAddHeader(uint32_t uid, uint32_t size);
+    /**
+     * \brief Add an header item
+     * \param uid header's uid to add
+     * \param size header serialized size
+     * \param chunkUid the chunk uid of the header
+     */
+    void AddHeaderItem(uint32_t uid, uint32_t size, uint16_t chunkUid);
+    /**
+     * \brief Remove an header item
+     * \param uid header's uid to remove
+     * \param size header serialized size
+     */
+    void RemoveHeaderItem(uint32_t uid, uint32_t size);
+    /**
+     * \brief Add a trailer item
+     * \param uid trailer's uid to add
+     * \param size trailer serialized size
+     * \param chunkUid the chunk uid of the trailer
+     */
+    void AddTrailerItem(uint32_t uid, uint32_t size, uint16_t chunkUid);
+    /**
+     * \brief Remove a trailer item
+     * \param uid trailer's uid to remove
+     * \param size trailer serialized size
+     */
+    void RemoveTrailerItem(uint32_t uid, uint32_t size);
+    /**
+     * \brief Remove the items of a chunk of data at the start
+     * \param start the size of data to remove
+     */
+    void RemoveItemsAtStart(uint32_t start);
+    /**
+     * \brief Remove the items of a chunk of data at the end
+     * \param end the size of data to remove
+     */
+    void RemoveItemsAtEnd(uint32_t end);
     /**
      * \brief Check if the metadata state is ok
      * \returns true if the internal state is ok
@@ -675,9 +727,89 @@ class PacketMetadata
      */
     static void Deallocate(PacketMetadata::Data* data);
 
-    static DataFreeList m_freeList; //!< the metadata data storage
-    static bool m_enable;           //!< Enable the packet metadata
-    static bool m_enableChecking;   //!< Enable the packet metadata checking
+    /**
+     * \brief Kind of the operations recorded in a log
+     */
+    enum LogOperation : uint16_t
+    {
+        LOG_ADD_HEADER,      //!< AddHeader
+        LOG_REMOVE_HEADER,   //!< RemoveHeader
+        LOG_ADD_TRAILER,     //!< AddTrailer
+        LOG_REMOVE_TRAILER,  //!< RemoveTrailer
+        LOG_REMOVE_AT_START, //!< RemoveAtStart
+        LOG_REMOVE_AT_END    //!< RemoveAtEnd
+    };
+
+    /**
+     * \brief Operation recorded in a log
+     */
+    struct LogEntry
+    {
+        /** the LogOperation */
+        uint16_t operation;
+        /** the chunk uid of an added header or trailer */
+        uint16_t chunkUid;
+        /** the uid of a header or trailer, as in SmallItem::typeUid */
+        uint32_t typeUid;
+        /** the size of the header or trailer, or of the removed data */
+        uint32_t size;
+    };
+
+    /**
+     * \brief Log of the operations not applied to the items yet
+     *
+     * The entries follow the Log. Like the items of a Data, the entries
+     * are shared by the copies of a packet, which each see the first
+     * m_logUsed entries.
+     */
+    struct Log
+    {
+        /** number of references to this log */
+        uint32_t count;
+        /** number of entries */
+        uint32_t used;
+        /** number of entries available */
+        uint32_t capacity;
+    };
+
+    /**
+     * \brief Record an operation in the log
+     * \param operation the LogOperation
+     * \param typeUid the uid of the header or trailer, or 0
+     * \param size the size of the header or trailer, or of the removed data
+     * \param chunkUid the chunk uid of an added header or trailer, or 0
+     */
+    void Record(uint16_t operation, uint32_t typeUid, uint32_t size, uint16_t chunkUid);
+    /**
+     * \brief Remove the last recorded operation if it added this header or trailer
+     * \param operation LOG_ADD_HEADER or LOG_ADD_TRAILER
+     * \param typeUid the uid of the header or trailer
+     * \param size the size of the header or trailer
+     * \returns true if the operation was removed
+     */
+    bool CancelRecord(uint16_t operation, uint32_t typeUid, uint32_t size);
+    /**
+     * \brief Apply the recorded operations to the items, and release the log
+     *
+     * This does not change the metadata seen by the users of this class,
+     * so that it can be called by the const methods.
+     */
+    void Materialize() const;
+    /**
+     * \brief Allocate an empty log
+     * \param capacity the number of entries available
+     * \returns the log, with a count of 1
+     */
+    static Log* CreateLog(uint32_t capacity);
+    /**
+     * \brief Release a reference to a log
+     * \param log the log
+     */
+    static void ReleaseLog(Log* log);
+
+    static bool m_enable;         //!< Enable the packet metadata
+    static bool m_enableChecking; //!< Enable the packet metadata checking
+    static bool m_lazy;           //!< Record the operations in a log
 
     /**
      * Set to true when adding metadata to a packet is skipped because
@@ -699,6 +831,8 @@ class PacketMetadata
     uint16_t m_tail;      //!< list tail
     uint16_t m_used;      //!< used portion
     uint64_t m_packetUid; //!< packet Uid
+    Log* m_log;           //!< operations not applied yet, or nullptr
+    uint32_t m_logUsed;   //!< number of entries of m_log
 };
 
 } // namespace ns3
@@ -711,7 +845,9 @@ PacketMetadata::PacketMetadata(uint64_t uid, uint32_t size)
       m_head(0xffff),
       m_tail(0xffff),
       m_used(0),
-      m_packetUid(uid)
+      m_packetUid(uid),
+      m_log(nullptr),
+      m_logUsed(0)
 {
     memset(m_data->m_data, 0xff, 4);
     if (size > 0)
@@ -725,11 +861,17 @@ PacketMetadata::PacketMetadata(const PacketMetadata& o)
       m_head(o.m_head),
       m_tail(o.m_tail),
       m_used(o.m_used),
-      m_packetUid(o.m_packetUid)
+      m_packetUid(o.m_packetUid),
+      m_log(o.m_log),
+      m_logUsed(o.m_logUsed)
 {
     NS_ASSERT(m_data != nullptr);
     NS_ASSERT(m_data->m_count < std::numeric_limits<uint32_t>::max());
     m_data->m_count++;
+    if (m_log != nullptr)
+    {
+        m_log->count++;
+    }
 }
 
 PacketMetadata&
@@ -748,10 +890,23 @@ PacketMetadata::operator=(const PacketMetadata& o)
         NS_ASSERT(m_data != nullptr);
         m_data->m_count++;
     }
+    if (m_log != o.m_log)
+    {
+        if (o.m_log != nullptr)
+        {
+            o.m_log->count++;
+        }
+        if (m_log != nullptr)
+        {
+            ReleaseLog(m_log);
+        }
+        m_log = o.m_log;
+    }
     m_head = o.m_head;
     m_tail = o.m_tail;
     m_used = o.m_used;
     m_packetUid = o.m_packetUid;
+    m_logUsed = o.m_logUsed;
     return *this;
 }
 
@@ -763,6 +918,10 @@ PacketMetadata::~PacketMetadata()
     {
         PacketMetadata::Recycle(m_data);
     }
+    if (m_log != nullptr)
+    {
+        ReleaseLog(m_log);
+    }
 }
 
 } // namespace ns3
@@ -19,287 +19,410 @@
 
 /**
 \file   packet-tag-list.cc
-\brief  Implements a linked list of Packet tags, including copy-on-write semantics.
+\brief  Implements a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "packet-tag-list.h"
 
+#include "packet-allocator.h"
 #include "tag-buffer.h"
 #include "tag.h"
 
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstring>
+#include <limits>
+#include <mutex>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+
+/// Compact index shared by the tag types which come after the first 63 ones
+constexpr uint32_t OVERFLOW_INDEX = 63;
+/// Initial capacity of a store, in bytes, enough for a few small tags
+constexpr uint32_t SMALL_STORE_CAPACITY = 192;
+/// Offset of the serialized data in an entry
+constexpr uint32_t ENTRY_HEADER_SIZE = offsetof(ns3::PacketTagList::TagData, data);
+
+/// Compact indices plus 1 of the tag types, by TypeId uid, or 0 if not assigned yet
+std::atomic<uint8_t> g_compactIndices[std::numeric_limits<uint16_t>::max() + 1];
+/// Number of compact indices assigned
+uint32_t g_nCompactIndices = 0;
+/// Mutex protecting the assignment of the compact indices
+std::mutex g_compactIndicesMutex;
+
+/**
+ * Get the compact index of a tag type, assigning it on the first use.
+ *
+ * \param [in] tid The type of the tag.
+ * \returns The compact index.
+ */
+uint32_t
+GetCompactIndex(ns3::TypeId tid)
+{
+    std::atomic<uint8_t>& slot = g_compactIndices[tid.GetUid()];
+    uint8_t value = slot.load(std::memory_order_relaxed);
+    if (value == 0)
+    {
+        std::lock_guard<std::mutex> lock(g_compactIndicesMutex);
+        value = slot.load(std::memory_order_relaxed);
+        if (value == 0)
+        {
+            value = std::min(g_nCompactIndices, OVERFLOW_INDEX) + 1;
+            g_nCompactIndices++;
+            slot.store(value, std::memory_order_relaxed);
+        }
+    }
+    return value - 1;
+}
+
+/**
+ * Count the bits which are set.
+ *
+ * \param [in] bits The bit set.
+ * \returns The number of bits set.
+ */
+inline uint32_t
+CountBits(uint64_t bits)
+{
+    uint32_t n = 0;
+    for (; bits != 0; bits &= bits - 1)
+    {
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Get the size of an entry.
+ *
+ * \param [in] size The serialized size of the tag.
+ * \returns The size of the entry, aligned on 8 bytes.
+ */
+inline uint32_t
+GetEntryLength(uint32_t size)
+{
+    return (ENTRY_HEADER_SIZE + size + 7) & ~7U;
+}
+
+} // namespace
 
 namespace ns3
 {
 
 NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
-PacketTagList::TagData*
-PacketTagList::CreateTagData(size_t dataSize)
+/**
+ * Get the first entry of a store.
+ *
+ * \param [in] store The store.
+ * \returns The first byte of the entries.
+ */
+template <typename T>
+static uint8_t*
+GetEntries(T* store)
 {
-    NS_ASSERT_MSG(dataSize < std::numeric_limits<decltype(TagData::size)>::max(),
-                  "Requested TagData size " << dataSize << " exceeds maximum "
-                                            << std::numeric_limits<decltype(TagData::size)>::max());
-
-    void* p = std::malloc(sizeof(TagData) + dataSize - 1);
-    // The matching frees are in RemoveAll and RemoveWriter
+    return const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(store + 1));
+}
 
-    auto tag = new (p) TagData;
-    tag->size = dataSize;
-    return tag;
+/**
+ * Get the offset of an entry in a store.
+ *
+ * \param [in] store The store.
+ * \param [in] entry The entry.
+ * \returns The offset of the entry from the first one.
+ */
+template <typename T>
+static uint32_t
+GetOffset(T* store, const PacketTagList::TagData* entry)
+{
+    return static_cast<uint32_t>(reinterpret_cast<const uint8_t*>(entry) - GetEntries(store));
 }
 
-bool
-PacketTagList::COWTraverse(Tag& tag, PacketTagList::COWWriter Writer)
+PacketTagList::TagStore*
+PacketTagList::CreateStore(uint32_t capacity)
 {
-    TypeId tid = tag.GetInstanceTypeId();
-    NS_LOG_FUNCTION(this << tid);
-    NS_LOG_INFO("looking for " << tid);
+    NS_LOG_FUNCTION(capacity);
+    void* p = PacketAllocator::Allocate(sizeof(TagStore) + capacity);
+    // The matching DestroyStore call is in RemoveAll
+    auto store = new (p) TagStore;
+    store->count = 1;
+    store->used = 0;
+    store->capacity = capacity;
+    store->mask = 0;
+    store->head = nullptr;
+    return store;
+}
 
-    // trivial case when list is empty
-    if (m_next == nullptr)
+PacketTagList::TagStore*
+PacketTagList::CopyStore(const TagStore* store,
+                         const TagData* last,
+                         uint32_t capacity,
+                         const TagData* skip)
+{
+    NS_LOG_FUNCTION(store << last << capacity << skip);
+    TagStore* copy = CreateStore(capacity);
+    const TagData* entry = nullptr;
+    for (uint32_t offset = 0; entry != last; offset += GetEntryLength(entry->size))
     {
-        return false;
+        entry = reinterpret_cast<const TagData*>(GetEntries(store) + offset);
+        if (entry != skip)
+        {
+            TagData* entryCopy = AppendEntry(copy, entry->tid, entry->size);
+            std::memcpy(entryCopy->data, entry->data, entry->size);
+        }
     }
+    return copy;
+}
 
-    bool found = false;
+void
+PacketTagList::DestroyStore(TagStore* store)
+{
+    NS_LOG_FUNCTION(store);
+    uint32_t capacity = store->capacity;
+    store->~TagStore();
+    PacketAllocator::Deallocate(store, sizeof(TagStore) + capacity);
+}
 
-    TagData** prevNext = &m_next; // previous node's next pointer
-    TagData* cur = m_next;        // cursor to current node
-    TagData* it = nullptr;        // utility
+PacketTagList::TagData*
+PacketTagList::AppendEntry(TagStore* store, TypeId tid, uint32_t size)
+{
+    NS_ASSERT(store->used + GetEntryLength(size) <= store->capacity);
+    auto entry = new (GetEntries(store) + store->used) TagData;
+    entry->tid = tid;
+    entry->size = size;
+    IndexEntry(store, entry);
+    store->used += GetEntryLength(size);
+    return entry;
+}
 
-    // Search from the head of the list until we find tid or a merge
-    while (cur != nullptr)
+void
+PacketTagList::IndexEntry(TagStore* store, TagData* entry)
+{
+    entry->next = store->head;
+    store->head = entry;
+    uint32_t index = GetCompactIndex(entry->tid);
+    uint64_t bit = uint64_t(1) << index;
+    if (index != OVERFLOW_INDEX)
     {
-        if (cur->count > 1)
+        // the entries of the greater compact indices move up one rank
+        uint32_t rank = CountBits(store->mask & (bit - 1));
+        if (rank < RANKED_TAGS)
         {
-            // found merge
-            NS_LOG_INFO("found initial merge before tid");
-            break;
+            std::copy_backward(store->ranked + rank,
+                               store->ranked + RANKED_TAGS - 1,
+                               store->ranked + RANKED_TAGS);
+            store->ranked[rank] = GetOffset(store, entry);
         }
-        else if (cur->tid == tid)
+    }
+    store->mask |= bit;
+}
+
+void
+PacketTagList::Reindex(TagStore* store)
+{
+    store->mask = 0;
+    store->head = nullptr;
+    for (uint32_t offset = 0; offset < store->used;)
+    {
+        auto entry = reinterpret_cast<TagData*>(GetEntries(store) + offset);
+        IndexEntry(store, entry);
+        offset += GetEntryLength(entry->size);
+    }
+}
+
+PacketTagList::TagData*
+PacketTagList::Find(TypeId tid) const
+{
+    if (m_store == nullptr)
+    {
+        return nullptr;
+    }
+    uint32_t index = GetCompactIndex(tid);
+    uint64_t bit = uint64_t(1) << index;
+    if ((m_store->mask & bit) == 0)
+    {
+        return nullptr;
+    }
+    if (index != OVERFLOW_INDEX)
+    {
+        uint32_t rank = CountBits(m_store->mask & (bit - 1));
+        if (rank < RANKED_TAGS)
         {
-            NS_LOG_INFO("found tid before initial merge, calling writer");
-            found = (this->*Writer)(tag, true, cur, prevNext);
-            break;
+            // the entries after m_head belong to the other lists sharing the store
+            uint32_t offset = m_store->ranked[rank];
+            if (offset > GetOffset(m_store, m_head))
+            {
+                return nullptr;
+            }
+            return reinterpret_cast<TagData*>(GetEntries(m_store) + offset);
         }
-        else
+    }
+    for (TagData* cur = m_head; cur != nullptr; cur = cur->next)
+    {
+        if (cur->tid == tid)
         {
-            // no merge or tid found yet, move on
-            prevNext = &cur->next;
-            cur = cur->next;
+            return cur;
         }
-    } // while !found && !cow
+    }
+    return nullptr;
+}
 
-    // did we find it or run out of tags?
-    if (cur == nullptr || found)
+PacketTagList::TagData*
+PacketTagList::AddEntry(TypeId tid, uint32_t size)
+{
+    NS_ASSERT_MSG(size < std::numeric_limits<decltype(TagData::size)>::max(),
+                  "Requested TagData size " << size << " exceeds maximum "
+                                            << std::numeric_limits<decltype(TagData::size)>::max());
+    uint32_t length = GetEntryLength(size);
+    if (m_store == nullptr)
     {
-        NS_LOG_INFO("returning after header with found: " << found);
-        return found;
+        m_store = CreateStore(std::max(length, SMALL_STORE_CAPACITY));
     }
+    else
+    {
+        uint32_t used = GetOffset(m_store, m_head) + GetEntryLength(m_head->size);
+        if (m_store->count == 1 && m_head != m_store->head)
+        {
+            // drop the entries left by the lists which shared the store
+            m_store->used = used;
+            Reindex(m_store);
+        }
+        if (m_head != m_store->head || used + length > m_store->capacity)
+        {
+            // copy the tags with room for the new entry
+            uint32_t capacity = m_store->capacity;
+            while (used + length > capacity)
+            {
+                capacity *= 2;
+            }
+            Unshare(capacity, nullptr);
+        }
+    }
+    m_head = AppendEntry(m_store, tid, size);
+    return m_head;
+}
 
-    // From here on out, we have to copy the list
-    // until we find tid, then link past it
-
-    // Before we do all that work, let's make sure tid really exists
-    for (it = cur; it != nullptr; it = it->next)
+void
+PacketTagList::RemoveEntry(TagData* entry)
+{
+    NS_LOG_FUNCTION(this << entry);
+    if (entry == m_head)
     {
-        if (it->tid == tid)
+        // the entry is left in the store, until it is overwritten or copied
+        m_head = entry->next;
+        if (m_head == nullptr)
         {
-            break;
+            RemoveAll();
         }
     }
-    if (it == nullptr)
+    else if (m_store->count > 1)
     {
-        // got to end of list without finding tid
-        NS_LOG_INFO("tid not found after first merge");
-        return found;
+        Unshare(m_store->capacity, entry);
     }
-
-    // At this point cur is a merge, but untested for tid
-    NS_ASSERT(cur != nullptr);
-    NS_ASSERT(cur->count > 1);
-
-    /*
-       Walk the remainder of the list, copying, until we find tid
-       As we put a copy of the cur node onto our list,
-       we move the merge point down the list.
-
-       Starting position                  End position
-         T1 is a merge                     T1.count decremented
-                                           T2 is a merge
-                                           T1' is a copy of T1
-
-            other                             other
-                 \                                 \
-        Prev  ->  T1  ->  T2  -> ...                T1  ->  T2  -> ...
-             /   /                                         /|
-        pNext cur                         Prev  ->  T1' --/ |
-                                                       /    |
-                                                  pNext   cur
-
-       When we reach tid, we link past it, decrement count, and we're done.
-    */
-
-    // Should normally check for null cur pointer,
-    // but since we know tid exists, we'll skip this test
-    while (/* cur && */ cur->tid != tid)
+    else
     {
-        NS_ASSERT(cur != nullptr);
-        NS_ASSERT(cur->count > 1);
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(cur->size);
-        copy->tid = cur->tid;
-        copy->count = 1;
-        copy->size = cur->size;
-        memcpy(copy->data, cur->data, copy->size);
-        copy->next = cur->next; // merge into tail
-        copy->next->count++;    // mark new merge
-        *prevNext = copy;       // point prior list at copy
-        prevNext = &copy->next; // advance
-        cur = copy->next;
+        // move the next entries over the removed one
+        auto start = reinterpret_cast<uint8_t*>(entry);
+        uint32_t length = GetEntryLength(entry->size);
+        uint8_t* end = reinterpret_cast<uint8_t*>(m_head) + GetEntryLength(m_head->size);
+        entry->~TagData();
+        std::memmove(start, start + length, end - start - length);
+        m_store->used = static_cast<uint32_t>(end - GetEntries(m_store)) - length;
+        Reindex(m_store);
+        m_head = m_store->head;
     }
-    // Sanity check:
-    NS_ASSERT(cur != nullptr);  // cur should be non-zero
-    NS_ASSERT(cur->tid == tid); // cur->tid should be tid
-    NS_ASSERT(cur->count > 1);  // cur should be a merge
-
-    // link around tid, removing it from our list
-    found = (this->*Writer)(tag, false, cur, prevNext);
-    return found;
 }
 
-bool
-PacketTagList::Remove(Tag& tag)
+void
+PacketTagList::Unshare(uint32_t capacity, const TagData* skip)
 {
-    return COWTraverse(tag, &PacketTagList::RemoveWriter);
+    NS_LOG_FUNCTION(this << capacity << skip);
+    TagStore* store = CopyStore(m_store, m_head, capacity, skip);
+    RemoveAll();
+    m_store = store;
+    m_head = store->head;
 }
 
-// COWWriter implementing Remove
 bool
-PacketTagList::RemoveWriter(Tag& tag,
-                            bool preMerge,
-                            PacketTagList::TagData* cur,
-                            PacketTagList::TagData** prevNext)
+PacketTagList::Remove(Tag& tag)
 {
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-    *prevNext = cur->next; // link around cur
-
-    if (preMerge)
-    {
-        // found tid before first merge, so delete cur
-        cur->~TagData();
-        std::free(cur);
-    }
-    else
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    TagData* entry = Find(tid);
+    if (entry == nullptr)
     {
-        // cur is always a merge at this point
-        // unmerge cur, since we linked around it already
-        cur->count--;
-        if (cur->next != nullptr)
-        {
-            // there's a next, so make it a merge
-            cur->next->count++;
-        }
+        return false;
     }
-    return found;
+    tag.Deserialize(TagBuffer(entry->data, entry->data + entry->size));
+    RemoveEntry(entry);
+    return true;
 }
 
 bool
 PacketTagList::Replace(Tag& tag)
 {
-    bool found = COWTraverse(tag, &PacketTagList::ReplaceWriter);
-    if (!found)
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
+    TagData* entry = Find(tid);
+    if (entry == nullptr)
     {
         Add(tag);
+        return false;
     }
-    return found;
-}
-
-// COWWriter implementing Replace
-bool
-PacketTagList::ReplaceWriter(Tag& tag,
-                             bool preMerge,
-                             PacketTagList::TagData* cur,
-                             PacketTagList::TagData** prevNext)
-{
-    NS_LOG_FUNCTION_NOARGS();
-
-    // found tid
-    bool found = true;
-    if (preMerge)
+    uint32_t size = tag.GetSerializedSize();
+    if (entry->size != size)
     {
-        // found tid before first merge, so just rewrite
-        tag.Serialize(TagBuffer(cur->data, cur->data + cur->size));
+        RemoveEntry(entry);
+        Add(tag);
+        return true;
     }
-    else
+    if (m_store->count > 1)
     {
-        // cur is always a merge at this point
-        // need to copy, replace, and link past cur
-        cur->count--; // unmerge cur
-        TagData* copy = CreateTagData(tag.GetSerializedSize());
-        copy->tid = tag.GetInstanceTypeId();
-        copy->count = 1;
-        tag.Serialize(TagBuffer(copy->data, copy->data + copy->size));
-        copy->next = cur->next; // merge into tail
-        if (copy->next != nullptr)
-        {
-            copy->next->count++; // mark new merge
-        }
-        *prevNext = copy; // point prior list at copy
+        Unshare(m_store->capacity, nullptr);
+        entry = Find(tid);
     }
-    return found;
+    tag.Serialize(TagBuffer(entry->data, entry->data + size));
+    return true;
 }
 
 void
 PacketTagList::Add(const Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
+    TypeId tid = tag.GetInstanceTypeId();
+    NS_LOG_FUNCTION(this << tid);
     // ensure this id was not yet added
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
-    {
-        NS_ASSERT_MSG(cur->tid != tag.GetInstanceTypeId(),
-                      "Error: cannot add the same kind of tag twice.");
-    }
-    TagData* head = CreateTagData(tag.GetSerializedSize());
-    head->count = 1;
-    head->next = nullptr;
-    head->tid = tag.GetInstanceTypeId();
-    head->next = m_next;
-    tag.Serialize(TagBuffer(head->data, head->data + head->size));
-
-    const_cast<PacketTagList*>(this)->m_next = head;
+    NS_ASSERT_MSG(Find(tid) == nullptr, "Error: cannot add the same kind of tag twice.");
+    uint32_t size = tag.GetSerializedSize();
+    TagData* entry = const_cast<PacketTagList*>(this)->AddEntry(tid, size);
+    tag.Serialize(TagBuffer(entry->data, entry->data + size));
 }
 
 bool
 PacketTagList::Peek(Tag& tag) const
 {
-    NS_LOG_FUNCTION(this << tag.GetInstanceTypeId());
     TypeId tid = tag.GetInstanceTypeId();
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    NS_LOG_FUNCTION(this << tid);
+    TagData* entry = Find(tid);
+    if (entry == nullptr)
     {
-        if (cur->tid == tid)
-        {
-            /* found tag */
-            tag.Deserialize(TagBuffer(cur->data, cur->data + cur->size));
-            return true;
-        }
+        /* no tag found */
+        return false;
     }
-    /* no tag found */
-    return false;
+    tag.Deserialize(TagBuffer(entry->data, entry->data + entry->size));
+    return true;
 }
 
 const PacketTagList::TagData*
 PacketTagList::Head() const
 {
-    return m_next;
+    return m_head;
 }
 
 uint32_t
@@ -311,7 +434,7 @@ PacketTagList::GetSerializedSize() const
 
     size = 4; // numberOfTags
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = cur->next)
     {
         size += 4; // TagData -> size
 
@@ -348,7 +471,7 @@ PacketTagList::Serialize(uint32_t* buffer, uint32_t maxSize) const
         return 0;
     }
 
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    for (const TagData* cur = Head(); cur != nullptr; cur = cur->next)
     {
         if (size + 4 <= maxSize)
         {
@@ -409,7 +532,10 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
     NS_LOG_INFO("Deserializing number of tags " << numberOfTags);
 
-    TagData* prevTag = nullptr;
+    RemoveAll();
+    // the first serialized tag is the most recent one, so add the tags in reverse order
+    std::vector<std::tuple<TypeId, const uint32_t*, uint32_t>> tags;
+    tags.reserve(numberOfTags);
     for (uint32_t i = 0; i < numberOfTags; ++i)
     {
         NS_ASSERT(sizeCheck >= 4);
@@ -427,30 +553,18 @@ PacketTagList::Deserialize(const uint32_t* buffer, uint32_t size)
 
         NS_LOG_INFO("Deserializing tag of type " << tid);
 
-        TagData* newTag = CreateTagData(tagSize);
-        newTag->count = 1;
-        newTag->next = nullptr;
-        newTag->tid = tid;
-
         NS_ASSERT(sizeCheck >= tagSize);
-        memcpy(newTag->data, p, tagSize);
+        tags.emplace_back(tid, p, tagSize);
 
         // ensure 4 byte boundary
         uint32_t tagWordSize = (tagSize + 3) & (~3);
         p += tagWordSize / 4;
         sizeCheck -= tagWordSize;
-
-        // Set link list pointers.
-        if (i == 0)
-        {
-            m_next = newTag;
-        }
-        else
-        {
-            prevTag->next = newTag;
-        }
-
-        prevTag = newTag;
+    }
+    for (auto it = tags.rbegin(); it != tags.rend(); ++it)
+    {
+        TagData* newTag = AddEntry(std::get<0>(*it), std::get<2>(*it));
+        memcpy(newTag->data, std::get<1>(*it), std::get<2>(*it));
     }
 
     NS_ASSERT(sizeCheck == 0);
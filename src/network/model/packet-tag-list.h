@@ -21,7 +21,7 @@
 
 /**
 \file   packet-tag-list.h
-\brief  Defines a linked list of Packet tags, including copy-on-write semantics.
+\brief  Defines a list of Packet tags, including copy-on-write semantics.
 */
 
 #include "ns3/type-id.h"
@@ -44,88 +44,45 @@ class Tag;
  *
  * \internal
  *
- * The implementation of this class is a bit tricky.  Refer to this
- * diagram in the discussion that follows.
+ * The tags are stored in serialized form in a TagStore, a single block
+ * allocated by the PacketAllocator, as a sequence of TagData entries in
+ * the order in which they were added. The initial capacity of a store
+ * holds a few small tags, which is enough for most packets, so that adding
+ * the first tags to a packet costs a single allocation.
  *
- * \dot
- *    digraph {
- *        rankdir = "LR";
- *        clusterrank = local;
- *        node [ shape = record, fontname="FreeSans", fontsize="10" ];
- *        oth  [ label="<l> Other branch | <n> next | <c> ..." ];
- *        PTL1 [ label="<l> PacketTagList A | <n> m_next" , shape=Mrecord];
- *        PTL2 [ label="<l> PacketTagList B | <n> m_next" , shape=Mrecord];
- *        oth:n  -> T7:l ;
- *        PTL2:n -> T6:l ;
- *        PTL1:n -> T5:l ;
- *        T1   [ label="<l> T1  | <n> next | <c> count = 1" ];
- *        T2   [ label="<l> T2  | <n> next | <c> count = 1" ];
- *        T3   [ label="<l> T3  | <n> next | <c> count = 2" ];
- *        T4   [ label="<l> T4  | <n> next | <c> count = 1" ];
- *        T5   [ label="<l> T5  | <n> next | <c> count = 2" ];
- *        T6   [ label="<l> T6  | <n> next | <c> count = 1" ];
- *        T7   [ label="<l> T7  | <n> next | <c> count = 1" ];
- *        NULL [ label="0", shape = ellipse ];
- *        subgraph cluster_list {
- *          penwidth = 0;
- *          T6:n -> T5:l ;
- *          T5:n -> T4:l ;
- *          T4:n -> T3:l ;
- *          T7:n -> T3:l ;
- *          T3:n -> T2:l ;
- *          T2:n -> T1:l ;
- *          T1:n -> NULL ;
- *        };
- *      }
- * \enddot
+ *   - The \c next pointers of the entries link each tag to the tag added
+ *     before it. A list holds its store and its most recent entry, #m_head:
+ *     its tags are the entries from the start of the store up to #m_head.
+ *     This is the order of PacketTagIterator and of the serialized list.
  *
- *   - Tags are stored in serialized form in a tree of TagData
- *     structures. (<tt>T1-T7</tt> in the diagram)
- *
- *   - Each TagData points (\c next pointers in the diagram)
- *     toward the root of the tree, which is a null pointer.
- *
- *   - \c count is the number of incoming pointers to this
- *     TagData.  Branch points, where branches merge or join, have
- *     <tt>count \> 1</tt> (\c T3, \c T5); successive links along
- *     a branch have <tt>count = 1</tt> (\c T1, \c T2, \c T4, \c T6, \c T7).
- *
- *   - Each PacketTagList points to a specific TagData,
- *     which is the most recent Tag added to the packet. (<tt>T5-T7</tt>)
- *
- *   - Conceptually, therefore, each Packet has a PacketTagList which
- *     points to a singly-linked list of TagData.
+ *   - Each tag TypeId is given a compact index (up to 63 types, the next ones
+ *     share a last index) the first time it is used. The store keeps the bit
+ *     set of the compact indices of its tags, and the offsets of the first
+ *     #RANKED_TAGS entries ordered by compact index, so that #Peek finds a
+ *     tag, or its absence, without walking the list.
  *
  * \par <b> Copy-on-write </b> is implemented as follows:
  *
- *   - #Add prepends the new tag to the list (growing that branch of the tree,
- *     as \c T6). This is a constant time operation, and does not affect
- *     any other #PacketTagList's, hence this is a \c const function.
- *
  *   - Copy constructor (PacketTagList(const PacketTagList & o))
  *     and assignment (#operator=(const PacketTagList & o))
- *     simply join the tree at the same place as the original
- *     PacketTagList \c o, incrementing the \c count.
- *     For assignment, the old branch is deleted, up to
- *     the first branch point, which has its \c count decremented.
- *     (PacketTagList \c B started as a copy of PacketTagList \c A,
- *     before \c T6 was added to \c B).
+ *     share the store of \c o, incrementing its \c count, so that
+ *     Packet::Copy does not copy the tags.
  *
- *   - #Remove and #Replace are a little tricky, depending on where the
- *     target tag is found relative to the first branch point:
- *     - \e Target before <em> the first branch point: </em> \n
- *       The target is just dealt with in place (linked around and deleted,
- *       in the case of #Remove; rewritten in the case of #Replace).
- *     - \e Target at or after <em> the first branch point: </em> \n
- *       The portion of the list between the first branch and the target is
- *       shared. This portion is copied before the #Remove or #Replace is
- *       performed.
+ *   - Entries are only appended to a store, and only by a list whose
+ *     #m_head is the last entry of the store, so that the lists sharing
+ *     the store never see the tags added by the others. Otherwise, #Add
+ *     first copies the tags of the list to a new store, with a single
+ *     allocation.
+ *
+ *   - #Remove of the most recent tag only moves #m_head back. Removing
+ *     another tag, or replacing a tag, modifies the store in place when it
+ *     is not shared, and copies it otherwise.
  */
 class PacketTagList
 {
   public:
     /**
-     * Tree node for sharing serialized tags.
+     * Serialized tag, stored in a TagStore.
      *
      * See PacketTagList for a discussion of the data structure.
      *
@@ -135,14 +92,12 @@ class PacketTagList
      * The Item nested class can't be forward declared, so friending isn't
      * possible.
      *
-     * We use placement new so we can allocate enough room for the Tag
-     * type which will be serialized into data.  See Object::Aggregates
-     * for a similar construction.
+     * The entries are variable-sized: the store allocates enough room after
+     * each TagData for the Tag serialized into data.
      */
     struct TagData
     {
-        TagData* next;   //!< Pointer to next in list
-        uint32_t count;  //!< Number of incoming links
+        TagData* next;   //!< Pointer to the tag added before this one
         TypeId tid;      //!< Type of the tag serialized into #data
         uint32_t size;   //!< Size of the \c data buffer
         uint8_t data[1]; //!< Serialization buffer
@@ -157,8 +112,7 @@ class PacketTagList
      *
      * \param [in] o The PacketTagList to copy.
      *
-     * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * This makes a light-weight copy, sharing the tags of \pname{o}.
      */
     inline PacketTagList(const PacketTagList& o);
     /**
@@ -168,13 +122,13 @@ class PacketTagList
      * \returns the copied object
      *
      * This makes a light-weight copy by #RemoveAll, then
-     * pointing to the same \ref TagData as \pname{o}.
+     * sharing the tags of \pname{o}.
      */
     inline PacketTagList& operator=(const PacketTagList& o);
     /**
      * Destructor
      *
-     * #RemoveAll's the tags up to the first merge.
+     * #RemoveAll's the tags.
      */
     inline ~PacketTagList();
 
@@ -211,7 +165,7 @@ class PacketTagList
      */
     bool Peek(Tag& tag) const;
     /**
-     * Remove all tags from this list (up to the first merge).
+     * Remove all tags from this list.
      */
     inline void RemoveAll();
     /**
@@ -244,67 +198,112 @@ class PacketTagList
     uint32_t Deserialize(const uint32_t* buffer, uint32_t size);
 
   private:
+    /// Number of entries of a TagStore which are found by their compact index
+    static constexpr uint32_t RANKED_TAGS = 8;
+
     /**
-     * Allocate and construct a TagData struct, sizing the data area
-     * large enough to serialize dataSize bytes from a Tag.
+     * Shared storage of the tags of one or more lists.
      *
-     * \param [in] dataSize The serialized size of the Tag.
-     * \returns The newly constructed TagData object.
+     * The TagData entries follow the TagStore, aligned on 8 bytes.
      */
-    static TagData* CreateTagData(size_t dataSize);
+    struct TagStore
+    {
+        uint32_t count;               //!< Number of lists sharing this store
+        uint32_t used;                //!< Bytes used by the entries
+        uint32_t capacity;            //!< Bytes available for the entries
+        uint64_t mask;                //!< Bit set of the compact indices of the tags
+        TagData* head;                //!< Last entry
+        uint32_t ranked[RANKED_TAGS]; //!< Offsets of the entries, by rank of their compact index
+    };
 
     /**
-     * Typedef of method function pointer for copy-on-write operations
+     * Allocate an empty store.
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True if operation successful, false otherwise
+     * \param [in] capacity The bytes available for the entries.
+     * \returns The new store, with a count of 1.
      */
-    typedef bool (PacketTagList::*COWWriter)(Tag& tag,
-                                             bool preMerge,
-                                             TagData* cur,
-                                             TagData** prevNext);
+    static TagStore* CreateStore(uint32_t capacity);
     /**
-     * Traverse the list implementing copy-on-write, using \pname{Writer}.
+     * Copy the first entries of a store, optionally without one of them.
      *
-     * \param [in] tag The tag type to operate on.
-     * \param [in] Writer The copy-on-write function to use.
-     * \returns True if \pname{tag} found, false otherwise.
+     * \param [in] store The store to copy.
+     * \param [in] last The last entry to copy.
+     * \param [in] capacity The bytes available for the entries of the copy.
+     * \param [in] skip The entry not to copy, or nullptr.
+     * \returns The new store, with a count of 1.
      */
-    bool COWTraverse(Tag& tag, PacketTagList::COWWriter Writer);
+    static TagStore* CopyStore(const TagStore* store,
+                               const TagData* last,
+                               uint32_t capacity,
+                               const TagData* skip);
     /**
-     * Copy-on-write implementing Remove.
+     * Deallocate a store which is no longer used.
      *
-     * \param [in] tag The target tag type to remove.
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *             false otherwise.
-     * \param [in] cur Pointer to the tag.
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag will definitely be removed.
+     * \param [in] store The store.
      */
-    bool RemoveWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    static void DestroyStore(TagStore* store);
     /**
-     * Copy-on-write implementing Replace
+     * Append an entry to a store which has enough capacity left.
      *
-     * \param [in] tag The target tag type to replace
-     * \param [in] preMerge True if \pname{tag} was found before the first merge,
-     *          false otherwise.
-     * \param [in] cur Pointer to the tag
-     * \param [in] prevNext Pointer to the struct TagData.next pointer
-     *          pointing to \pname{cur}.
-     * \returns True, since tag value will definitely be replaced.
+     * \param [in] store The store.
+     * \param [in] tid The type of the tag.
+     * \param [in] size The serialized size of the tag.
+     * \returns The entry, with uninitialized data.
      */
-    bool ReplaceWriter(Tag& tag, bool preMerge, TagData* cur, TagData** prevNext);
+    static TagData* AppendEntry(TagStore* store, TypeId tid, uint32_t size);
+    /**
+     * Link the last entry of a store and add it to the compact indices.
+     *
+     * \param [in] store The store.
+     * \param [in] entry The entry, at the end of the store.
+     */
+    static void IndexEntry(TagStore* store, TagData* entry);
+    /**
+     * Update the links, the compact indices and the ranks of all the entries
+     * of a store, after some of them were moved.
+     *
+     * \param [in] store The store.
+     */
+    static void Reindex(TagStore* store);
 
     /**
-     * Pointer to first \ref TagData on the list
+     * Find the entry of a tag type.
+     *
+     * \param [in] tid The type of the tag.
+     * \returns The entry, or nullptr if there is no tag of this type.
      */
-    TagData* m_next;
+    TagData* Find(TypeId tid) const;
+    /**
+     * Add an entry for a new tag, copying the tags to a new store if
+     * the entry cannot be appended to the current one.
+     *
+     * \param [in] tid The type of the tag.
+     * \param [in] size The serialized size of the tag.
+     * \returns The entry, with uninitialized data.
+     */
+    TagData* AddEntry(TypeId tid, uint32_t size);
+    /**
+     * Remove an entry, copying the store if it is shared.
+     *
+     * \param [in] entry The entry, found by #Find.
+     */
+    void RemoveEntry(TagData* entry);
+    /**
+     * Copy the tags to a new store, which is not shared.
+     *
+     * \param [in] capacity The bytes available for the entries of the copy.
+     * \param [in] skip The entry not to copy, or nullptr.
+     */
+    void Unshare(uint32_t capacity, const TagData* skip);
+
+    /**
+     * Store of the tags, or nullptr if there is no tag
+     */
+    TagStore* m_store;
+    /**
+     * Most recent tag of this list, or nullptr if there is no tag
+     */
+    TagData* m_head;
 };
 
 } // namespace ns3
@@ -317,16 +316,18 @@ namespace ns3
 {
 
 PacketTagList::PacketTagList()
-    : m_next()
+    : m_store(nullptr),
+      m_head(nullptr)
 {
 }
 
 PacketTagList::PacketTagList(const PacketTagList& o)
-    : m_next(o.m_next)
+    : m_store(o.m_store),
+      m_head(o.m_head)
 {
-    if (m_next != nullptr)
+    if (m_store != nullptr)
     {
-        m_next->count++;
+        m_store->count++;
     }
 }
 
@@ -334,15 +335,16 @@ PacketTagList&
 PacketTagList::operator=(const PacketTagList& o)
 {
     // self assignment
-    if (m_next == o.m_next)
+    if (m_store == o.m_store && m_head == o.m_head)
     {
         return *this;
     }
     RemoveAll();
-    m_next = o.m_next;
-    if (m_next != nullptr)
+    m_store = o.m_store;
+    m_head = o.m_head;
+    if (m_store != nullptr)
     {
-        m_next->count++;
+        m_store->count++;
     }
     return *this;
 }
@@ -355,27 +357,16 @@ PacketTagList::~PacketTagList()
 void
 PacketTagList::RemoveAll()
 {
-    TagData* prev = nullptr;
-    for (TagData* cur = m_next; cur != nullptr; cur = cur->next)
+    if (m_store != nullptr)
     {
-        cur->count--;
-        if (cur->count > 0)
+        m_store->count--;
+        if (m_store->count == 0)
         {
-            break;
+            DestroyStore(m_store);
         }
-        if (prev != nullptr)
-        {
-            prev->~TagData();
-            std::free(prev);
-        }
-        prev = cur;
-    }
-    if (prev != nullptr)
-    {
-        prev->~TagData();
-        std::free(prev);
+        m_store = nullptr;
+        m_head = nullptr;
     }
-    m_next = nullptr;
 }
 
 } // namespace ns3
@@ -18,6 +18,8 @@
  */
 #include "packet.h"
 
+#include "packet-allocator.h"
+
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
@@ -136,6 +138,18 @@ Packet::Copy() const
     return Ptr<Packet>(new Packet(*this), false);
 }
 
+void*
+Packet::operator new(std::size_t size)
+{
+    return PacketAllocator::AllocatePacket(size);
+}
+
+void
+Packet::operator delete(void* p, std::size_t size)
+{
+    PacketAllocator::DeallocatePacket(p, size);
+}
+
 Packet::Packet()
     : m_buffer(),
       m_byteTagList(),
@@ -599,6 +613,13 @@ Packet::EnablePrinting()
     PacketMetadata::Enable();
 }
 
+void
+Packet::EnableLazyPrinting()
+{
+    NS_LOG_FUNCTION_NOARGS();
+    PacketMetadata::EnableLazy();
+}
+
 void
 Packet::EnableChecking()
 {
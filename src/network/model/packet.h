@@ -33,6 +33,7 @@
 #include "ns3/mac48-address.h"
 #include "ns3/ptr.h"
 
+#include <cstddef>
 #include <stdint.h>
 
 namespace ns3
@@ -206,7 +207,9 @@ class PacketTagIterator
  * output from Packet::Print. If you wish to only enable
  * checking of metadata, and do not need any printing capability, you can
  * call Packet::EnableChecking: its runtime cost is lower than
- * Packet::EnablePrinting.
+ * Packet::EnablePrinting. If only a few packets are printed, call
+ * Packet::EnableLazyPrinting instead of Packet::EnablePrinting: the metadata
+ * is then only built for the packets which are printed.
  *
  * - The set of tags contain simulation-specific information which cannot
  * be stored in the packet byte buffer because the protocol headers or trailers
@@ -290,6 +293,21 @@ class Packet : public SimpleRefCount<Packet>
      * \param size the size of the input buffer.
      */
     Packet(const uint8_t* buffer, uint32_t size);
+    /**
+     * \brief Allocate a packet from the PacketAllocator.
+     *
+     * The packets are counted by PacketAllocator::GetLivePackets.
+     *
+     * \param size the size of the packet object
+     * \returns the memory of the packet
+     */
+    static void* operator new(std::size_t size);
+    /**
+     * \brief Return a packet to the PacketAllocator.
+     * \param p the memory of the packet
+     * \param size the size of the packet object
+     */
+    static void operator delete(void* p, std::size_t size);
     /**
      * \brief Create a new packet which contains a fragment of the original
      * packet.
@@ -525,6 +543,18 @@ class Packet : public SimpleRefCount<Packet>
      * simulation setup and before any packet is created.
      */
     static void EnablePrinting();
+    /**
+     * \brief Enable printing packets metadata, building it only when needed.
+     *
+     * Like EnablePrinting, but the operations on the headers and trailers
+     * of the packets are only recorded in a compact log, which is turned
+     * into metadata when a packet is printed (by the Print methods,
+     * BeginItem, or the ascii traces) or serialized. This costs much less
+     * when few of the packets are printed.
+     *
+     * \sa PacketMetadata::EnableLazy
+     */
+    static void EnableLazyPrinting();
     /**
      * \brief Enable packets metadata checking.
      *
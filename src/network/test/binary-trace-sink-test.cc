@@ -0,0 +1,276 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/binary-trace-sink.h"
+#include "ns3/ptr.h"
+#include "ns3/test.h"
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+using namespace ns3;
+
+/// Number of records written by the tests
+static const uint32_t N_RECORDS = 20000;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Write the test records to a sink
+ * \param sink the sink
+ */
+static void
+WriteRecords(Ptr<BinaryTraceSink> sink)
+{
+    for (uint32_t i = 0; i < N_RECORDS; ++i)
+    {
+        std::ostringstream content;
+        content << "record " << i;
+        sink->Write(i * 0.001, (uint16_t)i, (uint64_t)i * 1000003, (int8_t)-i, content.str());
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Get the content of a file
+ * \param filename the name of the file
+ * \returns the bytes of the file
+ */
+static std::vector<uint8_t>
+ReadFile(const std::string& filename)
+{
+    std::ifstream in(filename, std::ios::binary);
+    return std::vector<uint8_t>(std::istreambuf_iterator<char>(in),
+                                std::istreambuf_iterator<char>());
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Read a value of the host byte order
+ * \param data the bytes
+ * \param [in,out] offset the offset of the value, moved after the value
+ * \returns the value
+ */
+template <typename T>
+static T
+Read(const std::vector<uint8_t>& data, uint32_t& offset)
+{
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Read a string field
+ * \param data the bytes
+ * \param [in,out] offset the offset of the field, moved after the field
+ * \returns the value
+ */
+static std::string
+ReadString(const std::vector<uint8_t>& data, uint32_t& offset)
+{
+    uint32_t size = Read<uint32_t>(data, offset);
+    std::string value(data.begin() + offset, data.begin() + offset + size);
+    offset += size;
+    return value;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the preamble and the records of the binary trace files
+ */
+class BinaryTraceSinkRecordsTestCase : public TestCase
+{
+  public:
+    BinaryTraceSinkRecordsTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceSinkRecordsTestCase::BinaryTraceSinkRecordsTestCase()
+    : TestCase("Check the preamble and the records of the binary trace files")
+{
+}
+
+void
+BinaryTraceSinkRecordsTestCase::DoRun()
+{
+    for (bool asynchronous : {false, true})
+    {
+        std::ostringstream name;
+        name << "records-" << asynchronous << ".bin";
+        std::string filename = CreateTempDirFilename(name.str());
+        Ptr<BinaryTraceSink> sink = Create<BinaryTraceSink>(filename,
+                                                            "% time\tid\tkey\tdelta\tcontent\n",
+                                                            "\t\n",
+                                                            asynchronous);
+        NS_TEST_ASSERT_MSG_EQ(sink->Fail(), false, "Open (" << filename << ") returns error");
+        WriteRecords(sink);
+        sink->Flush();
+        NS_TEST_EXPECT_MSG_EQ(sink->Fail(), false, "Writing " << filename << " failed");
+        sink = nullptr;
+
+        std::vector<uint8_t> data = ReadFile(filename);
+        NS_TEST_ASSERT_MSG_GT(data.size(), 8, "File too short");
+        NS_TEST_EXPECT_MSG_EQ(std::string(data.begin(), data.begin() + 8), "NS3BTRC1", "Magic");
+        uint32_t offset = 8;
+        NS_TEST_EXPECT_MSG_EQ(Read<uint32_t>(data, offset), 0x01020304, "Byte order");
+        NS_TEST_EXPECT_MSG_EQ(ReadString(data, offset),
+                              "% time\tid\tkey\tdelta\tcontent\n",
+                              "Header");
+        NS_TEST_EXPECT_MSG_EQ(ReadString(data, offset), "\t\n", "Terminator");
+        NS_TEST_ASSERT_MSG_EQ(+Read<uint8_t>(data, offset), 5, "Number of fields");
+        const uint8_t types[] = {BinaryTraceSink::DOUBLE,
+                                 BinaryTraceSink::UINT16,
+                                 BinaryTraceSink::UINT64,
+                                 BinaryTraceSink::INT8,
+                                 BinaryTraceSink::STRING};
+        for (uint8_t type : types)
+        {
+            NS_TEST_EXPECT_MSG_EQ(+Read<uint8_t>(data, offset), +type, "Field type");
+        }
+
+        for (uint32_t i = 0; i < N_RECORDS; ++i)
+        {
+            NS_TEST_ASSERT_MSG_LT(offset, data.size(), "Missing record " << i);
+            std::ostringstream content;
+            content << "record " << i;
+            NS_TEST_EXPECT_MSG_EQ(Read<double>(data, offset), i * 0.001, "Time of record " << i);
+            NS_TEST_EXPECT_MSG_EQ(Read<uint16_t>(data, offset), (uint16_t)i, "Id of record " << i);
+            NS_TEST_EXPECT_MSG_EQ(Read<uint64_t>(data, offset),
+                                  (uint64_t)i * 1000003,
+                                  "Key of record " << i);
+            NS_TEST_EXPECT_MSG_EQ(+Read<int8_t>(data, offset),
+                                  +(int8_t)-i,
+                                  "Delta of record " << i);
+            NS_TEST_EXPECT_MSG_EQ(ReadString(data, offset),
+                                  content.str(),
+                                  "Content of record " << i);
+        }
+        NS_TEST_EXPECT_MSG_EQ(offset, data.size(), "Trailing bytes");
+    }
+}
+
+#ifdef HAVE_ZLIB
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the compressed binary trace files hold the same records
+ */
+class BinaryTraceSinkGzipTestCase : public TestCase
+{
+  public:
+    BinaryTraceSinkGzipTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+BinaryTraceSinkGzipTestCase::BinaryTraceSinkGzipTestCase()
+    : TestCase("Check that the compressed binary trace files hold the same records")
+{
+}
+
+void
+BinaryTraceSinkGzipTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("records.bin");
+    WriteRecords(Create<BinaryTraceSink>(filename, "% header\n"));
+    std::string gzFilename = CreateTempDirFilename("records.bin.gz");
+    WriteRecords(
+        Create<BinaryTraceSink>(gzFilename, "% header\n", "\n", true, AsyncFileWriter::GZIP));
+
+    std::vector<uint8_t> data = ReadFile(filename);
+    std::vector<uint8_t> compressed = ReadFile(gzFilename);
+    NS_TEST_ASSERT_MSG_GT(compressed.size(), 2, "File too short");
+    NS_TEST_EXPECT_MSG_EQ(+compressed[0], 0x1f, "gzip magic");
+    NS_TEST_EXPECT_MSG_EQ(+compressed[1], 0x8b, "gzip magic");
+    NS_TEST_EXPECT_MSG_LT(compressed.size(), data.size(), "Compressed size");
+
+    std::vector<uint8_t> uncompressed(data.size() + 1);
+    gzFile file = gzopen(gzFilename.c_str(), "rb");
+    NS_TEST_ASSERT_MSG_NE(file, nullptr, "gzopen (" << gzFilename << ") returns error");
+    int size = gzread(file, uncompressed.data(), uncompressed.size());
+    gzclose(file);
+    NS_TEST_ASSERT_MSG_EQ(size, (int)data.size(), "Uncompressed size");
+    uncompressed.resize(size);
+    NS_TEST_EXPECT_MSG_EQ((uncompressed == data), true, "Uncompressed content");
+}
+#endif
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief BinaryTraceSink TestSuite
+ */
+class BinaryTraceSinkTestSuite : public TestSuite
+{
+  public:
+    BinaryTraceSinkTestSuite();
+};
+
+BinaryTraceSinkTestSuite::BinaryTraceSinkTestSuite()
+    : TestSuite("binary-trace-sink", UNIT)
+{
+    AddTestCase(new BinaryTraceSinkRecordsTestCase(), TestCase::QUICK);
+#ifdef HAVE_ZLIB
+    AddTestCase(new BinaryTraceSinkGzipTestCase(), TestCase::QUICK);
+#endif
+}
+
+static BinaryTraceSinkTestSuite
+    g_binaryTraceSinkTestSuite; //!< Static variable for test initialization
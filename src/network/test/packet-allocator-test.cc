@@ -0,0 +1,264 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/packet-allocator.h"
+#include "ns3/packet.h"
+#include "ns3/test.h"
+
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Get the live blocks of the size class of a requested size
+ * \param size the requested size
+ * \returns the number of live blocks
+ */
+static uint64_t
+GetLiveBlocks(std::size_t size)
+{
+    std::size_t blockSize = PacketAllocator::GetBlockSize(size);
+    for (const auto& stats : PacketAllocator::GetStats())
+    {
+        if (stats.blockSize == blockSize)
+        {
+            return stats.liveBlocks;
+        }
+    }
+    return 0;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the size classes and the block statistics, with and without pooling
+ */
+class PacketAllocatorSizeClassTestCase : public TestCase
+{
+  public:
+    PacketAllocatorSizeClassTestCase();
+
+  private:
+    void DoRun() override;
+    void DoTeardown() override;
+};
+
+PacketAllocatorSizeClassTestCase::PacketAllocatorSizeClassTestCase()
+    : TestCase("Check the size classes and the block statistics")
+{
+}
+
+void
+PacketAllocatorSizeClassTestCase::DoRun()
+{
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(1), 32, "Smallest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(33), 48, "1.5 * 32");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(64), 64, "Exact size");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(1600), 2048, "2 * 1024");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(65536), 65536, "Largest block");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetBlockSize(65537), 65537, "Heap block");
+
+    std::size_t previous = 0;
+    for (std::size_t size = 1; size <= 65536; size++)
+    {
+        std::size_t blockSize = PacketAllocator::GetBlockSize(size);
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(blockSize, size, "Block too small for " << size);
+        NS_TEST_ASSERT_MSG_GT_OR_EQ(blockSize, previous, "Block sizes not sorted");
+        if (size > 32)
+        {
+            NS_TEST_ASSERT_MSG_LT(2 * blockSize, 3 * size, "Block too large for " << size);
+        }
+        previous = blockSize;
+    }
+
+    for (bool pooling : {true, false})
+    {
+        PacketAllocator::SetPooling(pooling);
+        uint64_t liveBefore = GetLiveBlocks(100);
+        std::vector<void*> blocks;
+        for (uint32_t i = 0; i < 5000; i++)
+        {
+            void* block = PacketAllocator::Allocate(100);
+            std::memset(block, i % 256, PacketAllocator::GetBlockSize(100));
+            blocks.push_back(block);
+        }
+        NS_TEST_EXPECT_MSG_EQ(GetLiveBlocks(100), liveBefore + 5000, "Allocated blocks");
+        for (void* block : blocks)
+        {
+            PacketAllocator::Deallocate(block, 100);
+        }
+        NS_TEST_EXPECT_MSG_EQ(GetLiveBlocks(100), liveBefore, "Deallocated blocks");
+    }
+}
+
+void
+PacketAllocatorSizeClassTestCase::DoTeardown()
+{
+    PacketAllocator::SetPooling(true);
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the counts of the live and peak packets
+ */
+class PacketAllocatorPacketCountTestCase : public TestCase
+{
+  public:
+    PacketAllocatorPacketCountTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorPacketCountTestCase::PacketAllocatorPacketCountTestCase()
+    : TestCase("Check the counts of the live and peak packets")
+{
+}
+
+void
+PacketAllocatorPacketCountTestCase::DoRun()
+{
+    uint64_t live = PacketAllocator::GetLivePackets();
+    PacketAllocator::ResetPeaks();
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetPeakPackets(), live, "Reset peak");
+    {
+        std::vector<Ptr<Packet>> packets;
+        for (uint32_t i = 0; i < 10; i++)
+        {
+            packets.push_back(Create<Packet>(1000));
+        }
+        packets.push_back(packets.front()->Copy());
+        packets.push_back(packets.back()->CreateFragment(0, 500));
+        NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetLivePackets(), live + 12, "Live packets");
+    }
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetLivePackets(), live, "Released packets");
+    NS_TEST_EXPECT_MSG_EQ(PacketAllocator::GetPeakPackets(), live + 12, "Peak packets");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the allocation and the deallocation of blocks from several threads
+ */
+class PacketAllocatorThreadTestCase : public TestCase
+{
+  public:
+    PacketAllocatorThreadTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PacketAllocatorThreadTestCase::PacketAllocatorThreadTestCase()
+    : TestCase("Check the allocation of blocks from several threads")
+{
+}
+
+void
+PacketAllocatorThreadTestCase::DoRun()
+{
+    uint64_t live = 0;
+    for (const auto& stats : PacketAllocator::GetStats())
+    {
+        live += stats.liveBlocks;
+    }
+    auto worker = [](uint32_t seed) {
+        std::vector<std::pair<void*, std::size_t>> blocks;
+        for (uint32_t i = 0; i < 20000; i++)
+        {
+            std::size_t size = (seed * 7919 + i * 104729) % 3000 + 1;
+            blocks.emplace_back(PacketAllocator::Allocate(size), size);
+            std::memset(blocks.back().first, seed, size);
+            if (blocks.size() > 100)
+            {
+                // release the blocks in another order than their allocation
+                auto it = blocks.begin() + (i % blocks.size());
+                PacketAllocator::Deallocate(it->first, it->second);
+                blocks.erase(it);
+            }
+        }
+        for (const auto& block : blocks)
+        {
+            PacketAllocator::Deallocate(block.first, block.second);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    for (const auto& stats : PacketAllocator::GetStats())
+    {
+        live -= stats.liveBlocks;
+    }
+    NS_TEST_EXPECT_MSG_EQ(live, 0, "Released blocks");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief PacketAllocator TestSuite
+ */
+class PacketAllocatorTestSuite : public TestSuite
+{
+  public:
+    PacketAllocatorTestSuite();
+};
+
+PacketAllocatorTestSuite::PacketAllocatorTestSuite()
+    : TestSuite("packet-allocator", UNIT)
+{
+    AddTestCase(new PacketAllocatorSizeClassTestCase(), TestCase::QUICK);
+    AddTestCase(new PacketAllocatorPacketCountTestCase(), TestCase::QUICK);
+    AddTestCase(new PacketAllocatorThreadTestCase(), TestCase::QUICK);
+}
+
+static PacketAllocatorTestSuite
+    g_packetAllocatorTestSuite; //!< Static variable for test initialization
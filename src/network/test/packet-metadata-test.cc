@@ -326,7 +326,11 @@ HistoryTrailer<N>::Deserialize(Buffer::Iterator start)
 class PacketMetadataTest : public TestCase
 {
   public:
-    PacketMetadataTest();
+    /**
+     * Constructor
+     * \param lazy Whether to test the lazy mode of the metadata
+     */
+    PacketMetadataTest(bool lazy);
     ~PacketMetadataTest() override;
     /**
      * Checks the packet header and trailer history
@@ -336,6 +340,7 @@ class PacketMetadataTest : public TestCase
      */
     void CheckHistory(Ptr<Packet> p, uint32_t n, ...);
     void DoRun() override;
+    void DoTeardown() override;
 
   private:
     /**
@@ -344,10 +349,13 @@ class PacketMetadataTest : public TestCase
      * \return The packet with the header added.
      */
     Ptr<Packet> DoAddHeader(Ptr<Packet> p);
+
+    bool m_lazy; //!< Whether to test the lazy mode of the metadata
 };
 
-PacketMetadataTest::PacketMetadataTest()
-    : TestCase("Packet metadata")
+PacketMetadataTest::PacketMetadataTest(bool lazy)
+    : TestCase(lazy ? "Packet metadata, lazy" : "Packet metadata"),
+      m_lazy(lazy)
 {
 }
 
@@ -479,7 +487,14 @@ PacketMetadataTest::DoAddHeader(Ptr<Packet> p)
 void
 PacketMetadataTest::DoRun()
 {
-    PacketMetadata::Enable();
+    if (m_lazy)
+    {
+        PacketMetadata::EnableLazy();
+    }
+    else
+    {
+        PacketMetadata::Enable();
+    }
 
     Ptr<Packet> p = Create<Packet>(0);
     Ptr<Packet> p1 = Create<Packet>(0);
@@ -879,6 +894,40 @@ PacketMetadataTest::DoRun()
     NS_TEST_EXPECT_MSG_EQ(msg,
                           std::string("hello world"),
                           "Could not find original data in received packet");
+
+    // copies which add and remove headers before they are printed
+    p = Create<Packet>(10);
+    ADD_HEADER(p, 1);
+    ADD_HEADER(p, 2);
+    p1 = p->Copy();
+    REM_HEADER(p, 2);
+    ADD_HEADER(p, 3);
+    ADD_TRAILER(p1, 4);
+    p2 = p1->Copy();
+    REM_TRAILER(p2, 4);
+    REM_HEADER(p2, 2);
+    ADD_HEADER(p2, 5);
+    CHECK_HISTORY(p1, 4, 2, 1, 10, 4);
+    CHECK_HISTORY(p, 3, 3, 1, 10);
+    CHECK_HISTORY(p2, 3, 5, 1, 10);
+
+    // more operations than a log holds
+    p = Create<Packet>(10);
+    for (uint32_t i = 0; i < 50; i++)
+    {
+        ADD_HEADER(p, 1);
+        ADD_TRAILER(p, 2);
+        p->RemoveAtStart(1);
+        p->RemoveAtEnd(2);
+    }
+    ADD_HEADER(p, 3);
+    CHECK_HISTORY(p, 2, 3, 10);
+}
+
+void
+PacketMetadataTest::DoTeardown()
+{
+    PacketMetadata::DisableLazy();
 }
 
 /**
@@ -896,7 +945,8 @@ class PacketMetadataTestSuite : public TestSuite
 PacketMetadataTestSuite::PacketMetadataTestSuite()
     : TestSuite("packet-metadata", UNIT)
 {
-    AddTestCase(new PacketMetadataTest, TestCase::QUICK);
+    AddTestCase(new PacketMetadataTest(false), TestCase::QUICK);
+    AddTestCase(new PacketMetadataTest(true), TestCase::QUICK);
 }
 
 static PacketMetadataTestSuite g_packetMetadataTest; //!< Static variable for test initialization
@@ -26,6 +26,8 @@
 #include <iostream>
 #include <limits> // std:numeric_limits
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -1264,6 +1266,174 @@ PacketTagListTest::DoRun()
 } // Timing
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet Tag list unit tests with more tags than the list finds by their
+ * compact index, and more tag types than compact indices.
+ */
+class PacketTagListManyTagsTest : public TestCase
+{
+  public:
+    PacketTagListManyTagsTest();
+
+  private:
+    void DoRun() override;
+
+    /// Number of tag types
+    static constexpr int N_TAGS = 70;
+    /// Sequence of the tag types
+    using TagSequence = std::make_integer_sequence<int, N_TAGS>;
+
+    /**
+     * Add a tag of each type, with its index as data.
+     * \param ptl The list.
+     */
+    template <int... N>
+    static void AddTags(PacketTagList& ptl, std::integer_sequence<int, N...>);
+    /**
+     * Check the tags of a list.
+     * \param ptl The list.
+     * \param step Only the tags with an index multiple of step are expected.
+     * \param msg Message.
+     */
+    template <int... N>
+    void CheckTags(const PacketTagList& ptl,
+                   int step,
+                   const char* msg,
+                   std::integer_sequence<int, N...>);
+    /**
+     * Remove the tags with an odd index.
+     * \param ptl The list.
+     */
+    template <int... N>
+    static void RemoveOddTags(PacketTagList& ptl, std::integer_sequence<int, N...>);
+    /**
+     * Check a tag of a list.
+     * \param ptl The list.
+     * \param tag The tag type to find.
+     * \param expected The expected data, or -1 if the tag should be missing.
+     * \param msg Message.
+     */
+    void CheckTag(const PacketTagList& ptl, ATestTagBase&& tag, int expected, const char* msg);
+};
+
+PacketTagListManyTagsTest::PacketTagListManyTagsTest()
+    : TestCase("PacketTagListManyTagsTest")
+{
+}
+
+template <int... N>
+void
+PacketTagListManyTagsTest::AddTags(PacketTagList& ptl, std::integer_sequence<int, N...>)
+{
+    (ptl.Add(ATestTag<N + 100>(N)), ...);
+}
+
+template <int... N>
+void
+PacketTagListManyTagsTest::CheckTags(const PacketTagList& ptl,
+                                     int step,
+                                     const char* msg,
+                                     std::integer_sequence<int, N...>)
+{
+    (CheckTag(ptl, ATestTag<N + 100>(), (N % step == 0) ? N : -1, msg), ...);
+}
+
+template <int... N>
+void
+PacketTagListManyTagsTest::RemoveOddTags(PacketTagList& ptl, std::integer_sequence<int, N...>)
+{
+    auto removeOdd = [&ptl](ATestTagBase&& tag, int index) {
+        if (index % 2 == 1)
+        {
+            ptl.Remove(tag);
+        }
+    };
+    (removeOdd(ATestTag<N + 100>(), N), ...);
+}
+
+void
+PacketTagListManyTagsTest::CheckTag(const PacketTagList& ptl,
+                                    ATestTagBase&& tag,
+                                    int expected,
+                                    const char* msg)
+{
+    bool found = ptl.Peek(tag);
+    NS_TEST_EXPECT_MSG_EQ(found, (expected >= 0), msg << ": " << tag.GetInstanceTypeId());
+    if (found && expected >= 0)
+    {
+        NS_TEST_EXPECT_MSG_EQ(int(tag.GetData()), expected, msg << ": " << tag.GetInstanceTypeId());
+        NS_TEST_EXPECT_MSG_EQ(tag.m_error, false, msg << ": " << tag.GetInstanceTypeId());
+    }
+}
+
+void
+PacketTagListManyTagsTest::DoRun()
+{
+    PacketTagList ref;
+    AddTags(ref, TagSequence());
+    CheckTags(ref, 1, "all tags", TagSequence());
+
+    // the most recent tag comes first
+    int n = 0;
+    for (const PacketTagList::TagData* cur = ref.Head(); cur != nullptr; cur = cur->next)
+    {
+        NS_TEST_EXPECT_MSG_EQ(cur->size, uint32_t(N_TAGS - n + 100), "order of the tags");
+        n++;
+    }
+    NS_TEST_EXPECT_MSG_EQ(n, N_TAGS, "number of tags");
+
+    PacketTagList copy = ref;
+    RemoveOddTags(copy, TagSequence());
+    CheckTags(ref, 1, "removal, orig", TagSequence());
+    CheckTags(copy, 2, "removal, copy", TagSequence());
+
+    ATestTag<100> t0(42);
+    copy.Replace(t0);
+    CheckTag(ref, ATestTag<100>(), 0, "replace, orig");
+    CheckTag(copy, ATestTag<100>(), 42, "replace, copy");
+    t0.m_data = 0;
+    copy.Replace(t0);
+
+    // the copies sharing a store do not see the tags removed and added by the others
+    PacketTagList branch = ref;
+    ATestTag<N_TAGS + 99> newest;
+    branch.Remove(newest);
+    CheckTag(ref, ATestTag<N_TAGS + 99>(), N_TAGS - 1, "branch, orig");
+    CheckTag(branch, ATestTag<N_TAGS + 99>(), -1, "branch, copy");
+    PacketTagList left;
+    left.Add(ATestTag<1>(1));
+    left.Add(ATestTag<2>(2));
+    PacketTagList right = left;
+    ATestTag<2> t2;
+    right.Remove(t2);
+    left.Add(ATestTag<3>(3));
+    right.Add(ATestTag<4>(4));
+    CheckTag(left, ATestTag<2>(), 2, "branches, left");
+    CheckTag(left, ATestTag<3>(), 3, "branches, left");
+    CheckTag(left, ATestTag<4>(), -1, "branches, left");
+    CheckTag(right, ATestTag<1>(), 1, "branches, right");
+    CheckTag(right, ATestTag<2>(), -1, "branches, right");
+    CheckTag(right, ATestTag<3>(), -1, "branches, right");
+    CheckTag(right, ATestTag<4>(), 4, "branches, right");
+
+    std::vector<uint32_t> buffer(copy.GetSerializedSize() / 4);
+    NS_TEST_ASSERT_MSG_EQ(copy.Serialize(buffer.data(), buffer.size() * 4), 1, "serialize");
+    PacketTagList deserialized;
+    // the size includes the 4 bytes of the length of the list in a serialized packet
+    deserialized.Deserialize(buffer.data(), buffer.size() * 4 + 4);
+    CheckTags(deserialized, 2, "deserialized", TagSequence());
+    const PacketTagList::TagData* a = copy.Head();
+    const PacketTagList::TagData* b = deserialized.Head();
+    for (; a != nullptr && b != nullptr; a = a->next, b = b->next)
+    {
+        NS_TEST_EXPECT_MSG_EQ(a->tid, b->tid, "order of the deserialized tags");
+    }
+    NS_TEST_EXPECT_MSG_EQ((a == nullptr && b == nullptr), true, "number of deserialized tags");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1281,6 +1451,7 @@ PacketTestSuite::PacketTestSuite()
 {
     AddTestCase(new PacketTest, TestCase::QUICK);
     AddTestCase(new PacketTagListTest, TestCase::QUICK);
+    AddTestCase(new PacketTagListManyTagsTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
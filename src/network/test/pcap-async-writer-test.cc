@@ -0,0 +1,342 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/enum.h"
+#include "ns3/pcap-file-wrapper.h"
+#include "ns3/pcap-file.h"
+#include "ns3/test.h"
+#include "ns3/trace-helper.h"
+#include "ns3/uinteger.h"
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/// Number of packets written by the tests
+static const uint32_t N_PACKETS = 500;
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Get the content of a test packet
+ * \param i the index of the packet
+ * \returns the bytes of the packet, of various sizes up to 3000 bytes
+ */
+static std::vector<uint8_t>
+GetPacketData(uint32_t i)
+{
+    std::vector<uint8_t> data((i * 37) % 3000 + 1);
+    for (uint32_t j = 0; j < data.size(); ++j)
+    {
+        data[j] = (i + j) & 0xff;
+    }
+    return data;
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Write the test packets to a file, alternating the Write methods
+ * \param file the file, initialized
+ */
+static void
+WritePackets(Ptr<PcapFileWrapper> file)
+{
+    for (uint32_t i = 0; i < N_PACKETS; ++i)
+    {
+        std::vector<uint8_t> data = GetPacketData(i);
+        Time t = MicroSeconds(1000000 + i * 1234567);
+        if (i % 2 == 0)
+        {
+            file->Write(t, data.data(), data.size());
+        }
+        else
+        {
+            file->Write(t, Create<Packet>(data.data(), data.size()));
+        }
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Read a 32-bit little-endian value
+ * \param data the bytes
+ * \param offset the offset of the value
+ * \returns the value
+ */
+static uint32_t
+ReadU32(const std::vector<uint8_t>& data, uint32_t offset)
+{
+    return data[offset] | (data[offset + 1] << 8) | (data[offset + 2] << 16) |
+           (uint32_t(data[offset + 3]) << 24);
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check that the asynchronous writer writes the same pcap files as PcapFile
+ */
+class PcapAsyncWriterPcapTestCase : public TestCase
+{
+  public:
+    PcapAsyncWriterPcapTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapAsyncWriterPcapTestCase::PcapAsyncWriterPcapTestCase()
+    : TestCase("Check that the asynchronous pcap files match the synchronous ones")
+{
+}
+
+void
+PcapAsyncWriterPcapTestCase::DoRun()
+{
+    std::string syncFilename = CreateTempDirFilename("sync.pcap");
+    Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+    file->Open(syncFilename, std::ios::out);
+    file->Init(PcapHelper::DLT_RAW);
+    WritePackets(file);
+    file->Close();
+
+    // Small buffers, so that the simulation waits for the background thread,
+    // and that the largest packets do not fit in a buffer
+    for (bool asynchronous : {false, true})
+    {
+        std::ostringstream name;
+        name << "buffered-" << asynchronous << ".pcap";
+        std::string filename = CreateTempDirFilename(name.str());
+        file = CreateObject<PcapFileWrapper>();
+        file->SetAttribute("Asynchronous", BooleanValue(asynchronous));
+        file->SetAttribute("BufferSize", UintegerValue(2048));
+        file->Open(filename, std::ios::out);
+        NS_TEST_ASSERT_MSG_EQ(file->Fail(), false, "Open (" << filename << ") returns error");
+        file->Init(PcapHelper::DLT_RAW);
+        NS_TEST_EXPECT_MSG_EQ(file->GetSnapLen(), PcapFile::SNAPLEN_DEFAULT, "Snapshot length");
+        WritePackets(file);
+        file->Close();
+        NS_TEST_EXPECT_MSG_EQ(file->Fail(), false, "Writing " << filename << " failed");
+
+        uint32_t sec = 0;
+        uint32_t usec = 0;
+        uint32_t packets = 0;
+        bool diff = PcapFile::Diff(syncFilename, filename, sec, usec, packets);
+        NS_TEST_EXPECT_MSG_EQ(diff, false, "Files differ at packet " << packets);
+        NS_TEST_EXPECT_MSG_EQ(packets, N_PACKETS, "Number of packets");
+    }
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the sampling and the snapshot length of the asynchronous files
+ */
+class PcapAsyncWriterSamplingTestCase : public TestCase
+{
+  public:
+    PcapAsyncWriterSamplingTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapAsyncWriterSamplingTestCase::PcapAsyncWriterSamplingTestCase()
+    : TestCase("Check the sampling and the snapshot length of the asynchronous files")
+{
+}
+
+void
+PcapAsyncWriterSamplingTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("sampled.pcap");
+    Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+    file->SetAttribute("Asynchronous", BooleanValue(true));
+    file->SetAttribute("CaptureSize", UintegerValue(100));
+    file->SetAttribute("SamplingInterval", UintegerValue(3));
+    file->Open(filename, std::ios::out);
+    file->Init(PcapHelper::DLT_RAW);
+    WritePackets(file);
+    file->Close();
+
+    PcapFile f;
+    f.Open(filename, std::ios::in);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(f.GetSnapLen(), 100, "Snapshot length");
+    uint8_t data[100];
+    uint32_t tsSec;
+    uint32_t tsUsec;
+    uint32_t inclLen;
+    uint32_t origLen;
+    uint32_t readLen;
+    uint32_t i = 0;
+    for (;; i += 3)
+    {
+        f.Read(data, sizeof(data), tsSec, tsUsec, inclLen, origLen, readLen);
+        if (f.Eof())
+        {
+            break;
+        }
+        std::vector<uint8_t> expected = GetPacketData(i);
+        uint64_t t = 1000000 + i * 1234567ULL;
+        NS_TEST_EXPECT_MSG_EQ(tsSec, t / 1000000, "Timestamp of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(tsUsec, t % 1000000, "Timestamp of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(origLen, expected.size(), "Length of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(inclLen, std::min<uint32_t>(expected.size(), 100), "Snapshot");
+        NS_TEST_EXPECT_MSG_EQ(std::equal(data, data + inclLen, expected.begin()),
+                              true,
+                              "Content of packet " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(i, (N_PACKETS + 2) / 3 * 3, "Number of sampled packets");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief Check the blocks of the pcapng files
+ */
+class PcapAsyncWriterPcapngTestCase : public TestCase
+{
+  public:
+    PcapAsyncWriterPcapngTestCase();
+
+  private:
+    void DoRun() override;
+};
+
+PcapAsyncWriterPcapngTestCase::PcapAsyncWriterPcapngTestCase()
+    : TestCase("Check the blocks of the pcapng files")
+{
+}
+
+void
+PcapAsyncWriterPcapngTestCase::DoRun()
+{
+    std::string filename = CreateTempDirFilename("packets.pcapng");
+    Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper>();
+    file->SetAttribute("Asynchronous", BooleanValue(true));
+    file->SetAttribute("Format", EnumValue(PcapAsyncWriter::PCAPNG));
+    file->SetAttribute("NanosecMode", BooleanValue(true));
+    file->SetAttribute("BufferSize", UintegerValue(4096));
+    file->Open(filename, std::ios::out);
+    file->Init(PcapHelper::DLT_PPP, 2000);
+    NS_TEST_EXPECT_MSG_EQ(file->GetMagic(), 0x0a0d0d0a, "Magic number of pcapng");
+    WritePackets(file);
+    file->Close();
+
+    std::ifstream in(filename, std::ios::binary);
+    std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)),
+                              std::istreambuf_iterator<char>());
+    NS_TEST_ASSERT_MSG_GT(data.size(), 60, "File too short");
+
+    // Section Header Block
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 0), 0x0a0d0d0a, "SHB type");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 4), 28, "SHB length");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 8), 0x1a2b3c4d, "Byte-order magic");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 24), 28, "SHB trailing length");
+
+    // Interface Description Block, with if_tsresol = 9
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 28), 1, "IDB type");
+    uint32_t idbLength = ReadU32(data, 32);
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 36), PcapHelper::DLT_PPP, "Data link type");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 40), 2000, "Snapshot length");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 44), 0x00010009, "if_tsresol option");
+    NS_TEST_EXPECT_MSG_EQ(data[48], 9, "Nanosecond resolution");
+    NS_TEST_EXPECT_MSG_EQ(ReadU32(data, 28 + idbLength - 4), idbLength, "IDB trailing length");
+
+    // Enhanced Packet Blocks
+    uint32_t offset = 28 + idbLength;
+    uint32_t i = 0;
+    while (offset < data.size())
+    {
+        NS_TEST_ASSERT_MSG_EQ(ReadU32(data, offset), 6, "EPB type of packet " << i);
+        uint32_t length = ReadU32(data, offset + 4);
+        NS_TEST_ASSERT_MSG_EQ(length % 4, 0, "EPB length of packet " << i);
+        NS_TEST_ASSERT_MSG_LT_OR_EQ(offset + length, data.size(), "EPB of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(ReadU32(data, offset + length - 4), length, "Trailing length");
+
+        std::vector<uint8_t> expected = GetPacketData(i);
+        uint64_t t = (1000000 + i * 1234567ULL) * 1000;
+        uint64_t timestamp = (uint64_t(ReadU32(data, offset + 12)) << 32) |
+                             ReadU32(data, offset + 16);
+        uint32_t inclLen = ReadU32(data, offset + 20);
+        NS_TEST_EXPECT_MSG_EQ(timestamp, t, "Timestamp of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(ReadU32(data, offset + 24), expected.size(), "Original length");
+        NS_TEST_EXPECT_MSG_EQ(inclLen, std::min<uint32_t>(expected.size(), 2000), "Snapshot");
+        NS_TEST_EXPECT_MSG_EQ(length, 32 + (inclLen + 3) / 4 * 4, "EPB length of packet " << i);
+        NS_TEST_EXPECT_MSG_EQ(std::equal(data.begin() + offset + 28,
+                                         data.begin() + offset + 28 + inclLen,
+                                         expected.begin()),
+                              true,
+                              "Content of packet " << i);
+        offset += length;
+        ++i;
+    }
+    NS_TEST_EXPECT_MSG_EQ(i, N_PACKETS, "Number of packets");
+}
+
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * \brief PcapAsyncWriter TestSuite
+ */
+class PcapAsyncWriterTestSuite : public TestSuite
+{
+  public:
+    PcapAsyncWriterTestSuite();
+};
+
+PcapAsyncWriterTestSuite::PcapAsyncWriterTestSuite()
+    : TestSuite("pcap-async-writer", UNIT)
+{
+    AddTestCase(new PcapAsyncWriterPcapTestCase(), TestCase::QUICK);
+    AddTestCase(new PcapAsyncWriterSamplingTestCase(), TestCase::QUICK);
+    AddTestCase(new PcapAsyncWriterPcapngTestCase(), TestCase::QUICK);
+}
+
+static PcapAsyncWriterTestSuite
+    g_pcapAsyncWriterTestSuite; //!< Static variable for test initialization
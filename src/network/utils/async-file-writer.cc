@@ -0,0 +1,313 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "async-file-writer.h"
+
+#include "ns3/fatal-error.h"
+#include "ns3/log.h"
+
+#include <deque>
+#include <thread>
+#include <utility>
+
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("AsyncFileWriter");
+
+namespace
+{
+
+/**
+ * \ingroup network
+ *
+ * Background thread which writes the buffers of all the asynchronous
+ * writers, in the order in which they are handed over.
+ */
+class AsyncFileWriterThread
+{
+  public:
+    /**
+     * \returns the thread, started on the first call
+     */
+    static AsyncFileWriterThread& Get()
+    {
+        static AsyncFileWriterThread thread;
+        return thread;
+    }
+
+    /**
+     * \returns true if the thread was stopped at the end of the program
+     */
+    static bool IsDestroyed()
+    {
+        return m_destroyed;
+    }
+
+    /**
+     * Queue a buffer to be written.
+     *
+     * \param writer The writer of the buffer.
+     * \param buffer The index of the buffer.
+     */
+    void Submit(AsyncFileWriter* writer, uint32_t buffer)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.emplace_back(writer, buffer);
+        m_cv.notify_one();
+    }
+
+  private:
+    AsyncFileWriterThread()
+        : m_stop(false)
+    {
+        m_thread = std::thread(&AsyncFileWriterThread::Run, this);
+    }
+
+    ~AsyncFileWriterThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+            m_cv.notify_one();
+        }
+        m_thread.join();
+        m_destroyed = true;
+    }
+
+    /**
+     * Write the queued buffers until the thread is stopped.
+     */
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        while (true)
+        {
+            m_cv.wait(lock, [this] { return m_stop || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                return;
+            }
+            std::pair<AsyncFileWriter*, uint32_t> job = m_jobs.front();
+            m_jobs.pop_front();
+            lock.unlock();
+            job.first->WriteBuffer(job.second);
+            job.first->ReleaseBuffer(job.second);
+            lock.lock();
+        }
+    }
+
+    static std::atomic<bool> m_destroyed; //!< Whether the thread was stopped
+    std::mutex m_mutex;                   //!< Protects m_jobs and m_stop
+    std::condition_variable m_cv;         //!< Signals a new job, or the stop
+    std::deque<std::pair<AsyncFileWriter*, uint32_t>> m_jobs; //!< Buffers to write
+    bool m_stop;                                              //!< Whether to stop the thread
+    std::thread m_thread;                                     //!< Thread
+};
+
+std::atomic<bool> AsyncFileWriterThread::m_destroyed(false);
+
+} // namespace
+
+AsyncFileWriter::AsyncFileWriter(const std::string& filename,
+                                 uint32_t bufferSize,
+                                 bool asynchronous,
+                                 Compression compression)
+    : m_gzFile(nullptr),
+      m_failed(false),
+      m_asynchronous(asynchronous),
+      m_bufferSize(bufferSize),
+      m_nBuffers(1),
+      m_current(0),
+      m_used(0),
+      m_pending(0)
+{
+    NS_LOG_FUNCTION(this << filename << bufferSize << asynchronous << compression);
+    if (compression == GZIP)
+    {
+#ifdef HAVE_ZLIB
+        m_gzFile = gzopen(filename.c_str(), "wb");
+        m_failed = m_gzFile == nullptr;
+#else
+        NS_FATAL_ERROR("The gzip compression of " << filename << " requires zlib");
+#endif
+    }
+    else
+    {
+        m_file.open(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+        m_failed = m_file.fail();
+    }
+    m_buffers[0].resize(m_bufferSize);
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+    NS_LOG_FUNCTION(this);
+    Close();
+}
+
+bool
+AsyncFileWriter::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_failed;
+}
+
+void
+AsyncFileWriter::Submit(uint32_t size)
+{
+    NS_LOG_FUNCTION(this << m_current << m_used << size);
+    if (m_used > 0)
+    {
+        m_sizes[m_current] = m_used;
+        m_used = 0;
+        if (!m_asynchronous || AsyncFileWriterThread::IsDestroyed())
+        {
+            WriteBuffer(m_current);
+        }
+        else
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_pending++;
+            }
+            AsyncFileWriterThread::Get().Submit(this, m_current);
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (m_free.empty() && m_nBuffers < MAX_BUFFERS)
+            {
+                m_current = m_nBuffers++;
+                m_buffers[m_current].resize(m_bufferSize);
+            }
+            else
+            {
+                m_cv.wait(lock, [this] { return !m_free.empty(); });
+                m_current = m_free.back();
+                m_free.pop_back();
+            }
+        }
+    }
+    if (size > m_buffers[m_current].size())
+    {
+        m_buffers[m_current].resize(size);
+    }
+}
+
+void
+AsyncFileWriter::WriteBuffer(uint32_t buffer)
+{
+    NS_LOG_FUNCTION(this << buffer << m_sizes[buffer]);
+#ifdef HAVE_ZLIB
+    if (m_gzFile != nullptr)
+    {
+        int written =
+            gzwrite(static_cast<gzFile>(m_gzFile), m_buffers[buffer].data(), m_sizes[buffer]);
+        if (written != static_cast<int>(m_sizes[buffer]))
+        {
+            m_failed = true;
+        }
+        return;
+    }
+#endif
+    m_file.write(reinterpret_cast<const char*>(m_buffers[buffer].data()), m_sizes[buffer]);
+    if (m_file.fail())
+    {
+        m_failed = true;
+    }
+}
+
+void
+AsyncFileWriter::ReleaseBuffer(uint32_t buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(buffer);
+    m_pending--;
+    // The writer may be destroyed as soon as the lock is released
+    m_cv.notify_all();
+}
+
+void
+AsyncFileWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    Submit(0);
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_pending == 0; });
+    }
+#ifdef HAVE_ZLIB
+    if (m_gzFile != nullptr)
+    {
+        if (gzflush(static_cast<gzFile>(m_gzFile), Z_SYNC_FLUSH) != Z_OK)
+        {
+            m_failed = true;
+        }
+        return;
+    }
+#endif
+    m_file.flush();
+    if (m_file.fail())
+    {
+        m_failed = true;
+    }
+}
+
+void
+AsyncFileWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    if (m_gzFile != nullptr)
+    {
+        Flush();
+#ifdef HAVE_ZLIB
+        if (gzclose(static_cast<gzFile>(m_gzFile)) != Z_OK)
+        {
+            m_failed = true;
+        }
+#endif
+        m_gzFile = nullptr;
+    }
+    else if (m_file.is_open())
+    {
+        Flush();
+        m_file.close();
+    }
+}
+
+} // namespace ns3
@@ -0,0 +1,185 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef ASYNC_FILE_WRITER_H
+#define ASYNC_FILE_WRITER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Buffered writer of a binary file
+ *
+ * The data is copied into memory buffers of a fixed size. Each full buffer
+ * is written to the file with a single write, either by the calling thread,
+ * or, in the asynchronous mode, by a background thread shared by all the
+ * writers, while the caller fills the next buffer. A writer allocates up to
+ * #MAX_BUFFERS buffers as needed, and the caller waits for a buffer to be
+ * written when they are all full. The file can be compressed in the gzip
+ * format, if ns-3 is built with zlib; the compression is then also done by
+ * the thread which writes the buffers.
+ */
+class AsyncFileWriter
+{
+  public:
+    /// Compression of the file
+    enum Compression
+    {
+        NONE, //!< No compression
+        GZIP  //!< gzip format, requires zlib
+    };
+
+    /// Maximum number of buffers of a writer
+    static constexpr uint32_t MAX_BUFFERS = 4;
+
+    /**
+     * Create a writer.
+     *
+     * \param filename The name of the file, which is truncated.
+     * \param bufferSize The size of each buffer, in bytes.
+     * \param asynchronous Whether the buffers are written by the background thread.
+     * \param compression The compression of the file.
+     */
+    AsyncFileWriter(const std::string& filename,
+                    uint32_t bufferSize,
+                    bool asynchronous,
+                    Compression compression = NONE);
+    /**
+     * Write the data left in the buffers and close the file.
+     */
+    ~AsyncFileWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    AsyncFileWriter(const AsyncFileWriter&) = delete;
+    AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+
+    /**
+     * \return true if the file could not be opened or written, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Make room for some bytes in the current buffer, handing the buffer
+     * over if they do not fit, and growing the next one if needed.
+     *
+     * \param size The number of bytes.
+     * \returns The position of the bytes, to be filled before the next call.
+     */
+    inline uint8_t* Reserve(uint32_t size);
+
+    /**
+     * Write the data in the buffers to the file, and wait until it is
+     * written.
+     */
+    void Flush();
+    /**
+     * Flush the buffers and close the file.
+     */
+    void Close();
+
+    /**
+     * Write a buffer to the file, called by the thread which writes the
+     * buffers.
+     *
+     * \param buffer The index of the buffer.
+     */
+    void WriteBuffer(uint32_t buffer);
+    /**
+     * Return a written buffer to the free buffers, called by the background
+     * thread.
+     *
+     * \param buffer The index of the buffer.
+     */
+    void ReleaseBuffer(uint32_t buffer);
+
+  private:
+    /**
+     * Hand the current buffer over to be written, and get another one at
+     * least as large as a number of bytes.
+     *
+     * \param size The number of bytes.
+     */
+    void Submit(uint32_t size);
+
+    std::ofstream m_file;                        //!< Output file, without compression
+    void* m_gzFile;                              //!< Output file, with compression
+    std::atomic<bool> m_failed;                  //!< Whether writing the file failed
+    bool m_asynchronous;                         //!< Whether the buffers are written asynchronously
+    uint32_t m_bufferSize;                       //!< Size of each buffer
+    std::vector<uint8_t> m_buffers[MAX_BUFFERS]; //!< Buffers
+    uint32_t m_sizes[MAX_BUFFERS];               //!< Bytes used in each buffer handed over
+    uint32_t m_nBuffers;                         //!< Number of allocated buffers
+    std::vector<uint32_t> m_free;                //!< Indices of the free buffers
+    uint32_t m_current;                          //!< Index of the buffer being filled
+    uint32_t m_used;                             //!< Bytes used in the buffer being filled
+    uint32_t m_pending;                          //!< Number of buffers waiting to be written
+    std::mutex m_mutex;                          //!< Protects m_free and m_pending
+    std::condition_variable m_cv;                //!< Signals the release of a buffer
+};
+
+} // namespace ns3
+
+/****************************************************
+ *  Implementation of inline methods for performance
+ ****************************************************/
+
+namespace ns3
+{
+
+uint8_t*
+AsyncFileWriter::Reserve(uint32_t size)
+{
+    if (m_used + size > m_buffers[m_current].size())
+    {
+        Submit(size);
+    }
+    uint8_t* p = m_buffers[m_current].data() + m_used;
+    m_used += size;
+    return p;
+}
+
+} // namespace ns3
+
+#endif /* ASYNC_FILE_WRITER_H */
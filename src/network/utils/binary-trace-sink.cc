@@ -0,0 +1,107 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "binary-trace-sink.h"
+
+#include "ns3/log.h"
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("BinaryTraceSink");
+
+namespace
+{
+
+/// Magic bytes at the start of a binary trace file
+const char BINARY_TRACE_MAGIC[] = "NS3BTRC1";
+/// Byte-order mark of a binary trace file
+const uint32_t BINARY_TRACE_BYTE_ORDER = 0x01020304;
+/// Size of the buffers of a binary trace file
+const uint32_t BINARY_TRACE_BUFFER_SIZE = 256 * 1024;
+
+} // namespace
+
+BinaryTraceSink::BinaryTraceSink(const std::string& filename,
+                                 const std::string& header,
+                                 const std::string& terminator,
+                                 bool asynchronous,
+                                 AsyncFileWriter::Compression compression)
+    : m_writer(filename, BINARY_TRACE_BUFFER_SIZE, asynchronous, compression),
+      m_header(header),
+      m_terminator(terminator),
+      m_types(nullptr),
+      m_nFields(0)
+{
+    NS_LOG_FUNCTION(this << filename << asynchronous << compression);
+}
+
+BinaryTraceSink::~BinaryTraceSink()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+BinaryTraceSink::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_writer.Fail();
+}
+
+void
+BinaryTraceSink::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.Flush();
+}
+
+void
+BinaryTraceSink::WritePreamble(const uint8_t* types, uint8_t nFields)
+{
+    NS_LOG_FUNCTION(this << +nFields);
+    m_types = types;
+    m_nFields = nFields;
+    uint32_t magicSize = sizeof(BINARY_TRACE_MAGIC) - 1;
+    uint8_t* p = m_writer.Reserve(magicSize + sizeof(uint32_t));
+    std::memcpy(p, BINARY_TRACE_MAGIC, magicSize);
+    std::memcpy(p + magicSize, &BINARY_TRACE_BYTE_ORDER, sizeof(uint32_t));
+    p = m_writer.Reserve(GetFieldSize(m_header) + GetFieldSize(m_terminator) + 1 + nFields);
+    WriteField(p, m_header);
+    WriteField(p, m_terminator);
+    *p++ = nFields;
+    std::memcpy(p, types, nFields);
+}
+
+} // namespace ns3
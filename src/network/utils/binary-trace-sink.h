@@ -0,0 +1,254 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef BINARY_TRACE_SINK_H
+#define BINARY_TRACE_SINK_H
+
+#include "async-file-writer.h"
+
+#include "ns3/assert.h"
+#include "ns3/simple-ref-count.h"
+
+#include <cstring>
+#include <stdint.h>
+#include <string>
+#include <type_traits>
+
+namespace ns3
+{
+
+/**
+ * \ingroup network
+ *
+ * \brief Sink of binary trace records
+ *
+ * A BinaryTraceSink stores the records of a text trace file, such as the
+ * statistics files of the LTE module, without formatting them: each record
+ * is the sequence of its fields in their native representation, and the
+ * records are written in batches by an AsyncFileWriter, on a background
+ * thread, optionally compressed. The text file is produced later by the
+ * utils/binary-trace-to-text.py tool, which writes the header lines, then
+ * each record as its fields separated by tabs and followed by the record
+ * terminator, formatted like std::ostream formats them by default: integers
+ * in decimal, and floating-point values with 6 significant digits.
+ *
+ * All the records of a sink have the same fields, which are given to #Write:
+ * integers of 1 to 8 bytes (which are formatted in decimal, including
+ * uint8_t), floating-point values (stored as double) and std::string values,
+ * written as a length and the characters. The sink is reference counted,
+ * like OutputStreamWrapper, so that it can be bound to trace callbacks.
+ *
+ * The file starts with a preamble, written with the first record:
+ *   - the magic bytes "NS3BTRC1",
+ *   - the byte-order mark, a uint32_t of value 0x01020304 (the following
+ *     values are in this byte order),
+ *   - the header lines and the record terminator, each a uint32_t length
+ *     followed by the characters,
+ *   - the number of fields (uint8_t), and the FieldType of each field.
+ */
+class BinaryTraceSink : public SimpleRefCount<BinaryTraceSink>
+{
+  public:
+    /// Types of the record fields, in the preamble of the file
+    enum FieldType : uint8_t
+    {
+        UINT8 = 1, //!< uint8_t
+        UINT16,    //!< uint16_t
+        UINT32,    //!< uint32_t
+        UINT64,    //!< uint64_t
+        INT8,      //!< int8_t
+        INT16,     //!< int16_t
+        INT32,     //!< int32_t
+        INT64,     //!< int64_t
+        DOUBLE,    //!< double
+        STRING     //!< uint32_t length followed by the characters
+    };
+
+    /**
+     * Create a sink.
+     *
+     * \param filename The name of the file, which is truncated.
+     * \param header The header lines of the text file, with their line ends.
+     * \param terminator The characters after the last field of a record.
+     * \param asynchronous Whether the records are written by a background thread.
+     * \param compression The compression of the file.
+     */
+    BinaryTraceSink(const std::string& filename,
+                    const std::string& header,
+                    const std::string& terminator = "\n",
+                    bool asynchronous = true,
+                    AsyncFileWriter::Compression compression = AsyncFileWriter::NONE);
+    ~BinaryTraceSink();
+
+    /**
+     * \return true if the file could not be opened or written, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Write a record.
+     *
+     * \tparam Ts \deduced The types of the fields, the same for all the records.
+     * \param [in] values The fields.
+     */
+    template <typename... Ts>
+    void Write(const Ts&... values);
+
+    /**
+     * Write the buffered records to the file.
+     */
+    void Flush();
+
+  private:
+    /**
+     * \tparam T The type of a field.
+     * \returns The FieldType of the field.
+     */
+    template <typename T>
+    static constexpr uint8_t GetFieldType();
+    /**
+     * \param [in] value A field.
+     * \returns The number of bytes of the field.
+     */
+    template <typename T>
+    static uint32_t GetFieldSize(const T& value);
+    /**
+     * Copy a field.
+     *
+     * \param [in,out] p The position of the field, moved after the field.
+     * \param [in] value The field.
+     */
+    template <typename T>
+    static void WriteField(uint8_t*& p, const T& value);
+
+    /**
+     * Write the preamble of the file.
+     *
+     * \param types The types of the fields.
+     * \param nFields The number of fields.
+     */
+    void WritePreamble(const uint8_t* types, uint8_t nFields);
+
+    AsyncFileWriter m_writer; //!< Writer of the file
+    std::string m_header;     //!< Header lines
+    std::string m_terminator; //!< Characters after the last field of a record
+    const uint8_t* m_types;   //!< Types of the fields, once the preamble is written
+    uint8_t m_nFields;        //!< Number of fields
+};
+
+template <typename T>
+constexpr uint8_t
+BinaryTraceSink::GetFieldType()
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return STRING;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return DOUBLE;
+    }
+    else
+    {
+        static_assert(std::is_integral_v<T> && sizeof(T) <= 8, "Unsupported field type");
+        uint8_t type = std::is_signed_v<T> ? INT8 : UINT8;
+        return type + (sizeof(T) == 8 ? 3 : sizeof(T) / 2);
+    }
+}
+
+template <typename T>
+uint32_t
+BinaryTraceSink::GetFieldSize(const T& value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        return sizeof(uint32_t) + value.size();
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        return sizeof(double);
+    }
+    else
+    {
+        return sizeof(T);
+    }
+}
+
+template <typename T>
+void
+BinaryTraceSink::WriteField(uint8_t*& p, const T& value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        uint32_t size = value.size();
+        std::memcpy(p, &size, sizeof(size));
+        std::memcpy(p + sizeof(size), value.data(), size);
+        p += sizeof(size) + size;
+    }
+    else if constexpr (std::is_floating_point_v<T>)
+    {
+        double v = value;
+        std::memcpy(p, &v, sizeof(v));
+        p += sizeof(v);
+    }
+    else
+    {
+        std::memcpy(p, &value, sizeof(value));
+        p += sizeof(value);
+    }
+}
+
+template <typename... Ts>
+void
+BinaryTraceSink::Write(const Ts&... values)
+{
+    static const uint8_t types[] = {GetFieldType<Ts>()...};
+    if (m_types != types)
+    {
+        if (m_types == nullptr)
+        {
+            WritePreamble(types, sizeof...(Ts));
+        }
+        NS_ASSERT_MSG(m_nFields == sizeof...(Ts) &&
+                          std::memcmp(m_types, types, sizeof...(Ts)) == 0,
+                      "The fields of the records of a BinaryTraceSink must not change");
+    }
+    uint8_t* p = m_writer.Reserve((GetFieldSize(values) + ...));
+    (WriteField(p, values), ...);
+}
+
+} // namespace ns3
+
+#endif /* BINARY_TRACE_SINK_H */
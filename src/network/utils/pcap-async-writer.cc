@@ -0,0 +1,301 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "pcap-async-writer.h"
+
+#include "ns3/buffer.h"
+#include "ns3/header.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+
+#include <algorithm>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("PcapAsyncWriter");
+
+namespace
+{
+
+const uint32_t PCAP_MAGIC = 0xa1b2c3d4;    //!< Magic number of the pcap format
+const uint32_t PCAP_NS_MAGIC = 0xa1b23c4d; //!< Magic number of the nanosecond pcap format
+const uint32_t PCAPNG_SHB = 0x0a0d0d0a;    //!< Block type of a pcapng Section Header Block
+const uint32_t PCAPNG_IDB = 0x00000001;    //!< Block type of a pcapng Interface Description Block
+const uint32_t PCAPNG_EPB = 0x00000006;    //!< Block type of a pcapng Enhanced Packet Block
+const uint32_t PCAPNG_BYTE_ORDER = 0x1a2b3c4d; //!< Byte-order magic of the pcapng sections
+const uint16_t PCAPNG_IF_TSRESOL = 9;          //!< Timestamp resolution option of an IDB
+
+const uint32_t PCAP_FILE_HEADER_SIZE = 24;   //!< Size of the pcap file header
+const uint32_t PCAP_RECORD_HEADER_SIZE = 16; //!< Size of a pcap record header
+const uint32_t PCAPNG_SHB_SIZE = 28;         //!< Size of the Section Header Block
+const uint32_t PCAPNG_IDB_SIZE = 32;         //!< Size of the Interface Description Block
+const uint32_t PCAPNG_EPB_SIZE = 32;         //!< Size of an EPB without the packet data
+
+/**
+ * Write a 16-bit value in little-endian byte order.
+ * \param p The position of the value.
+ * \param value The value.
+ * \returns The position after the value.
+ */
+uint8_t*
+WriteU16(uint8_t* p, uint16_t value)
+{
+    p[0] = value & 0xff;
+    p[1] = (value >> 8) & 0xff;
+    return p + 2;
+}
+
+/**
+ * Write a 32-bit value in little-endian byte order.
+ * \param p The position of the value.
+ * \param value The value.
+ * \returns The position after the value.
+ */
+uint8_t*
+WriteU32(uint8_t* p, uint32_t value)
+{
+    p = WriteU16(p, value & 0xffff);
+    return WriteU16(p, value >> 16);
+}
+
+} // namespace
+
+PcapAsyncWriter::PcapAsyncWriter(const std::string& filename,
+                                 uint32_t bufferSize,
+                                 bool asynchronous)
+    : m_writer(filename, bufferSize, asynchronous),
+      m_format(PCAP),
+      m_dataLinkType(0),
+      m_snapLen(0),
+      m_tzCorrection(0),
+      m_nanosecMode(false)
+{
+    NS_LOG_FUNCTION(this << filename << bufferSize << asynchronous);
+}
+
+PcapAsyncWriter::~PcapAsyncWriter()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+bool
+PcapAsyncWriter::Fail() const
+{
+    NS_LOG_FUNCTION(this);
+    return m_writer.Fail();
+}
+
+void
+PcapAsyncWriter::Init(Format format,
+                      uint32_t dataLinkType,
+                      uint32_t snapLen,
+                      int32_t tzCorrection,
+                      bool nanosecMode)
+{
+    NS_LOG_FUNCTION(this << format << dataLinkType << snapLen << tzCorrection << nanosecMode);
+    m_format = format;
+    m_dataLinkType = dataLinkType;
+    m_snapLen = snapLen;
+    m_tzCorrection = tzCorrection;
+    m_nanosecMode = nanosecMode;
+
+    if (m_format == PCAP)
+    {
+        uint8_t* p = m_writer.Reserve(PCAP_FILE_HEADER_SIZE);
+        p = WriteU32(p, m_nanosecMode ? PCAP_NS_MAGIC : PCAP_MAGIC);
+        p = WriteU16(p, GetVersionMajor());
+        p = WriteU16(p, GetVersionMinor());
+        p = WriteU32(p, m_tzCorrection);
+        p = WriteU32(p, 0); // sigfigs
+        p = WriteU32(p, m_snapLen);
+        WriteU32(p, m_dataLinkType);
+        return;
+    }
+
+    uint8_t* p = m_writer.Reserve(PCAPNG_SHB_SIZE + PCAPNG_IDB_SIZE);
+    p = WriteU32(p, PCAPNG_SHB);
+    p = WriteU32(p, PCAPNG_SHB_SIZE);
+    p = WriteU32(p, PCAPNG_BYTE_ORDER);
+    p = WriteU16(p, GetVersionMajor());
+    p = WriteU16(p, GetVersionMinor());
+    p = WriteU32(p, 0xffffffff); // unknown section length, on 64 bits
+    p = WriteU32(p, 0xffffffff);
+    p = WriteU32(p, PCAPNG_SHB_SIZE);
+
+    p = WriteU32(p, PCAPNG_IDB);
+    p = WriteU32(p, PCAPNG_IDB_SIZE);
+    p = WriteU16(p, m_dataLinkType);
+    p = WriteU16(p, 0); // reserved
+    p = WriteU32(p, m_snapLen);
+    p = WriteU16(p, PCAPNG_IF_TSRESOL);
+    p = WriteU16(p, 1);
+    p = WriteU32(p, m_nanosecMode ? 9 : 6); // power of ten, padded to 32 bits
+    p = WriteU32(p, 0);                     // end of the options
+    WriteU32(p, PCAPNG_IDB_SIZE);
+}
+
+uint8_t*
+PcapAsyncWriter::BeginRecord(uint32_t tsSec,
+                             uint32_t tsSubsec,
+                             uint32_t totalLen,
+                             uint32_t& inclLen)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsSubsec << totalLen);
+    inclLen = std::min(totalLen, m_snapLen);
+
+    if (m_format == PCAP)
+    {
+        uint8_t* p = m_writer.Reserve(PCAP_RECORD_HEADER_SIZE + inclLen);
+        p = WriteU32(p, tsSec);
+        p = WriteU32(p, tsSubsec);
+        p = WriteU32(p, inclLen);
+        return WriteU32(p, totalLen);
+    }
+
+    uint32_t padded = (inclLen + 3) & ~3U;
+    uint32_t blockSize = PCAPNG_EPB_SIZE + padded;
+    uint64_t timestamp = tsSec * (m_nanosecMode ? 1000000000ULL : 1000000ULL) + tsSubsec;
+    uint8_t* p = m_writer.Reserve(blockSize);
+    p = WriteU32(p, PCAPNG_EPB);
+    p = WriteU32(p, blockSize);
+    p = WriteU32(p, 0); // interface
+    p = WriteU32(p, timestamp >> 32);
+    p = WriteU32(p, timestamp & 0xffffffff);
+    p = WriteU32(p, inclLen);
+    p = WriteU32(p, totalLen);
+    std::fill(p + inclLen, p + padded, 0);
+    WriteU32(p + padded, blockSize);
+    return p;
+}
+
+void
+PcapAsyncWriter::Write(uint32_t tsSec, uint32_t tsSubsec, const uint8_t* data, uint32_t totalLen)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsSubsec << &data << totalLen);
+    uint32_t inclLen;
+    uint8_t* p = BeginRecord(tsSec, tsSubsec, totalLen, inclLen);
+    std::copy(data, data + inclLen, p);
+}
+
+void
+PcapAsyncWriter::Write(uint32_t tsSec, uint32_t tsSubsec, Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsSubsec << p);
+    uint32_t inclLen;
+    uint8_t* data = BeginRecord(tsSec, tsSubsec, p->GetSize(), inclLen);
+    p->CopyData(data, inclLen);
+}
+
+void
+PcapAsyncWriter::Write(uint32_t tsSec,
+                       uint32_t tsSubsec,
+                       const Header& header,
+                       Ptr<const Packet> p)
+{
+    NS_LOG_FUNCTION(this << tsSec << tsSubsec << &header << p);
+    uint32_t headerSize = header.GetSerializedSize();
+    uint32_t inclLen;
+    uint8_t* data = BeginRecord(tsSec, tsSubsec, headerSize + p->GetSize(), inclLen);
+
+    Buffer headerBuffer;
+    headerBuffer.AddAtStart(headerSize);
+    header.Serialize(headerBuffer.Begin());
+    uint32_t toCopy = std::min(headerSize, inclLen);
+    headerBuffer.CopyData(data, toCopy);
+    p->CopyData(data + toCopy, inclLen - toCopy);
+}
+
+void
+PcapAsyncWriter::Flush()
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.Flush();
+}
+
+void
+PcapAsyncWriter::Close()
+{
+    NS_LOG_FUNCTION(this);
+    m_writer.Close();
+}
+
+uint32_t
+PcapAsyncWriter::GetMagic() const
+{
+    if (m_format == PCAPNG)
+    {
+        return PCAPNG_SHB;
+    }
+    return m_nanosecMode ? PCAP_NS_MAGIC : PCAP_MAGIC;
+}
+
+uint16_t
+PcapAsyncWriter::GetVersionMajor() const
+{
+    return m_format == PCAPNG ? 1 : 2;
+}
+
+uint16_t
+PcapAsyncWriter::GetVersionMinor() const
+{
+    return m_format == PCAPNG ? 0 : 4;
+}
+
+int32_t
+PcapAsyncWriter::GetTimeZoneOffset() const
+{
+    return m_tzCorrection;
+}
+
+uint32_t
+PcapAsyncWriter::GetSnapLen() const
+{
+    return m_snapLen;
+}
+
+uint32_t
+PcapAsyncWriter::GetDataLinkType() const
+{
+    return m_dataLinkType;
+}
+
+bool
+PcapAsyncWriter::IsNanoSecMode() const
+{
+    return m_nanosecMode;
+}
+
+} // namespace ns3
@@ -0,0 +1,194 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef PCAP_ASYNC_WRITER_H
+#define PCAP_ASYNC_WRITER_H
+
+#include "async-file-writer.h"
+
+#include "ns3/ptr.h"
+
+#include <stdint.h>
+#include <string>
+
+namespace ns3
+{
+
+class Header;
+class Packet;
+
+/**
+ * \ingroup network
+ *
+ * \brief Buffered writer of a pcap or pcapng file
+ *
+ * The records are copied, truncated to the snapshot length, into the
+ * memory buffers of an AsyncFileWriter, which writes them in batches,
+ * on a background thread in the asynchronous mode.
+ *
+ * The pcap files are identical to the files written by PcapFile, in the
+ * little-endian byte order. The pcapng files contain a Section Header
+ * Block, an Interface Description Block with the data link type, the
+ * snapshot length and the timestamp resolution, and an Enhanced Packet
+ * Block per packet.
+ *
+ * This class is used by PcapFileWrapper, see its "Asynchronous" and "Format"
+ * attributes; it only writes files.
+ */
+class PcapAsyncWriter
+{
+  public:
+    /// File formats
+    enum Format
+    {
+        PCAP,  //!< libpcap format
+        PCAPNG //!< pcapng format, with a single interface
+    };
+
+    /**
+     * Create a writer.
+     *
+     * \param filename The name of the file, which is truncated.
+     * \param bufferSize The size of each buffer, in bytes.
+     * \param asynchronous Whether the buffers are written by the background thread.
+     */
+    PcapAsyncWriter(const std::string& filename, uint32_t bufferSize, bool asynchronous);
+    /**
+     * Write the records left in the buffers and close the file.
+     */
+    ~PcapAsyncWriter();
+
+    // Delete copy constructor and assignment operator to avoid misuse
+    PcapAsyncWriter(const PcapAsyncWriter&) = delete;
+    PcapAsyncWriter& operator=(const PcapAsyncWriter&) = delete;
+
+    /**
+     * \return true if the file could not be opened or written, false otherwise.
+     */
+    bool Fail() const;
+
+    /**
+     * Write the header of the file.
+     *
+     * \param format The format of the file.
+     * \param dataLinkType The data link type, as defined in the pcap library.
+     * \param snapLen The maximum number of bytes written per packet.
+     * \param tzCorrection The time zone offset of the pcap file header, not
+     *        written to pcapng files.
+     * \param nanosecMode Whether the timestamps are in nanoseconds instead of
+     *        microseconds.
+     */
+    void Init(Format format,
+              uint32_t dataLinkType,
+              uint32_t snapLen,
+              int32_t tzCorrection,
+              bool nanosecMode);
+
+    /**
+     * Write a packet given as a data buffer.
+     *
+     * \param tsSec The seconds of the timestamp.
+     * \param tsSubsec The microseconds or nanoseconds of the timestamp.
+     * \param data The data buffer.
+     * \param totalLen The size of the data buffer.
+     */
+    void Write(uint32_t tsSec, uint32_t tsSubsec, const uint8_t* data, uint32_t totalLen);
+    /**
+     * Write a packet.
+     *
+     * \param tsSec The seconds of the timestamp.
+     * \param tsSubsec The microseconds or nanoseconds of the timestamp.
+     * \param p The packet.
+     */
+    void Write(uint32_t tsSec, uint32_t tsSubsec, Ptr<const Packet> p);
+    /**
+     * Write a header followed by a packet.
+     *
+     * \param tsSec The seconds of the timestamp.
+     * \param tsSubsec The microseconds or nanoseconds of the timestamp.
+     * \param header The header.
+     * \param p The packet.
+     */
+    void Write(uint32_t tsSec, uint32_t tsSubsec, const Header& header, Ptr<const Packet> p);
+
+    /**
+     * Write the records in the buffers to the file, and wait until they are
+     * written.
+     */
+    void Flush();
+    /**
+     * Flush the buffers and close the file.
+     */
+    void Close();
+
+    /// \return the magic number of the file header
+    uint32_t GetMagic() const;
+    /// \return the major version of the file format
+    uint16_t GetVersionMajor() const;
+    /// \return the minor version of the file format
+    uint16_t GetVersionMinor() const;
+    /// \return the time zone offset of the file header
+    int32_t GetTimeZoneOffset() const;
+    /// \return the snapshot length
+    uint32_t GetSnapLen() const;
+    /// \return the data link type
+    uint32_t GetDataLinkType() const;
+    /// \return true if the timestamps are in nanoseconds
+    bool IsNanoSecMode() const;
+
+  private:
+    /**
+     * Reserve the room of a record in the buffers, and write the record
+     * fields.
+     *
+     * \param tsSec The seconds of the timestamp.
+     * \param tsSubsec The microseconds or nanoseconds of the timestamp.
+     * \param totalLen The size of the packet.
+     * \param [out] inclLen The number of bytes of the packet to copy.
+     * \returns The position at which the inclLen bytes of the packet are copied.
+     */
+    uint8_t* BeginRecord(uint32_t tsSec, uint32_t tsSubsec, uint32_t totalLen, uint32_t& inclLen);
+
+    AsyncFileWriter m_writer; //!< Writer of the file
+    Format m_format;          //!< Format of the file
+    uint32_t m_dataLinkType;  //!< Data link type
+    uint32_t m_snapLen;       //!< Snapshot length
+    int32_t m_tzCorrection;   //!< Time zone offset
+    bool m_nanosecMode;       //!< Whether the timestamps are in nanoseconds
+};
+
+} // namespace ns3
+
+#endif /* PCAP_ASYNC_WRITER_H */
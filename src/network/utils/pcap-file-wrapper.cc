@@ -17,8 +17,10 @@
 
 #include "pcap-file-wrapper.h"
 
+#include "ns3/abort.h"
 #include "ns3/boolean.h"
 #include "ns3/buffer.h"
+#include "ns3/enum.h"
 #include "ns3/header.h"
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
@@ -48,11 +50,39 @@ PcapFileWrapper::GetTypeId()
                           "microseconds(default).",
                           BooleanValue(false),
                           MakeBooleanAccessor(&PcapFileWrapper::m_nanosecMode),
-                          MakeBooleanChecker());
+                          MakeBooleanChecker())
+            .AddAttribute("Asynchronous",
+                          "Whether the packets of the new files are copied to memory buffers, "
+                          "which are written in batches by a background thread.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&PcapFileWrapper::m_asynchronous),
+                          MakeBooleanChecker())
+            .AddAttribute("BufferSize",
+                          "Size, in bytes, of each memory buffer of a file written in the "
+                          "asynchronous mode or in the pcapng format.",
+                          UintegerValue(256 * 1024),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                          MakeUintegerChecker<uint32_t>(1024))
+            .AddAttribute("Format",
+                          "Format of the new files. The pcapng files are written through "
+                          "memory buffers, like in the asynchronous mode.",
+                          EnumValue(PcapAsyncWriter::PCAP),
+                          MakeEnumAccessor(&PcapFileWrapper::m_format),
+                          MakeEnumChecker(PcapAsyncWriter::PCAP,
+                                          "PCAP",
+                                          PcapAsyncWriter::PCAPNG,
+                                          "PCAPNG"))
+            .AddAttribute("SamplingInterval",
+                          "Write one packet out of this number of packets given to the file "
+                          "(1 writes all the packets).",
+                          UintegerValue(1),
+                          MakeUintegerAccessor(&PcapFileWrapper::m_samplingInterval),
+                          MakeUintegerChecker<uint32_t>(1));
     return tid;
 }
 
 PcapFileWrapper::PcapFileWrapper()
+    : m_packets(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -67,6 +97,10 @@ bool
 PcapFileWrapper::Fail() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->Fail();
+    }
     return m_file.Fail();
 }
 
@@ -74,6 +108,10 @@ bool
 PcapFileWrapper::Eof() const
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return false;
+    }
     return m_file.Eof();
 }
 
@@ -88,6 +126,11 @@ void
 PcapFileWrapper::Close()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        m_writer->Close();
+        return;
+    }
     m_file.Close();
 }
 
@@ -95,6 +138,16 @@ void
 PcapFileWrapper::Open(const std::string& filename, std::ios::openmode mode)
 {
     NS_LOG_FUNCTION(this << filename << mode);
+    m_writer.reset();
+    m_packets = 0;
+    bool newFile = (mode & std::ios::out) && !(mode & (std::ios::in | std::ios::app));
+    NS_ABORT_MSG_IF(m_format == PcapAsyncWriter::PCAPNG && !newFile,
+                    "The pcapng format is only supported to write new files");
+    if (newFile && (m_asynchronous || m_format == PcapAsyncWriter::PCAPNG))
+    {
+        m_writer = std::make_unique<PcapAsyncWriter>(filename, m_bufferSize, m_asynchronous);
+        return;
+    }
     m_file.Open(filename, mode);
 }
 
@@ -107,13 +160,40 @@ PcapFileWrapper::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t tzCorrect
     // a snaplen, we use the one provided.
     //
     NS_LOG_FUNCTION(this << dataLinkType << snapLen << tzCorrection);
-    if (snapLen != std::numeric_limits<uint32_t>::max())
+    if (snapLen == std::numeric_limits<uint32_t>::max())
+    {
+        snapLen = m_snapLen;
+    }
+    if (m_writer)
+    {
+        m_writer->Init(m_format, dataLinkType, snapLen, tzCorrection, m_nanosecMode);
+    }
+    else
     {
         m_file.Init(dataLinkType, snapLen, tzCorrection, false, m_nanosecMode);
     }
+}
+
+bool
+PcapFileWrapper::IsSampled()
+{
+    return m_packets++ % m_samplingInterval == 0;
+}
+
+void
+PcapFileWrapper::SplitTime(Time t, uint32_t& s, uint32_t& subsec) const
+{
+    if (m_writer->IsNanoSecMode())
+    {
+        uint64_t current = t.GetNanoSeconds();
+        s = current / 1000000000;
+        subsec = current % 1000000000;
+    }
     else
     {
-        m_file.Init(dataLinkType, m_snapLen, tzCorrection, false, m_nanosecMode);
+        uint64_t current = t.GetMicroSeconds();
+        s = current / 1000000;
+        subsec = current % 1000000;
     }
 }
 
@@ -121,6 +201,18 @@ void
 PcapFileWrapper::Write(Time t, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << p);
+    if (!IsSampled())
+    {
+        return;
+    }
+    if (m_writer)
+    {
+        uint32_t s;
+        uint32_t subsec;
+        SplitTime(t, s, subsec);
+        m_writer->Write(s, subsec, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -141,6 +233,18 @@ void
 PcapFileWrapper::Write(Time t, const Header& header, Ptr<const Packet> p)
 {
     NS_LOG_FUNCTION(this << t << &header << p);
+    if (!IsSampled())
+    {
+        return;
+    }
+    if (m_writer)
+    {
+        uint32_t s;
+        uint32_t subsec;
+        SplitTime(t, s, subsec);
+        m_writer->Write(s, subsec, header, p);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -161,6 +265,18 @@ void
 PcapFileWrapper::Write(Time t, const uint8_t* buffer, uint32_t length)
 {
     NS_LOG_FUNCTION(this << t << &buffer << length);
+    if (!IsSampled())
+    {
+        return;
+    }
+    if (m_writer)
+    {
+        uint32_t s;
+        uint32_t subsec;
+        SplitTime(t, s, subsec);
+        m_writer->Write(s, subsec, buffer, length);
+        return;
+    }
     if (m_file.IsNanoSecMode())
     {
         uint64_t current = t.GetNanoSeconds();
@@ -188,6 +304,8 @@ PcapFileWrapper::Read(Time& t)
 
     uint8_t datbuf[65536];
 
+    NS_ABORT_MSG_IF(m_writer, "Files written through memory buffers cannot be read");
+
     m_file.Read(datbuf, 65536, tsSec, tsUsec, inclLen, origLen, readLen);
 
     if (m_file.Fail())
@@ -211,6 +329,10 @@ uint32_t
 PcapFileWrapper::GetMagic()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetMagic();
+    }
     return m_file.GetMagic();
 }
 
@@ -218,6 +340,10 @@ uint16_t
 PcapFileWrapper::GetVersionMajor()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetVersionMajor();
+    }
     return m_file.GetVersionMajor();
 }
 
@@ -225,6 +351,10 @@ uint16_t
 PcapFileWrapper::GetVersionMinor()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetVersionMinor();
+    }
     return m_file.GetVersionMinor();
 }
 
@@ -232,6 +362,10 @@ int32_t
 PcapFileWrapper::GetTimeZoneOffset()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetTimeZoneOffset();
+    }
     return m_file.GetTimeZoneOffset();
 }
 
@@ -239,6 +373,10 @@ uint32_t
 PcapFileWrapper::GetSigFigs()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return 0;
+    }
     return m_file.GetSigFigs();
 }
 
@@ -246,6 +384,10 @@ uint32_t
 PcapFileWrapper::GetSnapLen()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetSnapLen();
+    }
     return m_file.GetSnapLen();
 }
 
@@ -253,6 +395,10 @@ uint32_t
 PcapFileWrapper::GetDataLinkType()
 {
     NS_LOG_FUNCTION(this);
+    if (m_writer)
+    {
+        return m_writer->GetDataLinkType();
+    }
     return m_file.GetDataLinkType();
 }
 
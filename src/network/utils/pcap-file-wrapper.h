@@ -18,6 +18,7 @@
 #ifndef PCAP_FILE_WRAPPER_H
 #define PCAP_FILE_WRAPPER_H
 
+#include "pcap-async-writer.h"
 #include "pcap-file.h"
 
 #include "ns3/nstime.h"
@@ -28,6 +29,7 @@
 #include <cstring>
 #include <fstream>
 #include <limits>
+#include <memory>
 
 namespace ns3
 {
@@ -37,6 +39,13 @@ namespace ns3
  * ns-3 interface to the low-level public methods of PcapFile.  Users are
  * encouraged to use this object instead of class ns3::PcapFile in ns-3
  * public APIs.
+ *
+ * The "Asynchronous" and "Format" attributes select how the new files are
+ * written: when the asynchronous mode or the pcapng format is enabled, the
+ * packets are copied to memory buffers by a PcapAsyncWriter, which writes
+ * them in batches, on a background thread in the asynchronous mode. The
+ * "SamplingInterval" attribute writes only one packet out of every N given
+ * to Write, e.g., to reduce the size of the traces of many devices.
  */
 class PcapFileWrapper : public Object
 {
@@ -222,9 +231,30 @@ class PcapFileWrapper : public Object
     uint32_t GetDataLinkType();
 
   private:
-    PcapFile m_file;    //!< Pcap file
-    uint32_t m_snapLen; //!< max length of saved packets
-    bool m_nanosecMode; //!< Timestamps in nanosecond mode
+    /**
+     * Count a packet given to Write, and check whether it is written.
+     *
+     * \returns true if the packet is written, false if it is skipped.
+     */
+    bool IsSampled();
+    /**
+     * Split a packet timestamp in the units of the file.
+     *
+     * \param t Packet timestamp as ns3::Time.
+     * \param [out] s The seconds.
+     * \param [out] subsec The microseconds or nanoseconds.
+     */
+    void SplitTime(Time t, uint32_t& s, uint32_t& subsec) const;
+
+    PcapFile m_file;                           //!< Pcap file
+    std::unique_ptr<PcapAsyncWriter> m_writer; //!< Buffered writer of the file, if enabled
+    uint32_t m_snapLen;                        //!< max length of saved packets
+    bool m_nanosecMode;                        //!< Timestamps in nanosecond mode
+    bool m_asynchronous;                       //!< Write the file on a background thread
+    uint32_t m_bufferSize;                     //!< Size of the buffers of the writer
+    PcapAsyncWriter::Format m_format;          //!< Format of the new files
+    uint32_t m_samplingInterval;               //!< Write one packet out of this number
+    uint32_t m_packets;                        //!< Number of packets given to Write
 };
 
 } // namespace ns3
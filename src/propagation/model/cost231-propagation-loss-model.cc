@@ -183,6 +183,35 @@ Cost231PropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + GetLoss(a, b);
 }
 
+void
+Cost231PropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                                const std::vector<Ptr<MobilityModel>>& receivers,
+                                                std::vector<double>& powersDbm) const
+{
+    // same computation as GetLoss, with the terms independent of the distance evaluated once
+    Vector aPosition = a->GetPosition();
+    double logFrequencyMhz = std::log10(m_frequency * 1e-6);
+    double logBSAntennaHeight = std::log10(m_BSAntennaHeight);
+
+    double C_H =
+        0.8 + ((1.11 * logFrequencyMhz) - 0.7) * m_SSAntennaHeight - (1.56 * logFrequencyMhz);
+    double constantLoss = 46.3 + (33.9 * logFrequencyMhz) - (13.82 * logBSAntennaHeight) - C_H;
+    double distanceFactor = 44.9 - 6.55 * logBSAntennaHeight;
+
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        double distance = CalculateDistance(aPosition, receivers[i]->GetPosition());
+        if (distance <= m_minDistance)
+        {
+            continue;
+        }
+        double logDistanceKm = std::log10(distance * 1e-3);
+        double loss_in_db = constantLoss + (distanceFactor * logDistanceKm) + m_shadowing;
+        NS_LOG_DEBUG("dist =" << distance << ", Path Loss = " << loss_in_db);
+        powersDbm[i] += (0 - loss_in_db);
+    }
+}
+
 int64_t
 Cost231PropagationLossModel::DoAssignStreams(int64_t stream)
 {
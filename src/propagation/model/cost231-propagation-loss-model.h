@@ -132,6 +132,9 @@ class Cost231PropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& receivers,
+                            std::vector<double>& powersDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     double m_BSAntennaHeight; //!< BS Antenna Height [m]
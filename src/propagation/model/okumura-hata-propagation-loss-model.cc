@@ -79,15 +79,20 @@ OkumuraHataPropagationLossModel::~OkumuraHataPropagationLossModel()
 double
 OkumuraHataPropagationLossModel::GetLoss(Ptr<MobilityModel> a, Ptr<MobilityModel> b) const
 {
-    double loss = 0.0;
     double fmhz = m_frequency / 1e6;
-    double log_fMhz = std::log10(fmhz);
+    return GetLoss(a->GetPosition(), b->GetPosition(), fmhz, std::log10(fmhz));
+}
+
+double
+OkumuraHataPropagationLossModel::GetLoss(const Vector& aPosition,
+                                         const Vector& bPosition,
+                                         double fmhz,
+                                         double log_fMhz) const
+{
+    double loss = 0.0;
     // In the Okumura Hata literature, the distance is expressed in units of kilometers
     // but other lengths are expressed in meters
-    double distKm = a->GetDistanceFrom(b) / 1000.0;
-
-    Vector aPosition = a->GetPosition();
-    Vector bPosition = b->GetPosition();
+    double distKm = CalculateDistance(aPosition, bPosition) / 1000.0;
 
     double hb = std::max(aPosition.z, bPosition.z);
     double hm = std::min(aPosition.z, bPosition.z);
@@ -164,6 +169,21 @@ OkumuraHataPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return (txPowerDbm - GetLoss(a, b));
 }
 
+void
+OkumuraHataPropagationLossModel::DoCalcRxPowerBatch(
+    Ptr<MobilityModel> a,
+    const std::vector<Ptr<MobilityModel>>& receivers,
+    std::vector<double>& powersDbm) const
+{
+    Vector aPosition = a->GetPosition();
+    double fmhz = m_frequency / 1e6;
+    double log_fMhz = std::log10(fmhz);
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        powersDbm[i] -= GetLoss(aPosition, receivers[i]->GetPosition(), fmhz, log_fMhz);
+    }
+}
+
 int64_t
 OkumuraHataPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -25,6 +25,8 @@
 #include "propagation-environment.h"
 #include "propagation-loss-model.h"
 
+#include "ns3/vector.h"
+
 namespace ns3
 {
 
@@ -68,6 +70,22 @@ class OkumuraHataPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& receivers,
+                            std::vector<double>& powersDbm) const override;
+
+    /**
+     * \param aPosition the position of the first node
+     * \param bPosition the position of the second node
+     * \param fmhz the frequency in MHz
+     * \param log_fMhz the decimal logarithm of the frequency in MHz
+     *
+     * \return the loss in dBm for the propagation between the two given positions
+     */
+    double GetLoss(const Vector& aPosition,
+                   const Vector& bPosition,
+                   double fmhz,
+                   double log_fMhz) const;
     int64_t DoAssignStreams(int64_t stream) override;
 
     EnvironmentType m_environment; //!< Environment Scenario
@@ -82,6 +82,31 @@ PropagationLossModel::CalcRxPower(double txPowerDbm,
     return self;
 }
 
+void
+PropagationLossModel::CalcRxPowerBatch(double txPowerDbm,
+                                       Ptr<MobilityModel> a,
+                                       const std::vector<Ptr<MobilityModel>>& receivers,
+                                       std::vector<double>& rxPowersDbm) const
+{
+    rxPowersDbm.assign(receivers.size(), txPowerDbm);
+    for (const PropagationLossModel* model = this; model != nullptr;
+         model = PeekPointer(model->m_next))
+    {
+        model->DoCalcRxPowerBatch(a, receivers, rxPowersDbm);
+    }
+}
+
+void
+PropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                         const std::vector<Ptr<MobilityModel>>& receivers,
+                                         std::vector<double>& powersDbm) const
+{
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        powersDbm[i] = DoCalcRxPower(powersDbm[i], a, receivers[i]);
+    }
+}
+
 int64_t
 PropagationLossModel::AssignStreams(int64_t stream)
 {
@@ -281,6 +306,34 @@ FriisPropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm - std::max(lossDb, m_minLoss);
 }
 
+void
+FriisPropagationLossModel::DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                              const std::vector<Ptr<MobilityModel>>& receivers,
+                                              std::vector<double>& powersDbm) const
+{
+    // same computation as DoCalcRxPower, with the constant terms evaluated once
+    Vector aPosition = a->GetPosition();
+    double numerator = m_lambda * m_lambda;
+    double factor = 16 * M_PI * M_PI;
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        double distance = CalculateDistance(aPosition, receivers[i]->GetPosition());
+        if (distance < 3 * m_lambda)
+        {
+            NS_LOG_WARN(
+                "distance not within the far field region => inaccurate propagation loss value");
+        }
+        if (distance <= 0)
+        {
+            powersDbm[i] -= m_minLoss;
+            continue;
+        }
+        double denominator = factor * distance * distance * m_systemLoss;
+        double lossDb = -10 * log10(numerator / denominator);
+        powersDbm[i] -= std::max(lossDb, m_minLoss);
+    }
+}
+
 int64_t
 FriisPropagationLossModel::DoAssignStreams(int64_t stream)
 {
@@ -554,6 +607,28 @@ LogDistancePropagationLossModel::DoCalcRxPower(double txPowerDbm,
     return txPowerDbm + rxc;
 }
 
+void
+LogDistancePropagationLossModel::DoCalcRxPowerBatch(
+    Ptr<MobilityModel> a,
+    const std::vector<Ptr<MobilityModel>>& receivers,
+    std::vector<double>& powersDbm) const
+{
+    // same computation as DoCalcRxPower, with the constant terms evaluated once
+    Vector aPosition = a->GetPosition();
+    double factor = 10 * m_exponent;
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        double distance = CalculateDistance(aPosition, receivers[i]->GetPosition());
+        if (distance <= m_referenceDistance)
+        {
+            powersDbm[i] -= m_referenceLoss;
+            continue;
+        }
+        double pathLossDb = factor * std::log10(distance / m_referenceDistance);
+        powersDbm[i] += -m_referenceLoss - pathLossDb;
+    }
+}
+
 int64_t
 LogDistancePropagationLossModel::DoAssignStreams(int64_t stream)
 {
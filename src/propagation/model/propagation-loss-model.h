@@ -28,6 +28,7 @@
 #include "ns3/random-variable-stream.h"
 
 #include <map>
+#include <vector>
 
 namespace ns3
 {
@@ -101,6 +102,25 @@ class PropagationLossModel : public Object
      */
     double CalcRxPower(double txPowerDbm, Ptr<MobilityModel> a, Ptr<MobilityModel> b) const;
 
+    /**
+     * Returns the Rx Power at several receivers of the same transmission, taking
+     * into account all the PropagationLossModel(s) chained to the current one.
+     *
+     * The result is the same as calling CalcRxPower for each receiver in order,
+     * but each model of the chain processes all the receivers at once, so that
+     * it can compute the terms depending only on the transmitter once.
+     *
+     * \param txPowerDbm current transmission power (in dBm)
+     * \param a the mobility model of the source
+     * \param receivers the mobility models of the destinations
+     * \param rxPowersDbm the reception power at each destination (in dBm), resized to the
+     *        number of destinations
+     */
+    void CalcRxPowerBatch(double txPowerDbm,
+                          Ptr<MobilityModel> a,
+                          const std::vector<Ptr<MobilityModel>>& receivers,
+                          std::vector<double>& rxPowersDbm) const;
+
     /**
      * If this loss model uses objects of type RandomVariableStream,
      * set the stream numbers to the integers starting with the offset
@@ -139,6 +159,23 @@ class PropagationLossModel : public Object
                                  Ptr<MobilityModel> a,
                                  Ptr<MobilityModel> b) const = 0;
 
+    /**
+     * Apply the propagation loss of this model to several receivers of the same
+     * transmission.
+     *
+     * The default implementation calls DoCalcRxPower for each receiver in order;
+     * subclasses can override it to compute the terms depending only on the
+     * transmitter once. Random variables must be drawn in the receiver order.
+     *
+     * \param a the mobility model of the source
+     * \param receivers the mobility models of the destinations
+     * \param powersDbm on input, the power sent to each destination; on output,
+     *        the power received by each destination (in dBm)
+     */
+    virtual void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                                    const std::vector<Ptr<MobilityModel>>& receivers,
+                                    std::vector<double>& powersDbm) const;
+
     Ptr<PropagationLossModel> m_next; //!< Next propagation loss model in the list
 };
 
@@ -303,6 +340,9 @@ class FriisPropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& receivers,
+                            std::vector<double>& powersDbm) const override;
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -491,6 +531,9 @@ class LogDistancePropagationLossModel : public PropagationLossModel
     double DoCalcRxPower(double txPowerDbm,
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& receivers,
+                            std::vector<double>& powersDbm) const override;
 
     int64_t DoAssignStreams(int64_t stream) override;
 
@@ -100,6 +100,35 @@ class ThreeGppPropagationLossModel : public PropagationLossModel
                          Ptr<MobilityModel> a,
                          Ptr<MobilityModel> b) const override;
 
+    /**
+     * Computes the received power at several receivers, fetching the position
+     * of the transmitter once and the position of each receiver once
+     *
+     * \param a tx mobility model
+     * \param receivers rx mobility models
+     * \param powersDbm on input the tx power, on output the rx power of each receiver in dBm
+     */
+    void DoCalcRxPowerBatch(Ptr<MobilityModel> a,
+                            const std::vector<Ptr<MobilityModel>>& receivers,
+                            std::vector<double>& powersDbm) const override;
+
+    /**
+     * Computes the received power as DoCalcRxPower, given the current
+     * positions of a and b
+     *
+     * \param txPowerDbm tx power in dBm
+     * \param a tx mobility model
+     * \param b rx mobility model
+     * \param aPosition the position of a
+     * \param bPosition the position of b
+     * \return the rx power in dBm
+     */
+    double CalcRxPowerAtPositions(double txPowerDbm,
+                                  Ptr<MobilityModel> a,
+                                  Ptr<MobilityModel> b,
+                                  const Vector& aPosition,
+                                  const Vector& bPosition) const;
+
     int64_t DoAssignStreams(int64_t stream) override;
 
     /**
@@ -17,12 +17,17 @@
 
 #include "ns3/abort.h"
 #include "ns3/config.h"
+#include "ns3/channel-condition-model.h"
 #include "ns3/constant-position-mobility-model.h"
+#include "ns3/cost231-propagation-loss-model.h"
 #include "ns3/double.h"
 #include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/okumura-hata-propagation-loss-model.h"
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 #include "ns3/test.h"
+#include "ns3/three-gpp-propagation-loss-model.h"
 
 using namespace ns3;
 
@@ -489,6 +494,93 @@ RangePropagationLossModelTestCase::DoRun()
     Simulator::Destroy();
 }
 
+/**
+ * \ingroup propagation-tests
+ *
+ * \brief PropagationLossModel::CalcRxPowerBatch Test
+ *
+ * Check that the batch computation of chains of loss models gives exactly the
+ * same results as CalcRxPower for each receiver, for the models overriding it
+ * and for the default implementation, including a random model.
+ */
+class BatchPropagationLossModelTestCase : public TestCase
+{
+  public:
+    BatchPropagationLossModelTestCase();
+
+  private:
+    void DoRun() override;
+
+    /**
+     * Create a chain of two loss models, the second one being a NakagamiPropagationLossModel
+     * \param tid the type of the first model of the chain
+     * \return the first model of the chain
+     */
+    Ptr<PropagationLossModel> CreateChain(TypeId tid);
+};
+
+BatchPropagationLossModelTestCase::BatchPropagationLossModelTestCase()
+    : TestCase("Test PropagationLossModel::CalcRxPowerBatch")
+{
+}
+
+Ptr<PropagationLossModel>
+BatchPropagationLossModelTestCase::CreateChain(TypeId tid)
+{
+    ObjectFactory factory;
+    factory.SetTypeId(tid);
+    Ptr<PropagationLossModel> first = factory.Create<PropagationLossModel>();
+    Ptr<ThreeGppPropagationLossModel> threeGpp = DynamicCast<ThreeGppPropagationLossModel>(first);
+    if (threeGpp)
+    {
+        threeGpp->SetAttribute("Frequency", DoubleValue(3.5e9));
+        threeGpp->SetChannelConditionModel(CreateObject<AlwaysLosChannelConditionModel>());
+    }
+    first->SetNext(CreateObject<NakagamiPropagationLossModel>());
+    first->AssignStreams(1);
+    return first;
+}
+
+void
+BatchPropagationLossModelTestCase::DoRun()
+{
+    Ptr<MobilityModel> tx = CreateObject<ConstantPositionMobilityModel>();
+    tx->SetPosition(Vector(0, 0, 25));
+    CreateObject<Node>()->AggregateObject(tx);
+    std::vector<Ptr<MobilityModel>> receivers;
+    for (uint32_t i = 0; i < 50; ++i)
+    {
+        Ptr<MobilityModel> rx = CreateObject<ConstantPositionMobilityModel>();
+        rx->SetPosition(Vector(20.0 + 37.0 * i, 13.0 * (i % 7), 1.5));
+        CreateObject<Node>()->AggregateObject(rx);
+        receivers.push_back(rx);
+    }
+
+    std::vector<TypeId> types = {FriisPropagationLossModel::GetTypeId(),
+                                 LogDistancePropagationLossModel::GetTypeId(),
+                                 OkumuraHataPropagationLossModel::GetTypeId(),
+                                 Cost231PropagationLossModel::GetTypeId(),
+                                 ThreeGppUmaPropagationLossModel::GetTypeId(),
+                                 TwoRayGroundPropagationLossModel::GetTypeId()};
+    for (const auto& tid : types)
+    {
+        Ptr<PropagationLossModel> single = CreateChain(tid);
+        Ptr<PropagationLossModel> batch = CreateChain(tid);
+        std::vector<double> rxPowersDbm;
+        batch->CalcRxPowerBatch(10, tx, receivers, rxPowersDbm);
+        NS_TEST_ASSERT_MSG_EQ(rxPowersDbm.size(), receivers.size(), "Wrong number of powers");
+        for (std::size_t i = 0; i < receivers.size(); ++i)
+        {
+            NS_TEST_EXPECT_MSG_EQ(rxPowersDbm[i],
+                                  single->CalcRxPower(10, tx, receivers[i]),
+                                  "Batch power differs for " << tid.GetName() << " receiver "
+                                                             << i);
+        }
+    }
+
+    Simulator::Destroy();
+}
+
 /**
  * \ingroup propagation-tests
  *
@@ -500,6 +592,7 @@ RangePropagationLossModelTestCase::DoRun()
  *   - LogDistancePropagationLossModel
  *   - MatrixPropagationLossModel
  *   - RangePropagationLossModel
+ *   - PropagationLossModel::CalcRxPowerBatch
  */
 class PropagationLossModelsTestSuite : public TestSuite
 {
@@ -515,6 +608,7 @@ PropagationLossModelsTestSuite::PropagationLossModelsTestSuite()
     AddTestCase(new LogDistancePropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new MatrixPropagationLossModelTestCase, TestCase::QUICK);
     AddTestCase(new RangePropagationLossModelTestCase, TestCase::QUICK);
+    AddTestCase(new BatchPropagationLossModelTestCase, TestCase::QUICK);
 }
 
 /// Static variable for test initialization
@@ -279,6 +279,10 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
             convertedTxPowerSpectrum = rxConverterIterator->second.Convert(txParams->psd);
         }
 
+        // select the receivers first, so that the propagation loss to all of them is computed
+        // at once
+        std::vector<Ptr<SpectrumPhy>> rxPhys;
+        std::vector<Ptr<MobilityModel>> rxMobilities;
         for (auto rxPhyIterator = rxInfoIterator->second.m_rxPhys.begin();
              rxPhyIterator != rxInfoIterator->second.m_rxPhys.end();
              ++rxPhyIterator)
@@ -309,87 +313,110 @@ MultiModelSpectrumChannel::StartTx(Ptr<SpectrumSignalParameters> txParams)
                     continue;
                 }
 
-                NS_LOG_LOGIC("copying signal parameters " << txParams);
-                Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
-                rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
-                Time delay = MicroSeconds(0);
-
-                Ptr<MobilityModel> receiverMobility = (*rxPhyIterator)->GetMobility();
+                rxPhys.push_back(*rxPhyIterator);
+                rxMobilities.push_back((*rxPhyIterator)->GetMobility());
+            }
+        }
 
-                if (txMobility && receiverMobility)
+        std::vector<double> propagationGainsDb;
+        if (txMobility && m_propagationLoss)
+        {
+            std::vector<Ptr<MobilityModel>> lossReceivers;
+            lossReceivers.reserve(rxMobilities.size());
+            for (const auto& receiverMobility : rxMobilities)
+            {
+                if (receiverMobility)
                 {
-                    double txAntennaGain = 0;
-                    double rxAntennaGain = 0;
-                    double propagationGainDb = 0;
-                    double pathLossDb = 0;
-                    if (rxParams->txAntenna)
-                    {
-                        Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
-                        txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
-                        NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
-                        pathLossDb -= txAntennaGain;
-                    }
-                    Ptr<AntennaModel> rxAntenna =
-                        DynamicCast<AntennaModel>((*rxPhyIterator)->GetAntenna());
-                    if (rxAntenna)
-                    {
-                        Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
-                        rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
-                        NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
-                        pathLossDb -= rxAntennaGain;
-                    }
-                    if (m_propagationLoss)
-                    {
-                        propagationGainDb =
-                            m_propagationLoss->CalcRxPower(0, txMobility, receiverMobility);
-                        NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
-                        pathLossDb -= propagationGainDb;
-                    }
-                    NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
-                    // Gain trace
-                    m_gainTrace(txMobility,
-                                receiverMobility,
-                                txAntennaGain,
-                                rxAntennaGain,
-                                propagationGainDb,
-                                pathLossDb);
-                    // Pathloss trace
-                    m_pathLossTrace(txParams->txPhy, *rxPhyIterator, pathLossDb);
-                    if (pathLossDb > m_maxLossDb)
-                    {
-                        // beyond range
-                        continue;
-                    }
-                    double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
-                    *(rxParams->psd) *= pathGainLinear;
-
-                    if (m_propagationDelay)
-                    {
-                        delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
-                    }
+                    lossReceivers.push_back(receiverMobility);
                 }
+            }
+            m_propagationLoss->CalcRxPowerBatch(0, txMobility, lossReceivers, propagationGainsDb);
+        }
 
-                if (rxNetDevice)
+        std::size_t lossIndex = 0;
+        for (std::size_t i = 0; i < rxPhys.size(); ++i)
+        {
+            Ptr<SpectrumPhy> rxPhy = rxPhys[i];
+            Ptr<NetDevice> rxNetDevice = rxPhy->GetDevice();
+
+            NS_LOG_LOGIC("copying signal parameters " << txParams);
+            Ptr<SpectrumSignalParameters> rxParams = txParams->Copy();
+            rxParams->psd = Copy<SpectrumValue>(convertedTxPowerSpectrum);
+            Time delay = MicroSeconds(0);
+
+            Ptr<MobilityModel> receiverMobility = rxMobilities[i];
+
+            if (txMobility && receiverMobility)
+            {
+                double txAntennaGain = 0;
+                double rxAntennaGain = 0;
+                double propagationGainDb = 0;
+                double pathLossDb = 0;
+                if (rxParams->txAntenna)
+                {
+                    Angles txAngles(receiverMobility->GetPosition(), txMobility->GetPosition());
+                    txAntennaGain = rxParams->txAntenna->GetGainDb(txAngles);
+                    NS_LOG_LOGIC("txAntennaGain = " << txAntennaGain << " dB");
+                    pathLossDb -= txAntennaGain;
+                }
+                Ptr<AntennaModel> rxAntenna = DynamicCast<AntennaModel>(rxPhy->GetAntenna());
+                if (rxAntenna)
+                {
+                    Angles rxAngles(txMobility->GetPosition(), receiverMobility->GetPosition());
+                    rxAntennaGain = rxAntenna->GetGainDb(rxAngles);
+                    NS_LOG_LOGIC("rxAntennaGain = " << rxAntennaGain << " dB");
+                    pathLossDb -= rxAntennaGain;
+                }
+                if (m_propagationLoss)
                 {
-                    // the receiver has a NetDevice, so we expect that it is attached to a Node
-                    uint32_t dstNode = rxNetDevice->GetNode()->GetId();
-                    Simulator::ScheduleWithContext(dstNode,
-                                                   delay,
-                                                   &MultiModelSpectrumChannel::StartRx,
-                                                   this,
-                                                   rxParams,
-                                                   *rxPhyIterator);
+                    propagationGainDb = propagationGainsDb[lossIndex++];
+                    NS_LOG_LOGIC("propagationGainDb = " << propagationGainDb << " dB");
+                    pathLossDb -= propagationGainDb;
                 }
-                else
+                NS_LOG_LOGIC("total pathLoss = " << pathLossDb << " dB");
+                // Gain trace
+                m_gainTrace(txMobility,
+                            receiverMobility,
+                            txAntennaGain,
+                            rxAntennaGain,
+                            propagationGainDb,
+                            pathLossDb);
+                // Pathloss trace
+                m_pathLossTrace(txParams->txPhy, rxPhy, pathLossDb);
+                if (pathLossDb > m_maxLossDb)
                 {
-                    // the receiver is not attached to a NetDevice, so we cannot assume that it is
-                    // attached to a node
-                    Simulator::Schedule(delay,
-                                        &MultiModelSpectrumChannel::StartRx,
-                                        this,
-                                        rxParams,
-                                        *rxPhyIterator);
+                    // beyond range
+                    continue;
                 }
+                double pathGainLinear = std::pow(10.0, (-pathLossDb) / 10.0);
+                *(rxParams->psd) *= pathGainLinear;
+
+                if (m_propagationDelay)
+                {
+                    delay = m_propagationDelay->GetDelay(txMobility, receiverMobility);
+                }
+            }
+
+            if (rxNetDevice)
+            {
+                // the receiver has a NetDevice, so we expect that it is attached to a Node
+                uint32_t dstNode = rxNetDevice->GetNode()->GetId();
+                Simulator::ScheduleWithContext(dstNode,
+                                               delay,
+                                               &MultiModelSpectrumChannel::StartRx,
+                                               this,
+                                               rxParams,
+                                               rxPhy);
+            }
+            else
+            {
+                // the receiver is not attached to a NetDevice, so we cannot assume that it is
+                // attached to a node
+                Simulator::Schedule(delay,
+                                    &MultiModelSpectrumChannel::StartRx,
+                                    this,
+                                    rxParams,
+                                    rxPhy);
             }
         }
     }
@@ -0,0 +1,270 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/applications-module.h"
+#include "ns3/core-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup wifi
+ *
+ * Benchmark of the scaling of an infrastructure network with the number of
+ * associated stations.
+ *
+ * For each number of stations, a single 802.11n AP serves stations placed on
+ * a circle around it; each station receives a UDP flow from the AP and sends
+ * a UDP flow to the AP. The program reports the wall-clock time of the
+ * simulation, the number of frames transmitted by all the PHYs (including
+ * the control frames) and the number of frames per wall-clock second, which
+ * exposes the per-frame costs of the MAC, such as the lookups of the remote
+ * station states by the rate control algorithm, e.g.:
+ *
+ * \code
+ *   ./ns3 run "wifi-ap-scaling-benchmark --stations=10,50,100,200"
+ *   ./ns3 run "wifi-ap-scaling-benchmark --manager=ns3::IdealWifiManager"
+ * \endcode
+ */
+
+NS_LOG_COMPONENT_DEFINE("WifiApScalingBenchmark");
+
+/**
+ * Parse a comma separated list of unsigned integers.
+ *
+ * \param list the list
+ * \return the values of the list
+ */
+static std::vector<uint32_t>
+ParseList(std::string list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Install a UDP flow between two nodes.
+ *
+ * \param sender the sending node
+ * \param receiver the receiving node
+ * \param address the address of the receiver
+ * \param port the UDP port of the flow
+ * \param interval the interval between the packets
+ * \param pktSize the size of the packets [bytes]
+ * \param start the start time of the flow
+ * \return the server receiving the flow
+ */
+static Ptr<UdpServer>
+InstallFlow(Ptr<Node> sender,
+            Ptr<Node> receiver,
+            Ipv4Address address,
+            uint16_t port,
+            Time interval,
+            uint32_t pktSize,
+            Time start)
+{
+    UdpServerHelper server(port);
+    ApplicationContainer serverApp = server.Install(receiver);
+    serverApp.Start(Seconds(0));
+
+    UdpClientHelper client(address, port);
+    client.SetAttribute("MaxPackets", UintegerValue(0));
+    client.SetAttribute("Interval", TimeValue(interval));
+    client.SetAttribute("PacketSize", UintegerValue(pktSize));
+    ApplicationContainer clientApp = client.Install(sender);
+    clientApp.Start(start);
+
+    return DynamicCast<UdpServer>(serverApp.Get(0));
+}
+
+/**
+ * Run an infrastructure network and print its results.
+ *
+ * \param nStations the number of stations associated with the AP
+ * \param manager the TypeId name of the remote station manager
+ * \param duration the simulated time of the traffic
+ * \param distance the distance between the stations and the AP [m]
+ * \param interval the interval between the packets of each flow
+ * \param pktSize the size of the packets [bytes]
+ */
+static void
+RunNetwork(uint32_t nStations,
+           std::string manager,
+           Time duration,
+           double distance,
+           Time interval,
+           uint32_t pktSize)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer apNode;
+    apNode.Create(1);
+    NodeContainer staNodes;
+    staNodes.Create(nStations);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel.Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211n);
+    wifi.SetRemoteStationManager(manager);
+
+    WifiMacHelper mac;
+    Ssid ssid("ap-scaling");
+    mac.SetType("ns3::StaWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer staDevices = wifi.Install(phy, mac, staNodes);
+    mac.SetType("ns3::ApWifiMac", "Ssid", SsidValue(ssid));
+    NetDeviceContainer apDevice = wifi.Install(phy, mac, apNode);
+    wifi.AssignStreams(apDevice, 1);
+    wifi.AssignStreams(staDevices, 2);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    positions->Add(Vector(0, 0, 0));
+    for (uint32_t i = 0; i < nStations; ++i)
+    {
+        double angle = 2 * M_PI * i / nStations;
+        positions->Add(Vector(distance * std::cos(angle), distance * std::sin(angle), 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(apNode);
+    mobility.Install(staNodes);
+
+    InternetStackHelper stack;
+    stack.Install(apNode);
+    stack.Install(staNodes);
+    Ipv4AddressHelper address;
+    address.SetBase("10.1.0.0", "255.255.0.0");
+    Ipv4InterfaceContainer apInterface = address.Assign(apDevice);
+    Ipv4InterfaceContainer staInterfaces = address.Assign(staDevices);
+
+    // the flows start once the stations are likely associated
+    Ptr<UniformRandomVariable> startTime = CreateObject<UniformRandomVariable>();
+    startTime->SetStream(100);
+    startTime->SetAttribute("Min", DoubleValue(1));
+    startTime->SetAttribute("Max", DoubleValue(1.1));
+    std::vector<Ptr<UdpServer>> downlink;
+    std::vector<Ptr<UdpServer>> uplink;
+    for (uint32_t i = 0; i < nStations; ++i)
+    {
+        downlink.push_back(InstallFlow(apNode.Get(0),
+                                       staNodes.Get(i),
+                                       staInterfaces.GetAddress(i),
+                                       9,
+                                       interval,
+                                       pktSize,
+                                       Seconds(startTime->GetValue())));
+        uplink.push_back(InstallFlow(staNodes.Get(i),
+                                     apNode.Get(0),
+                                     apInterface.GetAddress(0),
+                                     10000 + i,
+                                     interval,
+                                     pktSize,
+                                     Seconds(startTime->GetValue())));
+    }
+
+    uint64_t frames = 0;
+    Config::ConnectWithoutContext(
+        "/NodeList/*/DeviceList/*/$ns3::WifiNetDevice/Phy/PhyTxBegin",
+        MakeBoundCallback(+[](uint64_t* count, Ptr<const Packet>, double) { ++*count; },
+                          &frames));
+
+    Simulator::Stop(Seconds(1) + duration);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    uint64_t downlinkRx = 0;
+    uint64_t uplinkRx = 0;
+    for (uint32_t i = 0; i < nStations; ++i)
+    {
+        downlinkRx += downlink[i]->GetReceived();
+        uplinkRx += uplink[i]->GetReceived();
+    }
+    Simulator::Destroy();
+
+    std::cout << nStations << "\t" << manager << "\t" << std::fixed << std::setprecision(3)
+              << wallS << "\t" << frames << "\t" << std::setprecision(0) << frames / wallS << "\t"
+              << downlinkRx << "\t" << uplinkRx << std::defaultfloat << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string stations = "10,50,100,200";
+    std::string manager = "ns3::MinstrelHtWifiManager";
+    double duration = 2;
+    double distance = 10;
+    double interval = 0.02;
+    uint32_t pktSize = 1000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("stations", "Comma separated numbers of stations", stations);
+    cmd.AddValue("manager", "The remote station manager of the devices", manager);
+    cmd.AddValue("duration", "The simulated time of the traffic [s]", duration);
+    cmd.AddValue("distance", "The distance between the stations and the AP [m]", distance);
+    cmd.AddValue("interval", "The interval between the packets of each flow [s]", interval);
+    cmd.AddValue("pktSize", "The size of the packets [bytes]", pktSize);
+    cmd.Parse(argc, argv);
+
+    std::cout << "stations\tmanager\twall(s)\tframes\tframes/s\tdownlinkRx\tuplinkRx"
+              << std::endl;
+    for (uint32_t nStations : ParseList(stations))
+    {
+        RunNetwork(nStations, manager, Seconds(duration), distance, Seconds(interval), pktSize);
+    }
+    return 0;
+}
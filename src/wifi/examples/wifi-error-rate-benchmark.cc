@@ -0,0 +1,299 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/network-module.h"
+#include "ns3/wifi-module.h"
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \file
+ * \ingroup wifi
+ *
+ * Benchmark of the LookupTableErrorRateModel against the analytical error
+ * rate model that it approximates.
+ *
+ * The program first measures the rate of chunk evaluations, for random SNR
+ * values and chunk sizes, and the largest difference between the success
+ * rates of the two models. It then runs, for each number of stations, a
+ * saturated ad hoc network like the one of the wifi-bianchi example, where
+ * each station sends packets to the next one as fast as possible, once with
+ * each model, and reports the wall-clock time of the simulation and the
+ * throughput, e.g.:
+ *
+ * \code
+ *   ./ns3 run "wifi-error-rate-benchmark --stations=5,10,20,40"
+ * \endcode
+ */
+
+NS_LOG_COMPONENT_DEFINE("WifiErrorRateBenchmark");
+
+/**
+ * Parse a comma separated list of unsigned integers.
+ *
+ * \param list the list
+ * \return the values of the list
+ */
+static std::vector<uint32_t>
+ParseList(std::string list)
+{
+    std::vector<uint32_t> values;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        values.push_back(std::stoul(item));
+    }
+    return values;
+}
+
+/**
+ * Measure the rate of chunk evaluations of two models and print it.
+ *
+ * \param reference the analytical model
+ * \param lut the lookup table model
+ * \param mode the mode of the chunks
+ * \param nChunks the number of chunks to evaluate
+ */
+static void
+RunChunks(Ptr<ErrorRateModel> reference,
+          Ptr<ErrorRateModel> lut,
+          WifiMode mode,
+          uint32_t nChunks)
+{
+    using Clock = std::chrono::steady_clock;
+    WifiTxVector txVector;
+    txVector.SetMode(mode);
+    Ptr<UniformRandomVariable> snrDb = CreateObject<UniformRandomVariable>();
+    snrDb->SetAttribute("Min", DoubleValue(-5));
+    snrDb->SetAttribute("Max", DoubleValue(40));
+    Ptr<UniformRandomVariable> nbits = CreateObject<UniformRandomVariable>();
+    nbits->SetAttribute("Min", DoubleValue(1));
+    nbits->SetAttribute("Max", DoubleValue(12000 * 8));
+    std::vector<std::pair<double, uint64_t>> chunks;
+    for (uint32_t i = 0; i < nChunks; ++i)
+    {
+        chunks.emplace_back(std::pow(10, snrDb->GetValue() / 10), nbits->GetInteger());
+    }
+
+    // the tables of the mode are computed before the measure
+    lut->GetChunkSuccessRate(mode, txVector, chunks[0].first, chunks[0].second);
+
+    double sum = 0;
+    auto start = Clock::now();
+    for (const auto& [snr, n] : chunks)
+    {
+        sum += reference->GetChunkSuccessRate(mode, txVector, snr, n);
+    }
+    double referenceS = std::chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (const auto& [snr, n] : chunks)
+    {
+        sum -= lut->GetChunkSuccessRate(mode, txVector, snr, n);
+    }
+    double lutS = std::chrono::duration<double>(Clock::now() - start).count();
+
+    double maxError = 0;
+    for (const auto& [snr, n] : chunks)
+    {
+        maxError = std::max(maxError,
+                            std::abs(reference->GetChunkSuccessRate(mode, txVector, snr, n) -
+                                     lut->GetChunkSuccessRate(mode, txVector, snr, n)));
+    }
+
+    std::cout << mode << "\t" << std::fixed << std::setprecision(0) << nChunks / referenceS << "\t"
+              << nChunks / lutS << "\t" << std::setprecision(1) << referenceS / lutS << "\t"
+              << std::scientific << std::setprecision(2) << maxError << "\t"
+              << std::abs(sum) / nChunks << std::defaultfloat << std::endl;
+}
+
+/**
+ * Run a saturated ad hoc network and print its results.
+ *
+ * \param nStations the number of stations
+ * \param errorRateModel the TypeId name of the error rate model
+ * \param phyMode the constant PHY mode
+ * \param duration the simulated time
+ * \param distance the distance between the stations and the center of the network [m]
+ * \param pktSize the size of the packets [bytes]
+ */
+static void
+RunNetwork(uint32_t nStations,
+           std::string errorRateModel,
+           std::string phyMode,
+           Time duration,
+           double distance,
+           uint32_t pktSize)
+{
+    RngSeedManager::SetSeed(10);
+    RngSeedManager::SetRun(10);
+
+    NodeContainer nodes;
+    nodes.Create(nStations);
+
+    YansWifiChannelHelper channel = YansWifiChannelHelper::Default();
+    YansWifiPhyHelper phy;
+    phy.SetErrorRateModel(errorRateModel);
+    phy.SetChannel(channel.Create());
+
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue(phyMode),
+                                 "ControlMode",
+                                 StringValue(phyMode));
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    MobilityHelper mobility;
+    Ptr<ListPositionAllocator> positions = CreateObject<ListPositionAllocator>();
+    for (uint32_t i = 0; i < nStations; ++i)
+    {
+        double angle = 2 * M_PI * i / nStations;
+        positions->Add(Vector(distance * std::cos(angle), distance * std::sin(angle), 0));
+    }
+    mobility.SetPositionAllocator(positions);
+    mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+    mobility.Install(nodes);
+
+    PacketSocketHelper packetSocket;
+    packetSocket.Install(nodes);
+
+    Ptr<UniformRandomVariable> startTime = CreateObject<UniformRandomVariable>();
+    startTime->SetAttribute("Stream", IntegerValue(100));
+    startTime->SetAttribute("Max", DoubleValue(0.1));
+    std::vector<Ptr<PacketSocketServer>> servers;
+    for (uint32_t i = 0; i < nStations; ++i)
+    {
+        uint32_t j = (i + 1) % nStations;
+        PacketSocketAddress socketAddr;
+        socketAddr.SetSingleDevice(devices.Get(i)->GetIfIndex());
+        socketAddr.SetPhysicalAddress(devices.Get(j)->GetAddress());
+        socketAddr.SetProtocol(1);
+
+        Ptr<PacketSocketClient> client = CreateObject<PacketSocketClient>();
+        client->SetRemote(socketAddr);
+        client->SetAttribute("PacketSize", UintegerValue(pktSize));
+        client->SetAttribute("MaxPackets", UintegerValue(0));
+        client->SetAttribute("Interval", TimeValue(MicroSeconds(100)));
+        client->SetStartTime(Seconds(startTime->GetValue()));
+        nodes.Get(i)->AddApplication(client);
+
+        Ptr<PacketSocketServer> server = CreateObject<PacketSocketServer>();
+        server->SetLocal(socketAddr);
+        nodes.Get(j)->AddApplication(server);
+        servers.push_back(server);
+    }
+
+    uint64_t rxBytes = 0;
+    for (const auto& server : servers)
+    {
+        server->TraceConnectWithoutContext(
+            "Rx",
+            MakeBoundCallback(
+                +[](uint64_t* bytes, Ptr<const Packet> packet, const Address&) {
+                    *bytes += packet->GetSize();
+                },
+                &rxBytes));
+    }
+
+    Simulator::Stop(duration);
+    auto start = std::chrono::steady_clock::now();
+    Simulator::Run();
+    double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Simulator::Destroy();
+
+    std::cout << nStations << "\t" << errorRateModel << "\t" << std::fixed << std::setprecision(3)
+              << wallS << "\t" << std::setprecision(2) << rxBytes * 8 / duration.GetSeconds() / 1e6
+              << std::defaultfloat << std::endl;
+}
+
+int
+main(int argc, char* argv[])
+{
+    std::string stations = "5,10,20";
+    std::string phyMode = "OfdmRate54Mbps";
+    std::string reference = "ns3::NistErrorRateModel";
+    double duration = 2;
+    double distance = 1;
+    uint32_t pktSize = 1500;
+    uint32_t chunks = 200000;
+
+    CommandLine cmd(__FILE__);
+    cmd.AddValue("stations", "Comma separated numbers of stations", stations);
+    cmd.AddValue("phyMode", "The constant PHY mode of the network", phyMode);
+    cmd.AddValue("reference", "The error rate model approximated by the tables", reference);
+    cmd.AddValue("duration", "The simulated time of each network [s]", duration);
+    cmd.AddValue("distance", "The distance between the stations and the center [m]", distance);
+    cmd.AddValue("pktSize", "The size of the packets [bytes]", pktSize);
+    cmd.AddValue("chunks", "The number of chunks evaluated for each mode", chunks);
+    cmd.Parse(argc, argv);
+
+    Config::SetDefault("ns3::LookupTableErrorRateModel::ReferenceErrorRateModel",
+                       StringValue(reference));
+
+    ObjectFactory factory(reference);
+    Ptr<ErrorRateModel> referenceModel = factory.Create<ErrorRateModel>();
+    Ptr<ErrorRateModel> lut = CreateObject<LookupTableErrorRateModel>();
+    std::cout << "mode\tchunks/s\tlutChunks/s\tspeedup\tmaxError\tmeanDiff" << std::endl;
+    for (uint64_t rate : {6, 12, 24, 54})
+    {
+        RunChunks(referenceModel, lut, OfdmPhy::GetOfdmRate(rate * 1000000), chunks);
+    }
+    lut->Dispose();
+
+    std::cout << std::endl << "stations\tmodel\twall(s)\tthroughput(Mbit/s)" << std::endl;
+    for (uint32_t nStations : ParseList(stations))
+    {
+        for (const auto& model : {reference, std::string("ns3::LookupTableErrorRateModel")})
+        {
+            RunNetwork(nStations, model, phyMode, Seconds(duration), distance, pktSize);
+        }
+    }
+    return 0;
+}
@@ -94,6 +94,43 @@ ErrorRateModel::GetChunkSuccessRate(WifiMode mode,
     return 0;
 }
 
+double
+ErrorRateModel::GetChunksSuccessRate(WifiMode mode,
+                                     const WifiTxVector& txVector,
+                                     const Chunks& chunks,
+                                     uint8_t numRxAntennas,
+                                     WifiPpduField field,
+                                     uint16_t staId) const
+{
+    if (mode.GetModulationClass() == WIFI_MOD_CLASS_DSSS ||
+        mode.GetModulationClass() == WIFI_MOD_CLASS_HR_DSSS)
+    {
+        double psr = 1.0;
+        for (const auto& [snr, nbits] : chunks)
+        {
+            psr *= GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+        }
+        return psr;
+    }
+    return DoGetChunksSuccessRate(mode, txVector, chunks, numRxAntennas, field, staId);
+}
+
+double
+ErrorRateModel::DoGetChunksSuccessRate(WifiMode mode,
+                                       const WifiTxVector& txVector,
+                                       const Chunks& chunks,
+                                       uint8_t numRxAntennas,
+                                       WifiPpduField field,
+                                       uint16_t staId) const
+{
+    double psr = 1.0;
+    for (const auto& [snr, nbits] : chunks)
+    {
+        psr *= DoGetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+    }
+    return psr;
+}
+
 bool
 ErrorRateModel::IsAwgn() const
 {
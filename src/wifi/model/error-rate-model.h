@@ -24,6 +24,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -41,6 +43,11 @@ class ErrorRateModel : public Object
      */
     static TypeId GetTypeId();
 
+    /**
+     * SNR (linear scale) and number of bits of each chunk of a PPDU field
+     */
+    using Chunks = std::vector<std::pair<double, uint64_t>>;
+
     /**
      * \param txVector a specific transmission vector including WifiMode
      * \param ber a target BER
@@ -92,6 +99,29 @@ class ErrorRateModel : public Object
                                WifiPpduField field = WIFI_PPDU_FIELD_DATA,
                                uint16_t staId = SU_STA_ID) const;
 
+    /**
+     * This method returns the probability that all the given chunks of a PPDU
+     * field, which are sent with the same mode, will be successfully received
+     * by the PHY, i.e. the product of their success rates (see
+     * GetChunkSuccessRate), taken in the order of the chunks.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param chunks the SNR and the number of bits of each chunk
+     * \param numRxAntennas the number of active RX antennas (1 if not provided)
+     * \param field the PPDU field to which the chunks belong to (assumes this is for the payload
+     * part if not provided)
+     * \param staId the station ID for MU
+     *
+     * \return probability of successfully receiving all the chunks
+     */
+    double GetChunksSuccessRate(WifiMode mode,
+                                const WifiTxVector& txVector,
+                                const Chunks& chunks,
+                                uint8_t numRxAntennas = 1,
+                                WifiPpduField field = WIFI_PPDU_FIELD_DATA,
+                                uint16_t staId = SU_STA_ID) const;
+
     /**
      * Assign a fixed random variable stream number to the random variables
      * used by this model. Return the number of streams (possibly zero) that
@@ -123,6 +153,27 @@ class ErrorRateModel : public Object
                                          uint8_t numRxAntennas,
                                          WifiPpduField field,
                                          uint16_t staId) const = 0;
+
+    /**
+     * Return the probability of successfully receiving all the given chunks. The default
+     * implementation multiplies the results of DoGetChunkSuccessRate, the subclasses may
+     * override it to evaluate the chunks together.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param chunks the SNR and the number of bits of each chunk
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunks belong to
+     * \param staId the station ID for MU
+     *
+     * \return probability of successfully receiving all the chunks
+     */
+    virtual double DoGetChunksSuccessRate(WifiMode mode,
+                                          const WifiTxVector& txVector,
+                                          const Chunks& chunks,
+                                          uint8_t numRxAntennas,
+                                          WifiPpduField field,
+                                          uint16_t staId) const;
 };
 
 } // namespace ns3
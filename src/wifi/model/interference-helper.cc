@@ -205,12 +205,7 @@ void
 InterferenceHelper::DoDispose()
 {
     NS_LOG_FUNCTION(this);
-    for (auto it : m_niChanges)
-    {
-        it.second.clear();
-    }
-    m_niChanges.clear();
-    m_firstPowers.clear();
+    m_bands.clear();
     m_errorRateModel = nullptr;
 }
 
@@ -242,27 +237,61 @@ InterferenceHelper::AddForeignSignal(Time duration, RxPowerWattPerChannelBand& r
 bool
 InterferenceHelper::HasBands() const
 {
-    return !m_niChanges.empty();
+    return !m_bands.empty();
 }
 
 bool
 InterferenceHelper::HasBand(const WifiSpectrumBandInfo& band) const
 {
-    return (m_niChanges.count(band) > 0);
+    return (GetBandIndex(band) < m_bands.size());
+}
+
+std::size_t
+InterferenceHelper::GetBandIndex(const WifiSpectrumBandInfo& band) const
+{
+    auto it = std::lower_bound(m_bands.cbegin(),
+                               m_bands.cend(),
+                               band,
+                               [](const BandNiChanges& item, const WifiSpectrumBandInfo& key) {
+                                   return item.band < key;
+                               });
+    if (it == m_bands.cend() || band < it->band)
+    {
+        return m_bands.size();
+    }
+    return it - m_bands.cbegin();
+}
+
+InterferenceHelper::BandNiChanges&
+InterferenceHelper::GetBandNiChanges(const WifiSpectrumBandInfo& band)
+{
+    auto index = GetBandIndex(band);
+    NS_ABORT_IF(index == m_bands.size());
+    return m_bands[index];
+}
+
+const InterferenceHelper::BandNiChanges&
+InterferenceHelper::GetBandNiChanges(const WifiSpectrumBandInfo& band) const
+{
+    auto index = GetBandIndex(band);
+    NS_ABORT_IF(index == m_bands.size());
+    return m_bands[index];
 }
 
 void
 InterferenceHelper::AddBand(const WifiSpectrumBandInfo& band)
 {
     NS_LOG_FUNCTION(this << band);
-    NS_ASSERT(m_niChanges.count(band) == 0);
-    NS_ASSERT(m_firstPowers.count(band) == 0);
-    NiChanges niChanges;
-    auto result = m_niChanges.insert({band, niChanges});
-    NS_ASSERT(result.second);
+    NS_ASSERT(!HasBand(band));
+    auto it = std::upper_bound(m_bands.begin(),
+                               m_bands.end(),
+                               band,
+                               [](const WifiSpectrumBandInfo& key, const BandNiChanges& item) {
+                                   return key < item.band;
+                               });
+    it = m_bands.insert(it, BandNiChanges{band, {}, 0, 0.0});
     // Always have a zero power noise event in the list
-    AddNiChangeEvent(Time(0), NiChange(0.0, nullptr), result.first);
-    m_firstPowers.insert({band, 0.0});
+    AddNiChangeEvent(Time(0), NiChange(0.0, nullptr), *it);
 }
 
 void
@@ -270,14 +299,14 @@ InterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
                                 const FrequencyRange& freqRange)
 {
     NS_LOG_FUNCTION(this << freqRange);
-    for (auto it = m_niChanges.begin(); it != m_niChanges.end();)
+    for (auto it = m_bands.begin(); it != m_bands.end();)
     {
-        if (!IsBandInFrequencyRange(it->first, freqRange))
+        if (!IsBandInFrequencyRange(it->band, freqRange))
         {
             it++;
             continue;
         }
-        const auto frequencies = it->first.frequencies;
+        const auto frequencies = it->band.frequencies;
         const auto found =
             std::find_if(bands.cbegin(), bands.cend(), [frequencies](const auto& item) {
                 return frequencies == item.frequencies;
@@ -285,9 +314,7 @@ InterferenceHelper::UpdateBands(const std::vector<WifiSpectrumBandInfo>& bands,
         if (!found)
         {
             // band does not belong to the new bands, erase it
-            m_firstPowers.erase(it->first);
-            it->second.clear();
-            it = m_niChanges.erase(it);
+            it = m_bands.erase(it);
         }
         else
         {
@@ -333,11 +360,10 @@ InterferenceHelper::GetEnergyDuration(double energyW, const WifiSpectrumBandInfo
 {
     NS_LOG_FUNCTION(this << energyW << band);
     Time now = Simulator::Now();
-    auto niIt = m_niChanges.find(band);
-    NS_ABORT_IF(niIt == m_niChanges.end());
-    auto i = GetPreviousPosition(now, niIt);
+    auto& bandNiChanges = GetBandNiChanges(band);
+    auto i = GetPreviousPosition(now, bandNiChanges);
     Time end = i->first;
-    for (; i != niIt->second.end(); ++i)
+    for (; i != bandNiChanges.niChanges.end(); ++i)
     {
         double noiseInterferenceW = i->second.GetPower();
         end = i->first;
@@ -355,30 +381,35 @@ InterferenceHelper::AppendEvent(Ptr<Event> event, bool isStartHePortionRxing)
     NS_LOG_FUNCTION(this << event << isStartHePortionRxing);
     for (const auto& [band, power] : event->GetRxPowerWPerBand())
     {
-        auto niIt = m_niChanges.find(band);
-        NS_ABORT_IF(niIt == m_niChanges.end());
+        auto& bandNiChanges = GetBandNiChanges(band);
         double previousPowerStart = 0;
         double previousPowerEnd = 0;
-        auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), niIt);
+        auto previousPowerPosition = GetPreviousPosition(event->GetStartTime(), bandNiChanges);
         previousPowerStart = previousPowerPosition->second.GetPower();
-        previousPowerEnd = GetPreviousPosition(event->GetEndTime(), niIt)->second.GetPower();
+        previousPowerEnd =
+            GetPreviousPosition(event->GetEndTime(), bandNiChanges)->second.GetPower();
         if (!m_rxing)
         {
-            m_firstPowers.find(band)->second = previousPowerStart;
+            bandNiChanges.firstPower = previousPowerStart;
             // Always leave the first zero power noise event in the list
-            niIt->second.erase(++(niIt->second.begin()), ++previousPowerPosition);
+            RemoveNiChanges(previousPowerPosition, bandNiChanges);
         }
         else if (isStartHePortionRxing)
         {
-            // When the first HE portion is received, we need to set m_firstPowerPerBand
+            // When the first HE portion is received, we need to set the first power of the band
             // so that it takes into account interferences that arrived between the start of the
             // HE TB PPDU transmission and the start of HE TB payload.
-            m_firstPowers.find(band)->second = previousPowerStart;
+            bandNiChanges.firstPower = previousPowerStart;
         }
-        auto first =
-            AddNiChangeEvent(event->GetStartTime(), NiChange(previousPowerStart, event), niIt);
-        auto last = AddNiChangeEvent(event->GetEndTime(), NiChange(previousPowerEnd, event), niIt);
-        for (auto i = first; i != last; ++i)
+        auto first = AddNiChangeEvent(event->GetStartTime(),
+                                      NiChange(previousPowerStart, event),
+                                      bandNiChanges) -
+                     bandNiChanges.niChanges.begin();
+        // the end of the event is added after its start, which is thus not moved
+        auto last = AddNiChangeEvent(event->GetEndTime(),
+                                     NiChange(previousPowerEnd, event),
+                                     bandNiChanges);
+        for (auto i = bandNiChanges.niChanges.begin() + first; i != last; ++i)
         {
             i->second.AddPower(power);
         }
@@ -392,10 +423,9 @@ InterferenceHelper::UpdateEvent(Ptr<Event> event, const RxPowerWattPerChannelBan
     // This is called for UL MU events, in order to scale power as long as UL MU PPDUs arrive
     for (const auto& [band, power] : rxPower)
     {
-        auto niIt = m_niChanges.find(band);
-        NS_ABORT_IF(niIt == m_niChanges.end());
-        auto first = GetPreviousPosition(event->GetStartTime(), niIt);
-        auto last = GetPreviousPosition(event->GetEndTime(), niIt);
+        auto& bandNiChanges = GetBandNiChanges(band);
+        auto first = GetPreviousPosition(event->GetStartTime(), bandNiChanges);
+        auto last = GetPreviousPosition(event->GetEndTime(), bandNiChanges);
         for (auto i = first; i != last; ++i)
         {
             i->second.AddPower(power);
@@ -438,20 +468,29 @@ InterferenceHelper::CalculateSnr(double signal,
 
 double
 InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
-                                                NiChangesPerBand& nis,
+                                                NiChangesRange& nis,
                                                 const WifiSpectrumBandInfo& band) const
 {
     NS_LOG_FUNCTION(this << band);
-    auto firstPower_it = m_firstPowers.find(band);
-    NS_ABORT_IF(firstPower_it == m_firstPowers.end());
-    double noiseInterferenceW = firstPower_it->second;
-    auto niIt = m_niChanges.find(band);
-    NS_ABORT_IF(niIt == m_niChanges.end());
-    auto it = niIt->second.find(event->GetStartTime());
+    const auto& bandNiChanges = GetBandNiChanges(band);
+    double noiseInterferenceW = bandNiChanges.firstPower;
+    const auto& niChanges = bandNiChanges.niChanges;
+    // the NiChanges at the start of the event (if it has not expired)
+    auto start = std::lower_bound(niChanges.cbegin() + bandNiChanges.first,
+                                  niChanges.cend(),
+                                  event->GetStartTime(),
+                                  [](const auto& niChange, Time moment) {
+                                      return niChange.first < moment;
+                                  });
+    if (start != niChanges.cend() && start->first != event->GetStartTime())
+    {
+        start = niChanges.cend();
+    }
+    auto it = start;
     double muMimoPowerW = (event->GetPpdu()->GetType() == WIFI_PPDU_TYPE_UL_MU)
                               ? CalculateMuMimoPowerW(event, band)
                               : 0.0;
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    for (; it != niChanges.cend() && it->first < Simulator::Now(); ++it)
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()) &&
             (event != it->second.GetEvent()))
@@ -467,20 +506,20 @@ InterferenceHelper::CalculateNoiseInterferenceW(Ptr<Event> event,
             noiseInterferenceW = 0.0;
         }
     }
-    it = niIt->second.find(event->GetStartTime());
-    NS_ABORT_IF(it == niIt->second.end());
-    for (; it != niIt->second.end() && it->second.GetEvent() != event; ++it)
+    it = start;
+    NS_ABORT_IF(it == niChanges.cend());
+    for (; it != niChanges.cend() && it->second.GetEvent() != event; ++it)
     {
         ;
     }
-    NiChanges ni;
-    ni.emplace(event->GetStartTime(), NiChange(0, event));
-    while (++it != niIt->second.end() && it->second.GetEvent() != event)
+    // The NiChanges of the event are the ones from its start to its end, which are contiguous
+    nis.first = it;
+    while (++it != niChanges.cend() && it->second.GetEvent() != event)
     {
-        ni.insert(*it);
+        ;
     }
-    ni.emplace(event->GetEndTime(), NiChange(0, event));
-    nis.insert({band, ni});
+    NS_ASSERT(it != niChanges.cend());
+    nis.second = ++it;
     NS_ASSERT_MSG(noiseInterferenceW >= 0.0,
                   "CalculateNoiseInterferenceW returns negative value " << noiseInterferenceW);
     return noiseInterferenceW;
@@ -490,12 +529,11 @@ double
 InterferenceHelper::CalculateMuMimoPowerW(Ptr<const Event> event,
                                           const WifiSpectrumBandInfo& band) const
 {
-    auto niIt = m_niChanges.find(band);
-    NS_ASSERT(niIt != m_niChanges.end());
-    auto it = niIt->second.begin();
+    const auto& bandNiChanges = GetBandNiChanges(band);
+    auto it = bandNiChanges.niChanges.cbegin() + bandNiChanges.first;
     ++it;
     double muMimoPowerW = 0.0;
-    for (; it != niIt->second.end() && it->first < Simulator::Now(); ++it)
+    for (; it != bandNiChanges.niChanges.cend() && it->first < Simulator::Now(); ++it)
     {
         if (IsSameMuMimoTransmission(event, it->second.GetEvent()))
         {
@@ -552,10 +590,7 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
         return 1.0;
     }
     WifiMode mode = txVector.GetMode(staId);
-    uint64_t rate = mode.GetDataRate(txVector, staId);
-    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
-    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
-                                     // error rate as SISO for AWGN
+    uint64_t nbits = CalculatePayloadChunkBits(duration, txVector, staId);
     double csr = m_errorRateModel->GetChunkSuccessRate(mode,
                                                        txVector,
                                                        snir,
@@ -566,28 +601,41 @@ InterferenceHelper::CalculatePayloadChunkSuccessRate(double snir,
     return csr;
 }
 
+uint64_t
+InterferenceHelper::CalculatePayloadChunkBits(Time duration,
+                                              const WifiTxVector& txVector,
+                                              uint16_t staId) const
+{
+    WifiMode mode = txVector.GetMode(staId);
+    uint64_t rate = mode.GetDataRate(txVector, staId);
+    auto nbits = static_cast<uint64_t>(rate * duration.GetSeconds());
+    nbits /= txVector.GetNss(staId); // divide effective number of bits by NSS to achieve same chunk
+                                     // error rate as SISO for AWGN
+    return nbits;
+}
+
 double
 InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
                                         uint16_t channelWidth,
-                                        NiChangesPerBand* nis,
+                                        const NiChangesRange& nis,
                                         const WifiSpectrumBandInfo& band,
                                         uint16_t staId,
                                         std::pair<Time, Time> window) const
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << window.first << window.second);
-    double psr = 1.0; /* Packet Success Rate */
-    const auto& niIt = nis->find(band)->second;
-    auto j = niIt.cbegin();
+    // the chunks of the windowed payload, which are evaluated together by the error rate model
+    ErrorRateModel::Chunks chunks;
+    const auto& txVector = event->GetPpdu()->GetTxVector();
+    auto j = nis.first;
     Time previous = j->first;
     double muMimoPowerW = 0.0;
-    WifiMode payloadMode = event->GetPpdu()->GetTxVector().GetMode(staId);
+    WifiMode payloadMode = txVector.GetMode(staId);
     Time phyPayloadStart = j->first;
     if (event->GetPpdu()->GetType() != WIFI_PPDU_TYPE_UL_MU &&
         event->GetPpdu()->GetType() !=
             WIFI_PPDU_TYPE_DL_MU) // j->first corresponds to the start of the MU payload
     {
-        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(
-                                         event->GetPpdu()->GetTxVector());
+        phyPayloadStart = j->first + WifiPhy::CalculatePhyPreambleAndHeaderDuration(txVector);
     }
     else
     {
@@ -595,38 +643,37 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
     }
     Time windowStart = phyPayloadStart + window.first;
     Time windowEnd = phyPayloadStart + window.second;
-    NS_ABORT_IF(m_firstPowers.count(band) == 0);
-    double noiseInterferenceW = m_firstPowers.at(band);
+    double noiseInterferenceW = GetBandNiChanges(band).firstPower;
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.cend())
+    while (++j != nis.second)
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
         NS_ASSERT(current >= previous);
-        double snr = CalculateSnr(powerW,
-                                  noiseInterferenceW,
-                                  channelWidth,
-                                  event->GetPpdu()->GetTxVector().GetNss(staId));
+        double snr =
+            CalculateSnr(powerW, noiseInterferenceW, channelWidth, txVector.GetNss(staId));
         // Case 1: Both previous and current point to the windowed payload
         if (previous >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - previous,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            Time duration = Min(windowEnd, current) - previous;
+            if (!duration.IsZero())
+            {
+                chunks.emplace_back(snr, CalculatePayloadChunkBits(duration, txVector, staId));
+            }
             NS_LOG_DEBUG("Both previous and current point to the windowed payload: mode="
-                         << payloadMode << ", psr=" << psr);
+                         << payloadMode << ", snr=" << snr << ", duration=" << duration);
         }
         // Case 2: previous is before windowed payload and current is in the windowed payload
         else if (current >= windowStart)
         {
-            psr *= CalculatePayloadChunkSuccessRate(snr,
-                                                    Min(windowEnd, current) - windowStart,
-                                                    event->GetPpdu()->GetTxVector(),
-                                                    staId);
+            Time duration = Min(windowEnd, current) - windowStart;
+            if (!duration.IsZero())
+            {
+                chunks.emplace_back(snr, CalculatePayloadChunkBits(duration, txVector, staId));
+            }
             NS_LOG_DEBUG(
                 "previous is before windowed payload and current is in the windowed payload: mode="
-                << payloadMode << ", psr=" << psr);
+                << payloadMode << ", snr=" << snr << ", duration=" << duration);
         }
         noiseInterferenceW = j->second.GetPower() - powerW;
         if (IsSameMuMimoTransmission(event, j->second.GetEvent()))
@@ -644,6 +691,17 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
             break;
         }
     }
+    double psr = 1.0; /* Packet Success Rate */
+    if (!chunks.empty())
+    {
+        psr = m_errorRateModel->GetChunksSuccessRate(payloadMode,
+                                                     txVector,
+                                                     chunks,
+                                                     m_numRxAntennas,
+                                                     WIFI_PPDU_FIELD_DATA,
+                                                     staId);
+    }
+    NS_LOG_DEBUG("mode=" << payloadMode << ", chunks=" << chunks.size() << ", psr=" << psr);
     double per = 1 - psr;
     return per;
 }
@@ -651,15 +709,14 @@ InterferenceHelper::CalculatePayloadPer(Ptr<const Event> event,
 double
 InterferenceHelper::CalculatePhyHeaderSectionPsr(
     Ptr<const Event> event,
-    NiChangesPerBand* nis,
+    const NiChangesRange& nis,
     uint16_t channelWidth,
     const WifiSpectrumBandInfo& band,
     PhyEntity::PhyHeaderSections phyHeaderSections) const
 {
     NS_LOG_FUNCTION(this << band);
     double psr = 1.0; /* Packet Success Rate */
-    auto niIt = nis->find(band)->second;
-    auto j = niIt.begin();
+    auto j = nis.first;
 
     NS_ASSERT(!phyHeaderSections.empty());
     Time stopLastSection = Seconds(0);
@@ -669,10 +726,9 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
     }
 
     Time previous = j->first;
-    NS_ABORT_IF(m_firstPowers.count(band) == 0);
-    double noiseInterferenceW = m_firstPowers.at(band);
+    double noiseInterferenceW = GetBandNiChanges(band).firstPower;
     double powerW = event->GetRxPowerW(band);
-    while (++j != niIt.end())
+    while (++j != nis.second)
     {
         Time current = j->first;
         NS_LOG_DEBUG("previous= " << previous << ", current=" << current);
@@ -714,19 +770,18 @@ InterferenceHelper::CalculatePhyHeaderSectionPsr(
 
 double
 InterferenceHelper::CalculatePhyHeaderPer(Ptr<const Event> event,
-                                          NiChangesPerBand* nis,
+                                          const NiChangesRange& nis,
                                           uint16_t channelWidth,
                                           const WifiSpectrumBandInfo& band,
                                           WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    auto niIt = nis->find(band)->second;
     auto phyEntity =
         WifiPhy::GetStaticPhyEntity(event->GetPpdu()->GetTxVector().GetModulationClass());
 
     PhyEntity::PhyHeaderSections sections;
     for (const auto& section :
-         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), niIt.begin()->first))
+         phyEntity->GetPhyHeaderSections(event->GetPpdu()->GetTxVector(), nis.first->first))
     {
         if (section.first == header)
         {
@@ -751,7 +806,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
 {
     NS_LOG_FUNCTION(this << channelWidth << band << staId << relativeMpduStartStop.first
                          << relativeMpduStartStop.second);
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band),
                               noiseInterferenceW,
@@ -761,7 +816,7 @@ InterferenceHelper::CalculatePayloadSnrPer(Ptr<Event> event,
     /* calculate the SNIR at the start of the MPDU (located through windowing) and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePayloadPer(event, channelWidth, &ni, band, staId, relativeMpduStartStop);
+    double per = CalculatePayloadPer(event, channelWidth, ni, band, staId, relativeMpduStartStop);
 
     return PhyEntity::SnrPer(snr, per);
 }
@@ -772,7 +827,7 @@ InterferenceHelper::CalculateSnr(Ptr<Event> event,
                                  uint8_t nss,
                                  const WifiSpectrumBandInfo& band) const
 {
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, nss);
     return snr;
@@ -785,28 +840,33 @@ InterferenceHelper::CalculatePhyHeaderSnrPer(Ptr<Event> event,
                                              WifiPpduField header) const
 {
     NS_LOG_FUNCTION(this << band << header);
-    NiChangesPerBand ni;
+    NiChangesRange ni;
     double noiseInterferenceW = CalculateNoiseInterferenceW(event, ni, band);
     double snr = CalculateSnr(event->GetRxPowerW(band), noiseInterferenceW, channelWidth, 1);
 
     /* calculate the SNIR at the start of the PHY header and accumulate
      * all SNIR changes in the SNIR vector.
      */
-    double per = CalculatePhyHeaderPer(event, &ni, channelWidth, band, header);
+    double per = CalculatePhyHeaderPer(event, ni, channelWidth, band, header);
 
     return PhyEntity::SnrPer(snr, per);
 }
 
 InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetNextPosition(Time moment, NiChangesPerBand::iterator niIt)
+InterferenceHelper::GetNextPosition(Time moment, BandNiChanges& bandNiChanges)
 {
-    return niIt->second.upper_bound(moment);
+    return std::upper_bound(bandNiChanges.niChanges.begin() + bandNiChanges.first,
+                            bandNiChanges.niChanges.end(),
+                            moment,
+                            [](Time moment, const auto& niChange) {
+                                return moment < niChange.first;
+                            });
 }
 
 InterferenceHelper::NiChanges::iterator
-InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt)
+InterferenceHelper::GetPreviousPosition(Time moment, BandNiChanges& bandNiChanges)
 {
-    auto it = GetNextPosition(moment, niIt);
+    auto it = GetNextPosition(moment, bandNiChanges);
     // This is safe since there is always an NiChange at time 0,
     // before moment.
     --it;
@@ -814,9 +874,30 @@ InterferenceHelper::GetPreviousPosition(Time moment, NiChangesPerBand::iterator
 }
 
 InterferenceHelper::NiChanges::iterator
-InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, NiChangesPerBand::iterator niIt)
+InterferenceHelper::AddNiChangeEvent(Time moment, NiChange change, BandNiChanges& bandNiChanges)
 {
-    return niIt->second.insert(GetNextPosition(moment, niIt), std::make_pair(moment, change));
+    return bandNiChanges.niChanges.insert(GetNextPosition(moment, bandNiChanges),
+                                          std::make_pair(moment, change));
+}
+
+void
+InterferenceHelper::RemoveNiChanges(NiChanges::iterator last, BandNiChanges& bandNiChanges)
+{
+    auto& niChanges = bandNiChanges.niChanges;
+    auto index = static_cast<std::size_t>(last - niChanges.begin());
+    NS_ASSERT(index >= bandNiChanges.first);
+    if (index == bandNiChanges.first)
+    {
+        return;
+    }
+    // move the zero power noise event to the last removed NiChange
+    *last = std::make_pair(Time(0), NiChange(0.0, nullptr));
+    bandNiChanges.first = index;
+    if (2 * index >= niChanges.size())
+    {
+        niChanges.erase(niChanges.begin(), last);
+        bandNiChanges.first = 0;
+    }
 }
 
 void
@@ -831,17 +912,17 @@ InterferenceHelper::NotifyRxEnd(Time endTime, const FrequencyRange& freqRange)
 {
     NS_LOG_FUNCTION(this << endTime << freqRange);
     m_rxing = false;
-    // Update m_firstPowers for frame capture
-    for (auto niIt = m_niChanges.begin(); niIt != m_niChanges.end(); ++niIt)
+    // Update the first powers for frame capture
+    for (auto& bandNiChanges : m_bands)
     {
-        if (!IsBandInFrequencyRange(niIt->first, freqRange))
+        if (!IsBandInFrequencyRange(bandNiChanges.band, freqRange))
         {
             continue;
         }
-        NS_ASSERT(niIt->second.size() > 1);
-        auto it = GetPreviousPosition(endTime, niIt);
+        NS_ASSERT(bandNiChanges.niChanges.size() > bandNiChanges.first + 1);
+        auto it = GetPreviousPosition(endTime, bandNiChanges);
         it--;
-        m_firstPowers.find(niIt->first)->second = it->second.GetPower();
+        bandNiChanges.firstPower = it->second.GetPower();
     }
 }
 
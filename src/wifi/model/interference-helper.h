@@ -24,6 +24,8 @@
 
 #include "ns3/object.h"
 
+#include <vector>
+
 namespace ns3
 {
 
@@ -346,6 +348,19 @@ class InterferenceHelper : public Object
                                             Time duration,
                                             const WifiTxVector& txVector,
                                             uint16_t staId = SU_STA_ID) const;
+    /**
+     * Calculate the number of bits of a payload chunk given its duration and the TXVECTOR,
+     * which are used by the error rate model.
+     *
+     * \param duration the duration of the chunk
+     * \param txVector the TXVECTOR
+     * \param staId the station ID of the PSDU (only used for MU)
+     *
+     * \return the number of bits of the chunk
+     */
+    uint64_t CalculatePayloadChunkBits(Time duration,
+                                       const WifiTxVector& txVector,
+                                       uint16_t staId = SU_STA_ID) const;
 
   private:
     /**
@@ -387,19 +402,56 @@ class InterferenceHelper : public Object
     };
 
     /**
-     * typedef for a multimap of NiChange
+     * typedef for a vector of NiChange sorted by time
+     */
+    using NiChanges = std::vector<std::pair<Time, NiChange>>;
+
+    /**
+     * Range of NiChanges of an event, from the NiChange at its start to the NiChange at
+     * its end, included (i.e. the second iterator follows the NiChange at its end)
+     */
+    using NiChangesRange = std::pair<NiChanges::const_iterator, NiChanges::const_iterator>;
+
+    /**
+     * NI changes of a band.
+     *
+     * The live NiChanges of the band are the ones from index #first on. The first of them
+     * is always a zero power noise event at time 0. The NiChanges which expire are not
+     * erased: the zero power noise event is moved to the last of them, and the NiChanges
+     * before it are only erased when they are at least as many as the live ones, so that
+     * the vector behaves like a ring buffer.
+     */
+    struct BandNiChanges
+    {
+        WifiSpectrumBandInfo band; //!< the band
+        NiChanges niChanges;       //!< the NI changes, sorted by time from index #first on
+        std::size_t first;         //!< the index of the zero power noise event
+        double firstPower;         //!< the first power of the band in watts
+    };
+
+    /**
+     * Get the index of a band in #m_bands.
+     *
+     * \param band the band
+     * \return the index of the band, or the number of tracked bands if the band is not tracked
      */
-    using NiChanges = std::multimap<Time, NiChange>;
+    std::size_t GetBandIndex(const WifiSpectrumBandInfo& band) const;
 
     /**
-     * Map of NiChanges per band
+     * Get the NI changes of a band, which must be tracked.
+     *
+     * \param band the band
+     * \return the NI changes of the band
      */
-    using NiChangesPerBand = std::map<WifiSpectrumBandInfo, NiChanges>;
+    BandNiChanges& GetBandNiChanges(const WifiSpectrumBandInfo& band);
 
     /**
-     * Map of first power per band
+     * Get the NI changes of a band, which must be tracked.
+     *
+     * \param band the band
+     * \return the NI changes of the band
      */
-    using FirstPowerPerBand = std::map<WifiSpectrumBandInfo, double>;
+    const BandNiChanges& GetBandNiChanges(const WifiSpectrumBandInfo& band) const;
 
     /**
      * Check whether a given band is tracked by this interference helper.
@@ -432,13 +484,13 @@ class InterferenceHelper : public Object
      * Calculate noise and interference power in W.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the event
      * \param band the band
      *
      * \return noise and interference power
      */
     double CalculateNoiseInterferenceW(Ptr<Event> event,
-                                       NiChangesPerBand& nis,
+                                       NiChangesRange& nis,
                                        const WifiSpectrumBandInfo& band) const;
 
     /**
@@ -460,7 +512,7 @@ class InterferenceHelper : public Object
      *
      * \param event the event
      * \param channelWidth the channel width used to transmit the PSDU (in MHz)
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the event
      * \param band identify the band used by the PSDU
      * \param staId the station ID of the PSDU (only used for MU)
      * \param window time window (pair of start and end times) of PHY payload to focus on
@@ -469,7 +521,7 @@ class InterferenceHelper : public Object
      */
     double CalculatePayloadPer(Ptr<const Event> event,
                                uint16_t channelWidth,
-                               NiChangesPerBand* nis,
+                               const NiChangesRange& nis,
                                const WifiSpectrumBandInfo& band,
                                uint16_t staId,
                                std::pair<Time, Time> window) const;
@@ -478,7 +530,7 @@ class InterferenceHelper : public Object
      * can be divided into multiple chunks (e.g. due to interference from other transmissions).
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param header the PHY header to consider
@@ -486,7 +538,7 @@ class InterferenceHelper : public Object
      * \return the error rate of the HT PHY header
      */
     double CalculatePhyHeaderPer(Ptr<const Event> event,
-                                 NiChangesPerBand* nis,
+                                 const NiChangesRange& nis,
                                  uint16_t channelWidth,
                                  const WifiSpectrumBandInfo& band,
                                  WifiPpduField header) const;
@@ -494,7 +546,7 @@ class InterferenceHelper : public Object
      * Calculate the success rate of the PHY header sections for the provided event.
      *
      * \param event the event
-     * \param nis the NiChanges
+     * \param nis the NiChanges of the event
      * \param channelWidth the channel width (in MHz) for header measurement
      * \param band the band
      * \param phyHeaderSections the map of PHY header sections (\see PhyEntity::PhyHeaderSections)
@@ -502,7 +554,7 @@ class InterferenceHelper : public Object
      * \return the success rate of the PHY header sections
      */
     double CalculatePhyHeaderSectionPsr(Ptr<const Event> event,
-                                        NiChangesPerBand* nis,
+                                        const NiChangesRange& nis,
                                         uint16_t channelWidth,
                                         const WifiSpectrumBandInfo& band,
                                         PhyEntity::PhyHeaderSections phyHeaderSections) const;
@@ -510,39 +562,48 @@ class InterferenceHelper : public Object
     double m_noiseFigure;                 //!< noise figure (linear)
     Ptr<ErrorRateModel> m_errorRateModel; //!< error rate model
     uint8_t m_numRxAntennas;         //!< the number of RX antennas in the corresponding receiver
-    NiChangesPerBand m_niChanges;    //!< NI Changes for each band
-    FirstPowerPerBand m_firstPowers; //!< first power of each band in watts
-    bool m_rxing;                    //!< flag whether it is in receiving state
+    std::vector<BandNiChanges> m_bands; //!< NI changes of each band, sorted by band frequencies
+    bool m_rxing;                       //!< flag whether it is in receiving state
 
     /**
      * Returns an iterator to the first NiChange that is later than moment
      *
      * \param moment time to check from
-     * \param niIt iterator of the band to check
+     * \param bandNiChanges the NI changes of the band to check
      * \returns an iterator to the list of NiChanges
      */
-    NiChanges::iterator GetNextPosition(Time moment, NiChangesPerBand::iterator niIt);
+    NiChanges::iterator GetNextPosition(Time moment, BandNiChanges& bandNiChanges);
     /**
      * Returns an iterator to the last NiChange that is before than moment
      *
      * \param moment time to check from
-     * \param niIt iterator of the band to check
+     * \param bandNiChanges the NI changes of the band to check
      * \returns an iterator to the list of NiChanges
      */
-    NiChanges::iterator GetPreviousPosition(Time moment, NiChangesPerBand::iterator niIt);
+    NiChanges::iterator GetPreviousPosition(Time moment, BandNiChanges& bandNiChanges);
 
     /**
      * Add NiChange to the list at the appropriate position and
-     * return the iterator of the new event.
+     * return the iterator of the new event. This invalidates the other
+     * iterators to the list.
      *
      * \param moment time to check from
      * \param change the NiChange to add
-     * \param niIt iterator of the band to check
+     * \param bandNiChanges the NI changes of the band to check
      * \returns the iterator of the new event
      */
     NiChanges::iterator AddNiChangeEvent(Time moment,
                                          NiChange change,
-                                         NiChangesPerBand::iterator niIt);
+                                         BandNiChanges& bandNiChanges);
+
+    /**
+     * Remove the NiChanges that follow the zero power noise event, up to a given one.
+     * This invalidates the iterators to the list.
+     *
+     * \param last the last NiChange to remove
+     * \param bandNiChanges the NI changes of the band
+     */
+    void RemoveNiChanges(NiChanges::iterator last, BandNiChanges& bandNiChanges);
 
     /**
      * Return whether another event is a MU-MIMO event that belongs to the same transmission and to
@@ -0,0 +1,365 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "lookup-table-error-rate-model.h"
+
+#include "nist-error-rate-model.h"
+#include "wifi-tx-vector.h"
+#include "wifi-utils.h"
+
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/pointer.h"
+
+#include <cmath>
+#include <limits>
+
+namespace ns3
+{
+
+NS_LOG_COMPONENT_DEFINE("LookupTableErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED(LookupTableErrorRateModel);
+
+/// Index of the column of the largest chunk size, 2^MAX_KNOT bits
+static const uint8_t MAX_KNOT = 32;
+
+/**
+ * Interpolate linearly between two logarithms of error exponents, which may be
+ * infinite (zero or infinite exponent): the nearest value is then used.
+ *
+ * \param a the first value
+ * \param b the second value
+ * \param t the position between the values, in [0, 1]
+ * \return the interpolated value
+ */
+static double
+Interpolate(double a, double b, double t)
+{
+    if (a == b)
+    {
+        return a;
+    }
+    if (std::isinf(a) || std::isinf(b))
+    {
+        return (t < 0.5) ? a : b;
+    }
+    return a + t * (b - a);
+}
+
+bool
+LookupTableErrorRateModel::TableKey::operator==(const TableKey& other) const
+{
+    return modeUid == other.modeUid && channelWidth == other.channelWidth &&
+           guardInterval == other.guardInterval && nss == other.nss &&
+           numRxAntennas == other.numRxAntennas && field == other.field && ldpc == other.ldpc &&
+           dataMode == other.dataMode;
+}
+
+std::size_t
+LookupTableErrorRateModel::TableKeyHash::operator()(const TableKey& key) const
+{
+    uint64_t hash = key.modeUid;
+    hash = (hash << 16) ^ key.channelWidth;
+    hash = (hash << 12) ^ key.guardInterval;
+    hash = (hash << 8) ^ (key.nss | (key.numRxAntennas << 4));
+    hash = (hash << 8) ^ (key.field | (key.ldpc << 6) | (key.dataMode << 7));
+    return std::hash<uint64_t>()(hash);
+}
+
+TypeId
+LookupTableErrorRateModel::GetTypeId()
+{
+    static TypeId tid =
+        TypeId("ns3::LookupTableErrorRateModel")
+            .SetParent<ErrorRateModel>()
+            .SetGroupName("Wifi")
+            .AddConstructor<LookupTableErrorRateModel>()
+            .AddAttribute("ReferenceErrorRateModel",
+                          "The error rate model approximated by the tables, which is also used "
+                          "for the chunks that are not covered by the tables.",
+                          PointerValue(CreateObject<NistErrorRateModel>()),
+                          MakePointerAccessor(&LookupTableErrorRateModel::m_reference),
+                          MakePointerChecker<ErrorRateModel>())
+            .AddAttribute("MinSnr",
+                          "The SNR (dB) of the first point of the tables. It must be set "
+                          "before the first use of the model.",
+                          DoubleValue(-10),
+                          MakeDoubleAccessor(&LookupTableErrorRateModel::m_minSnr),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxSnr",
+                          "The SNR (dB) of the last point of the tables. It must be set "
+                          "before the first use of the model.",
+                          DoubleValue(60),
+                          MakeDoubleAccessor(&LookupTableErrorRateModel::m_maxSnr),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("SnrStep",
+                          "The SNR step (dB) between the points of the tables, which bounds "
+                          "the error of the interpolation. It must be set before the first use "
+                          "of the model.",
+                          DoubleValue(0.1),
+                          MakeDoubleAccessor(&LookupTableErrorRateModel::m_snrStep),
+                          MakeDoubleChecker<double>(0.001));
+    return tid;
+}
+
+LookupTableErrorRateModel::LookupTableErrorRateModel()
+    : m_snrPoints(0)
+{
+    NS_LOG_FUNCTION(this);
+}
+
+LookupTableErrorRateModel::~LookupTableErrorRateModel()
+{
+    NS_LOG_FUNCTION(this);
+}
+
+void
+LookupTableErrorRateModel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    m_tables.clear();
+    m_reference = nullptr;
+    ErrorRateModel::DoDispose();
+}
+
+bool
+LookupTableErrorRateModel::IsAwgn() const
+{
+    return m_reference->IsAwgn();
+}
+
+int64_t
+LookupTableErrorRateModel::AssignStreams(int64_t stream)
+{
+    return m_reference->AssignStreams(stream);
+}
+
+LookupTableErrorRateModel::Table&
+LookupTableErrorRateModel::GetTable(WifiMode mode,
+                                    const WifiTxVector& txVector,
+                                    uint8_t numRxAntennas,
+                                    WifiPpduField field) const
+{
+    if (m_snrPoints == 0)
+    {
+        NS_ABORT_MSG_IF(m_maxSnr <= m_minSnr, "The SNR range of the tables is empty");
+        m_snrPoints = static_cast<std::size_t>(std::floor((m_maxSnr - m_minSnr) / m_snrStep)) + 1;
+    }
+    TableKey key{mode.GetUid(),
+                 txVector.GetChannelWidth(),
+                 txVector.GetGuardInterval(),
+                 txVector.GetNss(),
+                 numRxAntennas,
+                 field,
+                 txVector.IsLdpc(),
+                 mode == txVector.GetMode()};
+    auto& table = m_tables[key];
+    if (table.empty())
+    {
+        table.resize(MAX_KNOT + 1);
+    }
+    return table;
+}
+
+const std::vector<double>&
+LookupTableErrorRateModel::GetColumn(Table& table,
+                                     uint8_t knot,
+                                     WifiMode mode,
+                                     const WifiTxVector& txVector,
+                                     uint8_t numRxAntennas,
+                                     WifiPpduField field,
+                                     uint16_t staId) const
+{
+    auto& column = table[knot];
+    if (!column.empty())
+    {
+        return column;
+    }
+    NS_LOG_FUNCTION(this << mode << +knot << field);
+    auto nbits = static_cast<uint64_t>(1) << knot;
+    column.resize(m_snrPoints);
+    for (std::size_t i = 0; i < m_snrPoints; ++i)
+    {
+        double snr = DbToRatio(m_minSnr + i * m_snrStep);
+        double csr =
+            m_reference
+                ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+        if (csr >= 1.0)
+        {
+            column[i] = -std::numeric_limits<double>::infinity();
+        }
+        else if (csr <= 0.0)
+        {
+            column[i] = std::numeric_limits<double>::infinity();
+        }
+        else
+        {
+            column[i] = std::log(-std::log(csr) / nbits);
+        }
+    }
+    return column;
+}
+
+bool
+LookupTableErrorRateModel::LookupExponent(Table& table,
+                                          double snr,
+                                          uint64_t nbits,
+                                          WifiMode mode,
+                                          const WifiTxVector& txVector,
+                                          uint8_t numRxAntennas,
+                                          WifiPpduField field,
+                                          uint16_t staId,
+                                          double& exponent) const
+{
+    double position = (RatioToDb(snr) - m_minSnr) / m_snrStep;
+    if (nbits == 0 || !(position >= 0.0))
+    {
+        return false;
+    }
+    double logBits = std::log2(static_cast<double>(nbits));
+    auto knot = static_cast<uint8_t>(std::min<double>(std::floor(logBits), MAX_KNOT));
+    double u = (knot < MAX_KNOT) ? logBits - knot : 0.0;
+    const auto& low = GetColumn(table, knot, mode, txVector, numRxAntennas, field, staId);
+    const std::vector<double>* high = nullptr;
+    if (u > 0.0)
+    {
+        high = &GetColumn(table, knot + 1, mode, txVector, numRxAntennas, field, staId);
+    }
+
+    if (position >= m_snrPoints - 1)
+    {
+        // above the grid, the success rate is 1 if it is 1 at the end of the grid
+        if (std::isinf(low.back()) && low.back() < 0 &&
+            (high == nullptr || (std::isinf(high->back()) && high->back() < 0)))
+        {
+            exponent = 0.0;
+            return true;
+        }
+        return false;
+    }
+    auto i = static_cast<std::size_t>(position);
+    double t = position - i;
+    double logExponent = Interpolate(low[i], low[i + 1], t);
+    if (high != nullptr)
+    {
+        logExponent = Interpolate(logExponent, Interpolate((*high)[i], (*high)[i + 1], t), u);
+    }
+    exponent = nbits * std::exp(logExponent);
+    return true;
+}
+
+double
+LookupTableErrorRateModel::DoGetChunkSuccessRate(WifiMode mode,
+                                                 const WifiTxVector& txVector,
+                                                 double snr,
+                                                 uint64_t nbits,
+                                                 uint8_t numRxAntennas,
+                                                 WifiPpduField field,
+                                                 uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << snr << nbits << +numRxAntennas << field << staId);
+    if (!txVector.IsMu())
+    {
+        auto& table = GetTable(mode, txVector, numRxAntennas, field);
+        double exponent;
+        if (LookupExponent(table,
+                           snr,
+                           nbits,
+                           mode,
+                           txVector,
+                           numRxAntennas,
+                           field,
+                           staId,
+                           exponent))
+        {
+            return std::exp(-exponent);
+        }
+    }
+    return m_reference
+        ->GetChunkSuccessRate(mode, txVector, snr, nbits, numRxAntennas, field, staId);
+}
+
+double
+LookupTableErrorRateModel::DoGetChunksSuccessRate(WifiMode mode,
+                                                  const WifiTxVector& txVector,
+                                                  const Chunks& chunks,
+                                                  uint8_t numRxAntennas,
+                                                  WifiPpduField field,
+                                                  uint16_t staId) const
+{
+    NS_LOG_FUNCTION(this << mode << chunks.size() << +numRxAntennas << field << staId);
+    if (txVector.IsMu())
+    {
+        return m_reference->GetChunksSuccessRate(mode,
+                                                 txVector,
+                                                 chunks,
+                                                 numRxAntennas,
+                                                 field,
+                                                 staId);
+    }
+    auto& table = GetTable(mode, txVector, numRxAntennas, field);
+    double exponents = 0.0;
+    double psr = 1.0;
+    for (const auto& [snr, nbits] : chunks)
+    {
+        double exponent;
+        if (LookupExponent(table,
+                           snr,
+                           nbits,
+                           mode,
+                           txVector,
+                           numRxAntennas,
+                           field,
+                           staId,
+                           exponent))
+        {
+            exponents += exponent;
+        }
+        else
+        {
+            psr *= m_reference->GetChunkSuccessRate(mode,
+                                                    txVector,
+                                                    snr,
+                                                    nbits,
+                                                    numRxAntennas,
+                                                    field,
+                                                    staId);
+        }
+    }
+    return psr * std::exp(-exponents);
+}
+
+} // namespace ns3
@@ -0,0 +1,213 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#ifndef LOOKUP_TABLE_ERROR_RATE_MODEL_H
+#define LOOKUP_TABLE_ERROR_RATE_MODEL_H
+
+#include "error-rate-model.h"
+#include "wifi-mode.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3
+{
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model which approximates another one, the reference model,
+ * with precomputed tables.
+ *
+ * The success rate of a chunk of \f$n\f$ bits is written as
+ * \f$e^{-n\,\epsilon(snr, n)}\f$, where the error exponent per bit \f$\epsilon\f$ does
+ * not depend on \f$n\f$ for the models which compute the success rate as the
+ * probability that all the bits of the chunk are received, such as the
+ * NistErrorRateModel and the YansErrorRateModel. For each combination of the
+ * mode, the TXVECTOR parameters and the PPDU field, the model tabulates
+ * \f$\ln \epsilon\f$ on a grid of SNR values (in dB) for each chunk size which
+ * is a power of two, and interpolates it linearly in the SNR (in dB) and in
+ * the logarithm of the chunk size. The columns of a table, one per chunk size,
+ * are computed with the reference model the first time they are needed.
+ *
+ * The chunks of a PPDU field (see ErrorRateModel::GetChunksSuccessRate) are
+ * evaluated together by adding their error exponents, so that the success
+ * rate of the field takes a single exponential.
+ *
+ * The chunks whose SNR is below the grid, those of MU PPDUs, and those whose
+ * SNR is above the grid unless the success rate is 1 at the end of the grid,
+ * are evaluated with the reference model.
+ */
+class LookupTableErrorRateModel : public ErrorRateModel
+{
+  public:
+    /**
+     * \brief Get the type ID.
+     * \return the object TypeId
+     */
+    static TypeId GetTypeId();
+
+    LookupTableErrorRateModel();
+    ~LookupTableErrorRateModel() override;
+
+    bool IsAwgn() const override;
+    int64_t AssignStreams(int64_t stream) override;
+
+  protected:
+    void DoDispose() override;
+
+  private:
+    double DoGetChunkSuccessRate(WifiMode mode,
+                                 const WifiTxVector& txVector,
+                                 double snr,
+                                 uint64_t nbits,
+                                 uint8_t numRxAntennas,
+                                 WifiPpduField field,
+                                 uint16_t staId) const override;
+    double DoGetChunksSuccessRate(WifiMode mode,
+                                  const WifiTxVector& txVector,
+                                  const Chunks& chunks,
+                                  uint8_t numRxAntennas,
+                                  WifiPpduField field,
+                                  uint16_t staId) const override;
+
+    /**
+     * Parameters which determine the success rates of the chunks, besides their SNR and size
+     */
+    struct TableKey
+    {
+        uint32_t modeUid;       //!< UID of the mode
+        uint16_t channelWidth;  //!< channel width of the TXVECTOR (MHz)
+        uint16_t guardInterval; //!< guard interval of the TXVECTOR (ns)
+        uint8_t nss;            //!< number of spatial streams of the TXVECTOR
+        uint8_t numRxAntennas;  //!< number of active RX antennas
+        WifiPpduField field;    //!< PPDU field
+        bool ldpc;              //!< whether the TXVECTOR uses LDPC
+        bool dataMode;          //!< whether the mode is the mode of the TXVECTOR
+
+        /**
+         * \param other the other key
+         * \return true if the keys are equal
+         */
+        bool operator==(const TableKey& other) const;
+    };
+
+    /// Hash function of the TableKey
+    struct TableKeyHash
+    {
+        /**
+         * \param key the key
+         * \return the hash of the key
+         */
+        std::size_t operator()(const TableKey& key) const;
+    };
+
+    /**
+     * Logarithms of the error exponents per bit: one column per power of two chunk size,
+     * indexed by SNR point, which is empty until it is needed
+     */
+    using Table = std::vector<std::vector<double>>;
+
+    /**
+     * Get the table of the chunks of a PPDU field.
+     *
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunks belong to
+     * \return the table
+     */
+    Table& GetTable(WifiMode mode,
+                    const WifiTxVector& txVector,
+                    uint8_t numRxAntennas,
+                    WifiPpduField field) const;
+
+    /**
+     * Get a column of a table, computing it with the reference model if needed.
+     *
+     * \param table the table
+     * \param knot the index of the column, i.e. the base 2 logarithm of the chunk size
+     * \param mode the Wi-Fi mode applicable to the chunks
+     * \param txVector TXVECTOR of the overall transmission
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunks belong to
+     * \param staId the station ID for MU
+     * \return the column
+     */
+    const std::vector<double>& GetColumn(Table& table,
+                                         uint8_t knot,
+                                         WifiMode mode,
+                                         const WifiTxVector& txVector,
+                                         uint8_t numRxAntennas,
+                                         WifiPpduField field,
+                                         uint16_t staId) const;
+
+    /**
+     * Look up the error exponent of a chunk, i.e. minus the logarithm of its success rate.
+     *
+     * \param table the table of the chunk
+     * \param snr the SNR of the chunk (linear scale)
+     * \param nbits the number of bits of the chunk
+     * \param mode the Wi-Fi mode applicable to the chunk
+     * \param txVector TXVECTOR of the overall transmission
+     * \param numRxAntennas the number of active RX antennas
+     * \param field the PPDU field to which the chunk belongs to
+     * \param staId the station ID for MU
+     * \param [out] exponent the error exponent of the chunk
+     * \return true if the chunk is covered by the table, false if it must be evaluated with
+     * the reference model
+     */
+    bool LookupExponent(Table& table,
+                        double snr,
+                        uint64_t nbits,
+                        WifiMode mode,
+                        const WifiTxVector& txVector,
+                        uint8_t numRxAntennas,
+                        WifiPpduField field,
+                        uint16_t staId,
+                        double& exponent) const;
+
+    Ptr<ErrorRateModel> m_reference; //!< the model approximated by the tables
+    double m_minSnr;                 //!< SNR of the first point of the tables (dB)
+    double m_maxSnr;                 //!< SNR of the last point of the tables (dB)
+    double m_snrStep;                //!< SNR step between the points of the tables (dB)
+
+    mutable std::size_t m_snrPoints; //!< number of points of the columns, or 0 before first use
+    mutable std::unordered_map<TableKey, Table, TableKeyHash> m_tables; //!< tables
+};
+
+} // namespace ns3
+
+#endif /* LOOKUP_TABLE_ERROR_RATE_MODEL_H */
@@ -47,8 +47,14 @@ WifiAddressHash::operator()(const Mac48Address& address) const
     uint8_t buffer[6];
     address.CopyTo(buffer);
 
-    std::string s(buffer, buffer + 6);
-    return std::hash<std::string>{}(s);
+    // pack the address in an integer rather than hashing a string, as this is
+    // computed every time the state of a remote station is looked up
+    uint64_t value = 0;
+    for (const auto byte : buffer)
+    {
+        value = (value << 8) | byte;
+    }
+    return std::hash<uint64_t>{}(value);
 }
 
 WifiAc::WifiAc(uint8_t lowTid, uint8_t highTid)
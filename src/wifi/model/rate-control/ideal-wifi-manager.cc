@@ -185,31 +185,26 @@ IdealWifiManager::BuildSnrThresholds()
     }
 }
 
+uint64_t
+IdealWifiManager::GetThresholdKey(const WifiTxVector& txVector)
+{
+    return (static_cast<uint64_t>(txVector.GetMode().GetUid()) << 32) |
+           (static_cast<uint64_t>(txVector.GetChannelWidth()) << 8) | txVector.GetNss();
+}
+
 double
 IdealWifiManager::GetSnrThreshold(WifiTxVector txVector)
 {
     NS_LOG_FUNCTION(this << txVector);
-    auto it = std::find_if(m_thresholds.begin(),
-                           m_thresholds.end(),
-                           [&txVector](const std::pair<double, WifiTxVector>& p) -> bool {
-                               return ((txVector.GetMode() == p.second.GetMode()) &&
-                                       (txVector.GetNss() == p.second.GetNss()) &&
-                                       (txVector.GetChannelWidth() == p.second.GetChannelWidth()));
-                           });
+    auto it = m_thresholds.find(GetThresholdKey(txVector));
     if (it == m_thresholds.end())
     {
         // This means capabilities have changed in runtime, hence rebuild SNR thresholds
         BuildSnrThresholds();
-        it = std::find_if(m_thresholds.begin(),
-                          m_thresholds.end(),
-                          [&txVector](const std::pair<double, WifiTxVector>& p) -> bool {
-                              return ((txVector.GetMode() == p.second.GetMode()) &&
-                                      (txVector.GetNss() == p.second.GetNss()) &&
-                                      (txVector.GetChannelWidth() == p.second.GetChannelWidth()));
-                          });
+        it = m_thresholds.find(GetThresholdKey(txVector));
         NS_ASSERT_MSG(it != m_thresholds.end(), "SNR threshold not found");
     }
-    return it->first;
+    return it->second;
 }
 
 void
@@ -217,7 +212,7 @@ IdealWifiManager::AddSnrThreshold(WifiTxVector txVector, double snr)
 {
     NS_LOG_FUNCTION(this << txVector.GetMode().GetUniqueName() << txVector.GetChannelWidth()
                          << snr);
-    m_thresholds.emplace_back(snr, txVector);
+    m_thresholds.emplace(GetThresholdKey(txVector), snr);
 }
 
 WifiRemoteStation*
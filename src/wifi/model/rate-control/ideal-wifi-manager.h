@@ -23,6 +23,8 @@
 #include "ns3/traced-value.h"
 #include "ns3/wifi-remote-station-manager.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 
@@ -139,13 +141,22 @@ class IdealWifiManager : public WifiRemoteStationManager
                               uint8_t nss) const;
 
     /**
-     * A vector of <snr, WifiTxVector> pair holding the minimum SNR for the
-     * WifiTxVector
+     * Return the key of the SNR threshold of a WifiTxVector in the hash table,
+     * made of the mode, the channel width and the number of spatial streams.
+     *
+     * \param txVector the WifiTxVector storing mode, channel width, and Nss
+     * \return the key of the SNR threshold
+     */
+    static uint64_t GetThresholdKey(const WifiTxVector& txVector);
+
+    /**
+     * A hash table holding the minimum SNR of the WifiTxVectors, indexed by
+     * the key returned by GetThresholdKey
      */
-    typedef std::vector<std::pair<double, WifiTxVector>> Thresholds;
+    using Thresholds = std::unordered_map<uint64_t, double>;
 
     double m_ber;            //!< The maximum Bit Error Rate acceptable at any transmission mode
-    Thresholds m_thresholds; //!< List of WifiTxVector and the minimum SNR pair
+    Thresholds m_thresholds; //!< Minimum SNR of the WifiTxVectors
 
     TracedValue<uint64_t> m_currentRate; //!< Trace rate changes
 };
@@ -30,13 +30,15 @@
 #include "ns3/wifi-mpdu-type.h"
 #include "ns3/wifi-remote-station-manager.h"
 
+#include <unordered_map>
+
 namespace ns3
 {
 
 /**
  * Data structure to save transmission time calculations per rate.
  */
-typedef std::map<WifiMode, Time> TxTime;
+typedef std::unordered_map<WifiMode, Time, WifiModeHash> TxTime;
 
 /**
  * \enum McsGroupType
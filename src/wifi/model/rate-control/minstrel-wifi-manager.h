@@ -25,7 +25,7 @@
 #include "ns3/wifi-remote-station-manager.h"
 
 #include <fstream>
-#include <map>
+#include <unordered_map>
 
 namespace ns3
 {
@@ -338,11 +338,10 @@ class MinstrelWifiManager : public WifiRemoteStationManager
     void PrintTable(MinstrelWifiRemoteStation* station);
 
     /**
-     * typedef for a vector of a pair of Time, WifiMode.
-     * Essentially a map from WifiMode to its corresponding transmission time
-     * to transmit a reference packet.
+     * typedef for a hash table from WifiMode to its corresponding transmission
+     * time to transmit a reference packet.
      */
-    typedef std::map<WifiMode, Time> TxTime;
+    typedef std::unordered_map<WifiMode, Time, WifiModeHash> TxTime;
 
     TxTime m_calcTxTime;      ///< to hold all the calculated TxTime for all modes
     Time m_updateStats;       ///< how frequent do we calculate the stats
@@ -42,6 +42,12 @@ operator!=(const WifiMode& a, const WifiMode& b)
     return a.GetUid() != b.GetUid();
 }
 
+std::size_t
+WifiModeHash::operator()(const WifiMode& mode) const
+{
+    return std::hash<uint32_t>{}(mode.GetUid());
+}
+
 bool
 operator<(const WifiMode& a, const WifiMode& b)
 {
@@ -221,6 +221,22 @@ bool operator==(const WifiMode& a, const WifiMode& b);
  */
 bool operator!=(const WifiMode& a, const WifiMode& b);
 
+/**
+ * \ingroup wifi
+ * Function object to compute the hash of a WifiMode, so that WifiModes can be
+ * used as keys of unordered containers.
+ */
+struct WifiModeHash
+{
+    /**
+     * Functional operator for WifiMode hash computation.
+     *
+     * \param mode the WifiMode
+     * \return the hash
+     */
+    std::size_t operator()(const WifiMode& mode) const;
+};
+
 /**
  * Compare two WifiModes
  *
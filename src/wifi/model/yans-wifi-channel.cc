@@ -25,6 +25,8 @@
 #include "wifi-utils.h"
 #include "yans-wifi-phy.h"
 
+#include "ns3/boolean.h"
+#include "ns3/double.h"
 #include "ns3/log.h"
 #include "ns3/mobility-model.h"
 #include "ns3/node.h"
@@ -33,6 +35,10 @@
 #include "ns3/propagation-loss-model.h"
 #include "ns3/simulator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 namespace ns3
 {
 
@@ -57,11 +63,33 @@ YansWifiChannel::GetTypeId()
                           "A pointer to the propagation delay model attached to this channel.",
                           PointerValue(),
                           MakePointerAccessor(&YansWifiChannel::m_delay),
-                          MakePointerChecker<PropagationDelayModel>());
+                          MakePointerChecker<PropagationDelayModel>())
+            .AddAttribute("RxPowerFloor",
+                          "The RX power (dBm) below which no reception is scheduled. "
+                          "The default value schedules all the receptions.",
+                          DoubleValue(-std::numeric_limits<double>::max()),
+                          MakeDoubleAccessor(&YansWifiChannel::m_rxPowerFloorDbm),
+                          MakeDoubleChecker<double>())
+            .AddAttribute("MaxRange",
+                          "The distance (m) beyond which no reception is scheduled. The "
+                          "stationary PHYs are kept in a grid of cells of this size, so that "
+                          "the PHYs of the cells which are not around the sender are not "
+                          "considered. The default value disables the grid.",
+                          DoubleValue(std::numeric_limits<double>::max()),
+                          MakeDoubleAccessor(&YansWifiChannel::m_maxRange),
+                          MakeDoubleChecker<double>(0))
+            .AddAttribute("CacheLoss",
+                          "Whether the RX power between two stationary PHYs is cached until "
+                          "one of them changes course. Only valid with deterministic "
+                          "propagation loss models.",
+                          BooleanValue(false),
+                          MakeBooleanAccessor(&YansWifiChannel::m_cacheLoss),
+                          MakeBooleanChecker());
     return tid;
 }
 
 YansWifiChannel::YansWifiChannel()
+    : m_gridCellSize(0)
 {
     NS_LOG_FUNCTION(this);
 }
@@ -72,6 +100,26 @@ YansWifiChannel::~YansWifiChannel()
     m_phyList.clear();
 }
 
+void
+YansWifiChannel::DoDispose()
+{
+    NS_LOG_FUNCTION(this);
+    for (const auto& [mobility, phys] : m_mobilityPhys)
+    {
+        m_phyStates[phys.front()].mobility->TraceDisconnectWithoutContext(
+            "CourseChange",
+            MakeCallback(&YansWifiChannel::CourseChanged, this));
+    }
+    m_mobilityPhys.clear();
+    m_phyStates.clear();
+    m_grid.clear();
+    m_movingPhys.clear();
+    m_lossCache.clear();
+    m_phyIndex.clear();
+    m_phyList.clear();
+    Channel::DoDispose();
+}
+
 void
 YansWifiChannel::SetPropagationLossModel(const Ptr<PropagationLossModel> loss)
 {
@@ -92,42 +140,236 @@ YansWifiChannel::Send(Ptr<YansWifiPhy> sender, Ptr<const WifiPpdu> ppdu, double
     NS_LOG_FUNCTION(this << sender << ppdu << txPowerDbm);
     Ptr<MobilityModel> senderMobility = sender->GetMobility();
     NS_ASSERT(senderMobility);
-    for (auto i = m_phyList.begin(); i != m_phyList.end(); i++)
+    bool useGrid = (m_maxRange < std::numeric_limits<double>::max());
+    if (useGrid || m_cacheLoss)
+    {
+        TrackPhys();
+    }
+
+    std::vector<std::size_t> candidates;
+    if (useGrid)
+    {
+        GetCandidates(senderMobility, candidates);
+    }
+    else
     {
-        if (sender != (*i))
+        candidates.resize(m_phyList.size());
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            candidates[i] = i;
+        }
+    }
+
+    // select the receivers first, so that the RX power of those which are not
+    // cached is computed at once
+    std::size_t senderIndex = m_cacheLoss ? m_phyIndex.at(PeekPointer(sender)) : 0;
+    std::vector<std::size_t> receivers;
+    std::vector<Ptr<MobilityModel>> receiverMobilities;
+    std::vector<double> rxPowersDbm;
+    std::vector<Ptr<MobilityModel>> lossReceivers;
+    for (std::size_t index : candidates)
+    {
+        const Ptr<YansWifiPhy>& phy = m_phyList[index];
+        if (sender == phy)
+        {
+            continue;
+        }
+        // For now don't account for inter channel interference nor channel bonding
+        if (phy->GetChannelNumber() != sender->GetChannelNumber())
+        {
+            continue;
+        }
+
+        Ptr<MobilityModel> receiverMobility = phy->GetMobility()->GetObject<MobilityModel>();
+        if (useGrid && senderMobility->GetDistanceFrom(receiverMobility) > m_maxRange)
+        {
+            continue;
+        }
+        double rxPowerDbm = std::numeric_limits<double>::quiet_NaN();
+        if (m_cacheLoss && m_phyStates[senderIndex].stationary && m_phyStates[index].stationary)
         {
-            // For now don't account for inter channel interference nor channel bonding
-            if ((*i)->GetChannelNumber() != sender->GetChannelNumber())
+            auto it = m_lossCache.find((uint64_t(senderIndex) << 32) | index);
+            if (it != m_lossCache.end() && it->second.txPowerDbm == txPowerDbm &&
+                it->second.txGeneration == m_phyStates[senderIndex].generation &&
+                it->second.rxGeneration == m_phyStates[index].generation)
             {
-                continue;
+                rxPowerDbm = it->second.rxPowerDbm;
             }
+        }
+        if (std::isnan(rxPowerDbm))
+        {
+            lossReceivers.push_back(receiverMobility);
+        }
+        receivers.push_back(index);
+        receiverMobilities.push_back(receiverMobility);
+        rxPowersDbm.push_back(rxPowerDbm);
+    }
+
+    std::vector<double> lossRxPowersDbm;
+    m_loss->CalcRxPowerBatch(txPowerDbm, senderMobility, lossReceivers, lossRxPowersDbm);
 
-            Ptr<MobilityModel> receiverMobility = (*i)->GetMobility()->GetObject<MobilityModel>();
-            Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
-            double rxPowerDbm = m_loss->CalcRxPower(txPowerDbm, senderMobility, receiverMobility);
-            NS_LOG_DEBUG("propagation: txPower="
-                         << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
-                         << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
-                         << "m, delay=" << delay);
-            Ptr<NetDevice> dstNetDevice = (*i)->GetDevice();
-            uint32_t dstNode;
-            if (!dstNetDevice)
+    std::size_t lossIndex = 0;
+    for (std::size_t i = 0; i < receivers.size(); ++i)
+    {
+        std::size_t index = receivers[i];
+        double rxPowerDbm = rxPowersDbm[i];
+        if (std::isnan(rxPowerDbm))
+        {
+            rxPowerDbm = lossRxPowersDbm[lossIndex++];
+            if (m_cacheLoss && m_phyStates[senderIndex].stationary &&
+                m_phyStates[index].stationary)
             {
-                dstNode = 0xffffffff;
+                m_lossCache[(uint64_t(senderIndex) << 32) | index] = {
+                    txPowerDbm,
+                    rxPowerDbm,
+                    m_phyStates[senderIndex].generation,
+                    m_phyStates[index].generation};
             }
-            else
+        }
+        if (rxPowerDbm < m_rxPowerFloorDbm)
+        {
+            NS_LOG_LOGIC("RX power " << rxPowerDbm << " dBm below the floor");
+            continue;
+        }
+
+        Ptr<MobilityModel> receiverMobility = receiverMobilities[i];
+        Time delay = m_delay->GetDelay(senderMobility, receiverMobility);
+        NS_LOG_DEBUG("propagation: txPower="
+                     << txPowerDbm << "dbm, rxPower=" << rxPowerDbm << "dbm, "
+                     << "distance=" << senderMobility->GetDistanceFrom(receiverMobility)
+                     << "m, delay=" << delay);
+        Ptr<NetDevice> dstNetDevice = m_phyList[index]->GetDevice();
+        uint32_t dstNode;
+        if (!dstNetDevice)
+        {
+            dstNode = 0xffffffff;
+        }
+        else
+        {
+            dstNode = dstNetDevice->GetNode()->GetId();
+        }
+
+        Simulator::ScheduleWithContext(dstNode,
+                                       delay,
+                                       &YansWifiChannel::Receive,
+                                       m_phyList[index],
+                                       ppdu,
+                                       rxPowerDbm);
+    }
+}
+
+void
+YansWifiChannel::TrackPhys() const
+{
+    double cellSize = (m_maxRange < std::numeric_limits<double>::max()) ? m_maxRange : 0;
+    if (cellSize != m_gridCellSize)
+    {
+        NS_LOG_FUNCTION(this << cellSize);
+        m_gridCellSize = cellSize;
+        m_grid.clear();
+        for (std::size_t index = 0; index < m_phyStates.size(); ++index)
+        {
+            m_phyStates[index].gridded = false;
+            UpdatePhy(index);
+        }
+    }
+    for (std::size_t index = m_phyStates.size(); index < m_phyList.size(); ++index)
+    {
+        Ptr<MobilityModel> mobility = m_phyList[index]->GetMobility();
+        NS_ASSERT_MSG(mobility, "YansWifiPhy " << index << " has no mobility model");
+        m_phyStates.push_back({mobility, 0, false, false, 0});
+        std::vector<std::size_t>& phys = m_mobilityPhys[PeekPointer(mobility)];
+        if (phys.empty())
+        {
+            mobility->TraceConnectWithoutContext(
+                "CourseChange",
+                MakeCallback(&YansWifiChannel::CourseChanged, this));
+        }
+        phys.push_back(index);
+        UpdatePhy(index);
+    }
+}
+
+void
+YansWifiChannel::UpdatePhy(std::size_t index) const
+{
+    NS_LOG_FUNCTION(this << index);
+    PhyState& state = m_phyStates[index];
+    state.generation++;
+    if (state.gridded)
+    {
+        std::vector<std::size_t>& phys = m_grid[state.cell];
+        *std::find(phys.begin(), phys.end(), index) = phys.back();
+        phys.pop_back();
+        state.gridded = false;
+    }
+    else if (!state.stationary)
+    {
+        auto it = std::find(m_movingPhys.begin(), m_movingPhys.end(), index);
+        if (it != m_movingPhys.end())
+        {
+            *it = m_movingPhys.back();
+            m_movingPhys.pop_back();
+        }
+    }
+
+    Vector velocity = state.mobility->GetVelocity();
+    state.stationary = (velocity.x == 0 && velocity.y == 0 && velocity.z == 0);
+    if (!state.stationary)
+    {
+        m_movingPhys.push_back(index);
+    }
+    else if (m_gridCellSize > 0)
+    {
+        state.cell = GetCell(state.mobility->GetPosition(), 0, 0);
+        state.gridded = true;
+        m_grid[state.cell].push_back(index);
+    }
+}
+
+uint64_t
+YansWifiChannel::GetCell(const Vector& position, int32_t dx, int32_t dy) const
+{
+    auto cx = static_cast<int32_t>(std::floor(position.x / m_gridCellSize)) + dx;
+    auto cy = static_cast<int32_t>(std::floor(position.y / m_gridCellSize)) + dy;
+    return (uint64_t(uint32_t(cx)) << 32) | uint32_t(cy);
+}
+
+void
+YansWifiChannel::CourseChanged(Ptr<const MobilityModel> mobility) const
+{
+    NS_LOG_FUNCTION(this << mobility);
+    auto it = m_mobilityPhys.find(PeekPointer(mobility));
+    if (it != m_mobilityPhys.end())
+    {
+        for (std::size_t index : it->second)
+        {
+            UpdatePhy(index);
+        }
+    }
+}
+
+void
+YansWifiChannel::GetCandidates(Ptr<MobilityModel> sender,
+                               std::vector<std::size_t>& candidates) const
+{
+    NS_LOG_FUNCTION(this << sender);
+    candidates = m_movingPhys;
+    Vector position = sender->GetPosition();
+    for (int32_t dx = -1; dx <= 1; ++dx)
+    {
+        for (int32_t dy = -1; dy <= 1; ++dy)
+        {
+            auto it = m_grid.find(GetCell(position, dx, dy));
+            if (it != m_grid.end())
             {
-                dstNode = dstNetDevice->GetNode()->GetId();
+                candidates.insert(candidates.end(), it->second.begin(), it->second.end());
             }
-
-            Simulator::ScheduleWithContext(dstNode,
-                                           delay,
-                                           &YansWifiChannel::Receive,
-                                           (*i),
-                                           ppdu,
-                                           rxPowerDbm);
         }
     }
+    // keep the order of the PHY list, so that the receptions are scheduled
+    // in the same order as without the grid
+    std::sort(candidates.begin(), candidates.end());
 }
 
 void
@@ -165,6 +407,7 @@ void
 YansWifiChannel::Add(Ptr<YansWifiPhy> phy)
 {
     NS_LOG_FUNCTION(this << phy);
+    m_phyIndex[PeekPointer(phy)] = m_phyList.size();
     m_phyList.push_back(phy);
 }
 
@@ -21,10 +21,15 @@
 #define YANS_WIFI_CHANNEL_H
 
 #include "ns3/channel.h"
+#include "ns3/vector.h"
+
+#include <unordered_map>
+#include <vector>
 
 namespace ns3
 {
 
+class MobilityModel;
 class NetDevice;
 class PropagationLossModel;
 class PropagationDelayModel;
@@ -41,6 +46,23 @@ class WifiPpdu;
  * class and supports an ns3::PropagationLossModel and an
  * ns3::PropagationDelayModel.  By default, no propagation models are set;
  * it is the caller's responsibility to set them before using the channel.
+ *
+ * By default, every PPDU is delivered to every other PHY on the same channel
+ * number.  With many PHYs, most of these receptions are far below the RX
+ * sensitivity and are dropped on arrival, so three attributes allow
+ * skipping them at the source:
+ *
+ *  - RxPowerFloor: no reception is scheduled below this RX power;
+ *  - MaxRange: no reception is scheduled beyond this distance. The PHYs
+ *    which do not move are kept in a grid of cells of this size, so that
+ *    only the PHYs of the cells around the sender, and the moving PHYs, are
+ *    considered at all;
+ *  - CacheLoss: the RX power between two PHYs which do not move is
+ *    computed once, and computed again after one of them changes course.
+ *    This is only valid with deterministic propagation loss models.
+ *
+ * The grid and the cache follow the CourseChange trace of the mobility
+ * models; a PHY is considered not to move while its velocity is zero.
  */
 class YansWifiChannel : public Channel
 {
@@ -96,12 +118,71 @@ class YansWifiChannel : public Channel
      */
     int64_t AssignStreams(int64_t stream);
 
+  protected:
+    void DoDispose() override;
+
   private:
     /**
      * A vector of pointers to YansWifiPhy.
      */
     typedef std::vector<Ptr<YansWifiPhy>> PhyList;
 
+    /// State of a PHY, for the grid and the loss cache
+    struct PhyState
+    {
+        Ptr<MobilityModel> mobility; //!< Mobility model of the PHY
+        uint32_t generation;         //!< Number of course changes of the PHY
+        bool stationary;             //!< Whether the velocity of the PHY is zero
+        bool gridded;                //!< Whether the PHY is in #m_grid
+        uint64_t cell;               //!< Grid cell of the PHY, if gridded
+    };
+
+    /// RX power between two PHYs, valid until one of them changes course
+    struct CachedLoss
+    {
+        double txPowerDbm;     //!< TX power
+        double rxPowerDbm;     //!< RX power
+        uint32_t txGeneration; //!< Generation of the sender
+        uint32_t rxGeneration; //!< Generation of the receiver
+    };
+
+    /**
+     * Start following the PHYs added since the last call, and rebuild the
+     * grid if the MaxRange attribute changed.
+     */
+    void TrackPhys() const;
+
+    /**
+     * Update the state of a PHY after it was added or changed course.
+     *
+     * \param index the index of the PHY in #m_phyList
+     */
+    void UpdatePhy(std::size_t index) const;
+
+    /**
+     * \param position a position
+     * \param dx the offset of the cell along the x axis, in cells
+     * \param dy the offset of the cell along the y axis, in cells
+     * \return the key of the grid cell of the position, moved by the offsets
+     */
+    uint64_t GetCell(const Vector& position, int32_t dx, int32_t dy) const;
+
+    /**
+     * Called by the CourseChange trace of the mobility models of the PHYs.
+     *
+     * \param mobility the mobility model which changed course
+     */
+    void CourseChanged(Ptr<const MobilityModel> mobility) const;
+
+    /**
+     * Get the PHYs which may be within MaxRange of a position: those of the
+     * grid cells around the position and the moving ones.
+     *
+     * \param sender the mobility model of the sender
+     * \param [out] candidates the indices of the PHYs, in increasing order
+     */
+    void GetCandidates(Ptr<MobilityModel> sender, std::vector<std::size_t>& candidates) const;
+
     /**
      * This method is scheduled by Send for each associated YansWifiPhy.
      * The method then calls the corresponding YansWifiPhy that the first
@@ -116,6 +197,22 @@ class YansWifiChannel : public Channel
     PhyList m_phyList;                  //!< List of YansWifiPhys connected to this YansWifiChannel
     Ptr<PropagationLossModel> m_loss;   //!< Propagation loss model
     Ptr<PropagationDelayModel> m_delay; //!< Propagation delay model
+
+    double m_rxPowerFloorDbm; //!< RX power below which no reception is scheduled
+    double m_maxRange;        //!< Distance beyond which no reception is scheduled
+    bool m_cacheLoss;         //!< Whether the RX power between stationary PHYs is cached
+
+    /// Index of each PHY in #m_phyList
+    std::unordered_map<const YansWifiPhy*, std::size_t> m_phyIndex;
+    mutable std::vector<PhyState> m_phyStates; //!< State of the followed PHYs
+    /// Indices of the followed PHYs, by mobility model
+    mutable std::unordered_map<const MobilityModel*, std::vector<std::size_t>> m_mobilityPhys;
+    mutable double m_gridCellSize; //!< Size of the grid cells, 0 if there is no grid
+    /// Indices of the stationary PHYs, by grid cell
+    mutable std::unordered_map<uint64_t, std::vector<std::size_t>> m_grid;
+    mutable std::vector<std::size_t> m_movingPhys; //!< Indices of the moving PHYs
+    /// Cached RX power, by pair of sender and receiver indices
+    mutable std::unordered_map<uint64_t, CachedLoss> m_lossCache;
 };
 
 } // namespace ns3
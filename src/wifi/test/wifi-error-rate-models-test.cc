@@ -29,7 +29,9 @@
 #include "ns3/he-phy.h" //includes HT and VHT
 #include "ns3/interference-helper.h"
 #include "ns3/log.h"
+#include "ns3/lookup-table-error-rate-model.h"
 #include "ns3/nist-error-rate-model.h"
+#include "ns3/pointer.h"
 #include "ns3/table-based-error-rate-model.h"
 #include "ns3/test.h"
 #include "ns3/wifi-phy.h"
@@ -1039,6 +1041,90 @@ TableBasedErrorRateTestCase::DoRun()
     }
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Lookup Table Error Rate Model Test Case
+ *
+ * Check that the success rates of the LookupTableErrorRateModel stay within a bound
+ * of those of its reference model, for single chunks and for lists of chunks,
+ * at SNR values and chunk sizes which are not on the points of the tables.
+ */
+class LookupTableErrorRateTestCase : public TestCase
+{
+  public:
+    /**
+     * Constructor
+     *
+     * \param testName the test name
+     * \param reference the reference error rate model
+     * \param modes the modes to test
+     */
+    LookupTableErrorRateTestCase(const std::string& testName,
+                                 Ptr<ErrorRateModel> reference,
+                                 const std::vector<WifiMode>& modes);
+
+  private:
+    void DoRun() override;
+
+    Ptr<ErrorRateModel> m_reference; ///< The reference error rate model
+    std::vector<WifiMode> m_modes;   ///< The modes to test
+};
+
+LookupTableErrorRateTestCase::LookupTableErrorRateTestCase(const std::string& testName,
+                                                           Ptr<ErrorRateModel> reference,
+                                                           const std::vector<WifiMode>& modes)
+    : TestCase(testName),
+      m_reference(reference),
+      m_modes(modes)
+{
+}
+
+void
+LookupTableErrorRateTestCase::DoRun()
+{
+    const double tolerance = 0.005;
+    Ptr<LookupTableErrorRateModel> lut = CreateObject<LookupTableErrorRateModel>();
+    lut->SetAttribute("ReferenceErrorRateModel", PointerValue(m_reference));
+
+    for (const auto& mode : m_modes)
+    {
+        WifiTxVector txVector;
+        txVector.SetMode(mode);
+        double maxError = 0;
+        for (double snrDb = -5.03; snrDb <= 45; snrDb += 0.0777)
+        {
+            double snr = std::pow(10, snrDb / 10);
+            for (uint64_t nbits : {1, 37, 1000, 11700, 120000})
+            {
+                double expected = m_reference->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                double csr = lut->GetChunkSuccessRate(mode, txVector, snr, nbits);
+                maxError = std::max(maxError, std::abs(csr - expected));
+                NS_TEST_ASSERT_MSG_EQ_TOL(csr,
+                                          expected,
+                                          tolerance,
+                                          "Chunk of " << nbits << " bits at " << snrDb << " dB for "
+                                                      << mode);
+            }
+            // a list of chunks, as for a payload hit by interference
+            ErrorRateModel::Chunks chunks{{snr, 1500}, {snr * 0.8, 20}, {snr * 1.3, 9000}};
+            double expected = 1.0;
+            for (const auto& [chunkSnr, nbits] : chunks)
+            {
+                expected *= m_reference->GetChunkSuccessRate(mode, txVector, chunkSnr, nbits);
+            }
+            double psr = lut->GetChunksSuccessRate(mode, txVector, chunks);
+            NS_TEST_ASSERT_MSG_EQ_TOL(psr,
+                                      expected,
+                                      tolerance,
+                                      "Chunks at " << snrDb << " dB for " << mode);
+        }
+        NS_LOG_INFO(GetName() << ": " << mode << " max error " << maxError);
+    }
+    lut->Dispose();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -1106,6 +1192,37 @@ WifiErrorRateModelsTestSuite::WifiErrorRateModelsTestSuite()
                                                 HePhy::GetHeMcs11(),
                                                 1458),
                 TestCase::QUICK);
+    std::vector<WifiMode> ofdmModes;
+    for (uint64_t rate : {6, 9, 12, 18, 24, 36, 48, 54})
+    {
+        ofdmModes.push_back(OfdmPhy::GetOfdmRate(rate * 1000000));
+    }
+    std::vector<WifiMode> htHeModes;
+    for (uint8_t mcs = 0; mcs < 8; ++mcs)
+    {
+        htHeModes.push_back(HtPhy::GetHtMcs(mcs));
+    }
+    for (uint8_t mcs = 0; mcs < 12; ++mcs)
+    {
+        htHeModes.push_back(HePhy::GetHeMcs(mcs));
+    }
+    AddTestCase(new LookupTableErrorRateTestCase("LookupTableNistOfdm",
+                                                 CreateObject<NistErrorRateModel>(),
+                                                 ofdmModes),
+                TestCase::QUICK);
+    AddTestCase(new LookupTableErrorRateTestCase("LookupTableNistHtHe",
+                                                 CreateObject<NistErrorRateModel>(),
+                                                 htHeModes),
+                TestCase::QUICK);
+    AddTestCase(new LookupTableErrorRateTestCase("LookupTableYansOfdm",
+                                                 CreateObject<YansErrorRateModel>(),
+                                                 ofdmModes),
+                TestCase::QUICK);
+    AddTestCase(new LookupTableErrorRateTestCase("LookupTableTableBasedHt",
+                                                 CreateObject<TableBasedErrorRateModel>(),
+                                                 std::vector<WifiMode>(htHeModes.begin(),
+                                                                       htHeModes.begin() + 8)),
+                TestCase::QUICK);
 }
 
 static WifiErrorRateModelsTestSuite wifiErrorRateModelsTestSuite; ///< the test suite
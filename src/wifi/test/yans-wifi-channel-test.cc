@@ -0,0 +1,279 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * NIST-developed software is provided by NIST as a public
+ * service. You may use, copy and distribute copies of the software in
+ * any medium, provided that you keep intact this entire notice. You
+ * may improve, modify and create derivative works of the software or
+ * any portion of the software, and you may copy and distribute such
+ * modifications or works. Modified works should carry a notice
+ * stating that you changed the software and should note the date and
+ * nature of any such change. Please explicitly acknowledge the
+ * National Institute of Standards and Technology as the source of the
+ * software.
+ *
+ * NIST-developed software is expressly provided "AS IS." NIST MAKES
+ * NO WARRANTY OF ANY KIND, EXPRESS, IMPLIED, IN FACT OR ARISING BY
+ * OPERATION OF LAW, INCLUDING, WITHOUT LIMITATION, THE IMPLIED
+ * WARRANTY OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE,
+ * NON-INFRINGEMENT AND DATA ACCURACY. NIST NEITHER REPRESENTS NOR
+ * WARRANTS THAT THE OPERATION OF THE SOFTWARE WILL BE UNINTERRUPTED
+ * OR ERROR-FREE, OR THAT ANY DEFECTS WILL BE CORRECTED. NIST DOES NOT
+ * WARRANT OR MAKE ANY REPRESENTATIONS REGARDING THE USE OF THE
+ * SOFTWARE OR THE RESULTS THEREOF, INCLUDING BUT NOT LIMITED TO THE
+ * CORRECTNESS, ACCURACY, RELIABILITY, OR USEFULNESS OF THE SOFTWARE.
+ *
+ * You are solely responsible for determining the appropriateness of
+ * using and distributing the software and you assume all risks
+ * associated with its use, including but not limited to the risks and
+ * costs of program errors, compliance with applicable laws, damage to
+ * or loss of data, programs or equipment, and the unavailability or
+ * interruption of operation. This software is not intended to be used
+ * in any situation where a failure could cause risk of injury or
+ * damage to property. The software developed by NIST employees is not
+ * subject to copyright protection within the United States.
+ */
+
+#include "ns3/boolean.h"
+#include "ns3/constant-velocity-mobility-model.h"
+#include "ns3/double.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/node-container.h"
+#include "ns3/packet.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+#include "ns3/test.h"
+#include "ns3/uinteger.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/yans-wifi-channel.h"
+#include "ns3/yans-wifi-helper.h"
+
+#include <limits>
+#include <numeric>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Check that the RX power floor, the grid and the loss cache of the
+ * YansWifiChannel only skip the receptions which would be dropped anyway
+ *
+ * Stationary nodes on a square grid, and nodes crossing it, broadcast
+ * packets. The receptions of each node are counted with the default
+ * channel and with the three optimizations, set so that they only cull the
+ * signals below the RX sensitivity: the counts must be the same. A smaller
+ * MaxRange must cull receptions.
+ */
+class YansWifiChannelCullingTest : public TestCase
+{
+  public:
+    YansWifiChannelCullingTest();
+
+  private:
+    void DoRun() override;
+
+    /// Counts of the receptions of each node
+    struct Counts
+    {
+        std::vector<uint32_t> rxBegin; //!< Receptions started
+        std::vector<uint32_t> rxEnd;   //!< Receptions ended successfully
+    };
+
+    /**
+     * Run the scenario.
+     *
+     * \param rxPowerFloor the RxPowerFloor attribute of the channel (dBm)
+     * \param maxRange the MaxRange attribute of the channel (m)
+     * \param cacheLoss the CacheLoss attribute of the channel
+     * \return the counts of the receptions
+     */
+    Counts Run(double rxPowerFloor, double maxRange, bool cacheLoss);
+
+    /**
+     * Broadcast a packet.
+     *
+     * \param device the device which sends the packet
+     */
+    void Send(Ptr<WifiNetDevice> device);
+
+    /**
+     * Count a reception start.
+     *
+     * \param node the index of the receiving node
+     * \param packet the packet
+     * \param rxPowersW the RX power per band
+     */
+    void RxBegin(uint32_t node, Ptr<const Packet> packet, RxPowerWattPerChannelBand rxPowersW);
+
+    /**
+     * Count a successful reception.
+     *
+     * \param node the index of the receiving node
+     * \param packet the packet
+     */
+    void RxEnd(uint32_t node, Ptr<const Packet> packet);
+
+    Counts m_counts; //!< Counts of the current run
+};
+
+/// Number of stationary nodes along each side of the grid
+static const uint32_t GRID_SIDE = 6;
+/// Distance between the stationary nodes (m)
+static const double GRID_SPACING = 100;
+/// Number of moving nodes
+static const uint32_t MOVING_NODES = 4;
+
+YansWifiChannelCullingTest::YansWifiChannelCullingTest()
+    : TestCase("Check the RX power floor, the grid and the loss cache of YansWifiChannel")
+{
+}
+
+void
+YansWifiChannelCullingTest::Send(Ptr<WifiNetDevice> device)
+{
+    device->Send(Create<Packet>(500), device->GetBroadcast(), 1);
+}
+
+void
+YansWifiChannelCullingTest::RxBegin(uint32_t node,
+                                    Ptr<const Packet> packet,
+                                    RxPowerWattPerChannelBand rxPowersW)
+{
+    m_counts.rxBegin[node]++;
+}
+
+void
+YansWifiChannelCullingTest::RxEnd(uint32_t node, Ptr<const Packet> packet)
+{
+    m_counts.rxEnd[node]++;
+}
+
+YansWifiChannelCullingTest::Counts
+YansWifiChannelCullingTest::Run(double rxPowerFloor, double maxRange, bool cacheLoss)
+{
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    NodeContainer nodes;
+    nodes.Create(GRID_SIDE * GRID_SIDE + MOVING_NODES);
+
+    YansWifiChannelHelper channelHelper;
+    channelHelper.SetPropagationDelay("ns3::ConstantSpeedPropagationDelayModel");
+    channelHelper.AddPropagationLoss("ns3::LogDistancePropagationLossModel");
+    Ptr<YansWifiChannel> channel = channelHelper.Create();
+    channel->SetAttribute("RxPowerFloor", DoubleValue(rxPowerFloor));
+    channel->SetAttribute("MaxRange", DoubleValue(maxRange));
+    channel->SetAttribute("CacheLoss", BooleanValue(cacheLoss));
+
+    YansWifiPhyHelper phy;
+    phy.SetChannel(channel);
+    WifiMacHelper mac;
+    mac.SetType("ns3::AdhocWifiMac");
+    WifiHelper wifi;
+    wifi.SetStandard(WIFI_STANDARD_80211a);
+    wifi.SetRemoteStationManager("ns3::ConstantRateWifiManager",
+                                 "DataMode",
+                                 StringValue("OfdmRate6Mbps"));
+    NetDeviceContainer devices = wifi.Install(phy, mac, nodes);
+    wifi.AssignStreams(devices, 1);
+
+    MobilityHelper mobility;
+    mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                                  "DeltaX",
+                                  DoubleValue(GRID_SPACING),
+                                  "DeltaY",
+                                  DoubleValue(GRID_SPACING),
+                                  "GridWidth",
+                                  UintegerValue(GRID_SIDE));
+    mobility.SetMobilityModel("ns3::ConstantVelocityMobilityModel");
+    mobility.Install(nodes);
+
+    m_counts.rxBegin.assign(nodes.GetN(), 0);
+    m_counts.rxEnd.assign(nodes.GetN(), 0);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i)
+    {
+        Ptr<ConstantVelocityMobilityModel> model =
+            nodes.Get(i)->GetObject<ConstantVelocityMobilityModel>();
+        if (i >= GRID_SIDE * GRID_SIDE)
+        {
+            // cross the grid diagonally, and stop in the middle of the run
+            uint32_t k = i - GRID_SIDE * GRID_SIDE;
+            model->SetPosition(Vector(-50.0 + 30 * k, -50.0, 0));
+            model->SetVelocity(Vector(100, 100 - 20 * k, 0));
+            Simulator::Schedule(Seconds(1.5),
+                                &ConstantVelocityMobilityModel::SetVelocity,
+                                model,
+                                Vector(0, 0, 0));
+        }
+        Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice>(devices.Get(i));
+        device->GetPhy()->TraceConnectWithoutContext(
+            "PhyRxBegin",
+            MakeCallback(&YansWifiChannelCullingTest::RxBegin, this).Bind(i));
+        device->GetPhy()->TraceConnectWithoutContext(
+            "PhyRxEnd",
+            MakeCallback(&YansWifiChannelCullingTest::RxEnd, this).Bind(i));
+        for (uint32_t n = 0; n < 20; ++n)
+        {
+            Simulator::Schedule(MilliSeconds(100 * n + 2 * i + 1),
+                                &YansWifiChannelCullingTest::Send,
+                                this,
+                                device);
+        }
+    }
+
+    Simulator::Stop(Seconds(3));
+    Simulator::Run();
+    Simulator::Destroy();
+    return m_counts;
+}
+
+void
+YansWifiChannelCullingTest::DoRun()
+{
+    Counts reference = Run(-std::numeric_limits<double>::max(),
+                           std::numeric_limits<double>::max(),
+                           false);
+    // with the default TX power and LogDistance parameters, the signals are
+    // below the RX sensitivity (-101 dBm) beyond about 220 m
+    Counts culled = Run(-101.5, 250, true);
+
+    uint32_t total = std::accumulate(reference.rxBegin.begin(), reference.rxBegin.end(), 0U);
+    NS_TEST_ASSERT_MSG_GT(total, 0, "No reception");
+    for (std::size_t i = 0; i < reference.rxBegin.size(); ++i)
+    {
+        NS_TEST_EXPECT_MSG_EQ(culled.rxBegin[i],
+                              reference.rxBegin[i],
+                              "Receptions started by node " << i);
+        NS_TEST_EXPECT_MSG_EQ(culled.rxEnd[i],
+                              reference.rxEnd[i],
+                              "Receptions ended by node " << i);
+    }
+
+    Counts shortRange = Run(-std::numeric_limits<double>::max(), 150, false);
+    uint32_t shortRangeTotal =
+        std::accumulate(shortRange.rxBegin.begin(), shortRange.rxBegin.end(), 0U);
+    NS_TEST_EXPECT_MSG_LT(shortRangeTotal, total, "Receptions beyond MaxRange");
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief YansWifiChannel TestSuite
+ */
+class YansWifiChannelTestSuite : public TestSuite
+{
+  public:
+    YansWifiChannelTestSuite();
+};
+
+YansWifiChannelTestSuite::YansWifiChannelTestSuite()
+    : TestSuite("yans-wifi-channel", UNIT)
+{
+    AddTestCase(new YansWifiChannelCullingTest(), TestCase::QUICK);
+}
+
+static YansWifiChannelTestSuite g_yansWifiChannelTestSuite; ///< the test suite
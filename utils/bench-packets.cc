@@ -20,8 +20,13 @@
 // This program can be used to benchmark packet serialization/deserialization
 // operations using Headers and Tags, for various numbers of packets 'n'
 // Sample usage:  ./ns3 run 'bench-packets --n=10000'
+// Add --compare-pooling to run the benchmarks with and without the pooling
+// of the PacketAllocator, and --print-stats to print its statistics.
+// Add --compare-printing to run them with the packet metadata built as the
+// headers are added and removed, then only when a packet is inspected.
 
 #include "ns3/command-line.h"
+#include "ns3/packet-allocator.h"
 #include "ns3/packet-metadata.h"
 #include "ns3/packet.h"
 #include "ns3/system-wall-clock-ms.h"
@@ -350,6 +355,116 @@ benchByteTags(uint32_t n)
     }
 }
 
+/**
+ * Pass packets through a pipeline which uses the packet tags like the LTE
+ * stack: the PDCP, RLC, MAC and PHY layers each add a tag and a header, the
+ * RLC keeps a copy of the packet for retransmission, the PHY delivers a
+ * copy to several receivers, which peek and remove the tags.
+ *
+ * \param n The number of packets.
+ */
+static void
+benchTagPipeline(uint32_t n)
+{
+    BenchHeader<2> pdcpHeader;
+    BenchHeader<3> rlcHeader;
+    BenchHeader<4> macHeader;
+    BenchTag<8> pdcpTag;      // like LtePdcpTag
+    BenchTag<1> rlcStatusTag; // like LteRlcSduStatusTag
+    BenchTag<4> bearerTag;    // like LteRadioBearerTag
+    BenchTag<12> phyTag;      // like LtePhyTag
+    BenchTag<6> epsBearerTag; // like EpsBearerTag, never added
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // PDCP
+        Ptr<Packet> p = Create<Packet>(1400);
+        p->AddPacketTag(pdcpTag);
+        p->AddHeader(pdcpHeader);
+        // RLC
+        p->AddPacketTag(rlcStatusTag);
+        Ptr<Packet> txCopy = p->Copy();
+        p->AddHeader(rlcHeader);
+        // MAC
+        p->AddPacketTag(bearerTag);
+        p->PeekPacketTag(rlcStatusTag);
+        p->PeekPacketTag(epsBearerTag);
+        p->AddHeader(macHeader);
+        // PHY
+        p->AddPacketTag(phyTag);
+        for (uint32_t j = 0; j < 2; j++)
+        {
+            Ptr<Packet> rx = p->Copy();
+            rx->PeekPacketTag(phyTag);
+            rx->RemovePacketTag(phyTag);
+            rx->RemoveHeader(macHeader);
+            rx->PeekPacketTag(bearerTag);
+            rx->RemovePacketTag(bearerTag);
+            rx->RemoveHeader(rlcHeader);
+            rx->RemovePacketTag(rlcStatusTag);
+            rx->RemoveHeader(pdcpHeader);
+            rx->PeekPacketTag(epsBearerTag);
+            rx->RemovePacketTag(pdcpTag);
+        }
+    }
+}
+
+/**
+ * Pass packets through the headers of an EPC bearer: the UE adds the UDP and
+ * IP headers and the PDCP, RLC and MAC headers, the eNB removes the radio
+ * headers and tunnels the packet in GTP-U, UDP and IP, and the SGW and PGW
+ * remove the tunnel and the inner headers. One packet out of 100 is
+ * inspected, like the packets written to an ascii trace.
+ *
+ * \param n The number of packets.
+ */
+static void
+benchEpcTunnel(uint32_t n)
+{
+    BenchHeader<8> udpHeader;
+    BenchHeader<20> ipv4Header;
+    BenchHeader<2> pdcpHeader;
+    BenchHeader<3> rlcHeader;
+    BenchHeader<4> macHeader;
+    BenchHeader<12> gtpuHeader;
+    uint32_t nItems = 0;
+
+    for (uint32_t i = 0; i < n; i++)
+    {
+        // UE
+        Ptr<Packet> p = Create<Packet>(1000);
+        p->AddHeader(udpHeader);
+        p->AddHeader(ipv4Header);
+        p->AddHeader(pdcpHeader);
+        p->AddHeader(rlcHeader);
+        p->AddHeader(macHeader);
+        // eNB
+        Ptr<Packet> rx = p->Copy();
+        rx->RemoveHeader(macHeader);
+        rx->RemoveHeader(rlcHeader);
+        rx->RemoveHeader(pdcpHeader);
+        rx->AddHeader(gtpuHeader);
+        rx->AddHeader(udpHeader);
+        rx->AddHeader(ipv4Header);
+        if (i % 100 == 0)
+        {
+            for (PacketMetadata::ItemIterator item = rx->BeginItem(); item.HasNext();)
+            {
+                item.Next();
+                nItems++;
+            }
+        }
+        // SGW and PGW
+        Ptr<Packet> s1u = rx->Copy();
+        s1u->RemoveHeader(ipv4Header);
+        s1u->RemoveHeader(udpHeader);
+        s1u->RemoveHeader(gtpuHeader);
+        s1u->RemoveHeader(ipv4Header);
+        s1u->RemoveHeader(udpHeader);
+    }
+    NS_ASSERT(nItems == 0 || nItems == 6 * ((n + 99) / 100));
+}
+
 static uint64_t
 runBenchOneIteration(void (*bench)(uint32_t), uint32_t n)
 {
@@ -376,12 +491,36 @@ runBench(void (*bench)(uint32_t), uint32_t n, uint32_t minIterations, const char
               << " (" << minDelay << " ms elapsed)\t" << name << std::endl;
 }
 
+/**
+ * Run all the benchmarks.
+ *
+ * \param n The number of packets per benchmark.
+ * \param minIterations The number of iterations of each benchmark.
+ */
+static void
+runAllBenches(uint32_t n, uint32_t minIterations)
+{
+    runBench(&benchA, n, minIterations, "Copy packet, remove headers");
+    runBench(&benchB, n, minIterations, "Just add headers");
+    runBench(&benchC, n, minIterations, "Remove by func call");
+    runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
+    runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
+    runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    runBench(&benchTagPipeline, n, minIterations, "Packet tags through PDCP, RLC, MAC and PHY");
+    runBench(&benchEpcTunnel, n, minIterations, "Headers through an EPC tunnel, 1% inspected");
+}
+
 int
 main(int argc, char* argv[])
 {
     uint32_t n = 0;
     uint32_t minIterations = 1;
     bool enablePrinting = false;
+    bool lazyPrinting = false;
+    bool comparePrinting = false;
+    bool pooling = true;
+    bool comparePooling = false;
+    bool printStats = false;
 
     CommandLine cmd(__FILE__);
     cmd.Usage("Benchmark Packet class");
@@ -390,6 +529,15 @@ main(int argc, char* argv[])
                  "number of subiterations to minimize iteration time over",
                  minIterations);
     cmd.AddValue("enable-printing", "enable packet printing", enablePrinting);
+    cmd.AddValue("lazy-printing", "enable lazy packet printing", lazyPrinting);
+    cmd.AddValue("compare-printing",
+                 "run the benchmarks with packet printing, then lazy packet printing",
+                 comparePrinting);
+    cmd.AddValue("pooling", "keep the free packet blocks for reuse", pooling);
+    cmd.AddValue("compare-pooling",
+                 "run the benchmarks with and without pooling",
+                 comparePooling);
+    cmd.AddValue("print-stats", "print the packet allocation statistics", printStats);
     cmd.Parse(argc, argv);
 
     if (n == 0)
@@ -401,12 +549,44 @@ main(int argc, char* argv[])
     std::cout << "Running bench-packets with n=" << n << std::endl;
     std::cout << "All tests begin by adding UDP and IPv4 headers." << std::endl;
 
-    runBench(&benchA, n, minIterations, "Copy packet, remove headers");
-    runBench(&benchB, n, minIterations, "Just add headers");
-    runBench(&benchC, n, minIterations, "Remove by func call");
-    runBench(&benchD, n, minIterations, "Intermixed add/remove headers and tags");
-    runBench(&benchFragment, n, minIterations, "Fragmentation and concatenation");
-    runBench(&benchByteTags, n, minIterations, "Benchmark byte tags");
+    if (comparePrinting)
+    {
+        std::cout << "With packet printing:" << std::endl;
+        Packet::EnablePrinting();
+        runAllBenches(n, minIterations);
+        std::cout << "With lazy packet printing:" << std::endl;
+        Packet::EnableLazyPrinting();
+        runAllBenches(n, minIterations);
+        return 0;
+    }
+    if (lazyPrinting)
+    {
+        Packet::EnableLazyPrinting();
+    }
+    else if (enablePrinting)
+    {
+        Packet::EnablePrinting();
+    }
+
+    if (comparePooling)
+    {
+        std::cout << "With pooling:" << std::endl;
+        PacketAllocator::SetPooling(true);
+        runAllBenches(n, minIterations);
+        std::cout << "Without pooling:" << std::endl;
+        PacketAllocator::SetPooling(false);
+        runAllBenches(n, minIterations);
+    }
+    else
+    {
+        PacketAllocator::SetPooling(pooling);
+        runAllBenches(n, minIterations);
+    }
+
+    if (printStats)
+    {
+        PacketAllocator::PrintStats(std::cout);
+    }
 
     return 0;
 }
@@ -0,0 +1,101 @@
+#!/usr/bin/env python3
+"""
+Convert a file written by ns3::BinaryTraceSink to the text format of the trace.
+
+Usage: binary-trace-to-text.py BINARY [TEXT]
+
+The file may be compressed with gzip. The text is written to TEXT, or to the
+standard output: the header lines, then one line per record with the fields
+separated by tabs, formatted as by a std::ostream with its default settings.
+"""
+
+import argparse
+import gzip
+import struct
+import sys
+
+## Magic bytes at the start of a binary trace file
+BINARY_MAGIC = b"NS3BTRC1"
+## Magic bytes at the start of a gzip file
+GZIP_MAGIC = b"\x1f\x8b"
+## struct formats of the field types, indexed by their code in the preamble
+FIELD_FORMATS = {1: "B", 2: "H", 3: "I", 4: "Q", 5: "b", 6: "h", 7: "i", 8: "q", 9: "d"}
+## code of the string fields, a uint32 length followed by the characters
+STRING_FIELD = 10
+
+
+def format_field(value):
+    """! Format a field as a std::ostream does.
+    @param value the field
+    @return the text of the field
+    """
+    if isinstance(value, float):
+        return "%g" % value
+    return str(value)
+
+
+def convert(data, out):
+    """! Convert a binary trace.
+    @param data the content of the file, uncompressed
+    @param out the output text file
+    """
+    if not data.startswith(BINARY_MAGIC):
+        raise ValueError("not a binary trace file")
+    pos = len(BINARY_MAGIC)
+    order = "<" if struct.unpack_from("<I", data, pos)[0] == 0x01020304 else ">"
+    pos += 4
+
+    def read_string():
+        nonlocal pos
+        (size,) = struct.unpack_from(order + "I", data, pos)
+        pos += 4 + size
+        return data[pos - size : pos].decode()
+
+    out.write(read_string())
+    terminator = read_string()
+    nFields = data[pos]
+    types = data[pos + 1 : pos + 1 + nFields]
+    pos += 1 + nFields
+
+    # the consecutive fixed-size fields are unpacked together
+    groups = []
+    for fieldType in types:
+        if fieldType == STRING_FIELD:
+            groups.append(None)
+        elif groups and groups[-1] is not None:
+            groups[-1] += FIELD_FORMATS[fieldType]
+        else:
+            groups.append(FIELD_FORMATS[fieldType])
+    groups = [None if g is None else struct.Struct(order + g) for g in groups]
+
+    while pos < len(data):
+        fields = []
+        for group in groups:
+            if group is None:
+                fields.append(read_string())
+            else:
+                fields.extend(format_field(v) for v in group.unpack_from(data, pos))
+                pos += group.size
+        out.write("\t".join(fields) + terminator)
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[1])
+    parser.add_argument("binary", help="file written by BinaryTraceSink")
+    parser.add_argument("text", nargs="?", help="output text file (default: standard output)")
+    args = parser.parse_args(argv[1:])
+
+    with open(args.binary, "rb") as f:
+        data = f.read()
+    if data.startswith(GZIP_MAGIC):
+        data = gzip.decompress(data)
+
+    if args.text:
+        with open(args.text, "w") as out:
+            convert(data, out)
+    else:
+        convert(data, sys.stdout)
+
+
+if __name__ == "__main__":
+    main(sys.argv)